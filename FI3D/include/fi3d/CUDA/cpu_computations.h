@@ -0,0 +1,53 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		cpu_computations.h
+* @brief	The CPU twins of the CUDA functions, used when CUDA is disabled.
+*
+* Each function computes the same points as the CUDA function with the same
+* name and the "_cuda" suffix, in the same order. The CUDA blocks become rows
+* that are spread over threads with ParallelAlgorithms, and the CUDA threads
+* of a block become the values of a row. The angles are the same for every
+* row, so their sines and cosines are computed once, which leaves rows of
+* multiplications the compiler vectorizes. Like cuda_computations, this file
+* should be used through cuda_helpers.h.
+*/
+
+namespace fi3d {
+namespace CUDA {
+
+/*!
+ * @brief Compute sphere part of workspace, see computeMK3Workspace_sphere_cuda.
+ *
+ * @param points where the x, y, z of the points are written, one row of
+ *			rotations points per translation
+ * @param translations the number of circles
+ * @param rotations the number of points in a circle
+ * @param circleStepSize the radius added by each circle
+ * @param pointStepSize the angle between the points of a circle
+ * @param separation the separation between the top and bottom stages
+ * @param depth the depth of the needle
+ */
+void computeMK3Workspace_sphere_cpu(float* points, const int& translations,
+	const int& rotations, const float& circleStepSize, const float& pointStepSize,
+	const float& separation, const float& depth);
+
+/*!
+ * @brief Compute cone part of workspace, see computeMK3Workspace_cone_cuda.
+ *
+ * @param points where the x, y, z of the points are written, one row of
+ *			rotations points per insertion
+ * @param insertions the number of depths down the cone
+ * @param rotations the number of points at each depth
+ * @param insertionStepSize the depth added by each insertion
+ * @param pointStepSize the angle between the points at a depth
+ * @param separation the separation between the top and bottom stages
+ * @param range the maximum translation distance that can be achieved by
+ *			the top stage
+ * @param depthMin the minimum depth of the needle
+ */
+void computeMK3Workspace_cone_cpu(float* points, const int& insertions,
+	const int& rotations, const float& insertionStepSize, const float& pointStepSize,
+	const float& separation, const float& range, const float& depthMin);
+}
+}
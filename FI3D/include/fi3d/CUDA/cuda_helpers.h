@@ -14,6 +14,11 @@
 * name plus "_cuda" suffix. In other words, every CUDA function has a helper
 * function. The helper functions should be used throughout the application,
 * and CUDA functions are then invoked from here.
+*
+* When FI3D is built without CUDA (FI3D_NO_CUDA), the helpers invoke the
+* twins in cpu_computations with the "_cpu" suffix instead, which run on
+* all the cores of the CPU. Either way, the points are written at once into
+* the float points of the ModelData, see reserveWorkspacePoints.
 */
 
 #include <fi3d/data/ModelData.h>
@@ -42,7 +47,6 @@ namespace CUDA {
  *	@param rotations the number of rotations for which points will be 
  *			calculated, acceptable values [1-1024]
  */
- //TODO: Fix this function to work without the Model class which was removed
 void computeMK3Workspace_sphere(fi3d::ModelData& workspace, float separation, 
 	float depth, float range, int translations, int rotations);
 
@@ -62,8 +66,20 @@ void computeMK3Workspace_sphere(fi3d::ModelData& workspace, float separation,
  *	@param rotations the number of rotations for which points will be 
  *			calculated, acceptable values [1-1024]
  */
- //TODO: Fix this function to work without the Model class which was removed
 void computeMK3Workspace_cone(fi3d::ModelData& workspace, float separation, 
 	float dmin, float dmax, float range, int insertions, int rotations);
+
+/*!
+ * @brief Adds points to the end of the points of the workspace.
+ *
+ * The points of the workspace are converted to float if they are not.
+ * The added points are not set, they are meant to be written through the
+ * returned pointer. Call Modified on the points once they are written.
+ *
+ *	@param workspace the object where the points are added
+ *	@param count the number of points added
+ *	@return the x, y, z of the first added point, followed by the others
+ */
+float* reserveWorkspacePoints(fi3d::ModelData& workspace, const vtkIdType& count);
 }
 }
\ No newline at end of file
@@ -15,14 +15,23 @@
 * as persistent data. Each data object registered must have a unique ID. If
 * the given ID is already in use, an error message is returned during 
 * registration. 
+*
+* Persistent data is kept in a DataCatalog, updated as soon as data is
+* registered or its persistent state changes. Data is looked up by name or
+* StudyID through indexes built at registration, renaming registered data
+* is found through a slower search.
 */
 
 #include <fi3d/data/data_manager/EDM_State.h>
 #include <fi3d/data/data_manager/EFileExtension.h>
 #include <fi3d/data/data_manager/DataMessageEncoder.h>
+#include <fi3d/data/data_manager/catalog/DataCatalog.h>
+#include <fi3d/data/data_manager/crawler/DicomCrawler.h>
 #include <fi3d/data/data_manager/registered_data/RegisteredImage.h>
 #include <fi3d/data/data_manager/registered_data/RegisteredStudy.h>
 #include <fi3d/data/data_manager/registered_data/RegisteredModel.h>
+#include <fi3d/data/data_manager/stream/StreamIngest.h>
+#include <fi3d/data/data_manager/thumbnail/ThumbnailService.h>
 
 #include <fi3d/FI3D/FI3DComponentRegistration.h>
 
@@ -44,6 +53,10 @@ class DataManager : public QObject {
 	friend class DataMessageEncoder;
 
 /****************** Static members for the singleton ******************/
+signals:
+	/// @brief Emitted when scanStudies registers a study it found.
+	void addedStudy(fi3d::RegisteredStudyPtr study);
+
 /// Methods related GUI
 public slots:
 	/// @brief Pops ups the dialog used to load a new DICOM study.
@@ -70,6 +83,9 @@ public:
 	/// @brief Register the given study.
 	static EDM_State registerStudy(StudyPtr study);
 
+	/// @brief Unregisters the study, it is kept in the catalog if persistent.
+	static EDM_State unregisterStudy(const DataID& dataID);
+
 	/// @brief Registers model data in the manager.
 	static EDM_State registerModelData(ModelDataVPtr data);
 	
@@ -116,8 +132,47 @@ public:
 	 */
 	static EDM_State registerStudies(const QString& directory, const bool& isPersistent);
 
+	/*!
+	 * @brief Registers the studies in the directory as they are found.
+	 *
+	 * Same as registerStudies, but the directory is crawled in the 
+	 * background and each study is registered, and addedStudy emitted, as 
+	 * soon as it is found. Its files are set once the crawl is done, loading 
+	 * its data before then waits for the crawl. Studies with the StudyID and 
+	 * PatientID of a registered study are skipped, so scanning a directory 
+	 * again only registers the new ones. Only one directory is scanned at a 
+	 * time.
+	 *
+	 * @return The crawler, to follow its progress. Q_NULLPTR if a scan is running.
+	 */
+	static DicomCrawler* scanStudies(const QString& directory, const bool& isPersistent);
+
+/// Methods related to live streams
+public:
+	/*!
+	 * @brief Starts receiving live frames on a local socket into a Study.
+	 *
+	 * The Study is named after the stream and registered, so FIs can request
+	 * it like any other Study. Only one stream is received at a time,
+	 * starting another one stops the current one. See StreamIngest.
+	 *
+	 * @param frameCount The number of frames kept in the Study.
+	 */
+	static bool startStreamIngest(const QString& streamName, const int& frameCount = 8);
+
+	/// @brief Stops receiving live frames and unregisters their Study.
+	static void stopStreamIngest();
+
+	/// @brief Gets the stream being received, Q_NULLPTR if none.
+	static StreamIngest* getStreamIngest();
+
 private:
-	/// @brief Given the ManagedStudy, load the actual study data.
+	/*!
+	 * @brief Given the ManagedStudy, load the actual study data.
+	 *
+	 * A study found by a crawl that is still running has no files yet, it
+	 * is left without data and loaded when the crawl is done.
+	 */
 	static void loadStudyData(RegisteredStudyPtr regStudy);
 
 public:
@@ -219,9 +274,12 @@ public:
 
 /****************** Singleton members ******************/
 private:
-	/// @brief Path to location of file with persistent data.
+	/// @brief Path to the JSON file that kept persistent data before the catalog.
 	const QString M_PERSISTENT_PATH;
 
+	/// @brief The persistent data.
+	DataCatalogPtr mCatalog;
+
 	/// @brief Hash table with all the used up QUuIDs.
 	QHash<DataID, QString> mUsedQUuIDs;
 
@@ -234,9 +292,36 @@ private:
 	/// @brief Hash table with all the managed model data sets.
 	QHash<DataID, RegisteredModelPtr> mRegisteredModels;
 
+	/// @brief The first registered ImageData of each name.
+	QHash<QString, DataID> mImageNames;
+
+	/// @brief The first registered Study of each StudyID.
+	QHash<QString, DataID> mStudyIDs;
+
+	/// @brief The first registered ModelData of each name.
+	QHash<QString, DataID> mModelNames;
+
 	/// @brief Message encoder used to communicate with clients.
 	DataMessageEncoderPtr mMessageEncoder;
 
+	/// @brief Receives the live stream, if started.
+	StreamIngestPtr mStreamIngest;
+
+	/// @brief The crawler of the last scanStudies.
+	DicomCrawlerPtr mCrawler;
+
+	/// @brief Whether the studies found by the crawler are persistent.
+	bool mIsCrawlPersistent;
+
+	/// @brief The studies registered by the crawler, waiting for their files.
+	QHash<QString, RegisteredStudyPtr> mCrawledStudies;
+
+	/// @brief The crawled studies asked for during the crawl, loaded once it is done.
+	QList<RegisteredStudyPtr> mPendingStudyLoads;
+
+	/// @brief Renders the thumbnails shown by the dialogs.
+	ThumbnailServicePtr mThumbnails;
+
 	/// @brief The dialog used to interact with this manager.
 	QSharedPointer<DataManagerDialog> mGUI;
 
@@ -249,13 +334,61 @@ public:
 
 private:
 /// Methods related to the saving/loading of persistent data
-	/// @brief Reads a data manager configuration file.
+	/// @brief Opens the catalog and registers its data, without loading it.
 	void loadPersistantData();
 
-	/// @brief Saves the persistent data meta-data to configuration file.
-	void savePersistentData();
+	/// @brief Moves the data of the JSON file used before the catalog into the catalog.
+	void importPersistentJson();
+
+	/// @brief Writes the ImageData to the catalog.
+	void catalogImage(RegisteredImagePtr regImage);
+
+	/// @brief Writes the Study to the catalog.
+	void catalogStudy(RegisteredStudyPtr regStudy);
+
+	/// @brief Writes the ModelData to the catalog.
+	void catalogModel(RegisteredModelPtr regModel);
+
+	/// @brief Reads the DICOM files of a Study from the catalog, if not read yet.
+	void restoreDICOMPaths(RegisteredStudyPtr regStudy);
+
+/// Methods related to the registered data and its indexes
+	/// @brief Adds the ImageData to the registered ones and the name index.
+	void insertImage(RegisteredImagePtr regImage);
+
+	/// @brief Adds the Study to the registered ones and the StudyID index.
+	void insertStudy(RegisteredStudyPtr regStudy);
+
+	/// @brief Adds the ModelData to the registered ones and the name index.
+	void insertModel(RegisteredModelPtr regModel);
+
+	/// @brief Removes the Study from the registered ones and the StudyID index.
+	void removeStudy(RegisteredStudyPtr regStudy);
+
+	/// @brief Gets the first registered ImageData with the name, null if none.
+	RegisteredImagePtr findImageByName(const QString& dataName);
+
+	/// @brief Gets the first registered Study with the StudyID, null if none.
+	RegisteredStudyPtr findStudyByStudyID(const QString& studyID);
+
+	/// @brief Gets the first registered ModelData with the name, null if none.
+	RegisteredModelPtr findModelByName(const QString& dataName);
+
+/// Methods related to scanStudies
+	/// @brief Registers a study found by the crawler.
+	void onFoundStudy(const fi3d::DicomStudyRecord& record);
+
+	/// @brief Sets the files of the studies registered by the crawler.
+	void onCrawlFinished();
 
 /// Methods related to the GUI and data dialogs
+	/// @brief Requests the thumbnails of the studies from the thumbnail service.
+	void onRequestedThumbnails(const QList<fi3d::DataID>& studies);
+
+	/// @brief Gets what the thumbnail of a study is rendered from, without
+	/// loading its data. False if there is nothing to render yet.
+	bool getThumbnailSource(RegisteredStudyPtr regStudy, ThumbnailSource& source);
+
 	/// @brief Updates the list of images that are listed.
 	void updateDialogImageList();
 
@@ -48,6 +48,9 @@ private:
 	 */
 	bool mIsCacheable;
 
+	/// @brief Version of the data contents, increased by dataUpdated.
+	qint64 mDataVersion;
+
 public:
 	/// @brief Constructor.
 	DataObject();
@@ -71,9 +74,17 @@ public:
 
 	virtual void setCacheable(const bool& isCacheable);
 
+	/*!
+	 * @brief Gets the version of the data contents.
+	 *
+	 * It starts at 0 and increases every time dataUpdated is called, so a
+	 * copy of the data made at a given version is up to date for as long as
+	 * the version does not change.
+	 */
+	qint64 getDataVersion() const;
 
 	/*! 
-	 * @brief Emits the changedData signal.
+	 * @brief Increases the data version and emits the changedData signal.
 	 *
 	 * This funciton should be called when the internal data is changed.
 	 * This is useful to notify objects about changes to the data. This is
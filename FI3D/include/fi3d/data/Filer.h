@@ -113,8 +113,11 @@ public:
 	/*!
 	 * @brief Find studies within the given directory and populate their meta-data.
 	 *
-	 * The given study name is set if one study is found. If more than one study is found, each study gets an enumerated name
-	 * as follows: "studyName"_#, where # is the number of the study as it's found in the directory.
+	 * The directory is crawled by a DicomCrawler with the scan cache of the
+	 * DataManager, so searching the same directory again only parses new or
+	 * changed files. A study without a StudyID is named after its directory.
+	 * If that directory has more than one such study, the later ones get an
+	 * enumerated name as follows: "directory"_#.
 	 */
 	static QList<StudyPtr> findStudies(const QString& directoryPath, 
 		QVector<QVector<vtkSmartPointer<vtkStringArray>>>& outStudiesPaths);
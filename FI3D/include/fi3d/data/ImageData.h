@@ -4,19 +4,62 @@
 * @file		ImageData.h
 * @class	fi3d::ImageData
 * @brief	Same as vtkImageData but as a QObject as well.
+*
+* Writers that only change part of the voxels should call updateExtent or
+* updateSlice instead of dataUpdated. The changed extent is recorded with the
+* new data version, so that copies of the image, e.g., encoded slice messages,
+* only refresh the slices that were written.
+*
+* The voxels keep the depth they were read with, e.g., 16-bit DICOM. The
+* window/level only says how they are displayed and encoded, it never
+* changes the voxels.
 */
 
 #include <fi3d/data/DataObject.h>
 
+#include <fi3d/rendering/visuals/3D/slices/ESliceOrientation.h>
+
 #include <vtkImageData.h>
 #include <vtkSmartPointer.h>
 #include <vtkMatrix4x4.h>
 
+#include <QList>
+
 namespace fi3d {
+
+/// @brief A region of an ImageData changed in one data version.
+typedef struct DirtyExtent {
+	/// @brief The data version the change produced.
+	qint64 DataVersion = 0;
+	/// @brief The changed voxels as [xMin, xMax, yMin, yMax, zMin, zMax].
+	int Extent[6] = {0, -1, 0, -1, 0, -1};
+} DirtyExtent;
+
 class ImageData : public DataObject, public vtkImageData {
 
 	Q_OBJECT
 
+public:
+	/// @brief The number of data versions whose changed extents are kept.
+	static const int MAX_DIRTY_EXTENTS = 64;
+
+private:
+	/// @brief The extents changed by the last partial writes, oldest first.
+	QList<DirtyExtent> mDirtyExtents;
+
+	/// @brief The width of the displayed intensity range.
+	double mWindow;
+
+	/// @brief The center of the displayed intensity range.
+	double mLevel;
+
+	/// @brief Whether the window/level was set, otherwise it is the default.
+	bool mHasWindowLevel;
+
+signals:
+	/// @brief Emitted when the window/level changes.
+	void changedWindowLevel(const double& window, const double& level);
+
 public:
 	/*! @brief VTK object dependencies. */
 	static ImageData* New();
@@ -41,6 +84,92 @@ public:
 		const double& spaceX, const double& spaceY, const double spaceZ,
 		int type = VTK_UNSIGNED_CHAR);
 
+	/*!
+	*	@name Partial Images
+	*	@brief An image may keep only some of its voxels in memory, e.g., a
+	*	client-side cache. Its dimensions describe the whole image but it has
+	*	no scalars, so each displayed slice is copied into a separate image.
+	*/
+	/// @{
+	/// @brief Whether only some of the voxels are in memory. False by default.
+	virtual bool isPartial() const;
+
+	/*!
+	 * @brief Copies a slice into the given image.
+	 *
+	 * The slice image gets the origin and spacing of this image and the 
+	 * extent of the slice, e.g., [0, dimX - 1, 0, dimY - 1, k, k] for the
+	 * kth XY slice. By default it is copied from the scalars of this image.
+	 */
+	virtual void copySlice(const int& sliceIndex, 
+		const fi3d::ESliceOrientation& orientation, vtkImageData* slice);
+	/// @}
+
+	/*!
+	*	@name Partial Writes
+	*	@brief Tracks which voxels changed between data versions.
+	*/
+	/// @{
+	/*!
+	 * @brief Notifies that the voxels in the extent were written.
+	 *
+	 * The extent is clamped to the extent of the image and recorded with
+	 * the new data version, then dataUpdated is called. Nothing happens if
+	 * the extent does not overlap the image.
+	 *
+	 * @param extent The written voxels as [xMin, xMax, yMin, yMax, zMin, zMax].
+	 */
+	void updateExtent(const int extent[6]);
+
+	/// @brief Notifies that a slice was written, see updateExtent.
+	void updateSlice(const int& sliceIndex, const fi3d::ESliceOrientation& orientation);
+
+	/*!
+	 * @brief Gets the extent that bounds every change after a data version.
+	 *
+	 * The extent is empty (min > max) when the version is current.
+	 *
+	 * @param sinceVersion The version of the copy that is being refreshed.
+	 * @param extent The changed voxels as [xMin, xMax, yMin, yMax, zMin, zMax].
+	 * @return False when a change since that version is not known, i.e., it
+	 * was made with dataUpdated or is too old, so all of the image changed.
+	 */
+	bool getChangedExtent(const qint64& sinceVersion, int extent[6]) const;
+	/// @}
+
+	/*!
+	*	@name Window/Level
+	*	@brief Maps intensities [level - window/2, level + window/2] to [0, 1]
+	*	when the image is displayed or encoded.
+	*/
+	/// @{
+	/*!
+	 * @brief Sets the window/level.
+	 *
+	 * Only emits changedWindowLevel. The voxels do not change, so the data
+	 * version stays the same and copies of the image keep their slices.
+	 * Copies encoded through a window/level, e.g., slice messages, compare
+	 * it with the one they were encoded with instead.
+	 */
+	void setWindowLevel(const double& window, const double& level);
+
+	/*!
+	 * @brief Gets the window/level.
+	 *
+	 * When it was not set, unsigned char images use the whole range of the
+	 * type and any other type uses the range of its scalars.
+	 */
+	void getWindowLevel(double& window, double& level);
+
+	/// @brief Whether the window/level was set.
+	bool hasWindowLevel() const;
+	/// @}
+
+protected:
+	/// @brief Sets the geometry of the slice image, used by copySlice.
+	bool prepareSliceImage(const int& sliceIndex,
+		const fi3d::ESliceOrientation& orientation, vtkImageData* slice);
+
 protected:
 	/*! @brief Constructor. */
 	ImageData();
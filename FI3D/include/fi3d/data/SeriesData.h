@@ -10,6 +10,7 @@
 */
 
 #include <fi3d/data/ImageData.h>
+#include <fi3d/data/StudyStorage.h>
 
 #include <vtkDICOMMetaData.h>
 
@@ -30,6 +31,9 @@ private:
 	/// @brief The meta-data of the series obtain from the DICOMs.
 	vtkSmartPointer<vtkDICOMMetaData> mMetaData;
 
+	/// @brief The storage the scalars point into, null if they own their memory.
+	StudyStoragePtr mStorage;
+
 public:
 	/// @brief VTK object dependencies.
 	static SeriesData* New();
@@ -42,6 +46,9 @@ private:
 	/// @brief Sets the series index this image data has in the study.
 	void setSeriesIndex(const int& index);
 
+	/// @brief Sets the storage the scalars point into.
+	void setStorage(StudyStoragePtr storage);
+
 public:
 	/// @brief Gets the series index this image data has in the study.
 	int getSeriesIndex();
@@ -58,6 +65,9 @@ public:
 	/// @brief Gets the meta-data object.
 	vtkSmartPointer<vtkDICOMMetaData> getMetaData();
 
+	/// @brief Gets the storage the scalars point into, null if they own their memory.
+	StudyStoragePtr getStorage() const;
+
 protected:
 	/// @brief Constructor.
 	SeriesData();
@@ -0,0 +1,111 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		SeriesView.h
+* @class	fi3d::SeriesView
+* @brief	A SeriesData whose XY planes are read in place from other arrays.
+*
+* A StudyView phase that is not one whole array, e.g., a spatial domain phase
+* made of one plane of every time domain series, becomes a SeriesView. It
+* keeps a pointer to each of its planes and references to the arrays holding
+* them, so creating it copies no voxels. It is a partial ImageData: its
+* scalars are an empty array of the voxel type, and the visuals and encoders
+* copy the one slice they need through copySlice.
+*
+* Code that needs the whole volume in one array, e.g., to segment or save it,
+* calls makeContiguous, usually through Study::getContiguousSeries. That is
+* the only place the voxels of the planes are copied.
+*/
+
+#include <fi3d/data/SeriesData.h>
+
+#include <QVector>
+
+#include <vtkDataArray.h>
+#include <vtkSmartPointer.h>
+
+namespace fi3d {
+class SeriesView : public SeriesData {
+
+	Q_OBJECT
+	friend class Study;
+
+private:
+	/// @brief The arrays holding the planes, kept alive by the view.
+	QVector<vtkSmartPointer<vtkDataArray>> mBuffers;
+
+	/// @brief The first voxel of each XY plane, by z.
+	QVector<const char*> mPlanes;
+
+	/// @brief The bytes of one voxel, all of its components.
+	int mVoxelBytes;
+
+	/// @brief The bytes of one XY plane.
+	qint64 mPlaneBytes;
+
+public:
+	/// @brief VTK object dependencies.
+	static SeriesView* New();
+	vtkTypeMacro(SeriesView, SeriesData)
+
+	/*!
+	 * @brief Sets the planes of the series.
+	 *
+	 * The dimensions must be set first, there must be one plane per z.
+	 *
+	 * @param buffers The arrays the planes point into.
+	 * @param planes The first voxel of each XY plane.
+	 * @param scalarType The VTK scalar type of the voxels.
+	 * @param components The components of each voxel.
+	 * @return Whether there is one plane per z.
+	 */
+	bool setPlanes(const QVector<vtkSmartPointer<vtkDataArray>>& buffers,
+		const QVector<const void*>& planes, const int& scalarType, const int& components);
+
+	/// @brief Gets the first voxel of the XY plane z, Q_NULLPTR if not a view.
+	const void* getPlanePointer(const int& z) const;
+
+	/// @brief Copies every plane into output, one after the other.
+	bool copyPlanes(void* output) const;
+
+	/*!
+	 * @brief Copies the planes into an array of the series' own.
+	 *
+	 * Afterwards the series is a regular SeriesData and the arrays of the
+	 * planes are released. Emits changedData so that visuals copying their
+	 * slice show the scalars instead, the data version stays the same.
+	 *
+	 * @return Whether the scalars are contiguous.
+	 */
+	bool makeContiguous();
+
+	/*!
+	*	@name Partial ImageData implementations.
+	*	@brief See ImageData for more information.
+	*/
+	/// @{
+	virtual bool isPartial() const override;
+	virtual void copySlice(const int& sliceIndex,
+		const fi3d::ESliceOrientation& orientation, vtkImageData* slice) override;
+	/// @}
+
+private:
+	/// @brief Releases the planes, used once the scalars were replaced.
+	void releasePlanes();
+
+protected:
+	/// @brief Constructor.
+	SeriesView();
+
+	/// @brief Destructor.
+	~SeriesView() override = default;
+
+private:
+	SeriesView(const SeriesView&) = delete;
+	void operator=(const SeriesView&) = delete;
+};
+
+/// @brief Alias for a smart pointer of this class.
+using SeriesViewVPtr = vtkSmartPointer<SeriesView>;
+
+}
@@ -13,6 +13,7 @@
 #include <fi3d/data/DataObject.h>
 
 #include <fi3d/data/SeriesData.h>
+#include <fi3d/data/StudyView.h>
 
 #include <QVector>
 #include <QSharedPointer>
@@ -45,9 +46,15 @@ private:
 	/// @brief The time of the study. 
 	QString mTime;
 
-	/// @brief List of data sets (series). 
+	/// @brief List of data sets (series). Null until created from the view.
 	QVector<SeriesDataVPtr> mSeriesSet;
 
+	/// @brief The view the series are created from on first use, if any.
+	StudyViewPtr mView;
+
+	/// @brief The buffer holding the series when packed, null otherwise.
+	StudyStoragePtr mStorage;
+
 	/// @brief A low resolution image of a slice to represent the Study
 	/// visually.
 	ImageDataVPtr mThumbnail;
@@ -75,9 +82,62 @@ public:
 	/// @brief Get the number of data sets (series) in the study.
 	int getSeriesCount() const;
 
-	/// @brief Gets a data set from the study.
+	/*!
+	 * @brief Gets a data set from the study.
+	 *
+	 * A series of a view may be a partial SeriesView, which visuals and
+	 * encoders read one slice at a time. Use getContiguousSeries to read
+	 * the whole volume.
+	 */
 	SeriesDataVPtr getSeries(const int& seriesIndex);
 
+	/*!
+	 * @brief Gets a data set from the study with its voxels in one array.
+	 *
+	 * A SeriesView is made contiguous first, which copies its planes. It
+	 * stays the same object, so visuals showing it keep working.
+	 */
+	SeriesDataVPtr getContiguousSeries(const int& seriesIndex);
+
+	/*!
+	 * @brief Sets the series of the study to the phases of the view.
+	 *
+	 * The current series are removed. Each phase becomes a series the first
+	 * time it is asked for with getSeries, and even then no voxels are
+	 * copied, see StudyView::createSeries.
+	 */
+	void setView(StudyViewPtr view);
+
+	/// @brief Gets the view the series are created from, null if none.
+	StudyViewPtr getView() const;
+
+	/*!
+	 * @brief Moves every series into one contiguous StudyStorage.
+	 *
+	 * The series keep their objects, only their scalars are replaced by
+	 * arrays pointing into the storage, so anything holding a series keeps
+	 * working. The series must share dimensions, scalar type and components.
+	 * Each series is copied once, straight from the planes of a view, and
+	 * the view is released afterwards along with the arrays it referenced.
+	 *
+	 * @return Whether the series were packed.
+	 */
+	bool packSeries();
+
+	/*!
+	 * @brief Creates the series of a new StudyStorage and adds them.
+	 *
+	 * Used to load a study straight into contiguous storage, the voxels are
+	 * not initialized.
+	 *
+	 * @return Whether the storage could be allocated.
+	 */
+	bool allocateSeries(const int& phaseCount, const int dimensions[3],
+		const int& scalarType, const int& components = 1);
+
+	/// @brief Gets the storage of the packed series, null if not packed.
+	StudyStoragePtr getStorage() const;
+
 	/// @brief Whether the given index represents a series in the study.
 	bool isSeriesIndexInRange(const int& seriesIndex) const;
 
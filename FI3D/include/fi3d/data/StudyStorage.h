@@ -0,0 +1,112 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		StudyStorage.h
+* @class	fi3d::StudyStorage
+* @brief	One aligned 4D buffer (phase, z, y, x) holding the series of a Study.
+*
+* Each phase is one volume, laid out like the scalars of a vtkImageData, and
+* starts on an ALIGNMENT boundary. The series of a packed Study use arrays
+* that point into the buffer (see createPhaseArray), so cine playback walks
+* consecutive memory and the same plane of every phase sits at a fixed
+* stride, which extractPlaneOverPhases and getTimeCurve read in one pass.
+*
+* The arrays made by createPhaseArray do not own their memory, the series
+* using them keep the storage alive.
+*/
+
+#include <QSharedPointer>
+#include <QVector>
+
+#include <vtkDataArray.h>
+#include <vtkSmartPointer.h>
+
+namespace fi3d {
+class StudyStorage {
+public:
+	/// @brief The byte alignment of the buffer and of each phase.
+	static const int ALIGNMENT = 64;
+
+private:
+	/// @brief The buffer, Q_NULLPTR if it could not be allocated.
+	void* mData;
+
+	/// @brief The size of the x, y and z axes.
+	int mDimensions[3];
+
+	/// @brief The number of phases.
+	int mPhaseCount;
+
+	/// @brief The VTK scalar type of the voxels.
+	int mScalarType;
+
+	/// @brief The components of each voxel.
+	int mComponents;
+
+	/// @brief The bytes of one XY plane.
+	qint64 mPlaneBytes;
+
+	/// @brief The bytes from one phase to the next, padded to ALIGNMENT.
+	qint64 mPhaseStride;
+
+public:
+	/*!
+	 * @brief Constructor. Allocates the buffer, which is not initialized.
+	 *
+	 * @param dimensions The size of the x, y and z axes of each phase.
+	 * @param phaseCount The number of phases.
+	 * @param scalarType The VTK scalar type of the voxels.
+	 * @param components The components of each voxel.
+	 */
+	StudyStorage(const int dimensions[3], const int& phaseCount,
+		const int& scalarType, const int& components);
+
+	/// @brief Destructor. Frees the buffer.
+	~StudyStorage();
+
+	/// @brief Whether the buffer was allocated.
+	bool isAllocated() const;
+
+	/// @brief Gets the size of the x, y and z axes.
+	void getDimensions(int dimensions[3]) const;
+
+	/// @brief Gets the number of phases.
+	int getPhaseCount() const;
+
+	/// @brief Gets the VTK scalar type.
+	int getScalarType() const;
+
+	/// @brief Gets the components of each voxel.
+	int getComponents() const;
+
+	/// @brief Gets the bytes of one XY plane.
+	qint64 getPlaneBytes() const;
+
+	/// @brief Gets the bytes from one phase to the next.
+	qint64 getPhaseStride() const;
+
+	/// @brief Gets the first voxel of the phase.
+	void* getPhasePointer(const int& phase) const;
+
+	/// @brief Gets the first voxel of the plane z in the phase.
+	void* getPlanePointer(const int& phase, const int& z) const;
+
+	/// @brief Creates an array of the scalars of the phase, pointing into the buffer.
+	vtkSmartPointer<vtkDataArray> createPhaseArray(const int& phase) const;
+
+	/*!
+	 * @brief Copies the plane z of every phase, one after the other.
+	 *
+	 * @param z The plane to copy.
+	 * @param output Receives getPhaseCount() * getPlaneBytes() bytes.
+	 */
+	void extractPlaneOverPhases(const int& z, void* output) const;
+
+	/// @brief Gets the value of a voxel component in every phase.
+	QVector<double> getTimeCurve(const int& x, const int& y, const int& z,
+		const int& component = 0) const;
+};
+
+/// @brief Alias for a smart pointer of this class.
+using StudyStoragePtr = QSharedPointer<StudyStorage>;
+}
@@ -0,0 +1,182 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		StudyView.h
+* @class	fi3d::StudyView
+* @brief	A 4D view (x, y, slice, phase) of the voxels of several series.
+*
+* The view keeps references to the scalar arrays of the series it was made
+* from and never copies them. Each slice and each phase is mapped to one of
+* those arrays and to an offset within it, so swapping the slice and phase
+* axes or reordering the slices only changes these small tables. Within a
+* slice, rows and voxels keep the layout of the source arrays, so every XY
+* plane is contiguous and can be read in place.
+*
+* The series of a phase made by createSeries copy no voxels either: a phase
+* that is one whole array shares it, any other phase becomes a SeriesView
+* reading its planes in place. Voxels are only copied when a contiguous
+* series is asked for by createContiguousSeries.
+*/
+
+#include <fi3d/data/SeriesData.h>
+#include <fi3d/data/SeriesView.h>
+
+#include <QSharedPointer>
+#include <QVector>
+
+#include <vtkDataArray.h>
+#include <vtkMatrix4x4.h>
+#include <vtkSmartPointer.h>
+
+namespace fi3d {
+class StudyView {
+private:
+	/// @brief The scalar arrays of the source series.
+	QVector<vtkSmartPointer<vtkDataArray>> mBuffers;
+
+	/// @brief The size of the x, y, slice and phase axes.
+	int mDimensions[4];
+
+	/// @brief The array each slice is in, added to the array of its phase.
+	QVector<int> mSliceBuffers;
+
+	/// @brief The first tuple of each slice, added to the offset of its phase.
+	QVector<qint64> mSliceOffsets;
+
+	/// @brief The array each phase is in, added to the array of its slice.
+	QVector<int> mPhaseBuffers;
+
+	/// @brief The first tuple of each phase, added to the offset of its slice.
+	QVector<qint64> mPhaseOffsets;
+
+	/// @brief The series each array came from, for its patient matrix.
+	QVector<SeriesDataVPtr> mBufferSeries;
+
+	/// @brief The spacing along x, y and between slices.
+	double mSpacing[3];
+
+	/// @brief The origin of the series created from this view.
+	double mOrigin[3];
+
+	/// @brief The VTK scalar type of the voxels.
+	int mScalarType;
+
+	/// @brief The components of each voxel.
+	int mComponents;
+
+public:
+	/// @brief Constructor of an empty view.
+	StudyView();
+
+	/// @brief Destructor.
+	~StudyView();
+
+	/*!
+	 * @brief Creates a view of the series.
+	 *
+	 * The series must have the same dimensions and scalar type. In a time
+	 * domain study each series is one slice position and its third dimension
+	 * is time. Otherwise each series is one phase and its third dimension is
+	 * the slices.
+	 *
+	 * @return The view, null if the series do not match.
+	 */
+	static QSharedPointer<StudyView> fromSeries(const QVector<SeriesDataVPtr>& series,
+		const bool& isTimeDomain);
+
+	/// @brief Gets the size of an axis, 0 for x, 1 for y, 2 for slices, 3 for phases.
+	int getDimension(const int& axis) const;
+
+	/// @brief Gets the number of slices.
+	int getSliceCount() const;
+
+	/// @brief Gets the number of phases.
+	int getPhaseCount() const;
+
+	/// @brief Makes the slices the phases and the phases the slices.
+	void swapSlicesAndPhases();
+
+	/*!
+	 * @brief Reorders the slices.
+	 *
+	 * @param order The current index of each slice in the new order.
+	 * @return Whether the order is a permutation of the slices.
+	 */
+	bool reorderSlices(const QVector<int>& order);
+
+	/*!
+	 * @brief Gets the order of the slices by their position along the normal.
+	 *
+	 * The position is the origin of the patient matrix of the series each
+	 * slice came from, projected on the normal of the first of them. Slices
+	 * that came from the same series keep their order.
+	 */
+	QVector<int> getSpatialSliceOrder() const;
+
+	/*!
+	 * @brief Gets the order of the patient matrices by their position.
+	 *
+	 * The position is the origin of each matrix projected on the normal, the
+	 * third column, of the first matrix. Equal positions keep their order.
+	 *
+	 * @return The current index of each matrix in the new order.
+	 */
+	static QVector<int> getSpatialOrder(const QVector<vtkSmartPointer<vtkMatrix4x4>>& matrices);
+
+	/// @brief Sets the spacing between slices.
+	void setSliceSpacing(const double& spacing);
+
+	/// @brief Gets the spacing between slices.
+	double getSliceSpacing() const;
+
+	/// @brief Gets the patient matrix of the series the slice of the phase came from.
+	vtkSmartPointer<vtkMatrix4x4> getPatientMatrix(const int& slice, const int& phase = 0) const;
+
+	/// @brief Gets the distance between the patient matrix origins of two slices.
+	double getSliceDistance(const int& first, const int& second) const;
+
+	/// @brief Gets the XY plane of the slice in the phase, read in place.
+	const void* getPlanePointer(const int& slice, const int& phase) const;
+
+	/// @brief Gets a voxel component, slow, for spot checks only.
+	double getValue(const int& x, const int& y, const int& slice, const int& phase,
+		const int& component = 0) const;
+
+	/// @brief Whether the phase is one whole source array, in slice order.
+	bool isPhaseContiguous(const int& phase) const;
+
+	/*!
+	 * @brief Creates a series with the slices of the phase, copying nothing.
+	 *
+	 * The series shares the source array when the phase is contiguous.
+	 * Otherwise it is a SeriesView of the XY planes of the phase.
+	 *
+	 * @return The series, null if the phase is out of range.
+	 */
+	SeriesDataVPtr createSeries(const int& phase) const;
+
+	/*!
+	 * @brief Creates a series with the slices of the phase in one array.
+	 *
+	 * The series shares the source array when the phase is contiguous.
+	 * Otherwise each XY plane is copied into a new array.
+	 *
+	 * @return The series, null if the phase is out of range.
+	 */
+	SeriesDataVPtr createContiguousSeries(const int& phase) const;
+
+private:
+	/// @brief Creates a series with the geometry of the phase and no scalars.
+	template <typename T>
+	vtkSmartPointer<T> createEmptySeries(const int& phase) const;
+
+	/// @brief Gets the array holding the slice in the phase.
+	vtkDataArray* getBuffer(const int& slice, const int& phase) const;
+
+	/// @brief Gets the first tuple of the slice in the phase, in its array.
+	qint64 getOffset(const int& slice, const int& phase) const;
+};
+
+/// @brief Alias for a smart pointer of this class.
+using StudyViewPtr = QSharedPointer<StudyView>;
+}
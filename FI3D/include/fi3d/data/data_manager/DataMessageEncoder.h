@@ -4,6 +4,13 @@
 *   @file		DataMessageEncoder.h
 *	@class		fi3d::DataMessageEncoder
 *	@brief		This message encoder responds to data requests.
+*
+*	Requests are answered on the next event loop iteration rather than as
+*	they arrive, so all requests received together are known before any of
+*	them is converted. A request that carries a group (e.g., the visual that
+*	shows the slice) supersedes the pending requests of the same client and
+*	group, and a client can cancel its pending requests by ID. Superseded and
+*	cancelled requests are neither converted nor sent.
 */
 
 #include <fi3d/server/MessageEncoder.h>
@@ -16,8 +23,22 @@
 
 #include <fi3d/rendering/visuals/3D/slices/ESliceOrientation.h>
 
+#include <QList>
+#include <QTimer>
+
 namespace fi3d {
 class DataManager;
+
+/// @brief A data request waiting to be answered.
+typedef struct PendingDataRequest {
+	/// @brief The client that made the request.
+	QString ClientID;
+	/// @brief The ID given by the client, -1 if it has none.
+	int RequestID = -1;
+	/// @brief The request.
+	QJsonObject Request;
+} PendingDataRequest;
+
 class DataMessageEncoder : public fi3d::MessageEncoder {
 
 	Q_OBJECT
@@ -26,6 +47,12 @@ private:
 	/// @brief Pointer to the data manger in charge of this instance.
 	DataManager* mDataManager;
 
+	/// @brief Requests waiting to be answered, in the order received.
+	QList<PendingDataRequest> mPendingRequests;
+
+	/// @brief Answers the pending requests on the next event loop iteration.
+	QTimer mPendingTimer;
+
 public:
 	/// @brief Constructor.
 	DataMessageEncoder(DataManager* dataManager);
@@ -43,16 +70,26 @@ public:
 	virtual void parseModelDataRequest(const QJsonObject& request, const QString& clientID);
 	/// @}
 
+	/// @brief Drops the pending requests of the disconnected client.
+	virtual void onDisconnectedClient(const QString& clientID) override;
+
 	/// @brief Sends an error response.
 	virtual void prepareDataErrorResponse(QJsonObject& jsonObject, const QString& message = "");
 
 	/// @brief Converts the selected slice to its Message format.
 	static MessagePtr toMessage(ImageData* data, const int& sliceIndex, const ESliceOrientation& orientation);
 
-	/// @brief Converts the selected slice to its Message format.
+	/// @brief Converts the selected slice to its Message format, with the
+	/// window/level of the image.
 	static bool toMessage(ImageData* data, const int& sliceIndex, 
 		const fi3d::ESliceOrientation& orientation, MessagePtr dataMessage);
 
+	/// @brief Converts the selected slice to its Message format, with the
+	/// given window/level, e.g., the one a client asked for.
+	static bool toMessage(ImageData* data, const int& sliceIndex,
+		const fi3d::ESliceOrientation& orientation,
+		const double& window, const double& level, MessagePtr dataMessage);
+
 	/// @brief Same as ImageData toMessage but for a Series.
 	static MessagePtr toMessage(Study* data, const int& sliceIndex, 
 		const ESliceOrientation& orientation, const int& seriesIndex);
@@ -62,11 +99,27 @@ public:
 		const ESliceOrientation& orientation, 
 		const int& seriesIndex, MessagePtr dataMessage);
 
+	/// @brief Same as ImageData toMessage but for a Series.
+	static bool toMessage(Study* data, const int& sliceIndex,
+		const ESliceOrientation& orientation, const int& seriesIndex,
+		const double& window, const double& level, MessagePtr dataMessage);
+
 	/// @brief Converts the model to its Message format.
 	static bool toMessage(ModelData* data, MessagePtr dataMessage);
 
 	/// @brief Converts the model to its Message format.
 	static MessagePtr toMessage(ModelData* data);
+
+private slots:
+	/// @brief Answers the requests that are still pending.
+	void answerPendingRequests();
+
+private:
+	/// @brief Answers a single request.
+	void answerRequest(const QJsonObject& request, const QString& clientID);
+
+	/// @brief Removes the pending requests of the client that match.
+	int removePendingRequests(const QString& clientID, const QList<int>& requestIDs);
 };
 
 /// @brief Alias for a smart pointer of this class.
@@ -0,0 +1,161 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		DataCatalog.h
+* @class	fi3d::DataCatalog
+* @brief	The persistent data of the DataManager, kept in a binary log.
+*
+* Every change is appended to the catalog file as a record, a put replaces
+* the entry of its DataID and a remove deletes it. A record is written at
+* once and flushed, so a crash loses at most the record being written. Such
+* a torn record is detected by its size and checksum when the catalog is
+* opened and cut off.
+*
+* Opening the catalog only reads the meta-data of each entry. The DICOM
+* files of a study are stored after its meta-data, each path sharing its
+* prefix with the path before it, and are only read by readDICOMPaths, so
+* studies with many files do not slow down opening.
+*
+* Records of replaced and removed entries stay in the file until compact
+* rewrites it.
+*/
+
+#include <fi3d/data/EData.h>
+
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QList>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QUuid>
+#include <QVector>
+
+namespace fi3d {
+
+/// @brief The meta-data of a persistent data object.
+typedef struct CatalogEntry {
+	/// @brief The type of data, EData::IMAGE, EData::STUDY or EData::MODEL.
+	int Type = EData::UNKNOWN;
+	/// @brief The DataID.
+	QUuid ID;
+	/// @brief The data name, the StudyID for studies.
+	QString Name;
+	/// @brief The file of the data, empty for DICOM studies.
+	QString Path;
+	/// @brief The PatientID of a study.
+	QString PatientID;
+	/// @brief The PatientName of a study.
+	QString PatientName;
+	/// @brief The StudyDate of a study.
+	QString StudyDate;
+	/// @brief The StudyTime of a study.
+	QString StudyTime;
+	/// @brief The number of series of a study.
+	int SeriesCount = 0;
+	/// @brief Whether the study is read from DICOM files.
+	bool IsDICOM = false;
+	/// @brief Where the DICOM files of the study are in the catalog file, -1 if none.
+	qint64 PathsOffset = -1;
+	/// @brief The size of the DICOM files of the study in the catalog file.
+	quint32 PathsSize = 0;
+	/// @brief The checksum of the DICOM files of the study.
+	quint16 PathsChecksum = 0;
+} CatalogEntry;
+
+class DataCatalog {
+public:
+	/// @brief The first bytes of a catalog file.
+	static const quint32 MAGIC = 0x46334354;
+
+	/// @brief The format of the catalog file.
+	static const quint32 VERSION = 1;
+
+	/// @brief The bytes of the magic and version at the start of the file.
+	static const int FILE_HEADER_SIZE = 8;
+
+	/// @brief The bytes before each record: its sizes and checksums.
+	static const int RECORD_HEADER_SIZE = 12;
+
+private:
+	/// @brief The catalog file.
+	QString mFilePath;
+
+	/// @brief The catalog file, open while the catalog is.
+	QFile mFile;
+
+	/// @brief The entries, by DataID.
+	QHash<QUuid, CatalogEntry> mEntries;
+
+	/// @brief The number of records in the file.
+	int mRecordCount;
+
+public:
+	/// @brief Constructor of a closed catalog.
+	DataCatalog(const QString& filePath);
+
+	/// @brief Destructor.
+	~DataCatalog();
+
+	/// @brief Gets the catalog file used by the DataManager.
+	static QString getDefaultPath();
+
+	/*!
+	 * @brief Opens the catalog file, creating it if it does not exist.
+	 *
+	 * A torn record at the end of the file is cut off. A file of an unknown
+	 * format is moved aside, to the same path ending in ".old".
+	 *
+	 * @return False if the file could not be opened.
+	 */
+	bool open();
+
+	/// @brief Whether the catalog is open.
+	bool isOpen() const;
+
+	/// @brief Gets the entries.
+	QList<CatalogEntry> getEntries() const;
+
+	/// @brief Whether there is an entry with the DataID.
+	bool contains(const QUuid& dataID) const;
+
+	/// @brief Gets the number of entries.
+	int count() const;
+
+	/*!
+	 * @brief Adds or replaces the entry of its DataID.
+	 *
+	 * @param entry The entry, its Paths members are ignored.
+	 * @param dicomPaths The DICOM files of each series of a DICOM study.
+	 * @return False if the record could not be written.
+	 */
+	bool put(const CatalogEntry& entry, const QVector<QStringList>& dicomPaths = QVector<QStringList>());
+
+	/// @brief Removes the entry of the DataID. False if the record could not be written.
+	bool remove(const QUuid& dataID);
+
+	/// @brief Reads the DICOM files of each series of a study, empty if none.
+	QVector<QStringList> readDICOMPaths(const QUuid& dataID);
+
+	/// @brief Whether most of the records in the file are replaced or removed.
+	bool isWorthCompacting() const;
+
+	/*!
+	 * @brief Rewrites the file with only the record of each entry.
+	 *
+	 * The file is replaced at once when fully written, so a crash while
+	 * compacting leaves the previous file.
+	 */
+	bool compact();
+
+private:
+	/// @brief Appends a record and flushes it.
+	bool append(const QByteArray& meta, const QByteArray& paths, qint64& pathsOffset);
+
+	/// @brief Moves an unreadable catalog file aside and starts a new one.
+	bool reset();
+};
+
+/// @brief Alias for a smart pointer of this class.
+using DataCatalogPtr = QSharedPointer<DataCatalog>;
+}
@@ -0,0 +1,155 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		DicomCrawler.h
+* @class	fi3d::DicomCrawler
+* @brief	Finds the DICOM studies under a directory.
+*
+* The directories are walked one level at a time, listing the directories
+* of a level in parallel, down to MAX_DEPTH levels. Symbolic links are not
+* followed. Only the header of each file is parsed, up to its pixel data,
+* also in parallel. Files recorded in the DicomScanCache with the same size
+* and modification time are not opened at all, so crawling a directory
+* again only costs listing it.
+*
+* Files are grouped into studies by StudyInstanceUID and into series by
+* SeriesInstanceUID. Only files with pixel data are kept. A study without a
+* StudyID is named after the directory of its first file, with "_#"
+* appended if that directory has more than one such study.
+*
+* foundStudy is emitted as soon as the first file of a study is parsed,
+* with the meta-data of the study but without its files, so lists can show
+* studies while a large directory is still being crawled. Files of a study
+* may be found until the crawl is done, see getStudies.
+*/
+
+#include <fi3d/data/Study.h>
+
+#include <QAtomicInt>
+#include <QList>
+#include <QObject>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QVector>
+
+#include <vtkSmartPointer.h>
+#include <vtkStringArray.h>
+
+class QThread;
+
+namespace fi3d {
+
+/// @brief A study found by a DicomCrawler.
+typedef struct DicomStudyRecord {
+	/// @brief The StudyInstanceUID.
+	QString StudyUID;
+	/// @brief The StudyID, or the name given after its directory.
+	QString StudyID;
+	/// @brief The PatientID.
+	QString PatientID;
+	/// @brief The PatientName.
+	QString PatientName;
+	/// @brief The StudyDate.
+	QString StudyDate;
+	/// @brief The StudyTime.
+	QString StudyTime;
+	/// @brief The files of each series, in InstanceNumber order.
+	QVector<QStringList> Series;
+} DicomStudyRecord;
+
+class DicomCrawler : public QObject {
+
+	Q_OBJECT
+
+public:
+	/// @brief The deepest directory level crawled, guards against loops.
+	static const int MAX_DEPTH = 50;
+
+	/// @brief The files whose headers are parsed between progress updates.
+	static const int PARSE_BATCH = 256;
+
+signals:
+	/// @brief Emitted when a study is first found, without its files.
+	void foundStudy(const fi3d::DicomStudyRecord& study);
+
+	/// @brief Emitted after each batch of files is looked at.
+	void progressed(const int& checkedFiles, const int& listedFiles);
+
+	/// @brief Emitted when a crawl started with start is done.
+	void finished();
+
+	/// @brief Emitted instead of finished when the crawl was cancelled.
+	void cancelled();
+
+private:
+	/// @brief The directory to crawl.
+	QString mDirectory;
+
+	/// @brief The scan cache file, empty to crawl without a cache.
+	QString mCachePath;
+
+	/// @brief The studies found by the last crawl.
+	QList<DicomStudyRecord> mStudies;
+
+	/// @brief Set to 1 to stop crawling.
+	QAtomicInt mIsCancelled;
+
+	/// @brief The thread running the crawl, Q_NULLPTR until started.
+	QThread* mThread;
+
+public:
+	/*!
+	 * @brief Constructor.
+	 *
+	 * @param directory The directory to crawl.
+	 * @param cachePath The scan cache file, empty to not use one.
+	 */
+	DicomCrawler(const QString& directory, const QString& cachePath, QObject* parent = Q_NULLPTR);
+
+	/// @brief Destructor. Cancels the crawl and waits for its thread.
+	~DicomCrawler();
+
+	/// @brief Gets the crawled directory.
+	QString getDirectory() const;
+
+	/*!
+	 * @brief Crawls the directory, blocking until done.
+	 *
+	 * The scan cache is loaded before and saved after, even when cancelled,
+	 * so the headers parsed so far are kept.
+	 *
+	 * @return The studies found, empty if cancelled.
+	 */
+	QList<DicomStudyRecord> crawl();
+
+	/// @brief Crawls the directory in a thread owned by the crawler.
+	void start();
+
+	/// @brief Stops the crawl as soon as possible.
+	void cancel();
+
+	/// @brief Whether the crawl started with start is still running.
+	bool isRunning() const;
+
+	/// @brief Blocks until the crawl started with start is done.
+	void wait();
+
+	/// @brief Gets the studies found, complete once the crawl is done.
+	QList<DicomStudyRecord> getStudies() const;
+
+	/// @brief Creates a Study with the meta-data of the record, no data.
+	static StudyPtr createStudy(const DicomStudyRecord& record);
+
+	/// @brief Converts the files of the series of the record for vtkDICOMReader.
+	static QVector<vtkSmartPointer<vtkStringArray>> getSeriesPaths(const DicomStudyRecord& record);
+
+private:
+	/// @brief Whether cancel was called.
+	bool isCancelled() const;
+};
+
+/// @brief Alias for a smart pointer of this class.
+using DicomCrawlerPtr = QSharedPointer<DicomCrawler>;
+}
+
+Q_DECLARE_METATYPE(fi3d::DicomStudyRecord)
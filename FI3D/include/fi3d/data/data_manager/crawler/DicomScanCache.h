@@ -0,0 +1,107 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		DicomScanCache.h
+* @class	fi3d::DicomScanCache
+* @brief	The DICOM headers found by previous crawls, keyed by file path.
+*
+* A record stays valid while the size and modification time of its file do
+* not change, so crawling a directory again only parses new or changed
+* files. Files that are not DICOM are recorded too, so they are not opened
+* again either. The cache is saved in a binary file, see save.
+*/
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+
+namespace fi3d {
+
+/// @brief The header values of one file used to group it into studies.
+typedef struct DicomFileRecord {
+	/// @brief The size of the file when it was parsed, in bytes.
+	qint64 Size = -1;
+	/// @brief The modification time of the file when it was parsed, in ms since epoch.
+	qint64 Modified = 0;
+	/// @brief Whether the file is DICOM.
+	bool IsDICOM = false;
+	/// @brief Whether the file has pixel data.
+	bool HasPixelData = false;
+	/// @brief The StudyInstanceUID.
+	QString StudyUID;
+	/// @brief The SeriesInstanceUID.
+	QString SeriesUID;
+	/// @brief The StudyID, may be empty.
+	QString StudyID;
+	/// @brief The PatientID.
+	QString PatientID;
+	/// @brief The PatientName.
+	QString PatientName;
+	/// @brief The StudyDate.
+	QString StudyDate;
+	/// @brief The StudyTime.
+	QString StudyTime;
+	/// @brief The InstanceNumber, the order of the file in its series.
+	int InstanceNumber = 0;
+} DicomFileRecord;
+
+class DicomScanCache {
+public:
+	/// @brief The first bytes of a cache file.
+	static const quint32 MAGIC = 0x46334443;
+
+	/// @brief The format of the cache file, files of other versions are ignored.
+	static const quint32 VERSION = 1;
+
+private:
+	/// @brief The records, by absolute file path.
+	QHash<QString, DicomFileRecord> mRecords;
+
+	/// @brief Whether the records changed since loaded or saved.
+	bool mIsChanged;
+
+public:
+	/// @brief Constructor of an empty cache.
+	DicomScanCache();
+
+	/// @brief Destructor.
+	~DicomScanCache();
+
+	/// @brief Gets the cache file used by the DataManager.
+	static QString getDefaultPath();
+
+	/// @brief Replaces the records with the ones in the file. False if it could not be read.
+	bool load(const QString& filePath);
+
+	/// @brief Saves the records if they changed. The file is replaced at once
+	/// when fully written, so a crash never leaves half a cache.
+	bool save(const QString& filePath);
+
+	/*!
+	 * @brief Gets the record of a file.
+	 *
+	 * @param path The absolute path of the file.
+	 * @param size The current size of the file.
+	 * @param modified The current modification time of the file.
+	 * @param record Receives the record.
+	 * @return False if there is no record or the file changed since.
+	 */
+	bool find(const QString& path, const qint64& size, const qint64& modified,
+		DicomFileRecord& record) const;
+
+	/// @brief Adds or replaces the record of a file.
+	void insert(const QString& path, const DicomFileRecord& record);
+
+	/*!
+	 * @brief Removes the records of files in the directory that were not seen.
+	 *
+	 * @param directory The absolute path of the crawled directory.
+	 * @param seenPaths The files found in it.
+	 * @return The number of records removed.
+	 */
+	int prune(const QString& directory, const QSet<QString>& seenPaths);
+
+	/// @brief Gets the number of records.
+	int count() const;
+};
+}
@@ -4,6 +4,9 @@
 * @file		DataManagerDialog.h
 * @class	fi3d::DataManager
 * @brief	GUI to display all data objects available in the DataManager.
+*
+* The Study ID of each study shows its thumbnail. Thumbnails are requested
+* only for the rows in view, as the list is shown and scrolled.
 */
 
 #include <fi3d/data/Study.h>
@@ -14,7 +17,11 @@
 #include <fi3d/data/data_manager/registered_data/RegisteredModel.h>
 
 #include <QDialog>
+#include <QHash>
 #include <QHeaderView>
+#include <QImage>
+
+class QTableWidgetItem;
 
 namespace Ui {
 class DataManagerDialog;
@@ -44,6 +51,9 @@ signals:
 	/// @brief Emitted when the user wants to load a model.
 	void requestedLoadModel();
 
+	/// @brief Emitted with the studies in view that do not show a thumbnail.
+	void requestedThumbnails(const QList<fi3d::DataID>& studies);
+
 private:
 	/// @brief The GUI elements.
 	QSharedPointer<Ui::DataManagerDialog> mGUI;
@@ -54,6 +64,9 @@ private:
 	/// @brief The header labels of the model table.
 	QHeaderView* mModelTableHeader;
 
+	/// @brief The cell showing the thumbnail of each study.
+	QHash<QUuid, QTableWidgetItem*> mThumbnailItems;
+
 public:
 	///  @brief Constructor.
 	DataManagerDialog();
@@ -69,5 +82,13 @@ public:
 
 	/// @brief Set the models to be listed.
 	void setModels(const QList<RegisteredModelPtr> models);
+
+public slots:
+	/// @brief Shows the thumbnail of a study, if listed.
+	void setThumbnail(const QUuid& dataID, const QImage& thumbnail);
+
+private slots:
+	/// @brief Requests the thumbnails of the study rows in view.
+	void requestVisibleThumbnails();
 };
 }
\ No newline at end of file
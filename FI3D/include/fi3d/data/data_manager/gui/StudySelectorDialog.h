@@ -4,14 +4,21 @@
 * @file		StudySelectorDialog.h
 * @class	fi3d::StudySelectorDialog
 * @brief	Interface used to present list of studies for selection.
+*
+* The Study ID of each study shows its thumbnail. Thumbnails are requested
+* only for the rows in view, as the list is shown and scrolled.
 */
 
 #include <QDialog>
+#include <QHash>
+#include <QImage>
 #include <QList>
 
 #include <fi3d/data/DataID.h>
 #include <fi3d/data/data_manager/registered_data/RegisteredStudy.h>
 
+class QTableWidgetItem;
+
 namespace Ui {
 class StudySelectorDialog;
 }
@@ -21,6 +28,10 @@ class StudySelectorDialog : public QDialog {
 
 	Q_OBJECT
 
+signals:
+	/// @brief Emitted with the studies in view that do not show a thumbnail.
+	void requestedThumbnails(const QList<fi3d::DataID>& studies);
+
 private:
 	/// @brief The GUI elements.
 	QSharedPointer<Ui::StudySelectorDialog> mGUI;
@@ -31,6 +42,9 @@ private:
 	/// @brief The selected study, empty string if none selected.
 	DataID mSelectedStudyID;
 
+	/// @brief The cell showing the thumbnail of each study.
+	QHash<QUuid, QTableWidgetItem*> mThumbnailItems;
+
 public:
 	/// @brief Constructor.
 	StudySelectorDialog(QWidget *parent = nullptr);
@@ -44,7 +58,22 @@ public:
 	/// @brief Gets the selected study, empty string if no study selected.
 	DataID getSelectedStudy();
 
+public slots:
+	/// @brief Adds a study to the ones available, e.g., one just found by a
+	/// DICOM crawl while the dialog is open.
+	void addStudy(fi3d::RegisteredStudyPtr study);
+
+	/// @brief Shows the thumbnail of a study, if listed.
+	void setThumbnail(const QUuid& dataID, const QImage& thumbnail);
+
+private:
+	/// @brief Fills the cells of a row with the study.
+	void setStudyRow(const int& row, StudyPtr study);
+
 private slots:
+	/// @brief Requests the thumbnails of the rows in view.
+	void requestVisibleThumbnails();
+
 	/// @brief Handles double clicking a cell in the table.
 	void onCellDoubleClick(const int& row, const int& column);
 
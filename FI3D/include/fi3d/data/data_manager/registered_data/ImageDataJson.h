@@ -24,8 +24,14 @@ private:
 	/// @brief The ImageData slices in their JSON format.
 	QVector<MessagePtr> mTransverseJson, mSagittalJson, mCoronalJson;
 
+	/// @brief The data version the slice messages were encoded from.
+	qint64 mMessagesVersion;
+
+	/// @brief The window/level the slice messages were encoded with.
+	double mMessagesWindow, mMessagesLevel;
+
 public:
-	ImageDataJson(){};
+	ImageDataJson() : mMessagesVersion(0), mMessagesWindow(0), mMessagesLevel(0) {};
 
 	/// @brief Constructor.
 	ImageDataJson(ImageDataVPtr imageData);
@@ -36,10 +42,20 @@ public:
 	/// @brief Gets the registered ImageData object.
 	ImageDataVPtr getImageData();
 
-	/// @brief Gets the JSON data of a slice.
+	/// @brief Gets the JSON data of a slice. If the data version has changed,
+	/// the messages of the slices that were written are emptied first. If
+	/// the window/level has changed, every message is emptied first.
 	MessagePtr getMessage(const int& sliceIndex, const ESliceOrientation& orientation);
 
 	/// @brief Sets the JSON data of a slice.
 	void setMessage(const int& sliceIndex, const ESliceOrientation& orientation, MessagePtr data);
+
+private:
+	/// @brief Creates an empty message for every slice.
+	void resetMessages();
+
+	/// @brief Creates an empty message for the slices that changed since the
+	/// messages were encoded, or for every slice if that is not known.
+	void refreshMessages();
 };
 }
\ No newline at end of file
@@ -24,6 +24,9 @@ private:
 	/// @brief The ModelData encoded as a Message ready for delivery.
 	MessagePtr mMessage;
 
+	/// @brief The data version mMessage was encoded from.
+	qint64 mMessageVersion;
+
 public:
 	/// @brief Constructor.
 	RegisteredModel(ModelDataVPtr modelData, const QString& path = "");
@@ -44,6 +47,7 @@ public:
 	void setDataPath(const QString& path);
 
 	/// @brief Gets the ModelData in its encoded format as a DataMessage.
+	/// The message is emptied first if the data version has changed.
 	MessagePtr getMessage();
 
 	/// @brief Sets the ModelData encoded version as a Message.
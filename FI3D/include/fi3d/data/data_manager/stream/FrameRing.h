@@ -0,0 +1,87 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		FrameRing.h
+* @class	fi3d::FrameRing
+* @brief	A Study whose series are reused, in order, for streamed frames.
+*
+* The series are allocated once for a given geometry and each new frame is
+* written in place into the next one, so streaming does not allocate. The
+* last frames stay available for as long as they are not overwritten, which
+* lets clients keep reading a frame while the next one arrives.
+*/
+
+#include <fi3d/data/data_manager/stream/StreamFrame.h>
+
+#include <fi3d/data/Study.h>
+
+#include <QVector>
+
+namespace fi3d {
+class FrameRing {
+public:
+	/// @brief The most bytes the series of the ring may have together.
+	static const qint64 MAX_RING_BYTES = 2048LL * 1024 * 1024;
+
+private:
+	/// @brief The Study holding one series per frame of the ring.
+	StudyPtr mStudy;
+
+	/// @brief The dimensions of every series.
+	int mDimensions[3];
+
+	/// @brief The spacing of every series.
+	double mSpacing[3];
+
+	/// @brief The stream scalar type of every series.
+	quint16 mScalarType;
+
+	/// @brief The frame number held by each series, -1 when none.
+	QVector<qint64> mFrameNumbers;
+
+public:
+	/// @brief Constructor. Creates the series with an empty 1x1x1 geometry.
+	FrameRing(const QString& studyID, const int& frameCount);
+
+	/// @brief Destructor.
+	~FrameRing();
+
+	/// @brief Gets the Study with the frames.
+	StudyPtr getStudy();
+
+	/// @brief Gets the number of series in the ring.
+	int getFrameCount() const;
+
+	/// @brief Gets the series the frame is written to.
+	int getSeriesIndex(const qint64& frameNumber) const;
+
+	/// @brief Gets the frame number a series holds, -1 when none.
+	qint64 getFrameNumber(const int& seriesIndex) const;
+
+	/// @brief Whether the series already have the geometry of the header.
+	bool hasGeometry(const StreamFrameHeader& header) const;
+
+	/// @brief Whether the geometry is valid and the ring fits in MAX_RING_BYTES.
+	bool isGeometryAllowed(const StreamFrameHeader& header) const;
+
+	/*!
+	 * @brief Reallocates every series with the geometry of the header.
+	 *
+	 * The frames in the ring are discarded. Existing series are reused,
+	 * so visuals of the Study keep working.
+	 *
+	 * @return false, with nothing changed, if the geometry is not allowed.
+	 */
+	bool setGeometry(const StreamFrameHeader& header);
+
+	/*!
+	 * @brief Gets where the payload of a frame is written.
+	 *
+	 * The series of the frame is claimed for that frame number.
+	 *
+	 * @param length The bytes the payload must have.
+	 * @return Q_NULLPTR if the slice is out of range.
+	 */
+	char* getWritePointer(const StreamFrameHeader& header, qint64& length);
+};
+}
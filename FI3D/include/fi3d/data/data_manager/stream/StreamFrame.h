@@ -0,0 +1,150 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		StreamFrame.h
+* @brief	The header of a frame sent to the StreamIngest.
+*
+* A producer, e.g., a process next to the scanner, connects to the local
+* socket of the StreamIngest and writes one header followed by its payload
+* per frame, with no other framing:
+*
+*	Header: the STREAM_FRAME_HEADER_SIZE bytes of the StreamFrameHeader
+*	below, packed and little endian. Use writeStreamFrameHeader and
+*	readStreamFrameHeader, which convert every field.
+*
+*	Payload: PayloadLength bytes of voxels of the given scalar type, x
+*	changing fastest, then y, then z. A whole volume when SliceIndex is -1,
+*	otherwise the XY slice at SliceIndex.
+*
+* Writes with the same FrameNumber go to the same series, so a frame can be
+* sent as a volume or slice by slice. Each new FrameNumber goes to the next
+* series of the ring. The geometry may change between frames, which
+* reallocates the ring. Frames larger than the STREAM_MAX constants are
+* rejected before anything is allocated.
+*/
+
+#include <QtEndian>
+#include <QtGlobal>
+#include <QtNumeric>
+
+namespace fi3d {
+
+/// @brief Identifies a frame header.
+const quint32 STREAM_FRAME_MAGIC = 0x53334946;
+
+/// @brief The version of the frame header format.
+const quint16 STREAM_FRAME_VERSION = 1;
+
+/// @brief The bytes of a frame header.
+const int STREAM_FRAME_HEADER_SIZE = 68;
+
+/// @brief The largest dimension of a frame along any axis.
+const qint32 STREAM_MAX_DIMENSION = 4096;
+
+/// @brief The most voxels a frame may have.
+const qint64 STREAM_MAX_FRAME_VOXELS = 256LL * 1024 * 1024;
+
+/// @brief The most bytes a frame may have.
+const qint64 STREAM_MAX_FRAME_BYTES = 512LL * 1024 * 1024;
+
+/*!
+ * @name Stream Scalar Types
+ * @brief The scalar types accepted in a frame, same values as VTK's.
+ */
+/// @{
+const quint16 STREAM_SCALAR_UNSIGNED_CHAR = 3;
+const quint16 STREAM_SCALAR_SHORT = 4;
+const quint16 STREAM_SCALAR_UNSIGNED_SHORT = 5;
+const quint16 STREAM_SCALAR_FLOAT = 10;
+/// @}
+
+#pragma pack(push, 1)
+/// @brief The header written before the payload of every frame.
+typedef struct StreamFrameHeader {
+	/// @brief Must be STREAM_FRAME_MAGIC.
+	quint32 Magic;
+	/// @brief Must be STREAM_FRAME_VERSION.
+	quint16 Version;
+	/// @brief One of the stream scalar types.
+	quint16 ScalarType;
+	/// @brief The dimensions of the whole frame.
+	qint32 Dimensions[3];
+	/// @brief The spacing between voxels, in mm.
+	double Spacing[3];
+	/// @brief The XY slice in the payload, -1 for the whole frame.
+	qint32 SliceIndex;
+	/// @brief Unused, must be 0.
+	qint32 Reserved;
+	/// @brief Increases with every frame, the slices of a frame share it.
+	qint64 FrameNumber;
+	/// @brief The bytes that follow the header.
+	qint64 PayloadLength;
+} StreamFrameHeader;
+#pragma pack(pop)
+
+/// @brief Gets the bytes per voxel of a stream scalar type, 0 if unknown.
+inline int getStreamScalarSize(const quint16& scalarType) {
+	switch (scalarType) {
+		case STREAM_SCALAR_UNSIGNED_CHAR:
+			return 1;
+		case STREAM_SCALAR_SHORT:
+		case STREAM_SCALAR_UNSIGNED_SHORT:
+			return 2;
+		case STREAM_SCALAR_FLOAT:
+			return 4;
+		default:
+			return 0;
+	}
+}
+
+/// @brief Gets the bytes of a whole frame, -1 if the geometry is not valid or too large.
+inline qint64 getStreamFrameBytes(const StreamFrameHeader& header) {
+	for (int axis = 0; axis < 3; axis++) {
+		if (header.Dimensions[axis] <= 0 || header.Dimensions[axis] > STREAM_MAX_DIMENSION ||
+			!(header.Spacing[axis] > 0) || !qIsFinite(header.Spacing[axis]))
+		{
+			return -1;
+		}
+	}
+
+	qint64 voxels = (qint64)header.Dimensions[0] * header.Dimensions[1] * header.Dimensions[2];
+	qint64 bytes = voxels * getStreamScalarSize(header.ScalarType);
+	if (voxels > STREAM_MAX_FRAME_VOXELS || bytes <= 0 || bytes > STREAM_MAX_FRAME_BYTES) {
+		return -1;
+	}
+	return bytes;
+}
+
+/// @brief Decodes the STREAM_FRAME_HEADER_SIZE bytes of a header.
+inline StreamFrameHeader readStreamFrameHeader(const char* bytes) {
+	StreamFrameHeader header;
+	header.Magic = qFromLittleEndian<quint32>(bytes);
+	header.Version = qFromLittleEndian<quint16>(bytes + 4);
+	header.ScalarType = qFromLittleEndian<quint16>(bytes + 6);
+	for (int axis = 0; axis < 3; axis++) {
+		header.Dimensions[axis] = qFromLittleEndian<qint32>(bytes + 8 + 4 * axis);
+		header.Spacing[axis] = qFromLittleEndian<double>(bytes + 20 + 8 * axis);
+	}
+	header.SliceIndex = qFromLittleEndian<qint32>(bytes + 44);
+	header.Reserved = qFromLittleEndian<qint32>(bytes + 48);
+	header.FrameNumber = qFromLittleEndian<qint64>(bytes + 52);
+	header.PayloadLength = qFromLittleEndian<qint64>(bytes + 60);
+	return header;
+}
+
+/// @brief Encodes a header into STREAM_FRAME_HEADER_SIZE bytes.
+inline void writeStreamFrameHeader(const StreamFrameHeader& header, char* bytes) {
+	qToLittleEndian<quint32>(header.Magic, bytes);
+	qToLittleEndian<quint16>(header.Version, bytes + 4);
+	qToLittleEndian<quint16>(header.ScalarType, bytes + 6);
+	for (int axis = 0; axis < 3; axis++) {
+		qToLittleEndian<qint32>(header.Dimensions[axis], bytes + 8 + 4 * axis);
+		qToLittleEndian<double>(header.Spacing[axis], bytes + 20 + 8 * axis);
+	}
+	qToLittleEndian<qint32>(header.SliceIndex, bytes + 44);
+	qToLittleEndian<qint32>(header.Reserved, bytes + 48);
+	qToLittleEndian<qint64>(header.FrameNumber, bytes + 52);
+	qToLittleEndian<qint64>(header.PayloadLength, bytes + 60);
+}
+
+}
@@ -0,0 +1,190 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		StreamIngest.h
+* @class	fi3d::StreamIngest
+* @brief	Receives live image frames from a local producer into a Study.
+*
+* The ingest listens on a local socket (a Unix socket or a named pipe) for
+* producers, e.g., a process next to the scanner. See StreamFrame.h for the
+* format. The payload of every frame is read from the socket straight into
+* the series of a FrameRing, with no intermediate buffers.
+*
+* Once a frame, or a slice of it, is written, the written extent of its
+* series is updated. That increases the data version, so the subscribers
+* showing the series are sent a DATA_CHANGE with only the written slices.
+* Modules that show the latest frame should follow the changedFrame signal,
+* e.g., by setting the series index of their StudySlice.
+*
+* The time from the arrival of a frame header until the frame is written,
+* and until one of its slices is first sent to a client, is measured with a
+* monotonic clock. See StreamStatistics.
+*/
+
+#include <fi3d/data/data_manager/stream/FrameRing.h>
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QLocalServer>
+#include <QObject>
+#include <QSharedPointer>
+#include <QVector>
+
+class QLocalSocket;
+
+namespace fi3d {
+
+/// @brief Latency statistics of a StreamIngest.
+typedef struct StreamStatistics {
+	/// @brief Number of frames or slices written.
+	quint64 WriteCount = 0;
+	/// @brief Number of payload bytes written.
+	quint64 ByteCount = 0;
+	/// @brief Number of writes discarded, e.g., a producer disconnected
+	/// mid-frame or the frame was overwritten before being sent.
+	quint64 DroppedCount = 0;
+	/// @brief Number of writes sent to at least one client.
+	quint64 SentCount = 0;
+	/// @brief Average time from the frame header until written, in ms.
+	double AverageReceiveTime = 0;
+	/// @brief Longest time from the frame header until written, in ms.
+	double MaxReceiveTime = 0;
+	/// @brief Average time from the frame header until first sent, in ms.
+	double AverageLatency = 0;
+	/// @brief Median time from the frame header until first sent, in ms.
+	double P50Latency = 0;
+	/// @brief 99th percentile of the time until first sent, in ms.
+	double P99Latency = 0;
+	/// @brief Longest time from the frame header until first sent, in ms.
+	double MaxLatency = 0;
+} StreamStatistics;
+
+/// @brief Struct used internally to keep up with a producer connection.
+typedef struct StreamProducer {
+	/// @brief The header of the frame being read.
+	StreamFrameHeader Header;
+	/// @brief Whether the header was read and the payload is being read.
+	bool IsReadingPayload = false;
+	/// @brief Where the rest of the payload goes.
+	char* Destination = Q_NULLPTR;
+	/// @brief The payload bytes that are left to read.
+	qint64 Remaining = 0;
+	/// @brief When the header was read, in ns.
+	qint64 ArrivalTime = 0;
+} StreamProducer;
+
+/// @brief Struct used internally to keep up with writes not sent yet.
+typedef struct StreamWrite {
+	/// @brief The written series.
+	SeriesData* Series = Q_NULLPTR;
+	/// @brief The written XY slices.
+	int FirstSlice = 0;
+	int LastSlice = 0;
+	/// @brief When the header of the write was read, in ns.
+	qint64 ArrivalTime = 0;
+} StreamWrite;
+
+class StreamIngest : public QObject {
+
+	Q_OBJECT
+
+signals:
+	/// @brief Emitted when a frame, or a slice of it, has been written.
+	void changedFrame(const int& seriesIndex, const qint64& frameNumber);
+
+public:
+	/// @brief The number of writes waiting to be sent that are kept.
+	static const int MAX_PENDING_WRITES = 256;
+
+	/// @brief The number of latencies kept for the percentiles.
+	static const int MAX_LATENCY_SAMPLES = 1024;
+
+private:
+	/// @brief Accepts the producer connections.
+	QLocalServer mServer;
+
+	/// @brief The series the frames are written to.
+	FrameRing mRing;
+
+	/// @brief The state of each connected producer.
+	QHash<QLocalSocket*, QSharedPointer<StreamProducer>> mProducers;
+
+	/// @brief Monotonic clock used for the latencies.
+	QElapsedTimer mClock;
+
+	/// @brief Writes that have not been sent to any client, oldest first.
+	QList<StreamWrite> mPendingWrites;
+
+	/// @brief The latency statistics.
+	StreamStatistics mStatistics;
+
+	/// @brief The last latencies in ms, used for the percentiles.
+	QVector<double> mLatencySamples;
+
+	/// @brief Where the next latency sample is stored.
+	int mNextLatencySample;
+
+	/// @brief Total time from frame header until written, in ms.
+	double mTotalReceiveTime;
+
+	/// @brief Total time from frame header until first sent, in ms.
+	double mTotalLatency;
+
+public:
+	/*!
+	 * @brief Constructor.
+	 *
+	 * @param streamName Name of the local socket, also the Study ID.
+	 * @param frameCount Number of series in the ring.
+	 */
+	StreamIngest(const QString& streamName, const int& frameCount);
+
+	/// @brief Destructor. Closes every producer connection.
+	~StreamIngest();
+
+	/// @brief Starts listening for producers.
+	bool listen();
+
+	/// @brief Gets the full name of the local socket, e.g., its path.
+	QString getServerName() const;
+
+	/// @brief Gets the Study with the frames.
+	StudyPtr getStudy();
+
+	/// @brief Gets the latency statistics since the last reset.
+	StreamStatistics getStatistics() const;
+
+	/// @brief Resets the latency statistics.
+	void resetStatistics();
+
+	/*!
+	 * @brief Tells that a slice of a series was sent to a client.
+	 *
+	 * The writes in that slice are no longer pending and their latency is
+	 * recorded. Called by the DataMessageEncoder.
+	 */
+	void onDataSent(SeriesData* series, const int& sliceIndex, const ESliceOrientation& orientation);
+
+private slots:
+	/// @brief Accepts a new producer connection.
+	void onNewConnection();
+
+	/// @brief Reads the frames available from a producer.
+	void onReadyRead();
+
+	/// @brief Forgets a producer, the frame being read is dropped.
+	void onDisconnected();
+
+private:
+	/// @brief Reads and checks a frame header, the producer is closed if bad.
+	bool readHeader(QLocalSocket* socket, StreamProducer* producer);
+
+	/// @brief Updates the series and statistics once a payload is read.
+	void completeWrite(StreamProducer* producer);
+};
+
+/// @brief Alias for a smart pointer of this class.
+using StreamIngestPtr = QSharedPointer<StreamIngest>;
+
+}
@@ -0,0 +1,139 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		ThumbnailService.h
+* @class	fi3d::ThumbnailService
+* @brief	Renders the thumbnails of studies in the background.
+*
+* A thumbnail is the middle slice of a representative series mapped through
+* its window/level and scaled to fit SIZE x SIZE pixels. Only what is needed
+* for that slice is read: a single DICOM file, or the FI3D file of a study,
+* so the study itself is never loaded.
+*
+* Thumbnails are rendered one at a time by a thread owned by the service,
+* most recently requested first, so the rows a list just scrolled to come
+* first. Rendered thumbnails are saved as PNG files named after a hash of
+* what they were rendered from, the path, size and modification time of a
+* file or the values of a slice, so a changed file gets a new thumbnail and
+* identical slices share one. Saved thumbnails are only read again when
+* requested.
+*/
+
+#include <QAtomicInt>
+#include <QHash>
+#include <QImage>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QPair>
+#include <QSet>
+#include <QSharedPointer>
+#include <QString>
+#include <QUuid>
+#include <QVector>
+#include <QWaitCondition>
+
+class QThread;
+
+namespace fi3d {
+
+/// @brief What a thumbnail is rendered from, the first one set is used.
+typedef struct ThumbnailSource {
+	/// @brief A DICOM file, its middle frame is rendered.
+	QString DICOMFile;
+	/// @brief A FI3D study file, the middle slice of its middle series is rendered.
+	QString FI3DFile;
+	/// @brief A slice already mapped to [0, 1], rows ordered bottom to top.
+	QVector<float> Values;
+	/// @brief The width of the slice in Values.
+	int Width = 0;
+	/// @brief The height of the slice in Values.
+	int Height = 0;
+} ThumbnailSource;
+
+class ThumbnailService : public QObject {
+
+	Q_OBJECT
+
+public:
+	/// @brief The width and height, in pixels, thumbnails are scaled to fit.
+	static const int SIZE = 64;
+
+	/// @brief The way thumbnails are rendered, part of the hash of each file.
+	static const quint32 VERSION = 1;
+
+signals:
+	/// @brief Emitted when the thumbnail of a data object is ready.
+	void renderedThumbnail(const QUuid& dataID, const QImage& thumbnail);
+
+private:
+	/// @brief The directory with the thumbnail files.
+	QString mDirectory;
+
+	/// @brief The thumbnails ready, by data ID.
+	QHash<QUuid, QImage> mThumbnails;
+
+	/// @brief The requested thumbnails, the next one to render first.
+	QList<QPair<QUuid, ThumbnailSource>> mQueue;
+
+	/// @brief The data IDs that are queued or being rendered.
+	QSet<QUuid> mPending;
+
+	/// @brief Guards the thumbnails, queue and pending data IDs.
+	QMutex mMutex;
+
+	/// @brief Wakes the thread when a thumbnail is requested or the service stops.
+	QWaitCondition mCondition;
+
+	/// @brief Set to 1 to stop the thread.
+	QAtomicInt mIsStopped;
+
+	/// @brief The thread rendering the thumbnails, Q_NULLPTR until the first request.
+	QThread* mThread;
+
+public:
+	/// @brief Constructor.
+	ThumbnailService(const QString& directory, QObject* parent = Q_NULLPTR);
+
+	/// @brief Destructor. Stops after the thumbnail being rendered and waits for the thread.
+	~ThumbnailService();
+
+	/// @brief Gets the thumbnail directory used by the DataManager.
+	static QString getDefaultDirectory();
+
+	/// @brief Gets the thumbnail of a data object, null if it is not ready.
+	QImage getThumbnail(const QUuid& dataID);
+
+	/*!
+	 * @brief Requests the thumbnail of a data object.
+	 *
+	 * If it is ready, renderedThumbnail is emitted before returning.
+	 * Otherwise it is emitted from the thread of the service once rendered,
+	 * unless rendering fails. Requests for a data object already queued are
+	 * ignored.
+	 */
+	void request(const QUuid& dataID, const ThumbnailSource& source);
+
+	/// @brief Forgets the thumbnail of a data object, e.g., when its data changed.
+	void forget(const QUuid& dataID);
+
+private:
+	/// @brief Renders the requested thumbnails until stopped.
+	void run();
+
+	/// @brief Reads the thumbnail file of the source, rendering and saving it if there is none.
+	QImage loadOrRender(const ThumbnailSource& source) const;
+
+	/// @brief Gets the hash naming the thumbnail file of the source, empty if it has nothing to render.
+	static QString getKey(const ThumbnailSource& source);
+
+	/// @brief Renders the thumbnail of the source.
+	static QImage render(const ThumbnailSource& source);
+
+	/// @brief Converts a slice mapped to [0, 1] into a thumbnail.
+	static QImage toThumbnail(const QVector<float>& values, const int& width, const int& height);
+};
+
+/// @brief Alias for a smart pointer of this class.
+using ThumbnailServicePtr = QSharedPointer<ThumbnailService>;
+}
@@ -31,6 +31,7 @@
 #include <fi3d/server/MessageEncoder.h>
 
 #include <fi3d/modules/ModuleElement.h>
+#include <fi3d/modules/PoseRecord.h>
 #include <fi3d/modules/interactions/ValuelessInteraction.h>
 #include <fi3d/modules/interactions/BooleanInteraction.h>
 #include <fi3d/modules/interactions/IntegerInteraction.h>
@@ -39,15 +40,20 @@
 
 #include <fi3d/rendering/scenes/Scene.h>
 
+#include <fi3d/data/ImageData.h>
+
 #include <fi3d/server/message_keys/EModuleRequest.h>
 #include <fi3d/server/message_keys/EModuleResponse.h>
 #include <fi3d/server/message_keys/EResponseStatus.h>
 #include <fi3d/server/message_keys/EModuleInteraction.h>
 #include <fi3d/server/message_keys/EModuleInteractionConstraint.h>
 
+#include <QElapsedTimer>
 #include <QJsonArray>
+#include <QList>
 #include <QSharedPointer>
 #include <QTimer>
+#include <QUdpSocket>
 
 namespace fi3d {
 /// @brief Struct used interally to keep up with module interaction updates.
@@ -83,6 +89,21 @@ inline uint qHash(const SceneUpdateKey& key, uint seed) {
 	return qHash(key.VisualID, seed) ^ key.ResponseID.toInt();
 }
 
+/// @brief Struct used internally to keep up with the image data version
+/// last sent for an ImageSlice, so DATA_CHANGE can tell what changed since.
+typedef struct SentImageVersion {
+	fi3d::ImageData* Image = Q_NULLPTR;
+	qint64 DataVersion = 0;
+} SentImageVersion;
+
+/// @brief Struct used internally to keep the visual updates of a batch.
+typedef struct SceneLogEntry {
+	/// @brief The scene version the batch brought the scene to.
+	qint64 Version = 0;
+	/// @brief The VisualInfo sent in the batch, with their IDs.
+	QJsonArray VisualsInfo;
+} SceneLogEntry;
+
 /// @brief Struct used internally  to keep up with changes to Assembly objects.
 typedef struct AssembyUpdateKey : public SceneUpdateKey {
 	QString PartID;
@@ -108,6 +129,13 @@ class ModuleMessageEncoder : public fi3d::MessageEncoder, public ModuleElement,
 	Q_OBJECT
 	Q_INTERFACES(fi3d::IFeedbackEmitter)
 
+public:
+	/// @brief The VisualInfo kept in the scene log, older batches are dropped.
+	static const int MAX_SCENE_LOG_UPDATES = 4096;
+
+	/// @brief How long the scene log is kept after the last subscriber left, in ms.
+	static const qint64 SCENE_LOG_RETENTION = 300000;
+
 private:
 	/// @brief List of subscribers to the module.
 	QVector<QString> mSubscriberList;
@@ -127,6 +155,58 @@ private:
 	/// @brief Scene updates about assemblies only.
 	QHash<AssembyUpdateKey, bool> mAssemblyUpdates;
 
+	/// @brief The image data version last sent for each ImageSlice.
+	QHash<QString, SentImageVersion> mSentImageVersions;
+
+	/// @brief Subscribers that are sent handles in place of IDs.
+	QVector<QString> mHandleSubscribers;
+
+	/// @brief The handle of each visual, and of each assembly part as
+	/// "AssemblyID/PartID", once announced.
+	QHash<QString, int> mVisualHandles;
+
+	/// @brief The visual ID of each handle, used to resolve requests.
+	QHash<int, QString> mHandleVisualIDs;
+
+	/// @brief The handle of each data object, once announced.
+	QHash<QString, int> mDataHandles;
+
+	/// @brief The next handle given out. Handles are never reused.
+	int mNextHandle;
+
+	/// @brief Handle subscribers that are sent transforms as PoseRecords.
+	QVector<QString> mPoseSubscribers;
+
+	/// @brief The UDP port of the pose subscribers that asked for datagrams.
+	QHash<QString, quint16> mPosePorts;
+
+	/// @brief Sends the pose datagrams.
+	QUdpSocket mPoseSocket;
+
+	/// @brief The sequence of the last batch with PoseRecords.
+	quint32 mPoseSequence;
+
+	/// @brief The poses of the last batch that were only sent as datagrams.
+	QHash<int, PoseRecord> mDatagramPoses;
+
+	/// @brief Identifies this scene log, versions of other logs do not apply.
+	QString mSceneEpoch;
+
+	/// @brief The scene version, increased by every batch of visual updates.
+	qint64 mSceneVersion;
+
+	/// @brief The batches of visual updates sent, oldest first.
+	QList<SceneLogEntry> mSceneLog;
+
+	/// @brief The oldest version the scene log can bring a subscriber up from.
+	qint64 mSceneLogStart;
+
+	/// @brief The number of VisualInfo in the scene log.
+	int mSceneLogCount;
+
+	/// @brief Time since the last subscriber left, invalid while subscribed.
+	QElapsedTimer mUnsubscribedTime;
+
 public:
 	/// @brief Construct a Message Encoder for a module.
 	ModuleMessageEncoder();
@@ -178,6 +258,9 @@ private:
 	/// @brief Inserts the Json keys that are common to all module messages.
 	QJsonObject prepareModuleResponse(QJsonObject& moduleInfo, const QString& message = "");
 
+	/// @brief Gets the visual ID of the request target, from its handle if given.
+	QString getTargetVisualID(const QJsonObject& params) const;
+
 private slots:
 	/*!
 	 * @name Prepare functions for Module Interaction changes.
@@ -225,10 +308,74 @@ private:
 	/// @brief Creates the VisualInfo object based on the visual and response.
 	QJsonObject encodeVisualInfo(Visual3DPtr visual, const fi3d::EModuleResponse& responseType);
 
+	/*!
+	 * @brief Keeps up with the image data version sent for an ImageSlice.
+	 *
+	 * For DATA_CHANGE, the slice ranges written since the version that was
+	 * last sent are added, so clients only refresh the slices that changed.
+	 * The window/level of the image is added too, because changing it does
+	 * not change the data version.
+	 */
+	void encodeChangedExtent(Visual3DPtr visual, const fi3d::EModuleResponse& responseType, QJsonObject& visualInfo);
+
+	/*!
+	 * @name Handles
+	 * @brief Small integers standing for visual and data IDs on the wire.
+	 *
+	 * Every VisualInfo sent has the handles of its IDs. Subscribers that ask
+	 * for handles are sent updates with only the handle once it has been
+	 * announced, which saves the ID strings in every transform update.
+	 */
+	/// @{
+	int getVisualHandle(const QString& visualID);
+	int getDataHandle(const QString& dataID);
+	void insertHandles(QJsonObject& visualInfo, const QString& assemblyID = "");
+	QJsonObject compactVisualInfo(const QJsonObject& visualInfo, const int& announcedHandles) const;
+	/// @}
+
+	/*!
+	 * @name Pose Stream
+	 * @brief Sends transforms as PoseRecords to the subscribers that ask.
+	 *
+	 * Records go in the payload of the module message, or as UDP datagrams
+	 * to the subscribers that gave a PosePort. As datagrams may be lost,
+	 * the final pose of a visual that stopped moving is also sent in the
+	 * payload of the next module message.
+	 */
+	/// @{
+	void sendPoseMessage(QJsonObject& moduleInfo, const QVector<PoseRecord>& records,
+		const QVector<QString>& subscribers);
+	void sendPoseDatagrams(const QVector<PoseRecord>& records, const QVector<QString>& subscribers);
+	void removePoseSubscriber(const QString& clientID);
+	/// @}
+
+	/*!
+	 * @name Scene Log
+	 * @brief Lets a subscriber that comes back be sent only what changed.
+	 *
+	 * Every batch of visual updates increases the scene version and is kept
+	 * in the log. A subscriber that gives the epoch and the last version it
+	 * was sent is sent the updates logged since, otherwise a snapshot of the
+	 * whole scene. Scene changes are tracked for SCENE_LOG_RETENTION after
+	 * the last subscriber left, so a dropped connection can resync.
+	 */
+	/// @{
+	bool isTrackingScene() const;
+	void appendSceneLog(const QJsonArray& visualsInfo);
+	void clearSceneLog();
+	bool canResync(const QJsonObject& params) const;
+	QJsonArray getSceneChangesSince(const qint64& version) const;
+	QJsonArray getSceneSnapshot(const fi3d::EModuleResponse& responseID);
+	/// @}
+
 private slots:
 	/// @brief Sends the Scene updates to all subscribers.
 	void sendSceneUpdates();
 
+	/// @brief Sends the updates of an AnimationClock tick right away and
+	/// restarts the update timer, so a tick is never split across batches.
+	void sendAnimationUpdates();
+
 public:
 	/*! 
 	 * @brief Setups the scene to start listening for updates.
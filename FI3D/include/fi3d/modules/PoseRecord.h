@@ -0,0 +1,87 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		PoseRecord.h
+* @brief	Fixed-size binary form of a visual transform.
+*
+* Subscribers that ask for the pose stream are sent the TRANSFORM_VISUAL
+* updates of announced visuals as PoseRecords instead of VisualInfo, in the
+* payload of the module message. A record is 52 bytes, compared to the ID
+* and 16 doubles of the Json form.
+*
+* Records may instead be sent as UDP datagrams, each datagram is one
+* PoseDatagramHeader followed by RecordCount records. Datagrams may be lost
+* or arrive out of order, so receivers drop records older than the last one
+* applied to the same handle.
+*
+* Records are packed and little endian, they are only written and read
+* through the functions below, which convert each field.
+*/
+
+#include <QByteArray>
+#include <QVector>
+#include <QtGlobal>
+
+class vtkMatrix4x4;
+
+namespace fi3d {
+
+/// @brief Identifies a pose datagram.
+const quint32 POSE_DATAGRAM_MAGIC = 0x50334946;
+
+/// @brief The version of the pose record format.
+const quint16 POSE_RECORD_VERSION = 1;
+
+/// @brief Set in the flags of a record when its scale is not 1.
+const quint32 POSE_HAS_SCALE = 0x1;
+
+/// @brief The records sent in a single datagram, keeps it under the MTU.
+const int POSE_RECORDS_PER_DATAGRAM = 24;
+
+#pragma pack(push, 1)
+/// @brief The pose of a visual relative to its parent.
+typedef struct PoseRecord {
+	/// @brief The handle of the visual.
+	qint32 Handle = 0;
+	/// @brief The batch the record was sent in, later batches are higher.
+	quint32 Sequence = 0;
+	/// @brief POSE_HAS_SCALE when Scale is not 1.
+	quint32 Flags = 0;
+	/// @brief The translation.
+	float Position[3] = {0.0f, 0.0f, 0.0f};
+	/// @brief The rotation quaternion as x, y, z, w.
+	float Rotation[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+	/// @brief The scale along each axis, negative x when mirrored.
+	float Scale[3] = {1.0f, 1.0f, 1.0f};
+} PoseRecord;
+
+/// @brief The header of a pose datagram.
+typedef struct PoseDatagramHeader {
+	quint32 Magic = POSE_DATAGRAM_MAGIC;
+	quint16 Version = POSE_RECORD_VERSION;
+	/// @brief Number of records following the header.
+	quint16 RecordCount = 0;
+	/// @brief The batch the records were sent in.
+	quint32 Sequence = 0;
+} PoseDatagramHeader;
+#pragma pack(pop)
+
+/// @brief Fills the pose of the record from the matrix. Shear is lost.
+void toPoseRecord(vtkMatrix4x4* matrix, PoseRecord& record);
+
+/// @brief Sets the matrix to the pose of the record.
+void fromPoseRecord(const PoseRecord& record, vtkMatrix4x4* matrix);
+
+/// @brief Appends the records to the bytes, little endian.
+void appendPoseRecords(const PoseRecord* records, const int& count, QByteArray& bytes);
+
+/// @brief Reads count little endian records from the bytes.
+QVector<PoseRecord> readPoseRecords(const char* bytes, const int& count);
+
+/// @brief Appends the header to the bytes, little endian.
+void appendPoseDatagramHeader(const PoseDatagramHeader& header, QByteArray& bytes);
+
+/// @brief Reads a little endian header from the bytes.
+PoseDatagramHeader readPoseDatagramHeader(const char* bytes);
+
+}
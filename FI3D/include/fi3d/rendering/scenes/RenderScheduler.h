@@ -0,0 +1,140 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		RenderScheduler.h
+* @class	fi3d::RenderScheduler
+* @brief	Renders every Scene that changed at most once per display frame.
+*
+* Scene::render does not render right away, it marks the Scene as dirty. On
+* the next frame, all dirty scenes are rendered together, so the main window,
+* the slice viewers and their clones stay in phase and any number of changes
+* within a frame produce a single render per Scene.
+*
+* Frames are paced with a monotonic clock. Scenes whose widget is hidden or
+* whose window is minimized are not rendered; they are rendered once their
+* widget is shown again. Paused scenes are not rendered either, any number of
+* requests while paused result in a single render when resumed.
+*/
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QSet>
+#include <QSharedPointer>
+#include <QTimer>
+
+class QWidget;
+
+namespace fi3d {
+class Scene;
+
+/// @brief Frame-time statistics of the RenderScheduler.
+typedef struct RenderStatistics {
+	/// @brief Number of frames in which at least one Scene was rendered.
+	quint64 FrameCount = 0;
+	/// @brief Number of Scene renders.
+	quint64 RenderCount = 0;
+	/// @brief Number of render requests merged into an already dirty Scene.
+	quint64 CoalescedCount = 0;
+	/// @brief Number of renders deferred because the Scene was not shown.
+	quint64 DeferredCount = 0;
+	/// @brief Average time spent rendering a frame, in ms.
+	double AverageFrameTime = 0;
+	/// @brief Longest time spent rendering a frame, in ms.
+	double MaxFrameTime = 0;
+	/// @brief Average time between consecutive frames, in ms.
+	double AverageFrameInterval = 0;
+} RenderStatistics;
+
+class RenderScheduler : public QObject {
+
+	Q_OBJECT
+
+	/****************** Static members for the singleton ******************/
+public:
+	/// @brief Marks the Scene as dirty so it renders on the next frame.
+	static void requestRender(Scene* scene);
+
+	/// @brief Forgets the Scene, called when it is destroyed.
+	static void cancelRender(Scene* scene);
+
+	/// @brief Sets the minimum time between frames in ms, 16 by default.
+	static void setFrameInterval(const int& interval);
+
+	/// @brief Gets the minimum time between frames in ms.
+	static int getFrameInterval();
+
+	/// @brief Gets the frame-time statistics since the last reset.
+	static RenderStatistics getStatistics();
+
+	/// @brief Resets the frame-time statistics.
+	static void resetStatistics();
+
+private:
+	/// @brief The scheduler instance, created on first use.
+	static QSharedPointer<RenderScheduler> INSTANCE;
+
+	/// @brief Gets the scheduler, creating it if needed.
+	static RenderScheduler* getInstance();
+
+	/****************** Singleton members ******************/
+private:
+	/// @brief Scenes to render on the next frame.
+	QSet<Scene*> mDirtyScenes;
+
+	/// @brief Scenes that changed while not shown.
+	QSet<Scene*> mDeferredScenes;
+
+	/// @brief Triggers the next frame.
+	QTimer mFrameTimer;
+
+	/// @brief Monotonic clock used to pace the frames.
+	QElapsedTimer mClock;
+
+	/// @brief When the last frame started, in ns.
+	qint64 mLastFrameTime;
+
+	/// @brief Minimum time between frames in ms.
+	int mFrameInterval;
+
+	/// @brief The frame-time statistics.
+	RenderStatistics mStatistics;
+
+	/// @brief Total time spent rendering frames, in ms.
+	double mTotalFrameTime;
+
+	/// @brief Total time between consecutive frames, in ms.
+	double mTotalFrameInterval;
+
+	/// @brief Number of intervals between consecutive frames.
+	quint64 mFrameIntervalCount;
+
+	/// @brief Private constructor. Only one scheduler can exist.
+	RenderScheduler();
+
+public:
+	/// @brief Destructor.
+	~RenderScheduler();
+
+protected:
+	/// @brief Watches the widgets of deferred scenes to render when shown.
+	virtual bool eventFilter(QObject* watched, QEvent* event) override;
+
+private slots:
+	/// @brief Renders all the dirty scenes.
+	void renderFrame();
+
+	/// @brief Forgets the deferred scenes of a destroyed widget.
+	void onWidgetDestroyed(QObject* widget);
+
+private:
+	/// @brief Starts the frame timer, if not already started.
+	void scheduleFrame();
+
+	/// @brief Removes the event filters of a widget that no deferred Scene
+	/// is waiting on anymore.
+	void unwatchWidget(QWidget* widget);
+
+	/// @brief Whether the widget of the Scene can currently be seen.
+	static bool isShown(QWidget* widget);
+};
+}
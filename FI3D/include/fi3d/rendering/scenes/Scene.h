@@ -36,6 +36,8 @@ class Scene : public QObject, public fi3d::ModuleElement, public IFeedbackEmitte
 	Q_OBJECT
 	Q_INTERFACES(fi3d::IFeedbackEmitter)
 
+	friend class RenderScheduler;
+
 signals:
 	/// @brief Emitted when a Visual has been added.
 	void changedAddedSceneObject(VisualPtr sceneObject);
@@ -103,15 +105,12 @@ protected:
 	/// @brief Hash table used to find a Visual based on its vtkProp.
 	QHash<vtkProp*, QString> mActorsToNames;
 
-	/// @brief The time of the last render call.
-	int mTimeFromLastRender;
-
-	/// @brief Whether a render call is scheduled.
-	bool mIsRenderScheduled;
-
 	/// @brief Flag used to tell when rendering should be paused.
 	bool mIsRenderPaused;
 
+	/// @brief Whether a render was requested while paused.
+	bool mIsRenderPending;
+
 public:
 	/*!
 	* @brief Constructor of the scene.
@@ -332,7 +331,7 @@ public:
 	virtual bool getAxesVisible() const;
 
 public slots:
-	/// @brief Renders the window.
+	/// @brief Renders the window on the next frame of the RenderScheduler.
 	virtual void render();
 
 	/// @brief Resets and renders the window.
@@ -341,8 +340,9 @@ public slots:
 	/// @brief Pauses rendering until resumeRender is called.
 	virtual void pauseRender();
 
-	/// @brief Resumes rendering, called after pause. If pause wasn't
-	/// called before, it becomes a simple render call.
+	/// @brief Resumes rendering, called after pause. Renders once if a
+	/// render was requested while paused. If pause wasn't called before, it
+	/// becomes a simple render call.
 	virtual void resumeRender();
 
 public:
@@ -353,6 +353,9 @@ public:
 	void worldToDisplay(const double& x, const double& y, const double&z, double& i, double& j);
 
 private:
+	/// @brief Renders the window right away, called by the RenderScheduler.
+	void renderScene();
+
 	/// @brief Adds the Visual to the hash tables it belongs to.
 	void addToManagement(VisualPtr visual);
 
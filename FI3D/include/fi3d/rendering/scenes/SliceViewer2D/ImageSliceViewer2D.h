@@ -34,6 +34,7 @@
 */
 
 #include <fi3d/rendering/scenes/Scene.h>
+#include <fi3d/rendering/scenes/SliceViewer2D/ModelCapper.h>
 
 class vtkImageViewer2;
 
@@ -108,6 +109,9 @@ protected:
 	 */
 	QHash<QString, ModelPtr> mOriginalModels;
 
+	/// @brief Keeps the indexed meshes of the original models to cap them.
+	ModelCapper mCapper;
+
 public:
 	/*!
 	* @brief Constructor for the scene.
@@ -178,6 +182,9 @@ private slots:
 	 */
 	void onMouseMove();
 
+	/// @brief Displays the ImageData with its window/level.
+	void applyWindowLevel();
+
 public slots:
 	/// @brief Sets the ImageData to display.
 	void setImageData(fi3d::ImageDataVPtr data);
@@ -0,0 +1,102 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		ModelCapper.h
+* @class	fi3d::ModelCapper
+* @brief	Computes where models cross the cut plane of a 2D viewer.
+*
+* Capping a model used to transform its whole mesh and clip it with a VTK
+* pipeline every time the slice moved. Instead, the ModelCapper keeps the
+* transformed triangles of each model until its data or transform changes.
+* The triangles are sorted into slabs along the plane normal, so only the
+* triangles that may cross the plane are visited. The crossings are chained
+* into closed contours, which are returned as polygons like capClip does.
+*
+* Models are capped in parallel by capModels.
+*/
+
+#include <fi3d/data/ModelData.h>
+#include <fi3d/rendering/visuals/3D/models/Model.h>
+
+#include <QHash>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+#include <vtkType.h>
+
+class vtkMatrix4x4;
+class vtkPlane;
+
+namespace fi3d {
+
+/// @brief Struct used internally to keep the indexed mesh of a model.
+typedef struct CapMesh {
+	/// @brief The data the mesh was built from.
+	vtkPolyData* Data = Q_NULLPTR;
+	/// @brief The modification time of the data the mesh was built from.
+	vtkMTimeType DataTime = 0;
+	/// @brief The transform the mesh was built with.
+	double Matrix[16] = {0};
+	/// @brief The transformed vertices, x, y and z of each.
+	QVector<double> Points;
+	/// @brief The vertices of the triangles, three per triangle.
+	QVector<vtkIdType> Triangles;
+	/// @brief Whether the slabs were built for the normal below.
+	bool IsIndexed = false;
+	/// @brief The plane normal the slabs were built for.
+	double Normal[3] = {0, 0, 0};
+	/// @brief Each vertex projected on the normal.
+	QVector<double> Projections;
+	/// @brief The projection where the first slab starts.
+	double SlabStart = 0;
+	/// @brief The width of each slab along the normal.
+	double SlabWidth = 1;
+	/// @brief Where the triangles of each slab start, one more than slabs.
+	QVector<int> SlabOffsets;
+	/// @brief The triangles crossing each slab.
+	QVector<int> SlabTriangles;
+} CapMesh;
+
+class ModelCapper {
+private:
+	/// @brief The mesh of each model capped so far.
+	QHash<QString, QSharedPointer<CapMesh>> mMeshes;
+
+public:
+	/// @brief Constructor.
+	ModelCapper();
+
+	/// @brief Destructor.
+	~ModelCapper();
+
+	/*!
+	 * @brief Caps every model by the plane.
+	 *
+	 * The models are capped in parallel. Must be called from the thread
+	 * the models live in.
+	 *
+	 * @return The cap of each model, null if the model has no data.
+	 */
+	QHash<QString, ModelDataVPtr> capModels(const QHash<QString, ModelPtr>& models, vtkPlane* cutPlane);
+
+	/// @brief Caps a single model by the plane.
+	ModelDataVPtr capModel(const QString& visualID, ModelPtr model, vtkPlane* cutPlane);
+
+	/// @brief Forgets the mesh of a model.
+	void removeModel(const QString& visualID);
+
+	/// @brief Forgets every mesh.
+	void clear();
+
+private:
+	/// @brief Rebuilds the mesh if the data or the transform have changed.
+	static void updateMesh(CapMesh* mesh, vtkPolyData* data, const double matrix[16]);
+
+	/// @brief Rebuilds the slabs if the normal has changed.
+	static void updateSlabs(CapMesh* mesh, const double normal[3]);
+
+	/// @brief Chains the crossings of the plane into polygons.
+	static ModelDataVPtr intersect(const CapMesh* mesh, const double origin[3]);
+};
+}
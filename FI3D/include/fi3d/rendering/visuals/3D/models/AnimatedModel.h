@@ -5,16 +5,26 @@
 * @class	fi3d::AnimatedModel
 * @brief	An AnimatedModel renders and cycles through polygonal meshes at a
 *			chosen rate.
+*
+* The animation is driven by the AnimationClock, so all animated visuals
+* with the same speed change frames together.
+*
+* With the frame cache enabled, every frame gets its own mapper. VTK then
+* builds the render buffers of each frame once, and changing frames only
+* switches the mapper of the actor, instead of rebuilding the buffers of a
+* single mapper every frame. This costs one set of buffers per frame.
 */
 
 #include <fi3d/rendering/visuals/3D/models/Model.h>
 
+#include <fi3d/rendering/visuals/IAnimated.h>
+
 #include <fi3d/data/AnimatedModelData.h>
 
-#include <QTimer>
+#include <QVector>
 
 namespace fi3d {
-class AnimatedModel : public Model {
+class AnimatedModel : public Model, public IAnimated {
 
 	Q_OBJECT
 
@@ -38,11 +48,14 @@ protected:
 	/// @brief The animation speed, in milliseconds, defaults to 1000 (1 sec).
 	int mAnimationSpeed;
 
-	/// @brief The timer used to cycle through the animation.
-	QTimer mAnimationTimer;
+	/// @brief Whether the animation is playing.
+	bool mIsAnimationActive;
+
+	/// @brief Whether each frame is shown through its own mapper.
+	bool mIsFrameCacheEnabled;
 
-	/// @brief The external timer which controls the animation speed.
-	QTimer* mExternalTimer;
+	/// @brief The mapper of each frame, when the frame cache is enabled.
+	QVector<vtkSmartPointer<vtkPolyDataMapper>> mFrameMappers;
 
 public:
 	/*!
@@ -81,6 +94,10 @@ public slots:
 	/// @brief Sames as setNextFrame but cycles from end to beginning.
 	void setNextFrameCycle();
 
+	/// @brief Enables or disables the frame cache. Enabling it prepares the
+	/// mapper of every frame.
+	void setFrameCacheEnabled(const bool& isEnabled);
+
 public:
 	/// @brief get the data.
 	fi3d::AnimatedModelDataPtr getAnimatedModelData();
@@ -94,24 +111,21 @@ public:
 	/// @brief Gets the index of the frame currently being rendered. */
 	int getCurrentFrameIndex();
 
-	/*!
-	 * @brief Sets the timer in charge of the animation.
-	 *
-	 * This will disable the internal timer and use the given one instead. 
-	 * Null timer disables the external timer.
-	 *
-	 * When the external timer is set, the internal timer and animation speed 
-	 * is not set. Instead, the animation speed and enable/disable are handled 
-	 * by the given timer. When the external timer is set, the setAnimate(true)
-	 * will always fail (since it's using the external timer) and the 
-	 * isAnimationActive will always return false. Additionally, 
-	 * setAnimationSpeed will store the given speed but will not affect the 
-	 * animation speed (until the external timer is removed).
-	 */
-	void setExternalTimer(QTimer* timer);
-
-	/// @brief Removes the external timer, enabling the internal timer.
-	void disableExternalTimer();
+	/// @brief Whether each frame is shown through its own mapper.
+	bool isFrameCacheEnabled();
+
+	/// @brief Cycles forward by the given number of frames. See IAnimated.
+	virtual void advanceAnimation(const int& frameCount) override;
+
+private:
+	/// @brief Shows the current frame, through its mapper when cached.
+	void showCurrentFrame();
+
+	/// @brief Gets the mapper of the frame, creating it if needed. Frames
+	/// replaced in the AnimatedModelData get a new mapper.
+	vtkSmartPointer<vtkPolyDataMapper> getFrameMapper(const int& frameIndex);
+
+public:
 
 	/*!
 	*	@name Visual interface implementations.
@@ -33,6 +33,10 @@ protected:
 	/// @brief The mapper that maps the data to screen.
 	vtkSmartPointer<vtkPolyDataMapper> mMapper;
 
+	/// @brief The mapper currently used by the actor. It is mMapper unless
+	/// a subclass shows the data through a mapper prepared beforehand.
+	vtkSmartPointer<vtkPolyDataMapper> mActiveMapper;
+
 	/// @brief The actor that renders the mapped data to screen.
 	vtkSmartPointer<vtkActor> mActor;
 
@@ -56,6 +60,16 @@ public:
 	/// @brief Gets the data.
 	ModelDataVPtr getModelData();
 
+protected:
+	/*!
+	 * @brief Shows the data through the given mapper, which already has the
+	 * data as its input.
+	 *
+	 * Switching to a mapper that was rendered before reuses its render
+	 * buffers, where setModelData makes VTK rebuild them.
+	 */
+	void showModelData(fi3d::ModelDataVPtr data, vtkSmartPointer<vtkPolyDataMapper> mapper);
+
 public slots:
 	/// @brief Set the color of the Model in RGB (value range 0 to 1).
 	void setColor(const double& r, const double& g, const double& b);
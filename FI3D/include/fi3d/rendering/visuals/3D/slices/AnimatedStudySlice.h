@@ -3,16 +3,25 @@
 * @author	VelazcoJD
 * @file		AnimatedStudySlice.h
 * @class	fi3d::AnimatedStudySlice
-* @brief	An AnimatedStudySlice is a StudySlice with a timer that allows
-*			it to cycle through the series in the Study.
+* @brief	An AnimatedStudySlice is a StudySlice that cycles through the
+*			series in the Study.
+*
+* The animation is driven by the AnimationClock, so all animated visuals
+* with the same speed change frames together.
+*
+* With the frame cache enabled, every series gets its own mapper. VTK then
+* keeps the texture of each series, and changing series only switches the
+* mapper of the actor, instead of uploading the slice again every frame.
 */
 
 #include <fi3d/rendering/visuals/3D/slices/StudySlice.h>
 
-#include <QTimer>
+#include <fi3d/rendering/visuals/IAnimated.h>
+
+#include <QHash>
 
 namespace fi3d {
-class AnimatedStudySlice : public StudySlice {
+class AnimatedStudySlice : public StudySlice, public IAnimated {
 
 	Q_OBJECT
 
@@ -27,11 +36,14 @@ private:
 	/// @brief The animation speed, in milliseconds, defaults to 1000 (1 sec).
 	int mAnimationSpeed;
 
-	/// @brief The timer used to cycle through the animation. */
-	QTimer mAnimationTimer;
+	/// @brief Whether the animation is playing.
+	bool mIsAnimationActive;
+
+	/// @brief Whether each series is shown through its own mapper.
+	bool mIsFrameCacheEnabled;
 
-	/// @brief The external timer which controls the animation speed.
-	QTimer* mExternalTimer;
+	/// @brief The mapper of each series, when the frame cache is enabled.
+	QHash<ImageData*, vtkSmartPointer<vtkImageSliceMapper>> mFrameMappers;
 
 public:
 	/*!
@@ -62,6 +74,18 @@ public slots:
 	/// beginning.
 	void setSeriesIndexToNextCycle();
 
+	/// @brief Enables or disables the frame cache. Enabling it prepares the
+	/// mapper of every series.
+	void setFrameCacheEnabled(const bool& isEnabled);
+
+	/// @brief Sets the Study and follows the series removed from it. See
+	/// StudySlice::setStudy.
+	virtual void setStudy(fi3d::StudyPtr study) override;
+
+	/// @brief Shows the data through its cached mapper when it is a series
+	/// and the frame cache is enabled. See ImageSlice::setImageData.
+	virtual void setImageData(fi3d::ImageDataVPtr imageData) override;
+
 public:
 	/// @brief The animation speed, in milliseconds.
 	int getAnimationSpeed();
@@ -69,24 +93,28 @@ public:
 	/// @brief True if currently being animated. False if paushed.
 	bool isAnimationActive();
 
-	/*!
-	 * @brief Sets the timer in charge of the animation.
-	 *
-	 * This will disable the internal timer and use the given one instead.
-	 * Null timer disables the external timer.
-	 *
-	 * When the external timer is set, the internal timer and animation speed
-	 * is not set. Instead, the animation speed and enable/disable are handled
-	 * by the given timer. When the external timer is set, the setAnimate(true)
-	 * will always fail (since it's using the external timer) and the
-	 * isAnimationActive will always return false. Additionally,
-	 * setAnimationSpeed will store the given speed but will not affect the
-	 * animation speed (until the external timer is removed).
-	 */
-	void setExternalTimer(QTimer* timer);
+	/// @brief Whether each series is shown through its own mapper.
+	bool isFrameCacheEnabled();
+
+	/// @brief Cycles forward by the given number of series. See IAnimated.
+	virtual void advanceAnimation(const int& frameCount) override;
+
+private slots:
+	/// @brief Prepares the mappers of the new Study's series.
+	void onStudyChanged();
+
+	/// @brief Releases the mapper of a series removed from the Study.
+	void onSeriesRemoved(fi3d::SeriesDataVPtr series);
 
-	/// @brief Removes the external timer, enabling the internal timer.
-	void disableExternalTimer();
+private:
+	/// @brief Stops following the series removed from the previous Study
+	/// and follows the ones removed from the new one.
+	void watchStudy(StudyPtr previous, StudyPtr study);
+
+	/// @brief Creates the mapper of every series of the Study.
+	void prepareFrameMappers();
+
+public:
 
 	/*!
 	*	@name Visual interface implementations.
@@ -40,6 +40,9 @@ signals:
 	/// @brief Emitted When the ImageSlice slice has changed.
 	void changedSlice(const int& sliceIndex, const fi3d::ESliceOrientation& orientation);
 
+	/// @brief Emitted When the window/level of the ImageData has changed.
+	void changedWindowLevel(const double& window, const double& level);
+
 private:
 	///  @brief A visual which has a frame around the 3D imaging data set.
 	ModelPtr mDataFrame;
@@ -65,12 +68,19 @@ protected:
 	 */
 	SeriesSliceIndices mOrientationSliceIndices;
 
-	/// @brief The VTK mapper used to map the data to screen.
+	/// @brief The VTK mapper currently used to map the data to screen.
 	vtkSmartPointer<vtkImageSliceMapper> mMapper;
 
+	/// @brief The mapper used by setImageData. mMapper is a different one
+	/// while a subclass shows the data through a mapper prepared beforehand.
+	vtkSmartPointer<vtkImageSliceMapper> mImageMapper;
+
 	/// @brief the VTK actor used to render the data on screen.
 	vtkSmartPointer<vtkImageActor> mActor;
 
+	/// @brief The displayed slice when the ImageData is partial.
+	vtkSmartPointer<vtkImageData> mSliceImage;
+
 public:
 	/*!
 	 * @brief Constructor
@@ -101,6 +111,18 @@ public slots:
 	 */
 	virtual fi3d::ImageDataVPtr getImageData();
 
+protected:
+	/*!
+	 * @brief Shows the data through the given mapper, which already has the
+	 * data as its input.
+	 *
+	 * The mapper takes the current orientation and slice. Switching to a
+	 * mapper that was rendered before reuses its texture, where setImageData
+	 * makes VTK upload the slice again.
+	 */
+	void showImageData(fi3d::ImageDataVPtr data, vtkSmartPointer<vtkImageSliceMapper> mapper);
+
+public slots:
 	/// @brief Set the orientation of this slice to Transverse (XY).
 	virtual void setOrientationXY();
 
@@ -223,6 +245,13 @@ protected:
 	/// @brief Calculates the slice indices when new data is assigned.
 	virtual void calculateSliceIndices();
 
+	/// @brief Sets the slice the mapper shows in the current orientation.
+	/// A partial ImageData first copies the slice to the displayed image.
+	void applySliceNumber(const int& sliceIndex);
+
+	/// @brief Gets the axis normal to the current orientation, -1 if unknown.
+	int getSliceAxis() const;
+
 private slots:
 	/// @brief When the transform of the ImageSlice changes, it has to be applied
 	///	to the data frame as well.
@@ -232,6 +261,13 @@ private slots:
 	/// remits it as the local changedImageData signal
 	void onDataUpdated();
 
+	/// @brief Displays the ImageData with its window/level.
+	void applyWindowLevel();
+
+	/// @brief Catches the changedWindowLevel signal from the assigned
+	/// ImageData, applies it and remits it as the local changedWindowLevel.
+	void onWindowLevelChanged();
+
 public:
 	/*!
 	*	@name Visual interface implementations.
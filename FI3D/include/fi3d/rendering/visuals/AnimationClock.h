@@ -0,0 +1,112 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		AnimationClock.h
+* @class	fi3d::AnimationClock
+* @brief	The single timeline that advances every animated Visual.
+*
+* Animated visuals register with their frame interval instead of running
+* their own timer. Frames are counted from a shared monotonic epoch, so
+* visuals with the same interval always advance in the same tick, and every
+* visual due in a tick is advanced before control returns to the event loop.
+* The RenderScheduler and the ModuleMessageEncoder therefore see a tick as a
+* single change: one render and one batch of scene updates.
+*
+* When a tick comes late, e.g. because rendering took longer than the frame
+* interval, the visuals jump to the frame they should be showing and the
+* frames in between are dropped.
+*/
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QSharedPointer>
+#include <QTimer>
+
+namespace fi3d {
+class IAnimated;
+
+/// @brief Tick statistics of the AnimationClock.
+typedef struct AnimationStatistics {
+	/// @brief Number of ticks in which at least one animation advanced.
+	quint64 TickCount = 0;
+	/// @brief Number of frames shown across all animations.
+	quint64 FrameCount = 0;
+	/// @brief Number of frames skipped because a tick came late.
+	quint64 DroppedCount = 0;
+} AnimationStatistics;
+
+class AnimationClock : public QObject {
+
+	Q_OBJECT
+
+signals:
+	/// @brief Emitted after every animation due in a tick has advanced.
+	void advanced();
+
+	/****************** Static members for the singleton ******************/
+public:
+	/*!
+	 * @brief Starts advancing the animation every interval, in ms.
+	 *
+	 * Adding an animation that is already running changes its interval.
+	 */
+	static void addAnimation(IAnimated* animation, const int& interval);
+
+	/// @brief Stops advancing the animation.
+	static void removeAnimation(IAnimated* animation);
+
+	/// @brief Whether the animation is being advanced.
+	static bool hasAnimation(IAnimated* animation);
+
+	/// @brief Gets the tick statistics since the last reset.
+	static AnimationStatistics getStatistics();
+
+	/// @brief Resets the tick statistics.
+	static void resetStatistics();
+
+	/// @brief Gets the clock, creating it if needed. Used to connect to it.
+	static AnimationClock* getInstance();
+
+private:
+	/// @brief The clock instance, created on first use.
+	static QSharedPointer<AnimationClock> INSTANCE;
+
+	/****************** Singleton members ******************/
+private:
+	/// @brief A registered animation.
+	typedef struct AnimationTrack {
+		/// @brief Time between frames, in ms.
+		qint64 Interval = 1000;
+		/// @brief The last frame shown, counted from the epoch.
+		qint64 Frame = 0;
+	} AnimationTrack;
+
+	/// @brief The running animations.
+	QHash<IAnimated*, AnimationTrack> mAnimations;
+
+	/// @brief Triggers the next tick.
+	QTimer mTickTimer;
+
+	/// @brief Monotonic clock whose start is the epoch of every animation.
+	QElapsedTimer mClock;
+
+	/// @brief The tick statistics.
+	AnimationStatistics mStatistics;
+
+	/// @brief Private constructor. Only one clock can exist.
+	AnimationClock();
+
+public:
+	/// @brief Destructor.
+	~AnimationClock();
+
+private slots:
+	/// @brief Advances every animation that is due.
+	void tick();
+
+private:
+	/// @brief Starts the tick timer for the earliest frame due.
+	void scheduleTick();
+};
+}
@@ -0,0 +1,23 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		IAnimated.h
+* @class	fi3d::IAnimated
+* @brief	Interface for a Visual that is advanced by the AnimationClock.
+*/
+
+namespace fi3d {
+class IAnimated {
+public:
+	/// @brief Destructor.
+	virtual ~IAnimated() {}
+
+	/*!
+	 * @brief Advances the animation by the given number of frames.
+	 *
+	 * More than one frame is given when the clock fell behind, in which
+	 * case the skipped frames are dropped rather than shown late.
+	 */
+	virtual void advanceAnimation(const int& frameCount) = 0;
+};
+}
@@ -14,6 +14,9 @@
 
 #include <fi3d/server/FrameworkInterface.h>
 
+#include <fi3d/server/capture/TrafficRecorder.h>
+
+#include <QHostAddress>
 #include <QJsonObject>
 
 #include <QVector>
@@ -85,9 +88,28 @@ public:
 	/// @brief Gets the count of unidentified connections.
 	static int getUnidentifiedCount();
 
+	/// @brief Gets the address of an authenticated client, null if not found.
+	static QHostAddress getClientAddress(const QString& clientID);
+
 	/// @brief Gets a pointer to the running server.
 	static const Server* getInstance();
 
+	/*!
+	 * @brief Starts recording every inbound and outbound message to the given
+	 * capture file. 
+	 *
+	 * Payload contents are only recorded if includePayloads is set, their
+	 * length is always recorded. The capture can be replayed against a server
+	 * with the FI3DTrafficReplay tool.
+	 */
+	static bool startTrafficCapture(const QString& filePath, const bool& includePayloads = false);
+
+	/// @brief Stops recording the traffic and closes the capture file.
+	static void stopTrafficCapture();
+
+	/// @brief Whether the traffic is being recorded.
+	static bool isCapturingTraffic();
+
 	/****************** Singleton members ******************/
 signals:
 	/// @brief Emitted when a new client has connected.
@@ -131,6 +153,9 @@ private:
 	/// @brief Keeps a running count of connections, used to ID new connections.
 	unsigned long long mDeviceCount;
 
+	/// @brief Records the traffic when a capture is started.
+	TrafficRecorder mTrafficRecorder;
+
 private:
 	/// @brief Private constructor. Only one server can exist.
 	Server();
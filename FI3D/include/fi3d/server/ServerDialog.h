@@ -18,10 +18,19 @@ signals:
 	/// @brief Emitted when the user wants to change the password. 
 	void changePassword(const QString& newPassword) const;
 
+	/// @brief Emitted when the user wants to start capturing the traffic.
+	void startTrafficCapture(const QString& filePath, const bool& includePayloads) const;
+
+	/// @brief Emitted when the user wants to stop capturing the traffic.
+	void stopTrafficCapture() const;
+
 private:
 	/// @brief The UI elements.
 	Ui::ServerDialog ui;
 
+	/// @brief Whether the traffic is being captured.
+	bool mIsCapturingTraffic;
+
 public:
 	/// @brief Constructor.
 	ServerDialog(const QString& ip, const int& port, const QString& password, 
@@ -34,6 +43,9 @@ private slots:
 	/// @brief Handles the user clicking on the change password button.
 	void onChangePasswordClick();
 
+	/// @brief Handles the user clicking on the traffic capture button.
+	void onTrafficCaptureClick();
+
 public slots:
 	/// @brief Updates the server's IP.
 	void updateServerIP(const QString& ip);
@@ -49,6 +61,9 @@ public slots:
 
 	/// @brief Updates the number of unidentified connected devices.
 	void updateUnidentifiedConnections(const int& count);
+
+	/// @brief Updates the state of the traffic capture.
+	void updateTrafficCapture(const bool& isCapturing, const QString& filePath);
 };
 
 /// @brief Alias for a smart pointer of this class.
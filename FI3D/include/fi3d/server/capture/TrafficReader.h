@@ -0,0 +1,58 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		TrafficReader.h
+* @class	fi3d::TrafficReader
+* @brief	Reads the records of a capture file written by TrafficRecorder.
+*/
+
+#include <fi3d/server/capture/TrafficRecord.h>
+
+#include <QDataStream>
+#include <QFile>
+#include <QVector>
+
+namespace fi3d {
+class TrafficReader {
+private:
+	/// @brief The capture file.
+	QFile mFile;
+
+	/// @brief Reads from the capture file.
+	QDataStream mStream;
+
+	/// @brief When the capture started, in ms since epoch.
+	qint64 mStartTime;
+
+	/// @brief Whether the capture includes payload contents.
+	bool mIncludesPayloads;
+
+	/// @brief The client IDs by their index in the capture.
+	QVector<QString> mClientIDs;
+
+public:
+	/// @brief Constructor.
+	TrafficReader();
+
+	/// @brief Destructor.
+	~TrafficReader();
+
+	/// @brief Opens the capture file and reads its header.
+	bool open(const QString& filePath);
+
+	/// @brief Closes the capture file.
+	void close();
+
+	/// @brief Whether all the records have been read.
+	bool atEnd() const;
+
+	/// @brief Reads the next record. Returns false at the end or on error.
+	bool readNext(TrafficRecord& record);
+
+	/// @brief Gets when the capture started, in ms since epoch.
+	qint64 getStartTime() const;
+
+	/// @brief Whether the capture includes payload contents.
+	bool includesPayloads() const;
+};
+}
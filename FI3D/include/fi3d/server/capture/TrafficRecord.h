@@ -0,0 +1,61 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		TrafficRecord.h
+* @brief	A single event of a server traffic capture.
+*
+* A capture file starts with a header followed by one record per event:
+*
+*	Header: magic (quint32), version (quint16), capture start as ms since
+*	epoch (qint64) and whether payload contents are included (quint8).
+*
+*	Record: event (quint8), microseconds since the capture started
+*	(qint64) and the client index (quint16). CONNECTED records add the
+*	client ID (QString). INBOUND and OUTBOUND records add the compact JSON
+*	info (QByteArray), the payload length (qint32) and, if the capture
+*	includes payloads, the raw payload bytes.
+*
+* All the values are little endian, written with a QDataStream. Client IDs
+* are only written once, in the CONNECTED record, and are referenced by their
+* index afterwards.
+*/
+
+#include <QByteArray>
+#include <QString>
+
+namespace fi3d {
+
+/// @brief The event a TrafficRecord represents.
+enum TrafficEvent {
+	/// @brief A client connected to the server.
+	TRAFFIC_CONNECTED = 0,
+	/// @brief A client disconnected from the server.
+	TRAFFIC_DISCONNECTED = 1,
+	/// @brief A message received from a client.
+	TRAFFIC_INBOUND = 2,
+	/// @brief A message sent to a client.
+	TRAFFIC_OUTBOUND = 3
+};
+
+/// @brief A single event of a traffic capture.
+typedef struct TrafficRecord {
+	/// @brief The TrafficEvent.
+	int Event;
+	/// @brief Microseconds since the capture started, monotonic.
+	qint64 Timestamp;
+	/// @brief The ID of the client.
+	QString ClientID;
+	/// @brief The compact JSON info of the message.
+	QByteArray Info;
+	/// @brief The length of the payload of the message.
+	qint32 PayloadLength;
+	/// @brief The payload, empty if the capture does not include payloads.
+	QByteArray Payload;
+} TrafficRecord;
+
+/// @brief Identifies a traffic capture file.
+const quint32 TRAFFIC_CAPTURE_MAGIC = 0x43334946;
+
+/// @brief The version of the traffic capture format.
+const quint16 TRAFFIC_CAPTURE_VERSION = 1;
+}
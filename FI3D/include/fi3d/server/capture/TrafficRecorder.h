@@ -0,0 +1,88 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		TrafficRecorder.h
+* @class	fi3d::TrafficRecorder
+* @brief	Writes the server traffic to a capture file.
+*
+* Timestamps are taken from a monotonic clock started when the capture is
+* opened. Payload contents are optional since they dominate the size of the
+* capture, their length is always recorded. See TrafficRecord for the format.
+*
+* The recorder does nothing while it is not open, so callers can record
+* unconditionally. Checking isOpen first avoids encoding the info.
+*/
+
+#include <fi3d/server/capture/TrafficRecord.h>
+
+#include <fi3d/server/network/Message.h>
+
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+
+namespace fi3d {
+class TrafficRecorder {
+private:
+	/// @brief The capture file.
+	QFile mFile;
+
+	/// @brief Writes to the capture file.
+	QDataStream mStream;
+
+	/// @brief Monotonic clock started when the capture is opened.
+	QElapsedTimer mClock;
+
+	/// @brief Whether payload contents are written.
+	bool mIncludePayloads;
+
+	/// @brief The index of each client ID in the capture.
+	QHash<QString, quint16> mClientIndices;
+
+public:
+	/// @brief Constructor.
+	TrafficRecorder();
+
+	/// @brief Destructor. Closes the capture.
+	~TrafficRecorder();
+
+	/// @brief Opens a new capture file, closing the current one.
+	bool open(const QString& filePath, const bool& includePayloads = false);
+
+	/// @brief Closes the capture file.
+	void close();
+
+	/// @brief Whether a capture is open.
+	bool isOpen() const;
+
+	/// @brief Gets the path of the capture file.
+	QString getFilePath() const;
+
+	/// @brief Writes buffered records to the file.
+	void flush();
+
+	/// @brief Records a client connecting.
+	void recordConnected(const QString& clientID);
+
+	/// @brief Records a client disconnecting.
+	void recordDisconnected(const QString& clientID);
+
+	/// @brief Records a message received from a client.
+	void recordInbound(const QString& clientID, MessagePtr message);
+
+	/// @brief Records a message received from a client, info already encoded.
+	void recordInbound(const QString& clientID, const QByteArray& info, const QByteArray* payload = Q_NULLPTR);
+
+	/// @brief Records a message sent to a client, info already encoded.
+	void recordOutbound(const QString& clientID, const QByteArray& info, const QByteArray* payload = Q_NULLPTR);
+
+private:
+	/// @brief Writes the common part of a record.
+	void writeRecordHeader(const int& event, const QString& clientID);
+
+	/// @brief Writes a message record.
+	void writeMessage(const int& event, const QString& clientID,
+		const QByteArray& info, const QByteArray* payload);
+};
+}
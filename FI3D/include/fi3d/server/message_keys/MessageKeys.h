@@ -22,6 +22,9 @@ extern const QString APPLICATION_PARAMS;
 extern const QString MODULE_PARAMS;
 extern const QString DATA_PARAMS;
 extern const QString ERROR_CODE;
+extern const QString LOCAL_TRANSPORT;
+extern const QString SEGMENT_KEY;
+extern const QString TRANSPORT_NONCE;
 /// @}
 
 /*!
@@ -43,6 +46,13 @@ extern const QString ACTIVE_MODULES;
 extern const QString MODULE_ID;
 extern const QString REQUEST_ID;
 extern const QString TARGET_VISUAL;
+extern const QString TARGET_HANDLE;
+extern const QString USE_HANDLES;
+extern const QString USE_POSE_STREAM;
+extern const QString POSE_PORT;
+extern const QString SCENE_VERSION;
+extern const QString SCENE_EPOCH;
+extern const QString SCENE_SNAPSHOT;
 extern const QString IS_VISIBLE;
 extern const QString TRANSLATE;
 extern const QString ROTATE;
@@ -58,6 +68,7 @@ extern const QString SCENE_ID;
 extern const QString VISUALS_INFO;
 extern const QString MODULE_INTERACTIONS;
 extern const QString ID;
+extern const QString HANDLE;
 extern const QString TYPE;
 extern const QString VALUE;
 extern const QString CONSTRAINT;
@@ -70,6 +81,8 @@ extern const QString OPACITY;
 extern const QString TRANSFORMATION;
 extern const QString PARENT_ID;
 extern const QString DATA_ID;
+extern const QString DATA_HANDLE;
+extern const QString POSE_RECORD_COUNT;
 extern const QString DATA_NAME;
 extern const QString DATA_TYPE;
 extern const QString COLOR;
@@ -85,16 +98,23 @@ extern const QString UPDATE_CONSTRAINT;
 /// @{
 extern const QString DATA;
 extern const QString CACHEABLE;
+extern const QString DATA_VERSION;
+extern const QString CHANGED_EXTENT;
+extern const QString CHANGED_SINCE_VERSION;
 extern const QString SERIES_COUNT;
 extern const QString DIMENSIONS;
 extern const QString ORIGIN;
 extern const QString SPACING;
 extern const QString DATA_FORMAT;
+extern const QString WINDOW_WIDTH;
+extern const QString WINDOW_CENTER;
 extern const QString VALUES;
 extern const QString POINTS;
 extern const QString LINE_INDICES;
 extern const QString TRIANGLE_INDICES;
 extern const QString PAYLOAD_POINTS_LENGTH;
 extern const QString PAYLOAD_TRIANGLES_LENGTH;
+extern const QString DATA_REQUEST_ID;
+extern const QString CANCEL_DATA_REQUESTS;
 /// @}
 }
\ No newline at end of file
@@ -19,14 +19,38 @@
 * 
 * F : payload flag
 * L1: info length
-* L2: payload length (ommitted if payload flag is 0)
+* L2: payload length (ommitted if payload flag is 0 or 3)
 * I : info part of message, contains L1 bytes
 * P : payload part of message, contains L2 bytes
+* 
+* When the peer runs on the same machine, payloads of SHARED_PAYLOAD_THRESHOLD
+* bytes or more are not sent through the socket. They are written to a shared
+* memory segment, and P only has the payload length followed by the key of the
+* segment, so the payload skips the TLS encryption and the socket buffers. The
+* receiver copies the payload out and releases the segment, so the sender can
+* reuse it. Received messages are the same whichever way the payload came.
+* 
+* The local transport is negotiated by the side that connects, and only once
+* the peer advertised it: when a message from a local peer has LocalTransport
+* set to "Available", it offers a probe segment and the peer accepts by
+* answering with its contents. Either side only shares payloads after the
+* offer went through, so peers that do not support it never see a transport
+* control message and keep receiving payloads inline.
+* 
+* Segment keys start with "FI3D-" and the nonce of the offer, so a shared
+* payload is only read from the local peer that accepted the offer, and the
+* connection is closed when any other peer sends one.
 */
 
 #include <fi3d/server/network/ClientTCP.h>
 #include <fi3d/server/network/Message.h>
 
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+
+class QSharedMemory;
+
 namespace fi3d {
 class ClientFI3D : public ClientTCP {
 
@@ -36,10 +60,38 @@ signals:
 	/// @brief Emitted when a message is received.
 	void messageReceived(MessagePtr message) const;
 
+public:
+	/// @brief Values of the payload flag, the first byte of a message.
+	enum EPayloadFlag {
+		/// @brief The message has no payload.
+		NO_PAYLOAD = 0,
+		/// @brief The payload follows the info.
+		INLINE_PAYLOAD = 1,
+		/// @brief The payload is in a shared memory segment.
+		SHARED_PAYLOAD = 2,
+		/// @brief The info negotiates the transport, it is not a message.
+		TRANSPORT_CONTROL = 3
+	};
+
+	/// @brief Payloads this large are shared with local peers.
+	static const int SHARED_PAYLOAD_THRESHOLD = 64 * 1024;
+
+	/// @brief The smallest shared memory segment created.
+	static const int MIN_SEGMENT_SIZE = 1024 * 1024;
+
+	/// @brief The segments that may wait for the peer to release them.
+	static const int MAX_SHARED_SEGMENTS = 32;
+
+	/// @brief The released segments kept for reuse.
+	static const int MAX_FREE_SEGMENTS = 4;
+
 private:
 	/// @brief Whether the payload flag byte has been read.
 	bool mReadPayloadFlag;
 
+	/// @brief The payload flag of the receiving message.
+	quint8 mPayloadFlag;
+
 	///  @brief Whether the receiving message has a payload.
 	bool mHasPayload;
 
@@ -52,6 +104,24 @@ private:
 	/// @brief The message being received.
 	QByteArray mReceivingBytes;
 
+	/// @brief Whether the local transport may be used with local peers.
+	bool mIsLocalTransportEnabled;
+
+	/// @brief Whether payloads are sent through shared memory.
+	bool mIsSharingPayloads;
+
+	/// @brief The segment offered to the peer, until it is accepted.
+	QSharedPointer<QSharedMemory> mProbeSegment;
+
+	/// @brief The contents of the offered segment, also part of the segment keys.
+	QByteArray mProbeNonce;
+
+	/// @brief The segments sent, by key, until the peer releases them.
+	QHash<QString, QSharedPointer<QSharedMemory>> mSharedSegments;
+
+	/// @brief The released segments, reused for the next payloads.
+	QList<QSharedPointer<QSharedMemory>> mFreeSegments;
+
 public:
 	/// @brief Constructor.
 	ClientFI3D();
@@ -59,6 +129,31 @@ public:
 	/// @brief Destructor.
 	~ClientFI3D();
 
+	/*!
+	 * @brief Sends a message whose info is already encoded.
+	 * 
+	 * Used to encode the info once when sending it to several clients. It
+	 * may be called from any thread: when not called from the thread of the
+	 * socket, the message is queued to it, and messages queued by the same
+	 * thread are sent in order.
+	 * 
+	 * @param payload The payload, Q_NULLPTR if the message has none.
+	 */
+	void writeMessage(const QByteArray& info, const QByteArray* payload = Q_NULLPTR);
+
+	/*!
+	 * @brief Sets whether the local transport may be used. 
+	 * 
+	 * It is enabled by default and only takes effect on the next connection.
+	 */
+	void setLocalTransportEnabled(const bool& isEnabled);
+
+	/// @brief Whether the local transport may be used.
+	bool isLocalTransportEnabled() const;
+
+	/// @brief Whether payloads are being sent through shared memory.
+	bool isSharingPayloads() const;
+
 public slots:
 	/// @brief Sends the given message if there is an established connection.
 	void sendMessage(MessagePtr message);
@@ -66,6 +161,39 @@ public slots:
 private slots:
 	/// @brief Handles new bytes arriving.
 	void onPacket();
+
+	/// @brief Releases the shared memory segments.
+	void onDisconnected();
+
+private:
+	/// @brief Writes the header, info and payload of a message.
+	void writeFrame(const quint8& payloadFlag, const QByteArray& info, const QByteArray& payload);
+
+	/// @brief Sends the payload through a segment, false if it could not.
+	bool writeSharedPayload(const QByteArray& info, const QByteArray& payload);
+
+	/*!
+	 * @brief Reads the payload from the segment described by P.
+	 * 
+	 * Closes the connection if the payloads are not shared with the peer or
+	 * the key does not hold the nonce of the offer.
+	 */
+	bool readSharedPayload(const QByteArray& descriptor);
+
+	/// @brief Offers the local transport when the peer is local.
+	void offerLocalTransport();
+
+	/// @brief Sends a transport control message.
+	void sendTransportControl(const QJsonObject& control);
+
+	/// @brief Handles a transport control message from the peer.
+	void onTransportControl(const QJsonObject& control);
+
+	/// @brief Gets the start of the segment keys of the offer with the nonce.
+	static QString getSegmentPrefix(const QByteArray& nonce);
+
+	/// @brief Creates a segment key unique to this process.
+	static QString createSegmentKey(const QByteArray& nonce);
 };
 
 /// @brief Alias for a smart pointer of this class.
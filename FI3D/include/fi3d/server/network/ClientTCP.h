@@ -6,6 +6,7 @@
 * @brief	Functions as a TCP client with SSL/TLS support.
 */
 
+#include <QHostAddress>
 #include <QSslSocket>
 
 #include <QSharedPointer>
@@ -15,12 +16,35 @@ class ClientTCP : public QSslSocket {
 
 	Q_OBJECT
 
+private:
+	/// @brief The address of the peer, cached when the socket is accepted.
+	QHostAddress mAcceptedPeerAddress;
+
 public:
 	/// @brief Constructor.
 	ClientTCP();
 
 	/// @brief Destructor.
 	~ClientTCP();
+
+	/// @brief Whether the peer runs on this machine, e.g., through loopback.
+	bool isLocalPeer() const;
+
+	/*!
+	 * @brief Gets the address of the peer of an accepted socket.
+	 * 
+	 * It is cached by setSocketDescriptor, so unlike peerAddress it may be
+	 * called from any thread. Null for sockets that were not accepted.
+	 */
+	QHostAddress getAcceptedPeerAddress() const;
+
+	/// @brief Sets up the accepted socket and caches the peer address.
+	bool setSocketDescriptor(qintptr socketDescriptor, 
+		QAbstractSocket::SocketState state = QAbstractSocket::ConnectedState,
+		QIODevice::OpenMode openMode = QIODevice::ReadWrite) override;
+
+	/// @brief Closes the connection, may be called from any thread.
+	void closeConnection();
 };
 
 /// @brief Alias for a smart pointer of this class.
@@ -0,0 +1,65 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		NetworkThreadPool.h
+* @class	fi3d::NetworkThreadPool
+* @brief	Threads that own the sockets accepted by a ServerTCP.
+* 
+* Each accepted socket is moved to one of the threads, round-robin, and set
+* up there. The TLS handshake, the encryption, and the reading and framing of
+* messages then happen in that thread instead of the GUI thread. Signals from
+* the sockets reach the objects of other threads as queued connections, so 
+* fully received Messages are handed to the main thread through its event
+* queue. See ClientFI3D::writeMessage for sending from other threads.
+* 
+* The pool keeps track of the sockets it was given. When destroyed, it closes
+* and deletes the remaining ones in their own thread before stopping it, so no
+* socket outlives the thread its notifiers belong to.
+*/
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+
+class QAbstractSocket;
+class QObject;
+class QThread;
+
+namespace fi3d {
+class NetworkThreadPool {
+private:
+	/// @brief The running threads.
+	QList<QThread*> mThreads;
+
+	/// @brief An object living in each thread, to run code in it.
+	QList<QObject*> mThreadContexts;
+
+	/// @brief The thread the next socket is assigned to.
+	int mNextThread;
+
+	/// @brief The sockets of each thread that were not deleted yet.
+	QHash<QThread*, QList<QAbstractSocket*>> mSockets;
+
+	/// @brief Guards mSockets, sockets are deleted in their own thread.
+	QMutex mSocketsMutex;
+
+public:
+	/// @brief Constructor. Starts the given number of threads.
+	NetworkThreadPool(const int& threadCount = NetworkThreadPool::getDefaultThreadCount());
+
+	/// @brief Destructor. Deletes the sockets, stops the threads and waits for them.
+	~NetworkThreadPool();
+
+	/// @brief Gets the number of threads.
+	int getThreadCount() const;
+
+	/// @brief Gets the thread for the next socket, Q_NULLPTR if there are none.
+	QThread* nextThread();
+
+	/// @brief Moves the socket to the thread, which must be one of the pool.
+	void adoptSocket(QAbstractSocket* socket, QThread* thread);
+
+	/// @brief Half the cores, at least one and at most four threads.
+	static int getDefaultThreadCount();
+};
+}
@@ -15,9 +15,16 @@
 * 
 * It is also possible to override nextPendingConnection to alter logic of
 * new connections. See the QTcpServer documentation for more information.
+* 
+* Accepted sockets live in the threads of a NetworkThreadPool, so they are
+* set up, and their TLS handshake started, there. They are added as pending
+* connections, and newConnection is emitted, once that is done. Slots that
+* handle newConnection should therefore expect nextPendingConnection to
+* return Q_NULLPTR when the socket is not ready yet.
 */
 
 #include <fi3d/server/network/ClientTCP.h>
+#include <fi3d/server/network/NetworkThreadPool.h>
 
 #include <QSslCertificate>
 #include <QSslKey>
@@ -38,6 +45,9 @@ private:
 	///  @brief The SSL certificate when SSL is enabled.
 	QSslCertificate mSslCertificate;
 
+	/// @brief The threads the accepted sockets live in.
+	NetworkThreadPool mIOThreads;
+
 public:
 	/// @brief Constructor.
 	ServerTCP(const bool& enableSSL = false);
@@ -91,5 +101,9 @@ protected:
 	 * Override this function to use a derived class of ClientTCP instead.
 	 */
 	virtual ClientTCP* makeClientTCPSocket() const;
+
+private:
+	/// @brief Opens the socket and starts the SSL handshake if enabled.
+	bool setUpConnection(ClientTCP* client, qintptr socketDescriptor) const;
 };
 }
\ No newline at end of file
@@ -8,8 +8,32 @@
 
 #include <fi3d/data/ImageData.h>
 #include <fi3d/data/ModelData.h>
+#include <fi3d/data/Study.h>
+
+#include <functional>
 
 namespace fi3d {
+
+/// <summary>
+/// The steps of ImageAlgorithms::segment.
+/// </summary>
+typedef struct SegmentationSettings {
+	/// @brief Minimum value to include in the threshold.
+	double Min = 0;
+	/// @brief Maximum value to include in the threshold.
+	double Max = 255;
+	/// @brief Standard deviation of the gaussian smoothing, in voxels. 0 skips it.
+	double SmoothingDeviation = 1.0;
+	/// @brief Fraction of the triangles to remove, in [0, 1). 0 skips it.
+	double DecimationReduction = 0.0;
+} SegmentationSettings;
+
+/// <summary>
+/// Told the fraction of the segmentation done. Returns false to cancel.
+/// It is called from the segmenting threads, possibly at the same time.
+/// </summary>
+using SegmentationProgress = std::function<bool(const double& fraction)>;
+
 class ImageAlgorithms {
 private:
 	ImageAlgorithms() {}
@@ -47,6 +71,70 @@ public:
 	/// <returns>The lines corresponding to the edges.</returns>
 	static ModelDataVPtr computeEdges(vtkSmartPointer<vtkImageData> image);
 
+	/// <summary>
+	/// Extracts the surface of the thresholded volume. The image is
+	/// thresholded, optionally smoothed, contoured in 3D and optionally 
+	/// decimated. The volume is split into slabs of slices that overlap by
+	/// one slice and are processed in parallel. The slab surfaces are then
+	/// merged into a single model, the vertices of the shared slices match so
+	/// the model has no seams.
+	/// 
+	/// The first scalar component is used. Blocks until done, see
+	/// SegmentationTask to segment without blocking.
+	/// </summary>
+	/// <param name="image">The 3D image.</param>
+	/// <param name="settings">The steps to apply.</param>
+	/// <param name="progress">Told the progress, may cancel. Optional.</param>
+	/// <returns>The surface, null if cancelled or the image is invalid.</returns>
+	static ModelDataVPtr segment(vtkSmartPointer<vtkImageData> image,
+		const SegmentationSettings& settings,
+		const SegmentationProgress& progress = SegmentationProgress());
+
+	/// <summary>
+	/// Extracts the surface of the thresholded series of the study.
+	/// </summary>
+	/// <param name="study">The study.</param>
+	/// <param name="seriesIndex">The index of the series to segment.</param>
+	/// <param name="settings">The steps to apply.</param>
+	/// <param name="progress">Told the progress, may cancel. Optional.</param>
+	/// <returns>The surface, null if cancelled or the series is invalid.</returns>
+	static ModelDataVPtr segment(StudyPtr study, const int& seriesIndex,
+		const SegmentationSettings& settings,
+		const SegmentationProgress& progress = SegmentationProgress());
+
+	/// <summary>
+	/// Maps values through a window/level to [0, 1]. Values below
+	/// level - window / 2 map to 0 and values above level + window / 2 to 1.
+	/// 8-bit values go through a table of the 256 results, any other type
+	/// is scaled and clamped in a loop without branches.
+	/// </summary>
+	/// <param name="values">The first value.</param>
+	/// <param name="scalarType">The VTK type of the values.</param>
+	/// <param name="count">The number of values to map.</param>
+	/// <param name="stride">The values from one to the next, 1 if contiguous.</param>
+	/// <param name="window">The width of the mapped range.</param>
+	/// <param name="level">The center of the mapped range.</param>
+	/// <param name="output">Receives count values.</param>
+	static void applyWindowLevel(const void* values, const int& scalarType,
+		const qint64& count, const qint64& stride,
+		const double& window, const double& level, float* output);
+
+	/// <summary>
+	/// Maps the first component of a slice through a window/level, one row
+	/// at a time. Rows run along x for XY and XZ slices and along y for YZ
+	/// slices, rows are ordered by y for XY slices and by z otherwise.
+	/// </summary>
+	/// <param name="image">The image, which must have its scalars in memory.</param>
+	/// <param name="sliceIndex">The index of the slice.</param>
+	/// <param name="orientation">The orientation of the slice.</param>
+	/// <param name="window">The width of the mapped range.</param>
+	/// <param name="level">The center of the mapped range.</param>
+	/// <param name="output">Receives one value per voxel of the slice.</param>
+	/// <returns>False if the slice is out of range or there are no scalars.</returns>
+	static bool applyWindowLevel(vtkImageData* image, const int& sliceIndex,
+		const ESliceOrientation& orientation,
+		const double& window, const double& level, float* output);
+
 	/// @brief Loads the Geology data.
 	static ImageDataVPtr loadGeologyData(const QString& dirPath);
 };
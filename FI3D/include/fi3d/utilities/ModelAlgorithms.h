@@ -106,17 +106,19 @@ public:
 	/*!
 	* @brief Converts a ModelData to ImageData. 
 	*
-	* This functions sets the value to 255 to every converted points and 0 
-	* to empty space.
+	* This functions sets the value to 255 to every voxel the surface of the
+	* model overlaps and 0 to empty space. See Voxelizer.
 	*
 	* @param modelData The data to convert.
 	* @param vsX The voxel spacing in the x direction
 	* @param vsY The voxel spacing in the y direction
 	* @param vsZ The voxel spacing in the z direction
+	* @param isFilled Whether the inside of a closed model is set to 255 too.
 	* @return The converted ImageData.
 	*/
 	static ImageDataVPtr polyToImage(vtkSmartPointer<vtkPolyData> modelData, 
-		const double& vsX, const double& vsY, const double& vsZ);
+		const double& vsX, const double& vsY, const double& vsZ,
+		const bool& isFilled = false);
 
 	/*!
 	* @brief Creates a ModelData resulting from transforming another ModelData.
@@ -166,5 +168,16 @@ public:
 
 	/// @brief Reconstruct a surface based on the given point cloud. 
 	static ModelDataVPtr reconstructSurface(vtkSmartPointer<vtkPolyData> pointCloud);
+
+	/*!
+	 * @brief Gets the triangles of the polygons and strips of a ModelData.
+	 *
+	 * Polygons are split as fans. Used by the code that walks the triangles
+	 * itself, e.g., the Voxelizer and the ModelCapper.
+	 *
+	 * @param modelData The ModelData, may be read from several threads.
+	 * @return The three point IDs of each triangle, one triangle after another.
+	 */
+	static QVector<vtkIdType> getTriangles(vtkPolyData* modelData);
 };
 }
@@ -0,0 +1,37 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		ParallelAlgorithms.h
+* @class	fi3d::ParallelAlgorithms
+* @brief	Static functions to spread independent work over threads.
+*
+* The work runs on the global QThreadPool. The calling thread takes part in
+* the work, and helpers are only started on idle pool threads, so a call made
+* from a pool thread never waits on a thread that is not running.
+*/
+
+#include <functional>
+
+namespace fi3d {
+class ParallelAlgorithms {
+private:
+	ParallelAlgorithms() {}
+
+public:
+	~ParallelAlgorithms() {}
+
+	/*!
+	 * @brief Calls work with every index in [0, count), over several threads.
+	 *
+	 * Returns once every call returned. The calls must not depend on each
+	 * other, nor on the order they are made.
+	 *
+	 * @param count The number of work items.
+	 * @param work The function doing one work item.
+	 */
+	static void forRange(const int& count, const std::function<void(const int&)>& work);
+
+	/// @brief Gets how many threads forRange may use, including the caller.
+	static int getThreadCount();
+};
+}
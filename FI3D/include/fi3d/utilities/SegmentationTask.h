@@ -0,0 +1,76 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		SegmentationTask.h
+* @class	fi3d::SegmentationTask
+* @brief	Segments a series of a Study without blocking the caller.
+*
+* ImageAlgorithms::segment runs in a thread owned by the task, so the GUI
+* keeps responding. The signals are emitted from that thread and reach
+* objects in other threads as queued connections. Deleting the task cancels
+* the segmentation and waits for its thread.
+*/
+
+#include <fi3d/utilities/ImageAlgorithms.h>
+
+#include <QAtomicInt>
+#include <QObject>
+#include <QSharedPointer>
+
+class QThread;
+
+namespace fi3d {
+class SegmentationTask : public QObject {
+
+	Q_OBJECT
+
+signals:
+	/// @brief Emitted as the segmentation advances, fraction is in [0, 1].
+	void progressed(const double& fraction);
+
+	/// @brief Emitted with the surface once done, null if it failed.
+	void finished(fi3d::ModelDataVPtr model);
+
+	/// @brief Emitted instead of finished when the task was cancelled.
+	void cancelled();
+
+private:
+	/// @brief The series to segment.
+	SeriesDataVPtr mSeries;
+
+	/// @brief The steps to apply.
+	SegmentationSettings mSettings;
+
+	/// @brief Set to stop the segmentation at its next step.
+	QAtomicInt mIsCancelled;
+
+	/// @brief The thread running the segmentation.
+	QThread* mThread;
+
+public:
+	/*!
+	 * @brief Constructor. The series is taken from the study now.
+	 *
+	 * @param study The study holding the series.
+	 * @param seriesIndex The index of the series in the study.
+	 * @param settings The steps to apply.
+	 */
+	SegmentationTask(StudyPtr study, const int& seriesIndex,
+		const SegmentationSettings& settings, QObject* parent = Q_NULLPTR);
+
+	/// @brief Destructor. Cancels the segmentation and waits for it.
+	~SegmentationTask();
+
+	/// @brief Starts segmenting, does nothing if already started.
+	void start();
+
+	/// @brief Asks the segmentation to stop, cancelled is emitted once it does.
+	void cancel();
+
+	/// @brief Whether the segmentation is running.
+	bool isRunning() const;
+};
+
+/// @brief Alias for a smart pointer of this class.
+using SegmentationTaskPtr = QSharedPointer<SegmentationTask>;
+}
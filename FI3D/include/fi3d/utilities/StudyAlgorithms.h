@@ -19,7 +19,12 @@ public:
 	/// @brief Destructor.
 	~StudyAlgorithms();
 
-	/// @brief Creates new study with series in spatial order.
+	/*!
+	* @brief Creates new study with series in spatial order.
+	*
+	* The series are ordered by the position of their patient matrices along
+	* the slice normal. The new series share the voxels of the input series.
+	*/
 	static StudyPtr fixStudySeriesOrder(StudyPtr inputStudy);
 
 	/*!
@@ -37,6 +42,10 @@ public:
 	* the patient matrices of the first 2 slices are used by calculating the
 	* spacing between the point (0, 0) after it is transformed by the 
 	* respective matrix.
+	*
+	* No voxels are copied. The new study holds a StudyView of the input 
+	* series, with the slices in spatial order and time as the phases. Each
+	* of its series is gathered from the view the first time it is used.
 	*/
 	static StudyPtr convertStudyToSpatialDomain(StudyPtr inputStudy);
 
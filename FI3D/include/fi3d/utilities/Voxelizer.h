@@ -0,0 +1,64 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		Voxelizer.h
+* @class	fi3d::Voxelizer
+* @brief	Static functions to convert ModelData into a binary ImageData.
+*
+* Every triangle of the model is rasterized into the voxels it overlaps, using
+* an exact triangle/box test, so the surface has no holes at any spacing.
+* Optionally, the inside of the surface is filled by casting a ray along x
+* through the center of every row of voxels and filling between the
+* crossings. Filling assumes a closed surface, open surfaces may leak.
+*
+* The volume is split into slabs of z slices which are voxelized in
+* parallel, each slab only visits the triangles that reach it.
+*/
+
+#include <fi3d/data/ImageData.h>
+
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
+
+namespace fi3d {
+class Voxelizer {
+private:
+	Voxelizer() {}
+
+public:
+	~Voxelizer() {}
+
+	/// @brief The value of voxels in the model.
+	static const unsigned char INSIDE_VALUE = 255;
+
+	/*!
+	* @brief Voxelizes the model.
+	*
+	* The image spans the bounds of the model, with the center of the first
+	* voxel half a spacing from the lower bounds. Voxels in the model are set
+	* to INSIDE_VALUE and every other voxel to 0.
+	*
+	* @param modelData The model to voxelize. Polygons and strips are used.
+	* @param spacing The voxel spacing in each direction.
+	* @param isFilled Whether the inside of the surface is filled.
+	* @return The voxelized model, empty if the model or spacing is invalid.
+	*/
+	static ImageDataVPtr voxelize(vtkSmartPointer<vtkPolyData> modelData,
+		const double spacing[3], const bool& isFilled);
+
+	/*!
+	* @brief Whether the triangle overlaps the axis aligned box.
+	*
+	* Uses the separating axis test from Akenine-Moller, "Fast 3D
+	* Triangle-Box Overlap Testing". Touching counts as overlapping.
+	*
+	* @param center The center of the box.
+	* @param halfSize Half of the box size in each direction.
+	* @param a The first vertex of the triangle.
+	* @param b The second vertex of the triangle.
+	* @param c The third vertex of the triangle.
+	*/
+	static bool overlapsBox(const double center[3], const double halfSize[3],
+		const double a[3], const double b[3], const double c[3]);
+};
+}
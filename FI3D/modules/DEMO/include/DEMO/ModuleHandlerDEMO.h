@@ -30,9 +30,6 @@ private:
 	/// @brief The epicardium and endocardium.
 	fi3d::AnimatedModelPtr mEndocardium, mEpicardium;
 
-	/// @breif Timer which handles the animation of the renderings. 
-	QSharedPointer<QTimer> mDataAnimationTimer;
-
 	/// @brief The speed, in milliseconds, of the animation.
 	int mAnimationSpeed;
 
@@ -25,7 +25,7 @@ ModuleHandlerDEMO::ModuleHandlerDEMO(const QString& moduleID)
 	: ModuleHandler(sModuleName, sModuleAcronym, moduleID),
 	mGUI(new ModuleWindowDEMO()),
 	mSlice(Q_NULLPTR), mEndocardium(Q_NULLPTR), mEpicardium(Q_NULLPTR),
-	mDataAnimationTimer(new QTimer(this)), mAnimationSpeed(45)
+	mAnimationSpeed(45)
 {
 	//Ensure the data folder is created
 	Filer::checkAndCreateDirectory(this->getModuleDataPath());
@@ -57,7 +57,8 @@ ModuleHandlerDEMO::ModuleHandlerDEMO(const QString& moduleID)
 	mSlice->setSliceIndex(5);
 	mSlice->setSeriesIndex(0);
 	mSlice->setInteractable(false);
-	mSlice->setExternalTimer(mDataAnimationTimer.data());
+	mSlice->setAnimationSpeed(mAnimationSpeed);
+	mSlice->setFrameCacheEnabled(true);
 
 	loaderMessage.setLabelText("Loading Surfaces...");
 	loaderMessage.setValue(60);
@@ -74,12 +75,14 @@ ModuleHandlerDEMO::ModuleHandlerDEMO(const QString& moduleID)
 	}
 
 	mEndocardium = scene->addAnimatedModel("Endocardium", endoData);
+	mEndocardium->setFrameCacheEnabled(true);
 	mEndocardium->setFrame(0);
 	mEndocardium->setColor(1, 0, 0);
 	mEndocardium->setOpacity(0.7);
 	mEndocardium->setInteractable(false);
 
 	mEpicardium = scene->addAnimatedModel("Epicardium", epiData);
+	mEpicardium->setFrameCacheEnabled(true);
 	mEpicardium->setFrame(0);
 	mEpicardium->setColor(1, 1, 0);
 	mEpicardium->setOpacity(0.4);
@@ -119,15 +122,9 @@ void ModuleHandlerDEMO::showModuleWindow() {
 }
 
 void ModuleHandlerDEMO::setAnimationEnable(const bool& isEnable) {
-	if (mDataAnimationTimer->isActive() == isEnable) {
-		return;
-	}
-
-	if (isEnable && !mDataAnimationTimer->isActive()) {
-		mDataAnimationTimer->start(mAnimationSpeed);
-	} else {
-		mDataAnimationTimer->stop();
-	}
+	// The surfaces follow the slice's series, so they change in the same
+	// AnimationClock tick.
+	mSlice->setAnimate(isEnable);
 }
 
 void ModuleHandlerDEMO::updateConnectionNumbers() {
@@ -27,6 +27,7 @@ extern const QString MI_SUBSCRIBE_TO_MODULE;
 extern const QString MI_SETTINGS;
 extern const QString MI_SYNCHRONIZE;
 extern const QString MI_REFRESH_SCENE;
+extern const QString MI_POSE_DATAGRAMS;
 /// @}
 
 /*!
@@ -37,6 +38,7 @@ extern const QString MI_REFRESH_SCENE;
 extern const QString CK_IP;
 extern const QString CK_PORT;
 extern const QString CK_PASSWORD;
+extern const QString CK_POSE_DATAGRAMS;
 /// @}
 
 }
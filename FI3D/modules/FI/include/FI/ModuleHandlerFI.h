@@ -18,6 +18,8 @@
 #include <FI/ModuleMenuDialog.h>
 #include <FI/ServerConnection.h>
 
+#include <QUdpSocket>
+
 namespace fi {
 class ModuleHandlerFI : public fi3d::ModuleHandler {
 
@@ -43,6 +45,18 @@ private:
 	/// @brief Whether the module is being synchronized.
 	bool mIsSynchronized;
 
+	/// @brief The epoch of the scene log of the subscribed module.
+	QString mSceneEpoch;
+
+	/// @brief The last scene version received from the subscribed module.
+	qint64 mSceneVersion;
+
+	/// @brief Receives the pose datagrams, when enabled.
+	QUdpSocket mPoseSocket;
+
+	/// @brief The port the server sends pose datagrams from, 0 if unknown.
+	quint16 mServerPosePort;
+
 public:
 	/// @brief Constructor.
 	ModuleHandlerFI(const QString& moduleID);
@@ -93,6 +107,9 @@ private slots:
 	/// @brief Handles a module response.
 	void onModuleMessage(fi3d::MessagePtr message);
 
+	/// @brief Applies the pose datagrams that arrived.
+	void onPoseDatagrams();
+
 	/*!
 	* @name Module interaction response handlers.
 	*/
@@ -17,6 +17,15 @@ private:
 	/// @brief Whether the data object's data is already cached.
 	bool mIsCached;
 
+	/// @brief The version of the data object the cached data belongs to.
+	qint64 mDataVersion;
+
+	/// @brief The window/level the cached slices were encoded with.
+	double mWindow, mLevel;
+
+	/// @brief Whether the window/level is known.
+	bool mHasWindowLevel;
+
 public:
 	/// @brief Constructor.
 	CachedData();
@@ -30,6 +39,16 @@ public:
 	/// @brief Constructor.
 	QString getFI3DDataID() const;
 
+	/// @brief Sets the data version of the cached data.
+	void setFI3DDataVersion(const qint64& version);
+
+	/// @brief Gets the data version of the cached data.
+	qint64 getFI3DDataVersion() const;
+
+	/// @brief Sets the window/level the cached slices were encoded with.
+	/// @return Whether a different window/level was known before.
+	bool setFI3DWindowLevel(const double& window, const double& level);
+
 	/// @brief Set cached or not.
 	void setCached(const bool& isCached);
 
@@ -4,43 +4,36 @@
 * @file		CachedImage.h
 * @class	fi::CachedImage
 * @brief	An ImageData that is being cached.
+*
+* Only the slices received are kept in memory, see CachedVolume.
 */
 
 #include <fi3d/data/ImageData.h>
-#include <FI/data/CachedData.h>
+#include <FI/data/CachedVolume.h>
 
 #include <fi3d/rendering/visuals/3D/slices/ESliceOrientation.h>
 
-#include <QVector>
-
 namespace fi {
 class DataCache;
-class CachedImage : public fi3d::ImageData, public CachedData {
+class CachedImage : public fi3d::ImageData, public CachedVolume {
 
 	Q_OBJECT
 	friend class DataCache;
 
-private:
-	/*!
-	*	@name Slice Status
-	*	@brief Holds status of each slice (cached or not).
-	*/
-	/// @{
-	QVector<bool> mTransverseSlices;
-	QVector<bool> mSagittalSlices;
-	QVector<bool> mCoronalSlices;
-	/// @}
-
 public:
 	/// @brief VTK object dependencies.
 	static CachedImage* New();
 	vtkTypeMacro(CachedImage, fi3d::ImageData)
 
-	/// @brief Deletes the underlying 3D array.
-	virtual void release() override;
-
-	/// @brief Checks whether the slice is cached.
-	bool isSliceCached(const int& index, const fi3d::ESliceOrientation& orientation);
+	/*!
+	*	@name Partial ImageData implementations.
+	*	@brief See ImageData for more information.
+	*/
+	/// @{
+	virtual bool isPartial() const override;
+	virtual void copySlice(const int& sliceIndex, 
+		const fi3d::ESliceOrientation& orientation, vtkImageData* slice) override;
+	/// @}
 
 protected:
 	/// @brief Constructor.
@@ -57,4 +50,4 @@ private:
 /// @brief Alias for a smart pointer of this class.
 using CachedImageVPtr = vtkSmartPointer<CachedImage>;
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,52 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		CachedSeries.h
+* @class	fi::CachedSeries
+* @brief	A SeriesData of a CachedStudy.
+*
+* Like CachedImage, only the slices received are kept in memory, see
+* CachedVolume.
+*/
+
+#include <fi3d/data/SeriesData.h>
+#include <FI/data/CachedVolume.h>
+
+#include <fi3d/rendering/visuals/3D/slices/ESliceOrientation.h>
+
+namespace fi {
+class CachedSeries : public fi3d::SeriesData, public CachedVolume {
+
+	Q_OBJECT
+
+public:
+	/// @brief VTK object dependencies.
+	static CachedSeries* New();
+	vtkTypeMacro(CachedSeries, fi3d::SeriesData)
+
+	/*!
+	*	@name Partial ImageData implementations.
+	*	@brief See ImageData for more information.
+	*/
+	/// @{
+	virtual bool isPartial() const override;
+	virtual void copySlice(const int& sliceIndex,
+		const fi3d::ESliceOrientation& orientation, vtkImageData* slice) override;
+	/// @}
+
+protected:
+	/// @brief Constructor.
+	CachedSeries();
+
+	/// @brief Destructor.
+	~CachedSeries() = default;
+
+private:
+	CachedSeries(const CachedSeries&) = delete;
+	void operator=(const CachedSeries&) = delete;
+};
+
+/// @brief Alias for a smart pointer of this class.
+using CachedSeriesVPtr = vtkSmartPointer<CachedSeries>;
+
+}
@@ -4,10 +4,13 @@
 * @file		CachedModel.h
 * @class	fi::CachedStudy
 * @brief	A Study that is being cached.
+*
+* Its series are CachedSeries, which only keep the slices received.
 */
 
 #include <fi3d/data/Study.h>
 #include <FI/data/CachedData.h>
+#include <FI/data/CachedSeries.h>
 
 #include <fi3d/rendering/visuals/3D/slices/ESliceOrientation.h>
 
@@ -18,17 +21,6 @@ class CachedStudy : public fi3d::Study, public CachedData {
 	Q_OBJECT
 	friend class DataCache;
 
-private:
-	/// @brief Holds cache state of each slice in a series.
-	typedef struct CacheSeriesState {
-		QVector<bool> TransverseSlices;
-		QVector<bool> SagittalSlices;
-		QVector<bool> CoronalSlices;
-	} CacheSeriesState;
-
-	/// @brief State of the cached slices.
-	QVector<CacheSeriesState> mSeriesStates;
-
 public:
 	/// @brief Constructor.
 	CachedStudy();
@@ -41,6 +33,12 @@ public:
 
 	/// @brief Checks whether the slice is cached.
 	bool isSliceCached(const int& sliceIndex, const fi3d::ESliceOrientation& orientation, const int& seriesIndex);
+
+	/// @brief Gets the series, null if out of range.
+	CachedSeriesVPtr getCachedSeries(const int& seriesIndex);
+
+	/// @brief Gets the bytes used by the cached slices of all series.
+	qint64 getCachedBytes();
 };
 
 /// @brief Alias for a smart pointer of this class.
@@ -0,0 +1,71 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		CachedVolume.h
+* @class	fi::CachedVolume
+* @brief	The cached slices of a CachedImage or CachedSeries.
+*
+* Only the slices received are kept in memory, in a SparseVolume. The image
+* it belongs to has the dimensions of the whole volume but no scalars, so it
+* is a partial ImageData and visuals copy the slice they display with
+* readCachedSlice.
+*
+* Slices arrive as normalized floats and are stored as bytes, the same
+* precision as the unsigned char scalars the cache always allocated, so
+* what the FI displays does not change.
+*/
+
+#include <FI/data/CachedData.h>
+#include <FI/data/SparseVolume.h>
+
+#include <fi3d/data/ImageData.h>
+#include <fi3d/rendering/visuals/3D/slices/ESliceOrientation.h>
+
+namespace fi {
+class CachedVolume : public CachedData {
+private:
+	/// @brief The image the slices belong to.
+	fi3d::ImageData* mImage;
+
+	/// @brief The voxels of the received slices.
+	SparseVolume mVolume;
+
+public:
+	/// @brief Constructor, the image is the object inheriting this class.
+	CachedVolume(fi3d::ImageData* image);
+
+	/// @brief Destructor.
+	~CachedVolume();
+
+	/// @brief Checks whether the slice is cached.
+	bool isSliceCached(const int& index, const fi3d::ESliceOrientation& orientation) const;
+
+	/// @brief Gets the bytes used by the cached slices.
+	qint64 getCachedBytes() const;
+
+	/// @brief Sets the dimensions of the whole image, releasing the slices.
+	void setCacheDimensions(const int& dimX, const int& dimY, const int& dimZ);
+
+	/// @brief Marks every slice as not cached, used when the data version
+	/// changes. The old slices are shown until the new ones arrive.
+	void invalidateSlices();
+
+	/// @brief Marks the slices that cross the extent as not cached, used
+	/// when the data version changes only in that extent.
+	void invalidateSlices(const int extent[6]);
+
+	/// @brief Caches a slice of normalized values, see SparseVolume.
+	bool cacheSlice(const float* values, const int& valueCount,
+		const int& sliceIndex, const fi3d::ESliceOrientation& orientation);
+
+	/// @brief Releases the cached slices.
+	virtual void release() override;
+
+protected:
+	/// @brief Reads a cached slice into a slice image prepared with
+	/// ImageData::prepareSliceImage.
+	void readCachedSlice(const int& sliceIndex,
+		const fi3d::ESliceOrientation& orientation, vtkImageData* slice) const;
+};
+
+}
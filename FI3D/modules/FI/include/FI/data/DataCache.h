@@ -21,6 +21,7 @@
 
 #include <QHash>
 #include <QJsonObject>
+#include <QVector>
 
 namespace fi {
 
@@ -90,6 +91,15 @@ private:
 	/// @brief Active Study requests.
 	QHash<StudySliceRequestKey, StudyPromisePtr> mStudyRequests;
 
+	/// @brief The ID sent with each active Study request.
+	QHash<StudySliceRequestKey, int> mStudyRequestIDs;
+
+	/// @brief The latest Study request of each visual, while active.
+	QHash<QString, StudySliceRequestKey> mVisualStudyRequests;
+
+	/// @brief The ID given to the next data request.
+	int mNextRequestID;
+
 public:
 	/// @brief Constructor.
 	DataCache();
@@ -103,9 +113,46 @@ public:
 	/// @brief Requests a Model.
 	ModelPromisePtr getModelData(const QString& dataID);
 
-	/// @brief Requests a Study slice.
+	/*!
+	*	@brief Requests a Study slice.
+	*
+	*	When a visual is given, only its latest request is kept. Its previous
+	*	request, if still active and not needed by another visual, is
+	*	cancelled and its promise is never resolved.
+	*/
 	StudyPromisePtr getStudy(const QString& dataID, const int& index, 
-		const fi3d::ESliceOrientation& orientation, const int& series);
+		const fi3d::ESliceOrientation& orientation, const int& series,
+		const QString& visualID = "");
+
+private:
+	/// @brief Cancels the active request of the visual, unless still needed.
+	void cancelStudyRequest(const QString& visualID);
+
+	/*!
+	*	@brief Updates the known version of a data object.
+	*
+	*	Visual updates carry the version of their data. When it is newer than
+	*	the cached copy, the cached slices or model are marked as not cached
+	*	so the next request fetches them again. Stale slices are still shown
+	*	until the new ones arrive.
+	*
+	*	@param seriesIndex The series, for a Study.
+	*	@param changedExtent The slices written since changedSinceVersion as
+	*	[xMin, xMax, yMin, yMax, zMin, zMax]. If empty, or the cached copy is
+	*	older than changedSinceVersion, every slice is marked as not cached.
+	*	@param changedSinceVersion The version the changedExtent starts from.
+	*/
+	void setDataVersion(const QString& dataID, const qint64& version, const int& seriesIndex = -1,
+		const QVector<int>& changedExtent = QVector<int>(), const qint64& changedSinceVersion = -1);
+
+	/*!
+	*	@brief Sets the window/level the slices of a data object are encoded
+	*	with. It is not part of the data version, so when it changes every
+	*	slice is marked as not cached.
+	*	@param seriesIndex The series of a Study, ignored otherwise.
+	*/
+	void setWindowLevel(const QString& dataID, const double& window, const double& level,
+		const int& seriesIndex = -1);
 
 public slots:
 	/// @brief Handles a model data response.
@@ -0,0 +1,105 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		SparseVolume.h
+* @class	fi::SparseVolume
+* @brief	A 3D array of bytes that only stores the bricks that were written.
+*
+* The volume is split into cubic bricks of BRICK_SIZE voxels per side. A brick
+* is allocated when a slice that crosses it is written, so memory grows with
+* the slices received and not with the dimensions of the volume. Slices of
+* different orientations that cross the same brick share its storage, and a
+* slice can be read back in any orientation.
+*/
+
+#include <fi3d/rendering/visuals/3D/slices/ESliceOrientation.h>
+
+#include <QBitArray>
+#include <QByteArray>
+#include <QHash>
+
+namespace fi {
+class SparseVolume {
+public:
+	/// @brief Voxels per side of a brick.
+	static const int BRICK_SIZE = 8;
+
+private:
+	/// @brief The dimensions of the whole volume.
+	int mDimensions[3];
+
+	/// @brief The number of bricks along each axis.
+	int mBrickCounts[3];
+
+	/// @brief The allocated bricks, by their index.
+	QHash<int, QByteArray> mBricks;
+
+	/// @brief Which slices were written, by the axis normal to the slice.
+	QBitArray mWrittenSlices[3];
+
+public:
+	/// @brief Constructor.
+	SparseVolume();
+
+	/// @brief Destructor.
+	~SparseVolume();
+
+	/// @brief Sets the dimensions, which releases all the bricks.
+	void setDimensions(const int& dimX, const int& dimY, const int& dimZ);
+
+	/// @brief Gets the dimensions of the whole volume.
+	void getDimensions(int dimensions[3]) const;
+
+	/*!
+	 * @brief Writes a slice of normalized values [0, 1] as bytes [0, 255].
+	 *
+	 * The values are laid out like in a data message, rows next to each
+	 * other: XY is [y][x], YZ is [z][y], and XZ is [z][x].
+	 *
+	 * @return Whether the slice fits the volume and was written.
+	 */
+	bool writeSlice(const float* values, const int& valueCount,
+		const int& sliceIndex, const fi3d::ESliceOrientation& orientation);
+
+	/// @brief Reads a slice, laid out like in writeSlice. Voxels that were
+	/// not written are 0.
+	void readSlice(const int& sliceIndex, const fi3d::ESliceOrientation& orientation,
+		unsigned char* values) const;
+
+	/// @brief Checks whether the slice was written.
+	bool isSliceWritten(const int& sliceIndex, const fi3d::ESliceOrientation& orientation) const;
+
+	/// @brief Gets the bytes used by the allocated bricks.
+	qint64 getAllocatedBytes() const;
+
+	/// @brief Releases all the bricks.
+	void release();
+
+	/// @brief Marks every slice as not written but keeps the bricks, so the
+	/// old voxels can be read until new slices overwrite them.
+	void invalidate();
+
+	/// @brief Marks the slices that cross the extent as not written, in
+	/// every orientation. The extent is [xMin, xMax, yMin, yMax, zMin, zMax].
+	void invalidate(const int extent[6]);
+
+private:
+	/*!
+	 * @brief Gets the axes of a slice.
+	 *
+	 * @param normal The axis normal to the slice.
+	 * @param u The in-plane axis that changes fastest.
+	 * @param v The in-plane axis that changes slowest.
+	 * @return False when the orientation is unknown.
+	 */
+	static bool getSliceAxes(const fi3d::ESliceOrientation& orientation,
+		int& normal, int& u, int& v);
+
+	/// @brief Gets the index of the brick containing the voxel.
+	int getBrickIndex(const int voxel[3]) const;
+
+	/// @brief Gets the offset of the voxel within its brick.
+	static int getVoxelOffset(const int voxel[3]);
+};
+
+}
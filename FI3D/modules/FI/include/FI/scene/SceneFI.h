@@ -8,8 +8,11 @@
 
 #include <fi3d/rendering/scenes/InteractiveScene.h>
 
+#include <fi3d/modules/PoseRecord.h>
+
 #include <FI/data/DataCache.h>
 
+#include <QHash>
 #include <QJsonObject>
 
 namespace fi {
@@ -28,6 +31,18 @@ private:
 	/// @brief The object managing the cached data.
 	DataCachePtr mCache;
 
+	/// @brief The visual ID of each handle announced by the module.
+	QHash<int, QString> mHandleVisualIDs;
+
+	/// @brief The assembly and part ID of each part handle, as "assembly/part".
+	QHash<int, QString> mHandlePartIDs;
+
+	/// @brief The data ID of each data handle announced by the module.
+	QHash<int, QString> mHandleDataIDs;
+
+	/// @brief The sequence of the last pose applied to each handle.
+	QHash<int, quint32> mPoseSequences;
+
 public:
 	/// @brief Constructor.
 	SceneFI(DataCachePtr cache, QVTKOpenGLStereoWidget* widget, const QString& id = "");
@@ -39,7 +54,36 @@ public slots:
 	/// @brief Process a module response.
 	void handleModuleResponse(const QJsonArray& moduleInfo);
 
+	/*!
+	 * @brief Removes the visuals a snapshot of the scene does not have, and
+	 * those it adds again, e.g., when the module could not resync.
+	 */
+	void prepareSnapshot(const QJsonArray& visualsInfo);
+
+	/// @brief Applies the poses of the visuals, older poses are dropped.
+	void handlePoseRecords(const fi3d::PoseRecord* records, const int& count);
+
 private:
+	/*!
+	 * @brief Learns the handles announced by the visual info and by the
+	 * parts of an assembly, at any depth.
+	 * 
+	 * The info itself is left as received, the handlers find the visual and
+	 * its data through getVisualOf and getDataIDOf.
+	 * 
+	 * @param assemblyID The assembly the parts belong to, empty if none.
+	 */
+	void learnHandles(const QJsonObject& visualInfo, const QString& assemblyID = "");
+
+	/// @brief Gets the visual of the info by its handle, or by its ID.
+	fi3d::Visual3DPtr getVisualOf(const QJsonObject& visualInfo);
+
+	/// @brief Gets the ID of the visual of the info, from its handle if left out.
+	QString getVisualIDOf(const QJsonObject& visualInfo) const;
+
+	/// @brief Gets the data ID of the info, from its data handle if left out.
+	QString getDataIDOf(const QJsonObject& visualInfo) const;
+
 	/*!
 	* @name Server request/response message keys.
 	*/
@@ -11,7 +11,9 @@ const QString fi::MI_SUBSCRIBE_TO_MODULE = "FI Subscribe To Module";
 const QString fi::MI_SETTINGS = "FI Settings";
 const QString fi::MI_SYNCHRONIZE = "FI Synchronize";
 const QString fi::MI_REFRESH_SCENE = "FI Refresh Scene";
+const QString fi::MI_POSE_DATAGRAMS = "FI Pose Datagrams";
 
 const QString fi::CK_IP = "IP";
 const QString fi::CK_PORT = "Port";
-const QString fi::CK_PASSWORD = "Password";
\ No newline at end of file
+const QString fi::CK_PASSWORD = "Password";
+const QString fi::CK_POSE_DATAGRAMS = "PoseDatagrams";
\ No newline at end of file
@@ -27,7 +27,11 @@ ModuleHandlerFI::ModuleHandlerFI(const QString& moduleID)
 	mScene(Q_NULLPTR),
 	mConnection(new ServerConnection()),
 	mSubscribedModuleID(""),
-	mIsSynchronized(true)
+	mIsSynchronized(true),
+	mSceneEpoch(""),
+	mSceneVersion(0),
+	mPoseSocket(),
+	mServerPosePort(0)
 {
 	//Ensure the data folder is created
 	Filer::checkAndCreateDirectory(this->getModuleDataPath());
@@ -59,6 +63,9 @@ ModuleHandlerFI::ModuleHandlerFI(const QString& moduleID)
 	QObject::connect(
 		mConnection.data(), &ServerConnection::newDataResponse,
 		cache.data(), &DataCache::handleDataMessage);
+	QObject::connect(
+		&mPoseSocket, &QUdpSocket::readyRead,
+		this, &ModuleHandlerFI::onPoseDatagrams);
 
 	// Connect connections to make requests.
 	// TODO: Connect scene requests
@@ -171,6 +178,10 @@ void ModuleHandlerFI::setUpInteractions() {
 	QObject::connect(
 		refreshScene.data(), &ValuelessInteraction::triggered,
 		this, &ModuleHandlerFI::onRefreshScene);
+
+	// Whether transforms are received as datagrams, applies when subscribing.
+	BooleanInteractionPtr poseDatagrams(new BooleanInteraction(MI_POSE_DATAGRAMS, false));
+	this->addModuleInteraction(poseDatagrams);
 }
 
 void ModuleHandlerFI::closeModule() {
@@ -213,12 +224,40 @@ void ModuleHandlerFI::stopModule(const QString& moduleID) {
 }
 
 void ModuleHandlerFI::subscribeToModule(const QString& moduleID) {
+	if (moduleID != mSubscribedModuleID) {
+		mSceneEpoch = "";
+	}
 	mSubscribedModuleID = moduleID;
 
 	QJsonObject request{
 		{MODULE_ID, moduleID},
-		{REQUEST_ID, EModuleRequest::SUBSCRIBE_TO_MODULE}
+		{REQUEST_ID, EModuleRequest::SUBSCRIBE_TO_MODULE},
+		{USE_HANDLES, true},
+		{USE_POSE_STREAM, true}
 	};
+
+	// Coming back to the module only needs what changed since.
+	if (!mSceneEpoch.isEmpty()) {
+		request.insert(SCENE_EPOCH, mSceneEpoch);
+		request.insert(SCENE_VERSION, mSceneVersion);
+	}
+
+	mServerPosePort = 0;
+	if (this->getModuleInteractionValue(MI_POSE_DATAGRAMS).toBool()) {
+		// Only the interface the server is reached through receives poses.
+		QHostAddress localAddress = mConnection->localAddress();
+		if (mPoseSocket.state() == QAbstractSocket::BoundState && mPoseSocket.localAddress() != localAddress) {
+			mPoseSocket.close();
+		}
+		if (mPoseSocket.state() != QAbstractSocket::BoundState &&
+			!mPoseSocket.bind(localAddress, 0))
+		{
+			qWarning() << "Failed to bind pose socket because:" << mPoseSocket.errorString();
+		}
+		if (mPoseSocket.state() == QAbstractSocket::BoundState) {
+			request.insert(POSE_PORT, mPoseSocket.localPort());
+		}
+	}
 	mConnection->sendModuleRequest(request);
 
 	if (!mGUI->isVisible()) {
@@ -245,6 +284,10 @@ void ModuleHandlerFI::onRefreshScene() {
 		{MODULE_ID, mSubscribedModuleID},
 		{REQUEST_ID, EModuleRequest::GET_SCENE}
 	};
+	if (!mSceneEpoch.isEmpty()) {
+		request.insert(SCENE_EPOCH, mSceneEpoch);
+		request.insert(SCENE_VERSION, mSceneVersion);
+	}
 
 	mConnection->sendModuleRequest(request);
 }
@@ -275,10 +318,31 @@ void ModuleHandlerFI::onApplicationMessage(MessagePtr message) {
 
 void ModuleHandlerFI::onModuleMessage(MessagePtr message) {
 	QJsonObject moduleInfo = message->getInfo()->value(MODULE_INFO).toObject();
+	if (moduleInfo.value(MODULE_ID).toString() == mSubscribedModuleID) {
+		mSceneEpoch = moduleInfo.value(SCENE_EPOCH).toString(mSceneEpoch);
+		mSceneVersion = moduleInfo.value(SCENE_VERSION).toInteger(mSceneVersion);
+		if (moduleInfo.contains(POSE_PORT)) {
+			mServerPosePort = (quint16)moduleInfo.value(POSE_PORT).toInt(0);
+		}
+	}
 
 	QJsonArray visualsInfo = moduleInfo.value(VISUALS_INFO).toArray();
+	if (moduleInfo.value(SCENE_SNAPSHOT).toBool(false)) {
+		mScene->prepareSnapshot(visualsInfo);
+	}
 	mScene->handleModuleResponse(visualsInfo);
 
+	int poseCount = moduleInfo.value(POSE_RECORD_COUNT).toInt(0);
+	if (poseCount > 0 && message->hasPayload()) {
+		QSharedPointer<QByteArray> payload = message->getPayload();
+		if (payload->size() == poseCount * (int)sizeof(PoseRecord)) {
+			QVector<PoseRecord> records = readPoseRecords(payload->constData(), poseCount);
+			mScene->handlePoseRecords(records.constData(), records.count());
+		} else {
+			qWarning() << "Failed to apply" << poseCount << "poses because the payload has" << payload->size() << "bytes";
+		}
+	}
+
 	QJsonArray interactionsInfo = moduleInfo.value(MODULE_INTERACTIONS).toArray();
 	qDebug() << "Handling" << interactionsInfo.count() << "module interaction updates";
 
@@ -302,6 +366,38 @@ void ModuleHandlerFI::onModuleMessage(MessagePtr message) {
 	}
 }
 
+void ModuleHandlerFI::onPoseDatagrams() {
+	while (mPoseSocket.hasPendingDatagrams()) {
+		QByteArray datagram(mPoseSocket.pendingDatagramSize(), Qt::Uninitialized);
+		QHostAddress sender;
+		quint16 senderPort = 0;
+		mPoseSocket.readDatagram(datagram.data(), datagram.size(), &sender, &senderPort);
+
+		// Anyone can send to the port, only the server's poses are applied.
+		if (mServerPosePort == 0 || senderPort != mServerPosePort ||
+			!sender.isEqual(mConnection->peerAddress(), QHostAddress::TolerantConversion))
+		{
+			qWarning() << "Dropped a pose datagram from" << sender.toString() << senderPort << "which is not the server.";
+			continue;
+		}
+		if (datagram.size() < (int)sizeof(PoseDatagramHeader)) {
+			continue;
+		}
+
+		PoseDatagramHeader header = readPoseDatagramHeader(datagram.constData());
+		if (header.Magic != POSE_DATAGRAM_MAGIC || header.Version != POSE_RECORD_VERSION ||
+			datagram.size() != (int)(sizeof(PoseDatagramHeader) + header.RecordCount * sizeof(PoseRecord)))
+		{
+			qWarning() << "Dropped a pose datagram that is not valid.";
+			continue;
+		}
+
+		QVector<PoseRecord> records = readPoseRecords(
+			datagram.constData() + sizeof(PoseDatagramHeader), header.RecordCount);
+		mScene->handlePoseRecords(records.constData(), records.count());
+	}
+}
+
 void ModuleHandlerFI::handleAddModuleInteraction(const QJsonObject& interactionJson) {
 	QString id = interactionJson.value(ID).toString();
 	EModuleInteraction interactionType(interactionJson.value(TYPE).toInt());
@@ -549,6 +645,7 @@ void ModuleHandlerFI::applyConfig() {
 	this->setModuleInteractionValue(MI_IP, config.value(CK_IP).toString("localhost"));
 	this->setModuleInteractionValue(MI_PORT, config.value(CK_PORT).toInt(9000));
 	this->setModuleInteractionValue(MI_PASSWORD, config.value(CK_PASSWORD).toString("admin"));
+	this->setModuleInteractionValue(MI_POSE_DATAGRAMS, config.value(CK_POSE_DATAGRAMS).toBool(false));
 	this->setModuleInteractionValue(MI_CONNECT, true);
 }
 
@@ -558,6 +655,7 @@ void ModuleHandlerFI::makeConfig() {
 	config.insert(CK_IP, this->getModuleInteractionValue(MI_IP));
 	config.insert(CK_PORT, this->getModuleInteractionValue(MI_PORT));
 	config.insert(CK_PASSWORD, this->getModuleInteractionValue(MI_PASSWORD));
+	config.insert(CK_POSE_DATAGRAMS, this->getModuleInteractionValue(MI_POSE_DATAGRAMS));
 
 	this->saveConfig(config);
 }
\ No newline at end of file
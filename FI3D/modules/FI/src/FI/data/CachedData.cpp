@@ -4,7 +4,11 @@ using namespace fi;
 
 CachedData::CachedData() 
 	: mDataID(""),
-	mIsCached(false)
+	mIsCached(false),
+	mDataVersion(0),
+	mWindow(0),
+	mLevel(0),
+	mHasWindowLevel(false)
 {}
 
 CachedData::~CachedData() {}
@@ -17,6 +21,22 @@ QString CachedData::getFI3DDataID() const {
 	return mDataID;
 }
 
+void CachedData::setFI3DDataVersion(const qint64& version) {
+	mDataVersion = version;
+}
+
+qint64 CachedData::getFI3DDataVersion() const {
+	return mDataVersion;
+}
+
+bool CachedData::setFI3DWindowLevel(const double& window, const double& level) {
+	bool isChanged = mHasWindowLevel && (window != mWindow || level != mLevel);
+	mWindow = window;
+	mLevel = level;
+	mHasWindowLevel = true;
+	return isChanged;
+}
+
 void CachedData::setCached(const bool& isCached) {
 	mIsCached = isCached;
 }
@@ -9,26 +9,20 @@ using namespace fi3d;
 
 vtkStandardNewMacro(CachedImage)
 
-CachedImage::CachedImage() 
+CachedImage::CachedImage()
 	: ImageData(),
-	mTransverseSlices(),
-	mSagittalSlices(),
-	mCoronalSlices()
+	CachedVolume(this)
 {}
 
-void CachedImage::release() {
-	// TODO: Release the 3D data array.
+bool CachedImage::isPartial() const {
+	return true;
 }
 
-bool CachedImage::isSliceCached(const int& index, const ESliceOrientation& orientation)  {
-	switch (orientation.toInt()) {
-		case ESliceOrientation::XY:
-			return mTransverseSlices.value(index, false);
-		case ESliceOrientation::YZ:
-			return mSagittalSlices.value(index, false);
-		case ESliceOrientation::XZ:
-			return mCoronalSlices.value(index, false);
-		default:
-			return false;
+void CachedImage::copySlice(const int& sliceIndex,
+	const ESliceOrientation& orientation, vtkImageData* slice)
+{
+	if (!this->prepareSliceImage(sliceIndex, orientation, slice)) {
+		return;
 	}
-}
\ No newline at end of file
+	this->readCachedSlice(sliceIndex, orientation, slice);
+}
@@ -0,0 +1,28 @@
+#include <FI/data/CachedSeries.h>
+
+#include <fi3d/logger/Logger.h>
+
+#include <vtkObjectFactory.h>
+
+using namespace fi;
+using namespace fi3d;
+
+vtkStandardNewMacro(CachedSeries)
+
+CachedSeries::CachedSeries()
+	: SeriesData(),
+	CachedVolume(this)
+{}
+
+bool CachedSeries::isPartial() const {
+	return true;
+}
+
+void CachedSeries::copySlice(const int& sliceIndex,
+	const ESliceOrientation& orientation, vtkImageData* slice)
+{
+	if (!this->prepareSliceImage(sliceIndex, orientation, slice)) {
+		return;
+	}
+	this->readCachedSlice(sliceIndex, orientation, slice);
+}
@@ -8,25 +8,38 @@ CachedStudy::CachedStudy() {}
 CachedStudy::~CachedStudy() {}
 
 void CachedStudy::release() {
-	// TODO: Release the underlying Series.
+	for (int i = 0; i < this->getSeriesCount(); i++) {
+		CachedSeriesVPtr series = this->getCachedSeries(i);
+		if (series.Get() != Q_NULLPTR) {
+			series->release();
+		}
+	}
 }
 
 bool CachedStudy::isSliceCached(const int& sliceIndex, const ESliceOrientation& orientation, const int& seriesIndex) {
-	if (seriesIndex < 0 || seriesIndex >= mSeriesStates.count()) {
+	CachedSeriesVPtr series = this->getCachedSeries(seriesIndex);
+	if (series.Get() == Q_NULLPTR) {
 		return false;
 	}
 
-	CacheSeriesState series = mSeriesStates[seriesIndex];
-	switch (orientation.toInt()) {
-		case ESliceOrientation::XY:
-			return series.TransverseSlices.value(sliceIndex, false);
-		case ESliceOrientation::YZ:
-			return series.SagittalSlices.value(sliceIndex, false);
-		case ESliceOrientation::XZ:
-			return series.CoronalSlices.value(sliceIndex, false);
-		default:
-			return false;
+	return series->isSliceCached(sliceIndex, orientation);
+}
+
+CachedSeriesVPtr CachedStudy::getCachedSeries(const int& seriesIndex) {
+	if (!this->isSeriesIndexInRange(seriesIndex)) {
+		return Q_NULLPTR;
 	}
 
-	return false;
+	return CachedSeries::SafeDownCast(this->getSeries(seriesIndex));
+}
+
+qint64 CachedStudy::getCachedBytes() {
+	qint64 bytes = 0;
+	for (int i = 0; i < this->getSeriesCount(); i++) {
+		CachedSeriesVPtr series = this->getCachedSeries(i);
+		if (series.Get() != Q_NULLPTR) {
+			bytes += series->getCachedBytes();
+		}
+	}
+	return bytes;
 }
@@ -0,0 +1,59 @@
+#include <FI/data/CachedVolume.h>
+
+#include <fi3d/logger/Logger.h>
+
+using namespace fi;
+using namespace fi3d;
+
+CachedVolume::CachedVolume(ImageData* image)
+	: CachedData(),
+	mImage(image),
+	mVolume()
+{}
+
+CachedVolume::~CachedVolume() {}
+
+bool CachedVolume::isSliceCached(const int& index, const ESliceOrientation& orientation) const {
+	return mVolume.isSliceWritten(index, orientation);
+}
+
+qint64 CachedVolume::getCachedBytes() const {
+	return mVolume.getAllocatedBytes();
+}
+
+void CachedVolume::setCacheDimensions(const int& dimX, const int& dimY, const int& dimZ) {
+	// Only the geometry is set, the scalars stay in the sparse volume.
+	mImage->SetDimensions(dimX, dimY, dimZ);
+	mVolume.setDimensions(dimX, dimY, dimZ);
+}
+
+void CachedVolume::invalidateSlices() {
+	mVolume.invalidate();
+}
+
+void CachedVolume::invalidateSlices(const int extent[6]) {
+	mVolume.invalidate(extent);
+}
+
+bool CachedVolume::cacheSlice(const float* values, const int& valueCount,
+	const int& sliceIndex, const ESliceOrientation& orientation)
+{
+	if (!mVolume.writeSlice(values, valueCount, sliceIndex, orientation)) {
+		return false;
+	}
+	mImage->Modified();
+	mImage->dataUpdated();
+	return true;
+}
+
+void CachedVolume::release() {
+	mVolume.release();
+	mImage->dataUpdated();
+}
+
+void CachedVolume::readCachedSlice(const int& sliceIndex,
+	const ESliceOrientation& orientation, vtkImageData* slice) const
+{
+	slice->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+	mVolume.readSlice(sliceIndex, orientation, (unsigned char*)slice->GetScalarPointer());
+}
@@ -12,91 +12,12 @@
 using namespace fi;
 using namespace fi3d;
 
-/// Helper function that parses JSON data into the corresponding slice.
-inline void parseImage(QSharedPointer<QByteArray> bytes, ImageDataVPtr image, 
-	const int& sliceIndex, const ESliceOrientation orientation) 
-{
-	qDebug() << "Enter";
-	if (image.Get() == Q_NULLPTR) {
-		qCritical() << "Failed to cache slice into given image because image is null.";
-		qDebug() << "Exit - Null image";
-		return;
-	}
-
-	float* values = (float*)bytes->data();
-	int valueCount = bytes->count() / sizeof(float);
-
-	int* dims = image->GetDimensions();
-	if (orientation == ESliceOrientation::XY) {
-		if (sliceIndex < 0 || sliceIndex >= dims[2]) {
-			qWarning() << "Failed to cache slice with orientation" << orientation.getName() << 
-				"because the given slice index is out of range.";
-			qDebug() << "Exit - Index out of range";
-			return;
-		}
-
-		if (valueCount != dims[0] * dims[1]) {
-			qWarning() << "Failed to cache slice with orientation" << orientation.getName() <<
-				"because the image dimensions do not match the given data.";
-			qDebug() << "Exit - Dimensions and data missmatch";
-			return;
-		}
-
-		for (int y = 0; y < dims[1]; y++) {
-			for (int x = 0; x < dims[0]; x++) {
-				image->SetScalarComponentFromDouble(x, y, sliceIndex, 0, values[y * dims[0] + x] * 255.0);
-			}
-		}
-	} else if (orientation == ESliceOrientation::YZ) {
-		if (sliceIndex < 0 || sliceIndex >= dims[0]) {
-			qWarning() << "Failed to cache slice with orientation" << orientation.getName() <<
-				"because the given slice index is out of range";
-			qDebug() << "Exit - Index out of range";
-			return;
-		}
-
-		if (valueCount != dims[1] * dims[2]) {
-			qWarning() << "Failed to cache slice with orientation" << orientation.getName() <<
-				"because the image dimensions do not match the given data.";
-			qDebug() << "Exit - Dimensions and data missmatch";
-			return;
-		}
-
-		for (int z = 0; z < dims[2]; z++) {
-			for (int y = 0; y < dims[1]; y++) {
-				image->SetScalarComponentFromDouble(sliceIndex, y, z, 0, values[z * dims[1] + y] * 255.0);
-			}
-		}
-	} else if (orientation == ESliceOrientation::XZ) {
-		if (sliceIndex < 0 || sliceIndex >= dims[1]) {
-			qWarning() << "Failed to cache slice with orientation" << orientation.getName() <<
-				"because the given slice index is out of range";
-			qDebug() << "Exit - Index out of range";
-			return;
-		}
-
-		if (valueCount != dims[0] * dims[2]) {
-			qWarning() << "Failed to cache slice with orientation" << orientation.getName() <<
-				"because the image dimensions do not match the given data.";
-			qDebug() << "Exit - Dimensions and data missmatch";
-			return;
-		}
-
-		for (int z = 0; z < dims[2]; z++) {
-			for (int x = 0; x < dims[0]; x++) {
-				image->SetScalarComponentFromDouble(x, sliceIndex, z, 0, values[z * dims[0] + x] * 255.0);
-			}
-		}
-	} else {
-		qWarning() << "Failed to cache slice because the given orientation is uknown.";
-	}
-
-	qDebug() << "Exit";
-}
-
 DataCache::DataCache()
 	: QObject(),
-	mImages(), mModels(), mStudies()
+	mImages(), mModels(), mStudies(),
+	mImageSliceRequests(), mModelRequests(), mStudyRequests(),
+	mStudyRequestIDs(), mVisualStudyRequests(),
+	mNextRequestID(0)
 {}
 
 DataCache::~DataCache() {}
@@ -145,7 +66,7 @@ ImagePromisePtr DataCache::getImageData(const QString& dataID, const int& index,
 
 ModelPromisePtr DataCache::getModelData(const QString& dataID) {
 	ModelPromisePtr model;
-	if (mModels.contains(dataID)) {
+	if (mModels.contains(dataID) && mModels.value(dataID)->isCached()) {
 		model.reset(new ModelPromise());
 		CachedModelVPtr mod = mModels.value(dataID);
 		model->resolve(mod);
@@ -169,8 +90,19 @@ ModelPromisePtr DataCache::getModelData(const QString& dataID) {
 }
 
 StudyPromisePtr DataCache::getStudy(const QString& dataID, const int& index,
-	const ESliceOrientation& orientation, const int& series) 
+	const ESliceOrientation& orientation, const int& series, const QString& visualID)
 {
+	StudySliceRequestKey request{
+		dataID, index, orientation, series
+	};
+
+	// The visual moved on, its previous slice is no longer needed.
+	if (!visualID.isEmpty() && mVisualStudyRequests.contains(visualID) &&
+		!(mVisualStudyRequests.value(visualID) == request))
+	{
+		this->cancelStudyRequest(visualID);
+	}
+
 	bool needData = false;
 	StudyPromisePtr study;
 	if (mStudies.contains(dataID)) {
@@ -186,13 +118,10 @@ StudyPromisePtr DataCache::getStudy(const QString& dataID, const int& index,
 	}
 
 	if (needData) {
-		StudySliceRequestKey request{
-			dataID, index, orientation, series
-		};
-
 		study = mStudyRequests.value(request);
 		if (study.isNull()) {
 			study.reset(new StudyPromise());
+			int requestID = mNextRequestID++;
 			
 			QJsonObject dataParams;
 			dataParams.insert(DATA_TYPE, EData::STUDY);
@@ -200,16 +129,101 @@ StudyPromisePtr DataCache::getStudy(const QString& dataID, const int& index,
 			dataParams.insert(SLICE_INDEX, index);
 			dataParams.insert(SLICE_ORIENTATION, orientation.toInt());
 			dataParams.insert(SERIES_INDEX, series);
+			dataParams.insert(DATA_REQUEST_ID, requestID);
 
 			mStudyRequests.insert(request, study);
+			mStudyRequestIDs.insert(request, requestID);
 
 			emit dataRequest(dataParams, "");
 		}
+
+		if (!visualID.isEmpty()) {
+			mVisualStudyRequests.insert(visualID, request);
+		}
 	}
 
 	return study;
 }
 
+void DataCache::cancelStudyRequest(const QString& visualID) {
+	StudySliceRequestKey request = mVisualStudyRequests.take(visualID);
+
+	// Another visual is waiting for the same slice.
+	for (const StudySliceRequestKey& other : mVisualStudyRequests) {
+		if (other == request) {
+			return;
+		}
+	}
+
+	if (mStudyRequests.take(request).isNull()) {
+		return;
+	}
+	int requestID = mStudyRequestIDs.take(request);
+	qDebug() << "Cancelling Study request" << requestID << "of" << visualID;
+
+	QJsonObject dataParams;
+	dataParams.insert(CANCEL_DATA_REQUESTS, QJsonArray({requestID}));
+	emit dataRequest(dataParams, "");
+}
+
+void DataCache::setDataVersion(const QString& dataID, const qint64& version, const int& seriesIndex,
+	const QVector<int>& changedExtent, const qint64& changedSinceVersion)
+{
+	// The extent only covers the changes after changedSinceVersion.
+	bool isExtentKnown = changedExtent.count() == 6 && changedSinceVersion >= 0;
+
+	CachedImageVPtr image = mImages.value(dataID, Q_NULLPTR);
+	if (image.Get() != Q_NULLPTR && image->getFI3DDataVersion() < version) {
+		qDebug() << "Image" << dataID << "changed to version" << version;
+		if (isExtentKnown && image->getFI3DDataVersion() >= changedSinceVersion) {
+			image->invalidateSlices(changedExtent.constData());
+		} else {
+			image->invalidateSlices();
+		}
+		image->setFI3DDataVersion(version);
+	}
+
+	CachedModelVPtr model = mModels.value(dataID, Q_NULLPTR);
+	if (model.Get() != Q_NULLPTR && model->getFI3DDataVersion() < version) {
+		qDebug() << "Model" << dataID << "changed to version" << version;
+		model->setCached(false);
+		model->setFI3DDataVersion(version);
+	}
+
+	CachedStudyPtr study = mStudies.value(dataID, Q_NULLPTR);
+	if (!study.isNull()) {
+		CachedSeriesVPtr series = study->getCachedSeries(seriesIndex);
+		if (series.Get() != Q_NULLPTR && series->getFI3DDataVersion() < version) {
+			qDebug() << "Study" << dataID << "series" << seriesIndex << "changed to version" << version;
+			if (isExtentKnown && series->getFI3DDataVersion() >= changedSinceVersion) {
+				series->invalidateSlices(changedExtent.constData());
+			} else {
+				series->invalidateSlices();
+			}
+			series->setFI3DDataVersion(version);
+		}
+	}
+}
+
+void DataCache::setWindowLevel(const QString& dataID, const double& window, const double& level,
+	const int& seriesIndex)
+{
+	CachedImageVPtr image = mImages.value(dataID, Q_NULLPTR);
+	if (image.Get() != Q_NULLPTR && image->setFI3DWindowLevel(window, level)) {
+		qDebug() << "Image" << dataID << "changed its window/level";
+		image->invalidateSlices();
+	}
+
+	CachedStudyPtr study = mStudies.value(dataID, Q_NULLPTR);
+	if (!study.isNull()) {
+		CachedSeriesVPtr series = study->getCachedSeries(seriesIndex);
+		if (series.Get() != Q_NULLPTR && series->setFI3DWindowLevel(window, level)) {
+			qDebug() << "Study" << dataID << "series" << seriesIndex << "changed its window/level";
+			series->invalidateSlices();
+		}
+	}
+}
+
 void DataCache::handleDataMessage(MessagePtr message) {
 	qDebug() << "Enter";
 
@@ -217,6 +231,7 @@ void DataCache::handleDataMessage(MessagePtr message) {
 
 	QString dataID = dataParams.value(DATA_ID).toString();
 	EData dataType = dataParams.value(DATA_TYPE).toInt();
+	qint64 version = dataParams.value(DATA_VERSION).toInteger();
 
 	qDebug() << "Received data of type" << dataType.getName() << "with ID" << dataID;
 
@@ -241,27 +256,20 @@ void DataCache::handleDataMessage(MessagePtr message) {
 			QJsonArray dims = dataParams.value(DIMENSIONS).toArray();
 			QJsonArray spac = dataParams.value(SPACING).toArray();
 
-			image->SetDimensions(dims[0].toInt(), dims[1].toInt(), dims[2].toInt());
+			image->setCacheDimensions(dims[0].toInt(), dims[1].toInt(), dims[2].toInt());
 			image->SetSpacing(spac[0].toDouble(), spac[1].toDouble(), spac[2].toDouble());
-			image->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
-
-			image->mTransverseSlices.resize(dims[2].toInt());
-			image->mSagittalSlices.resize(dims[0].toInt());
-			image->mCoronalSlices.resize(dims[1].toInt());
 		}
 
-		parseImage(message->getPayload(), image, key.SliceIndex, key.SliceOrientation);
-		
-		switch (key.SliceOrientation.toInt()) {
-			case ESliceOrientation::XY:
-				image->mTransverseSlices[key.SliceIndex] = true;
-				break;
-			case ESliceOrientation::YZ:
-				image->mSagittalSlices[key.SliceIndex] = true;
-				break;
-			case ESliceOrientation::XZ:
-				image->mCoronalSlices[key.SliceIndex] = true;
-				break;
+		// Slices of a newer version replace all others, those of an older
+		// version arrived late and are dropped.
+		if (version > image->getFI3DDataVersion()) {
+			image->invalidateSlices();
+			image->setFI3DDataVersion(version);
+		}
+		if (version == image->getFI3DDataVersion()) {
+			QSharedPointer<QByteArray> bytes = message->getPayload();
+			image->cacheSlice((float*)bytes->data(), bytes->count() / sizeof(float),
+				key.SliceIndex, key.SliceOrientation);
 		}
 
 		ImagePromisePtr imPro = mImageSliceRequests.take(key);
@@ -277,56 +285,62 @@ void DataCache::handleDataMessage(MessagePtr message) {
 			model = CachedModelVPtr::New();
 			model->setFI3DDataID(dataID);
 		}
-		// TODO: Does this function really resets the object to starting state?
-		model->Initialize();
+		// A model of an older version arrived late and is dropped.
+		if (version >= model->getFI3DDataVersion()) {
+			// TODO: Does this function really resets the object to starting state?
+			model->Initialize();
 
-		int pointBytes = dataParams.value(PAYLOAD_POINTS_LENGTH).toInt();
-		int triangleBytes = dataParams.value(PAYLOAD_TRIANGLES_LENGTH).toInt();
+			int pointBytes = dataParams.value(PAYLOAD_POINTS_LENGTH).toInt();
+			int triangleBytes = dataParams.value(PAYLOAD_TRIANGLES_LENGTH).toInt();
 
-		char* bytes = message->getPayload()->data();
-		float* pointValues = (float*)bytes;
-		int* triangleValues = (int*)(&bytes[pointBytes]);
+			char* bytes = message->getPayload()->data();
+			float* pointValues = (float*)bytes;
+			int* triangleValues = (int*)(&bytes[pointBytes]);
 
-		int pointCount = pointBytes / 3 / sizeof(float);
-		int triangleCount = triangleBytes / 3 / sizeof(int);
+			int pointCount = pointBytes / 3 / sizeof(float);
+			int triangleCount = triangleBytes / 3 / sizeof(int);
 		
-		qDebug() << "Caching new Model" << dataID;
-		qDebug() << "Point Bytes=" << pointBytes << "Triangle Bytes=" << triangleBytes;
-		qDebug() << "Points=" << pointCount << "Triangles=" << triangleCount;
+			qDebug() << "Caching new Model" << dataID;
+			qDebug() << "Point Bytes=" << pointBytes << "Triangle Bytes=" << triangleBytes;
+			qDebug() << "Points=" << pointCount << "Triangles=" << triangleCount;
 
-		vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
-		points->SetNumberOfPoints(pointCount);
-		for (int i = 0; i < pointCount; i++) {
-			int index = i * 3;
+			vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+			points->SetNumberOfPoints(pointCount);
+			for (int i = 0; i < pointCount; i++) {
+				int index = i * 3;
 
-			double x = pointValues[index];
-			double y = pointValues[index + 1];
-			double z = pointValues[index + 2];
+				double x = pointValues[index];
+				double y = pointValues[index + 1];
+				double z = pointValues[index + 2];
 
-			points->SetPoint(i, x, y, z);
-		}
+				points->SetPoint(i, x, y, z);
+			}
 
-		vtkSmartPointer<vtkCellArray> cells = vtkSmartPointer<vtkCellArray>::New();
+			vtkSmartPointer<vtkCellArray> cells = vtkSmartPointer<vtkCellArray>::New();
 		
-		// TODO: add verts and lines
+			// TODO: add verts and lines
 		
-		for (int i = 0; i < triangleCount; i++) {
-			vtkSmartPointer<vtkTriangle> triangle = vtkSmartPointer<vtkTriangle>::New();
-			int index = i * 3;
+			for (int i = 0; i < triangleCount; i++) {
+				vtkSmartPointer<vtkTriangle> triangle = vtkSmartPointer<vtkTriangle>::New();
+				int index = i * 3;
 
-			int p0 = triangleValues[index];
-			int p1 = triangleValues[index + 1];
-			int p2 = triangleValues[index + 2];
+				int p0 = triangleValues[index];
+				int p1 = triangleValues[index + 1];
+				int p2 = triangleValues[index + 2];
 
-			triangle->GetPointIds()->SetId(0, p0);
-			triangle->GetPointIds()->SetId(1, p1);
-			triangle->GetPointIds()->SetId(2, p2);
+				triangle->GetPointIds()->SetId(0, p0);
+				triangle->GetPointIds()->SetId(1, p1);
+				triangle->GetPointIds()->SetId(2, p2);
 
-			cells->InsertNextCell(triangle);
-		}
+				cells->InsertNextCell(triangle);
+			}
+
+			model->SetPoints(points);
+			model->SetPolys(cells);
 
-		model->SetPoints(points);
-		model->SetPolys(cells);
+			model->setFI3DDataVersion(version);
+			model->setCached(true);
+		}
 		
 		ModelPromisePtr moPro = mModelRequests.take(dataID);
 		if (!moPro.isNull()) {
@@ -358,32 +372,39 @@ void DataCache::handleDataMessage(MessagePtr message) {
 			QJsonArray dims = dataParams.value(DIMENSIONS).toArray();
 			QJsonArray spac = dataParams.value(SPACING).toArray();
 
-			study->mSeriesStates.resize(seriesCount);
 			for (int i = 0; i < seriesCount; i++) {
-				SeriesDataVPtr series = study->createAndAddSeries();
-
-				series->SetDimensions(dims[0].toInt(), dims[1].toInt(), dims[2].toInt());
+				CachedSeriesVPtr series = CachedSeriesVPtr::New();
+				series->setCacheDimensions(dims[0].toInt(), dims[1].toInt(), dims[2].toInt());
 				series->SetSpacing(spac[0].toDouble(), spac[1].toDouble(), spac[2].toDouble());
-				series->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
-
-				study->mSeriesStates[i].TransverseSlices.resize(dims[2].toInt());
-				study->mSeriesStates[i].SagittalSlices.resize(dims[0].toInt());
-				study->mSeriesStates[i].CoronalSlices.resize(dims[1].toInt());
+				study->addSeries(series);
 			}
 		}
 
-		parseImage(message->getPayload(), study->getSeries(key.SeriesIndex), key.SliceIndex, key.SliceOrientation);
-		
-		switch (key.SliceOrientation.toInt()) {
-			case ESliceOrientation::XY:
-				study->mSeriesStates[key.SeriesIndex].TransverseSlices[key.SliceIndex] = true;
-				break;
-			case ESliceOrientation::YZ:
-				study->mSeriesStates[key.SeriesIndex].SagittalSlices[key.SliceIndex] = true;
-				break;
-			case ESliceOrientation::XZ:
-				study->mSeriesStates[key.SeriesIndex].CoronalSlices[key.SliceIndex] = true;
-				break;
+		CachedSeriesVPtr series = study->getCachedSeries(key.SeriesIndex);
+		if (series.Get() == Q_NULLPTR) {
+			qWarning() << "Failed to handle Study data. Series index is out of range.";
+			qDebug() << "Exit - Series index out of range";
+			return;
+		}
+
+		if (version > series->getFI3DDataVersion()) {
+			series->invalidateSlices();
+			series->setFI3DDataVersion(version);
+		}
+		if (version == series->getFI3DDataVersion()) {
+			QSharedPointer<QByteArray> bytes = message->getPayload();
+			series->cacheSlice((float*)bytes->data(), bytes->count() / sizeof(float),
+				key.SliceIndex, key.SliceOrientation);
+		}
+
+		mStudyRequestIDs.remove(key);
+		QHash<QString, StudySliceRequestKey>::iterator it = mVisualStudyRequests.begin();
+		while (it != mVisualStudyRequests.end()) {
+			if (it.value() == key) {
+				it = mVisualStudyRequests.erase(it);
+			} else {
+				it++;
+			}
 		}
 
 		StudyPromisePtr stuPro = mStudyRequests.take(key);
@@ -0,0 +1,199 @@
+#include <FI/data/SparseVolume.h>
+
+#include <fi3d/logger/Logger.h>
+
+#include <cstring>
+
+using namespace fi;
+using namespace fi3d;
+
+/// @brief Voxels in a brick.
+static const int BRICK_VOXELS = SparseVolume::BRICK_SIZE * SparseVolume::BRICK_SIZE * SparseVolume::BRICK_SIZE;
+
+SparseVolume::SparseVolume()
+	: mDimensions{0, 0, 0},
+	mBrickCounts{0, 0, 0},
+	mBricks(),
+	mWrittenSlices()
+{}
+
+SparseVolume::~SparseVolume() {}
+
+void SparseVolume::setDimensions(const int& dimX, const int& dimY, const int& dimZ) {
+	mDimensions[0] = qMax(0, dimX);
+	mDimensions[1] = qMax(0, dimY);
+	mDimensions[2] = qMax(0, dimZ);
+	for (int axis = 0; axis < 3; axis++) {
+		mBrickCounts[axis] = (mDimensions[axis] + BRICK_SIZE - 1) / BRICK_SIZE;
+	}
+	this->release();
+}
+
+void SparseVolume::getDimensions(int dimensions[3]) const {
+	dimensions[0] = mDimensions[0];
+	dimensions[1] = mDimensions[1];
+	dimensions[2] = mDimensions[2];
+}
+
+bool SparseVolume::writeSlice(const float* values, const int& valueCount,
+	const int& sliceIndex, const ESliceOrientation& orientation)
+{
+	int normal, u, v;
+	if (!getSliceAxes(orientation, normal, u, v)) {
+		qWarning() << "Failed to cache slice because the given orientation is unknown.";
+		return false;
+	}
+
+	if (sliceIndex < 0 || sliceIndex >= mDimensions[normal]) {
+		qWarning() << "Failed to cache slice with orientation" << orientation.getName() <<
+			"because the given slice index is out of range.";
+		return false;
+	}
+
+	if (valueCount != mDimensions[u] * mDimensions[v]) {
+		qWarning() << "Failed to cache slice with orientation" << orientation.getName() <<
+			"because the image dimensions do not match the given data.";
+		return false;
+	}
+
+	// Distance between consecutive voxels along u within a brick.
+	int stride = 1;
+	for (int axis = 0; axis < u; axis++) {
+		stride *= BRICK_SIZE;
+	}
+
+	int voxel[3];
+	voxel[normal] = sliceIndex;
+	for (int j = 0; j < mDimensions[v]; j++) {
+		voxel[v] = j;
+		const float* row = &values[j * mDimensions[u]];
+
+		// Each run is the part of the row within one brick.
+		for (int i = 0; i < mDimensions[u];) {
+			voxel[u] = i;
+			int run = qMin(BRICK_SIZE - i % BRICK_SIZE, mDimensions[u] - i);
+
+			QByteArray& brick = mBricks[this->getBrickIndex(voxel)];
+			if (brick.isEmpty()) {
+				brick.fill(0, BRICK_VOXELS);
+			}
+
+			unsigned char* out = (unsigned char*)brick.data() + getVoxelOffset(voxel);
+			for (int k = 0; k < run; k++) {
+				out[k * stride] = (unsigned char)qBound(0.0, row[i + k] * 255.0, 255.0);
+			}
+			i += run;
+		}
+	}
+
+	mWrittenSlices[normal].setBit(sliceIndex);
+	return true;
+}
+
+void SparseVolume::readSlice(const int& sliceIndex, const ESliceOrientation& orientation,
+	unsigned char* values) const
+{
+	int normal, u, v;
+	if (values == Q_NULLPTR || !getSliceAxes(orientation, normal, u, v) ||
+		sliceIndex < 0 || sliceIndex >= mDimensions[normal])
+	{
+		return;
+	}
+
+	int stride = 1;
+	for (int axis = 0; axis < u; axis++) {
+		stride *= BRICK_SIZE;
+	}
+
+	int voxel[3];
+	voxel[normal] = sliceIndex;
+	for (int j = 0; j < mDimensions[v]; j++) {
+		voxel[v] = j;
+		unsigned char* row = &values[j * mDimensions[u]];
+
+		for (int i = 0; i < mDimensions[u];) {
+			voxel[u] = i;
+			int run = qMin(BRICK_SIZE - i % BRICK_SIZE, mDimensions[u] - i);
+
+			QHash<int, QByteArray>::const_iterator brick = mBricks.constFind(this->getBrickIndex(voxel));
+			if (brick == mBricks.constEnd()) {
+				std::memset(&row[i], 0, run);
+			} else {
+				const unsigned char* in = (const unsigned char*)brick->constData() + getVoxelOffset(voxel);
+				for (int k = 0; k < run; k++) {
+					row[i + k] = in[k * stride];
+				}
+			}
+			i += run;
+		}
+	}
+}
+
+bool SparseVolume::isSliceWritten(const int& sliceIndex, const ESliceOrientation& orientation) const {
+	int normal, u, v;
+	if (!getSliceAxes(orientation, normal, u, v) ||
+		sliceIndex < 0 || sliceIndex >= mWrittenSlices[normal].size())
+	{
+		return false;
+	}
+	return mWrittenSlices[normal].testBit(sliceIndex);
+}
+
+qint64 SparseVolume::getAllocatedBytes() const {
+	return (qint64)mBricks.count() * BRICK_VOXELS;
+}
+
+void SparseVolume::release() {
+	mBricks.clear();
+	for (int axis = 0; axis < 3; axis++) {
+		mWrittenSlices[axis] = QBitArray(mDimensions[axis]);
+	}
+}
+
+void SparseVolume::invalidate() {
+	for (int axis = 0; axis < 3; axis++) {
+		mWrittenSlices[axis].fill(false);
+	}
+}
+
+void SparseVolume::invalidate(const int extent[6]) {
+	for (int axis = 0; axis < 3; axis++) {
+		int first = qMax(0, extent[2 * axis]);
+		int last = qMin(mWrittenSlices[axis].size() - 1, extent[2 * axis + 1]);
+		if (first <= last) {
+			mWrittenSlices[axis].fill(false, first, last + 1);
+		}
+	}
+}
+
+bool SparseVolume::getSliceAxes(const ESliceOrientation& orientation, int& normal, int& u, int& v) {
+	switch (orientation.toInt()) {
+		case ESliceOrientation::XY:
+			normal = 2;
+			u = 0;
+			v = 1;
+			return true;
+		case ESliceOrientation::YZ:
+			normal = 0;
+			u = 1;
+			v = 2;
+			return true;
+		case ESliceOrientation::XZ:
+			normal = 1;
+			u = 0;
+			v = 2;
+			return true;
+		default:
+			return false;
+	}
+}
+
+int SparseVolume::getBrickIndex(const int voxel[3]) const {
+	return ((voxel[2] / BRICK_SIZE) * mBrickCounts[1] + voxel[1] / BRICK_SIZE) * mBrickCounts[0] +
+		voxel[0] / BRICK_SIZE;
+}
+
+int SparseVolume::getVoxelOffset(const int voxel[3]) {
+	return ((voxel[2] % BRICK_SIZE) * BRICK_SIZE + voxel[1] % BRICK_SIZE) * BRICK_SIZE +
+		voxel[0] % BRICK_SIZE;
+}
@@ -34,7 +34,10 @@ inline vtkSmartPointer<vtkMatrix4x4> parseTransform(QJsonArray& transformJson) {
 SceneFI::SceneFI(DataCachePtr cache, QVTKOpenGLStereoWidget* widget, const QString& id)
 	: InteractiveScene(widget, id),
 	mSubscribedSceneID(""),
-	mCache(cache)
+	mCache(cache),
+	mHandleVisualIDs(),
+	mHandlePartIDs(),
+	mHandleDataIDs()
 {
 	if (mCache.isNull()) {
 		qInfo() << "No Data cache was given to Scene" << id << "Creating new cache.";
@@ -54,6 +57,28 @@ void SceneFI::handleModuleResponse(const QJsonArray& visualsInfo) {
 	QList<QJsonObject> parentChanges;
 	for (int i = 0; i < visualsInfo.count(); i++) {
 		QJsonObject visualInfo = visualsInfo[i].toObject();
+		this->learnHandles(visualInfo);
+
+		// Stale cached data is fetched again by the handlers below.
+		if (visualInfo.contains(DATA_VERSION)) {
+			QVector<int> changedExtent;
+			QJsonArray changedSlices = visualInfo.value(CHANGED_EXTENT).toArray();
+			for (int j = 0; j < changedSlices.count(); j++) {
+				changedExtent.append(changedSlices.at(j).toInt());
+			}
+
+			mCache->setDataVersion(this->getDataIDOf(visualInfo),
+				visualInfo.value(DATA_VERSION).toInteger(),
+				visualInfo.value(SERIES_INDEX).toInt(-1),
+				changedExtent,
+				visualInfo.value(CHANGED_SINCE_VERSION).toInteger(-1));
+		}
+		if (visualInfo.contains(WINDOW_WIDTH) && visualInfo.contains(WINDOW_CENTER)) {
+			mCache->setWindowLevel(this->getDataIDOf(visualInfo),
+				visualInfo.value(WINDOW_WIDTH).toDouble(),
+				visualInfo.value(WINDOW_CENTER).toDouble(),
+				visualInfo.value(SERIES_INDEX).toInt(-1));
+		}
 		
 		EModuleResponse responseID(visualInfo.value(RESPONSE_ID).toInt());
 		switch (responseID.toInt()) {
@@ -97,7 +122,7 @@ void SceneFI::handleModuleResponse(const QJsonArray& visualsInfo) {
 
 	// Ensure parenting was set as order of Visual updates may not come in order.
 	for (QJsonObject visualInfo : parentChanges) {
-		Visual3DPtr visual = mVisuals3D.value(visualInfo.value(ID).toString());
+		Visual3DPtr visual = this->getVisualOf(visualInfo);
 		Visual3DPtr parent = mVisuals3D.value(visualInfo.value(PARENT_ID).toString());
 		if (!parent.isNull() && !visual.isNull() && visual->getParentVisual() != parent) {
 			visual->setParentVisual(parent);
@@ -110,8 +135,98 @@ void SceneFI::handleModuleResponse(const QJsonArray& visualsInfo) {
 	qDebug() << "Exit";
 }
 
+void SceneFI::prepareSnapshot(const QJsonArray& visualsInfo) {
+	QHash<QString, int> snapshotResponses;
+	for (int i = 0; i < visualsInfo.count(); i++) {
+		QJsonObject visualInfo = visualsInfo[i].toObject();
+		snapshotResponses.insert(this->getVisualIDOf(visualInfo), visualInfo.value(RESPONSE_ID).toInt());
+	}
+
+	QList<Visual3DPtr> visuals = this->getVisuals3D();
+	for (Visual3DPtr visual : visuals) {
+		QString visualID = visual->getVisualID();
+		int responseID = snapshotResponses.value(visualID, EModuleResponse::UNKNOWN);
+		if ((responseID == EModuleResponse::UNKNOWN || responseID == EModuleResponse::ADD_VISUAL) &&
+			this->isVisualIDTaken(visualID))
+		{
+			this->removeVisual(visualID);
+		}
+	}
+}
+
+void SceneFI::handlePoseRecords(const PoseRecord* records, const int& count) {
+	qDebug() << "Handling" << count << "pose records";
+
+	vtkSmartPointer<vtkMatrix4x4> transform = vtkSmartPointer<vtkMatrix4x4>::New();
+	for (int i = 0; i < count; i++) {
+		const PoseRecord& record = records[i];
+
+		// Datagrams may arrive late, the sequence wraps around.
+		QHash<int, quint32>::const_iterator last = mPoseSequences.constFind(record.Handle);
+		if (last != mPoseSequences.constEnd() && (qint32)(record.Sequence - last.value()) < 0) {
+			continue;
+		}
+
+		Visual3DPtr visual = this->getVisual3D(mHandleVisualIDs.value(record.Handle));
+		if (visual.isNull()) {
+			continue;
+		}
+
+		mPoseSequences.insert(record.Handle, record.Sequence);
+		fromPoseRecord(record, transform);
+		visual->setTransformData(transform);
+	}
+}
+
+void SceneFI::learnHandles(const QJsonObject& visualInfo, const QString& assemblyID) {
+	int handle = visualInfo.value(HANDLE).toInt(0);
+	if (handle != 0 && visualInfo.contains(ID)) {
+		QString visualID = this->getVisualIDOf(visualInfo);
+		if (assemblyID.isEmpty()) {
+			// The handle is announced again, e.g., after subscribing anew.
+			mHandleVisualIDs.insert(handle, visualID);
+			mPoseSequences.remove(handle);
+		} else {
+			// Part IDs are only unique within their assembly.
+			mHandlePartIDs.insert(handle, assemblyID + "/" + visualID);
+		}
+	}
+
+	int dataHandle = visualInfo.value(DATA_HANDLE).toInt(0);
+	if (dataHandle != 0 && visualInfo.contains(DATA_ID)) {
+		mHandleDataIDs.insert(dataHandle, visualInfo.value(DATA_ID).toString());
+	}
+
+	// Parts are compacted like any visual, so their handles are learned too.
+	QJsonArray partsInfo = visualInfo.value(ASSEMBLY_PARTS_INFO).toArray();
+	QString partAssemblyID = assemblyID.isEmpty() ? this->getVisualIDOf(visualInfo) : assemblyID;
+	for (int i = 0; i < partsInfo.count(); i++) {
+		this->learnHandles(partsInfo.at(i).toObject(), partAssemblyID);
+	}
+}
+
+Visual3DPtr SceneFI::getVisualOf(const QJsonObject& visualInfo) {
+	return this->getVisual3D(this->getVisualIDOf(visualInfo));
+}
+
+QString SceneFI::getVisualIDOf(const QJsonObject& visualInfo) const {
+	int handle = visualInfo.value(HANDLE).toInt(0);
+	if (handle != 0 && !visualInfo.contains(ID)) {
+		return mHandleVisualIDs.value(handle);
+	}
+	return visualInfo.value(ID).toString();
+}
+
+QString SceneFI::getDataIDOf(const QJsonObject& visualInfo) const {
+	int dataHandle = visualInfo.value(DATA_HANDLE).toInt(0);
+	if (dataHandle != 0 && !visualInfo.contains(DATA_ID)) {
+		return mHandleDataIDs.value(dataHandle);
+	}
+	return visualInfo.value(DATA_ID).toString();
+}
+
 void SceneFI::handleAddVisual(const QJsonObject& visualJson) {
-	QString visualID = visualJson.value(ID).toString();
+	QString visualID = this->getVisualIDOf(visualJson);
 	if (this->isVisualIDTaken(visualID)) {
 		QString fb = tr("Failed to add Visual: %1. A visual with that ID already exists").arg(visualID);
 		emit feedbackWarning(fb);
@@ -127,12 +242,12 @@ void SceneFI::handleAddVisual(const QJsonObject& visualJson) {
 		// of the requested data and instead part of the visual's transform;
 		slice->setAutoSetPatientMatrix(false);
 
-		QString dataID = visualJson.value(DATA_ID).toString();
+		QString dataID = this->getDataIDOf(visualJson);
 		int index = visualJson.value(SLICE_INDEX).toInt();
 		ESliceOrientation orien = visualJson.value(SLICE_ORIENTATION).toInt();
 		int series = visualJson.value(SERIES_INDEX).toInt();
 
-		StudyPromisePtr prom = mCache->getStudy(dataID, index, orien, series);
+		StudyPromisePtr prom = mCache->getStudy(dataID, index, orien, series, visualID);
 
 		if (prom->isResolved()) {
 			slice->setStudy(prom->getResult());
@@ -159,7 +274,7 @@ void SceneFI::handleAddVisual(const QJsonObject& visualJson) {
 		QJsonArray color = visualJson.value(COLOR).toArray();
 		model->setColor(color[0].toDouble(), color[1].toDouble(), color[2].toDouble());
 
-		QString dataID = visualJson.value(DATA_ID).toString();
+		QString dataID = this->getDataIDOf(visualJson);
 		ModelPromisePtr prom = mCache->getModelData(dataID);
 
 		if (prom->isResolved()) {
@@ -196,7 +311,7 @@ void SceneFI::handleAddVisual(const QJsonObject& visualJson) {
 }
 
 void SceneFI::handleRefreshVisual(const QJsonObject& visualJson) {
-	QString visualID = visualJson.value(ID).toString();
+	QString visualID = this->getVisualIDOf(visualJson);
 	Visual3DPtr visual = this->getVisual3D(visualID);
 
 	if (visual.isNull()) {
@@ -208,12 +323,12 @@ void SceneFI::handleRefreshVisual(const QJsonObject& visualJson) {
 	if (visual->getVisualType() == EVisual::STUDY_IMAGE_SLICE) {
 		StudySlicePtr slice = this->getStudyImageSlice(visualID);
 
-		QString dataID = visualJson.value(DATA_ID).toString();
+		QString dataID = this->getDataIDOf(visualJson);
 		int index = visualJson.value(SLICE_INDEX).toInt();
 		ESliceOrientation orien = visualJson.value(SLICE_ORIENTATION).toInt();
 		int series = visualJson.value(SERIES_INDEX).toInt();
 
-		StudyPromisePtr prom = mCache->getStudy(dataID, index, orien, series);
+		StudyPromisePtr prom = mCache->getStudy(dataID, index, orien, series, visualID);
 
 		if (prom->isResolved()) {
 			slice->setStudy(prom->getResult());
@@ -240,7 +355,7 @@ void SceneFI::handleRefreshVisual(const QJsonObject& visualJson) {
 		QJsonArray color = visualJson.value(COLOR).toArray();
 		model->setColor(color[0].toDouble(), color[1].toDouble(), color[2].toDouble());
 
-		QString dataID = visualJson.value(DATA_ID).toString();
+		QString dataID = this->getDataIDOf(visualJson);
 		ModelPromisePtr prom = mCache->getModelData(dataID);
 
 		if (prom->isResolved()) {
@@ -276,7 +391,7 @@ void SceneFI::handleRefreshVisual(const QJsonObject& visualJson) {
 }
 
 void SceneFI::handleRemoveVisual(const QJsonObject& visualInfo) {
-	QString visualID = visualInfo.value(ID).toString();
+	QString visualID = this->getVisualIDOf(visualInfo);
 	if (!this->isVisualIDTaken(visualID)) {
 		QString fb = tr("Failed to remove Visual: %1. Visual does not exist.").arg(visualID);
 		emit feedbackWarning(fb);
@@ -287,7 +402,7 @@ void SceneFI::handleRemoveVisual(const QJsonObject& visualInfo) {
 }
 
 void SceneFI::handleDataChange(const QJsonObject& visualInfo) {
-	QString visualID = visualInfo.value(ID).toString();
+	QString visualID = this->getVisualIDOf(visualInfo);
 	Visual3DPtr visual = this->getVisual3D(visualID);
 
 	if (visual.isNull()) {
@@ -299,12 +414,12 @@ void SceneFI::handleDataChange(const QJsonObject& visualInfo) {
 	if (visual->getVisualType() == EVisual::STUDY_IMAGE_SLICE) {
 		StudySlice* slice = qobject_cast<StudySlice*>(visual.data());
 
-		QString dataID = visualInfo.value(DATA_ID).toString();
+		QString dataID = this->getDataIDOf(visualInfo);
 		int index = visualInfo.value(SLICE_INDEX).toInt();
 		int orien = visualInfo.value(SLICE_ORIENTATION).toInt();
 		int series = visualInfo.value(SERIES_INDEX).toInt();
 
-		StudyPromisePtr prom = mCache->getStudy(dataID, index, orien, series);
+		StudyPromisePtr prom = mCache->getStudy(dataID, index, orien, series, visualID);
 
 		if (prom->isResolved()) {
 			slice->setStudy(prom->getResult());
@@ -322,7 +437,7 @@ void SceneFI::handleDataChange(const QJsonObject& visualInfo) {
 	} else if (visual->getVisualType() == EVisual::MODEL) {
 		Model* model = qobject_cast<Model*>(visual.data());
 
-		QString dataID = visualInfo.value(DATA_ID).toString();
+		QString dataID = this->getDataIDOf(visualInfo);
 		ModelPromisePtr prom = mCache->getModelData(dataID);
 
 		if (prom->isResolved()) {
@@ -344,7 +459,7 @@ void SceneFI::handleDataChange(const QJsonObject& visualInfo) {
 }
 
 void SceneFI::handleHideVisual(const QJsonObject& visualInfo) {
-	QString visualID = visualInfo.value(ID).toString();
+	QString visualID = this->getVisualIDOf(visualInfo);
 	if (!this->isVisualIDTaken(visualID)) {
 		QString fb = tr("Failed to change visibility of Visual: %1. Visual does not exist").arg(visualID);
 		emit feedbackWarning(fb);
@@ -355,7 +470,7 @@ void SceneFI::handleHideVisual(const QJsonObject& visualInfo) {
 }
 
 void SceneFI::handleTransformVisual(const QJsonObject& visualInfo) {
-	QString visualID = visualInfo.value(ID).toString();
+	QString visualID = this->getVisualIDOf(visualInfo);
 	Visual3DPtr visual = this->getVisual3D(visualID);
 	if (visual.isNull()) {
 		QString fb = tr("Failed to transform Visual: %1. Visual does not exist").arg(visualID);
@@ -369,7 +484,7 @@ void SceneFI::handleTransformVisual(const QJsonObject& visualInfo) {
 }
 
 void SceneFI::handleParentChange(const QJsonObject& visualInfo) {
-	QString visualID = visualInfo.value(ID).toString();
+	QString visualID = this->getVisualIDOf(visualInfo);
 	Visual3DPtr visual = this->getVisual3D(visualID);
 
 	if (visual.isNull()) {
@@ -388,7 +503,7 @@ void SceneFI::handleParentChange(const QJsonObject& visualInfo) {
 }
 
 void SceneFI::handleSetVisualOpacity(const QJsonObject& visualInfo) {
-	QString visualID = visualInfo.value(ID).toString();
+	QString visualID = this->getVisualIDOf(visualInfo);
 	if (!this->isVisualIDTaken(visualID)) {
 		QString fb = tr("Failed to change opacity of Visual: %1. Visual does not exist").arg(visualID);
 		emit feedbackWarning(fb);
@@ -399,7 +514,7 @@ void SceneFI::handleSetVisualOpacity(const QJsonObject& visualInfo) {
 }
 
 void SceneFI::handleSetSlice(const QJsonObject& visualInfo) {
-	QString visualID = visualInfo.value(ID).toString();
+	QString visualID = this->getVisualIDOf(visualInfo);
 	if (!this->isVisualIDTaken(visualID)) {
 		QString fb = tr("Failed to set slice of Visual: %1. Visual does not exist").arg(visualID);
 		emit feedbackWarning(fb);
@@ -414,7 +529,7 @@ void SceneFI::handleSetSlice(const QJsonObject& visualInfo) {
 }
 
 void SceneFI::handleSetColor(const QJsonObject& visualInfo) {
-	QString visualID = visualInfo.value(ID).toString();
+	QString visualID = this->getVisualIDOf(visualInfo);
 	ModelPtr model = this->getModel(visualID);
 	if (model.isNull()) {
 		QString fb = tr("Failed to set color of Model: %1. Model does not exist.").arg(visualID);
@@ -446,7 +561,7 @@ void SceneFI::onSliceChange(const int& sliceIndex,
 	if (!stu->isSliceCached(sliceIndex, orientation, slice->getSeriesIndex())) {
 		StudyPromisePtr stuPro = mCache->getStudy(stu->getFI3DDataID(),
 			slice->getSliceIndex(), slice->getSliceOrientation(),
-			slice->getSeriesIndex());
+			slice->getSeriesIndex(), slice->getVisualID());
 
 		// Get when the promise resolves so that the scene is re-rendered to 
 		// update the slice data being rendered
@@ -0,0 +1,72 @@
+#include <fi3d/CUDA/cpu_computations.h>
+
+#include <fi3d/utilities/ParallelAlgorithms.h>
+
+#include <QVector>
+
+#include <cmath>
+
+using namespace fi3d;
+
+/// @brief Writes a circle of points at the same height, scaled from the unit circle.
+static void writeCircle(float* row, const float* cosines, const float* sines,
+	const int& count, const float& radius, const float& height)
+{
+	for (int j = 0; j < count; j++) {
+		row[3 * j] = radius * cosines[j];
+		row[3 * j + 1] = radius * sines[j];
+		row[3 * j + 2] = height;
+	}
+}
+
+/// @brief Computes the unit circle of the angles (j + 1) * stepSize.
+static void computeUnitCircle(const int& count, const float& stepSize,
+	QVector<float>& cosines, QVector<float>& sines)
+{
+	cosines.resize(count);
+	sines.resize(count);
+	for (int j = 0; j < count; j++) {
+		const float theta = (j + 1) * stepSize;
+		cosines[j] = std::cos(theta);
+		sines[j] = std::sin(theta);
+	}
+}
+
+void fi3d::CUDA::computeMK3Workspace_sphere_cpu(float* points, const int& translations,
+	const int& rotations, const float& circleStepSize, const float& pointStepSize,
+	const float& separation, const float& depth)
+{
+	QVector<float> cosines, sines;
+	computeUnitCircle(rotations, pointStepSize, cosines, sines);
+
+	ParallelAlgorithms::forRange(translations, [&](const int& i) {
+		const float cRange = (i + 1) * circleStepSize;
+
+		// x * x + y * y is cRange * cRange around the whole circle, so every
+		// point of the circle moves by the same factor.
+		const float magnitude = std::sqrt(cRange * cRange + separation * separation);
+		const float scale = 1.0f + depth / magnitude;
+
+		writeCircle(points + (qint64)i * rotations * 3, cosines.constData(), sines.constData(),
+			rotations, cRange * scale, separation * scale);
+	});
+}
+
+void fi3d::CUDA::computeMK3Workspace_cone_cpu(float* points, const int& insertions,
+	const int& rotations, const float& insertionStepSize, const float& pointStepSize,
+	const float& separation, const float& range, const float& depthMin)
+{
+	QVector<float> cosines, sines;
+	computeUnitCircle(rotations, pointStepSize, cosines, sines);
+
+	// Every point of the cone starts on the circle of the range.
+	const float magnitude = std::sqrt(range * range + separation * separation);
+
+	ParallelAlgorithms::forRange(insertions, [&](const int& i) {
+		const float cDepth = (i + 1) * insertionStepSize + depthMin;
+		const float scale = 1.0f + cDepth / magnitude;
+
+		writeCircle(points + (qint64)i * rotations * 3, cosines.constData(), sines.constData(),
+			rotations, range * scale, separation * scale);
+	});
+}
@@ -8,6 +8,8 @@
 #include <cuda_runtime.h>
 #include <device_launch_parameters.h>
 
+#include <algorithm>
+
 using namespace fi3d;
 using namespace fi3d::CUDA;
 
@@ -24,60 +26,50 @@ inline void gpuAssert(cudaError_t code, const char *file, int line, bool abort =
 	}
 }
 
-void computeMK3Workspace_sphere(ModelData& workspaceModel, float separation, 
+void fi3d::CUDA::computeMK3Workspace_sphere(ModelData& workspaceModel, float separation, 
 	float depth, float range, int translations, int rotations) 
 {
-	//if (translations > 1024) {
-	//	translations = 1024;
-	//}
-	//if (rotations > 1024) {
-	//	rotations = 1024;
-	//}
+	translations = std::min(std::max(translations, 1), 1024);
+	rotations = std::min(std::max(rotations, 1), 1024);
+
+	float szTranslation = range / (float)translations;		
+	float szRotation = 6.28318f / (float)rotations;
+	int totalPoints = translations * rotations;
+	size_t totalBytes = totalPoints * 3 * sizeof(float);
 
-	//float szTranslation = range / (float)translations;		
-	//float szRotation = 6.28318f / (float)rotations;
-	//int totalPoints = translations * rotations;
+	float* rawPoints = 0;
+	gpuErrorCheck(cudaMalloc(&rawPoints, totalBytes));
+	computeMK3Workspace_sphere_cuda<<<translations, rotations>>>(rawPoints, szTranslation, szRotation, separation, depth);
+	gpuErrorCheck(cudaPeekAtLastError());
 
-	//float* rawPoints = 0;
-	//gpuErrorCheck(cudaMallocManaged(&rawPoints, totalPoints * workspaceModel.getPointSize()));
-	//gpuErrorCheck(cudaMemset(rawPoints, 0, totalPoints * workspaceModel.getPointSize()));
-	//computeMK3Workspace_sphere_cuda<<<translations, rotations>>>(rawPoints, szTranslation, szRotation, separation, depth);
-	//gpuErrorCheck(cudaPeekAtLastError());
-	//gpuErrorCheck(cudaDeviceSynchronize());
-	////TODO: Change so that all data is copied at once instead of point per point.
-	//for (int i = 0; i < totalPoints; i++) {
-	//	int pos = i * 3;
-	//	workspaceModel.addPoint(rawPoints[pos], rawPoints[pos + 1], rawPoints[pos + 2]);
-	//}
-	//gpuErrorCheck(cudaFree(rawPoints));
+	// Copied at once into the points of the workspace.
+	float* points = reserveWorkspacePoints(workspaceModel, totalPoints);
+	gpuErrorCheck(cudaMemcpy(points, rawPoints, totalBytes, cudaMemcpyDeviceToHost));
+	gpuErrorCheck(cudaFree(rawPoints));
+	workspaceModel.GetPoints()->Modified();
 }
 
-void computeMK3Workspace_cone(ModelData& workspaceModel, float separation, 
+void fi3d::CUDA::computeMK3Workspace_cone(ModelData& workspaceModel, float separation, 
 	float dmin, float dmax, float range, int insertions, int rotations) 
 {
-	//if (insertions > 1024) {
-	//	insertions = 1024;
-	//}
-	//if (rotations > 1024) {
-	//	rotations = 1024;
-	//}
+	insertions = std::min(std::max(insertions, 1), 1024);
+	rotations = std::min(std::max(rotations, 1), 1024);
+
+	float szInsertions = (dmax - dmin) / (float)insertions;
+	float szRotations = 6.28318f / (float)rotations;
+	int totalPoints = insertions * rotations;
+	size_t totalBytes = totalPoints * 3 * sizeof(float);
 
-	//float szInsertions = (dmax - dmin) / (float)insertions;
-	//float szRotations = 6.28318f / (float)rotations;
-	//int totalPoints = insertions * rotations;
+	float *rawPoints = 0;
+	gpuErrorCheck(cudaMalloc(&rawPoints, totalBytes));
+	computeMK3Workspace_cone_cuda<<<insertions, rotations>>>(rawPoints, szInsertions, szRotations, separation, range, dmin, dmax);
+	gpuErrorCheck(cudaPeekAtLastError());
 
-	//float *rawPoints = 0;
-	//gpuErrorCheck(cudaMallocManaged(&rawPoints, totalPoints * workspaceModel.getPointSize()));
-	//gpuErrorCheck(cudaMemset(rawPoints, 0, totalPoints * workspaceModel.getPointSize()));
-	//computeMK3Workspace_cone_cuda<<<insertions, rotations>>>(rawPoints, szInsertions, szRotations, separation, range, dmin, dmax);
-	//gpuErrorCheck(cudaPeekAtLastError());
-	//gpuErrorCheck(cudaDeviceSynchronize());
-	////TODO: Change so that all data is copied at once instead of point per point.
-	//for (int i = 0; i < totalPoints; i++) {
-	//	int pos = i * 3;
-	//	workspaceModel.addPoint(rawPoints[pos], rawPoints[pos + 1], rawPoints[pos + 2]);
-	//}
-	//gpuErrorCheck(cudaFree(rawPoints));
+	// Copied at once into the points of the workspace.
+	float* points = reserveWorkspacePoints(workspaceModel, totalPoints);
+	gpuErrorCheck(cudaMemcpy(points, rawPoints, totalBytes, cudaMemcpyDeviceToHost));
+	gpuErrorCheck(cudaFree(rawPoints));
+	workspaceModel.GetPoints()->Modified();
 }
 
 #endif
\ No newline at end of file
@@ -3,19 +3,39 @@
 #include <fi3d/logger/Logger.h>
 
 #include <fi3d/CUDA/cuda_helpers.h>
+#include <fi3d/CUDA/cpu_computations.h>
 
 using namespace fi3d::CUDA;
 
 void fi3d::CUDA::computeMK3Workspace_sphere(fi3d::ModelData& workspaceModel, float separation, 
 	float depth, float range, int translations, int rotations) 
 {
-	qWarning() << "CUDA was not enabled for this build. GPU functions are disabled";
+	// The same limits as the CUDA build, where they are the threads of a block.
+	translations = qBound(1, translations, 1024);
+	rotations = qBound(1, rotations, 1024);
+
+	float szTranslation = range / (float)translations;
+	float szRotation = 6.28318f / (float)rotations;
+	int totalPoints = translations * rotations;
+
+	float* points = reserveWorkspacePoints(workspaceModel, totalPoints);
+	computeMK3Workspace_sphere_cpu(points, translations, rotations, szTranslation, szRotation, separation, depth);
+	workspaceModel.GetPoints()->Modified();
 }
 
 void fi3d::CUDA::computeMK3Workspace_cone(fi3d::ModelData& workspaceModel, float separation, float dmin, float dmax,
 		float range, int insertions, int rotations) 
 {
-	qWarning() << "CUDA was not enabled for this build. GPU functions are disabled";
+	insertions = qBound(1, insertions, 1024);
+	rotations = qBound(1, rotations, 1024);
+
+	float szInsertions = (dmax - dmin) / (float)insertions;
+	float szRotations = 6.28318f / (float)rotations;
+	int totalPoints = insertions * rotations;
+
+	float* points = reserveWorkspacePoints(workspaceModel, totalPoints);
+	computeMK3Workspace_cone_cpu(points, insertions, rotations, szInsertions, szRotations, separation, range, dmin);
+	workspaceModel.GetPoints()->Modified();
 }
 
 #endif
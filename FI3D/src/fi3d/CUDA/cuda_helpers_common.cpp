@@ -0,0 +1,29 @@
+#include <fi3d/CUDA/cuda_helpers.h>
+
+#include <vtkDataArray.h>
+#include <vtkNew.h>
+
+using namespace fi3d;
+
+float* fi3d::CUDA::reserveWorkspacePoints(ModelData& workspace, const vtkIdType& count) {
+	vtkPoints* points = workspace.GetPoints();
+	vtkIdType first = 0;
+	if (points != Q_NULLPTR) {
+		first = points->GetNumberOfPoints();
+	}
+
+	// The points are written as floats, the type the kernels compute.
+	if (points == Q_NULLPTR || points->GetDataType() != VTK_FLOAT) {
+		vtkNew<vtkPoints> floatPoints;
+		floatPoints->SetDataTypeToFloat();
+		floatPoints->SetNumberOfPoints(first);
+		for (vtkIdType i = 0; i < first; i++) {
+			floatPoints->SetPoint(i, points->GetPoint(i));
+		}
+		workspace.SetPoints(floatPoints);
+		points = floatPoints;
+	}
+
+	points->SetNumberOfPoints(first + count);
+	return static_cast<float*>(points->GetData()->GetVoidPointer(first * 3));
+}
@@ -4,14 +4,17 @@
 
 #include <fi3d/data/EData.h>
 #include <fi3d/data/Filer.h>
+#include <fi3d/data/data_manager/crawler/DicomScanCache.h>
 #include <fi3d/data/data_manager/gui/StudySelectorDialog.h>
 
 #include <fi3d/modules/ModuleFactory.h>
+#include <fi3d/utilities/ImageAlgorithms.h>
 
 #include <QAction>
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QJsonObject>
+#include <QFile>
 #include <QFileDialog>
 #include <QMenu>
 #include <QMessageBox>
@@ -24,74 +27,38 @@
 #include <vtkImageMapToColors.h>
 #include <vtkLookupTable.h>
 #include <vtkNew.h>
-#include <vtkImageResize.h>
 
 using namespace fi3d;
 
 /*************************** Helper Functions ***************************/
-inline void createThumbnail(RegisteredStudyPtr regStudy) {
-	if (regStudy.isNull() || regStudy->getStudy().isNull()) {
-		return;
-	}
-
-	StudyPtr study = regStudy->getStudy();
-
-	if (study->getSeriesCount() == 0 ||
-		study->getThumbnail().Get() != Q_NULLPTR) {
-		return;
+/// @brief Converts the files of each series for the catalog.
+inline QVector<QStringList> toPathLists(const QVector<vtkSmartPointer<vtkStringArray>>& seriesPaths) {
+	QVector<QStringList> pathLists;
+	pathLists.reserve(seriesPaths.count());
+	for (vtkStringArray* paths : seriesPaths) {
+		QStringList files;
+		files.reserve(paths->GetNumberOfValues());
+		for (vtkIdType i = 0; i < paths->GetNumberOfValues(); i++) {
+			files.append(QString::fromStdString(paths->GetValue(i)));
+		}
+		pathLists.append(files);
 	}
+	return pathLists;
+}
 
-	int middleSeriesIndex = study->getSeriesCount() / 2;
-	SeriesDataVPtr series = study->getSeries(middleSeriesIndex);
-
-	int* dims = series->GetDimensions();
-	double* spacing = series->GetSpacing();
-
-	int xy = dims[0] * dims[1];
-	int yz = dims[1] * dims[2];
-	int xz = dims[0] * dims[2];
-
-	ImageDataVPtr thumbnail = ImageDataVPtr::New();
-	//if (xy >= yz && xy >= xz) {				// Transverse Slice
-	//	if (xy == 0) {
-	//		return;
-	//	}
-
-	//	thumbnail->SetDimensions(dims[0], dims[1], 1);
-	//	thumbnail->SetSpacing(spacing[0], spacing[1], spacing[2]);
-	//} else if (yz >= xy && yz >= xz) {		// Sagittal Slice
-	//	if (yz == 0) {
-	//		return;
-	//	}
-
-	//	thumbnail->SetDimensions(dims[1], dims[2], 1);
-	//	thumbnail->SetSpacing(spacing[1], spacing[2], spacing[0]);
-	//} else {								// Coronal Slice
-	//	if (xz == 0) {
-	//		return;
-	//	}
-
-	//	thumbnail->SetDimensions(dims[0], dims[2], 1);
-	//	thumbnail->SetSpacing(spacing[0], spacing[2], spacing[1]);
-	//}
-
-	vtkNew<vtkImageResize> resizer;
-	resizer->SetInputData(series);
-	resizer->SetOutput(thumbnail);
-	resizer->SetOutputDimensions(64, 64, 1);
-	resizer->Update();
-
-	study->setThumbnail(thumbnail);
-
-	if (regStudy->isPersistent()) {
-		QString id = regStudy->getDataID().toString();
-
-		QString directory = QObject::tr("%1/FI3D/thumbnails").arg(FI3D_DATA_PATH);
-
-		Filer::checkAndCreateDirectory(directory);
-		QString filepath = QObject::tr("%1/%2.jpg").arg(directory).arg(id);
-		Filer::saveImageDataAsJPG(thumbnail, filepath);
+/// @brief Converts the files of each series from the catalog for vtkDICOMReader.
+inline QVector<vtkSmartPointer<vtkStringArray>> toSeriesPaths(const QVector<QStringList>& pathLists) {
+	QVector<vtkSmartPointer<vtkStringArray>> seriesPaths;
+	seriesPaths.reserve(pathLists.count());
+	for (const QStringList& files : pathLists) {
+		vtkSmartPointer<vtkStringArray> paths = vtkSmartPointer<vtkStringArray>::New();
+		paths->SetNumberOfValues(files.count());
+		for (int i = 0; i < files.count(); i++) {
+			paths->SetValue(i, files.at(i).toStdString());
+		}
+		seriesPaths.append(paths);
 	}
+	return seriesPaths;
 }
 
 /************************ FI3D Componenet Members ************************/
@@ -117,33 +84,24 @@ void DataManager::onLoadDICOMStudy() {
 		return;
 	}
 
-	EDM_State state = DataManager::registerStudies(path, true);
-
-	switch (state.toInt()) {
-	case EDM_State::DATA_NOT_FOUND:
-		{
-			QMessageBox message(INSTANCE->mGUI.data());
-			message.setText("No DICOM studies were found");
-			message.exec();
-		}
-		break;
-	case EDM_State::ALREADY_REGISTERED:
-		{
-			QMessageBox message(INSTANCE->mGUI.data());
-			message.setText("A Study with that ID is already in the system");
-			message.exec();
-		}
-		break;
-	case EDM_State::SUCCESS:
-		break;
-	default:
-		{
-			QMessageBox message(INSTANCE->mGUI.data());
-			message.setText("An error ocurred");
-			message.exec();
-		}
-		break;
+	// The studies show up in the dialog as they are found.
+	DicomCrawler* crawler = DataManager::scanStudies(path, true);
+	if (crawler == Q_NULLPTR) {
+		QMessageBox message(INSTANCE->mGUI.data());
+		message.setText("Another directory is being scanned for DICOM studies");
+		message.exec();
+		return;
 	}
+
+	QObject::connect(
+		crawler, &DicomCrawler::finished,
+		INSTANCE.data(), [crawler]() {
+			if (crawler->getStudies().isEmpty()) {
+				QMessageBox message(INSTANCE->mGUI.data());
+				message.setText("No DICOM studies were found");
+				message.exec();
+			}
+		});
 }
 
 void DataManager::onLoadFI3DStudy() {
@@ -169,9 +127,8 @@ void DataManager::onLoadFI3DStudy() {
 	regStudy->setDataLoaded(true);
 	regStudy->setPersistent(true);
 
-	createThumbnail(regStudy);
-
-	INSTANCE->mRegisteredStudies.insert(dataId, regStudy);
+	INSTANCE->insertStudy(regStudy);
+	INSTANCE->catalogStudy(regStudy);
 
 	INSTANCE->updateDialogStudyList();
 }
@@ -211,7 +168,8 @@ void DataManager::onLoadModel() {
 	regModel->setPersistent(true);
 	regModel->setDataPath(path);
 
-	INSTANCE->mRegisteredModels.insert(model->getDataID(), regModel);
+	INSTANCE->insertModel(regModel);
+	INSTANCE->catalogModel(regModel);
 
 	INSTANCE->updateDialogModelList();
 }
@@ -219,6 +177,17 @@ void DataManager::onLoadModel() {
 DataID DataManager::showStudySelector() {
 	StudySelectorDialog dialog;
 	dialog.setStudies(INSTANCE->mRegisteredStudies.values());
+
+	// Studies found by a running scan are added while the dialog is open.
+	QObject::connect(
+		INSTANCE.data(), &DataManager::addedStudy,
+		&dialog, &StudySelectorDialog::addStudy);
+	QObject::connect(
+		&dialog, &StudySelectorDialog::requestedThumbnails,
+		INSTANCE.data(), &DataManager::onRequestedThumbnails);
+	QObject::connect(
+		INSTANCE->mThumbnails.data(), &ThumbnailService::renderedThumbnail,
+		&dialog, &StudySelectorDialog::setThumbnail);
 	dialog.exec();
 
 	return dialog.getSelectedStudy();
@@ -244,7 +213,7 @@ EDM_State DataManager::registerImageData(ImageDataVPtr image) {
 	RegisteredImagePtr regImage(new RegisteredImage(image));
 	regImage->setRegistered(true);
 	regImage->setDataLoaded(true);
-	INSTANCE->mRegisteredImages.insert(regImage->getDataID(), regImage);
+	INSTANCE->insertImage(regImage);
 
 	qDebug() << "Exit";
 	return EDM_State::UNKNOWN;
@@ -267,9 +236,20 @@ EDM_State DataManager::registerStudy(StudyPtr study) {
 	regStudy->setRegistered(true);
 	regStudy->setDataLoaded(true);
 
-	createThumbnail(regStudy);
+	INSTANCE->insertStudy(regStudy);
 
-	INSTANCE->mRegisteredStudies.insert(dataId, regStudy);
+	INSTANCE->updateDialogStudyList();
+	return EDM_State::SUCCESS;
+}
+
+EDM_State DataManager::unregisterStudy(const DataID& dataID) {
+	RegisteredStudyPtr regStudy = INSTANCE->mRegisteredStudies.value(dataID);
+	if (regStudy.isNull()) {
+		return EDM_State::DATA_NOT_FOUND;
+	}
+
+	INSTANCE->removeStudy(regStudy);
+	INSTANCE->mUsedQUuIDs.remove(dataID);
 
 	INSTANCE->updateDialogStudyList();
 	return EDM_State::SUCCESS;
@@ -294,7 +274,7 @@ EDM_State DataManager::registerModelData(ModelDataVPtr model) {
 	RegisteredModelPtr regModel(new RegisteredModel(model));
 	regModel->setRegistered(true);
 	regModel->setDataLoaded(true);
-	INSTANCE->mRegisteredModels.insert(regModel->getDataID(), regModel);
+	INSTANCE->insertModel(regModel);
 
 	INSTANCE->updateDialogModelList();
 
@@ -362,20 +342,118 @@ EDM_State DataManager::registerStudies(const QString& directory, const bool& isP
 		studies[i]->setDataQUuID(dataId);
 
 		DataManager::loadStudyData(regStudy);
-		createThumbnail(regStudy);
 
-		INSTANCE->mRegisteredStudies.insert(dataId, regStudy);
+		INSTANCE->insertStudy(regStudy);
+		if (isPersistent) {
+			INSTANCE->catalogStudy(regStudy);
+		}
 	}
 
 	INSTANCE->updateDialogStudyList();
 	return EDM_State::SUCCESS;
 }
 
+DicomCrawler* DataManager::scanStudies(const QString& directory, const bool& isPersistent) {
+	if (!INSTANCE->mCrawler.isNull() && INSTANCE->mCrawler->isRunning()) {
+		qWarning() << "Failed to scan" << directory << "because" <<
+			INSTANCE->mCrawler->getDirectory() << "is being scanned.";
+		return Q_NULLPTR;
+	}
+
+	INSTANCE->mCrawler.reset(new DicomCrawler(directory, DicomScanCache::getDefaultPath()));
+	INSTANCE->mIsCrawlPersistent = isPersistent;
+	INSTANCE->mCrawledStudies.clear();
+	INSTANCE->mPendingStudyLoads.clear();
+
+	QObject::connect(
+		INSTANCE->mCrawler.data(), &DicomCrawler::foundStudy,
+		INSTANCE.data(), &DataManager::onFoundStudy);
+	QObject::connect(
+		INSTANCE->mCrawler.data(), &DicomCrawler::finished,
+		INSTANCE.data(), &DataManager::onCrawlFinished);
+
+	INSTANCE->mCrawler->start();
+	return INSTANCE->mCrawler.data();
+}
+
+void DataManager::onFoundStudy(const DicomStudyRecord& record) {
+	// Only studies sharing the StudyID need to be compared.
+	if (!this->findStudyByStudyID(record.StudyID).isNull()) {
+		for (RegisteredStudyPtr registered : mRegisteredStudies.values()) {
+			StudyPtr study = registered->getStudy();
+			if (study->getStudyID() == record.StudyID && study->getPatientID() == record.PatientID) {
+				qDebug() << "Skipping found study" << record.StudyID << "because it is registered.";
+				return;
+			}
+		}
+	}
+
+	StudyPtr study = DicomCrawler::createStudy(record);
+	QUuid dataId = this->generateUniqueQUuID();
+	mUsedQUuIDs.insert(dataId, study->getStudyID());
+	study->setDataQUuID(dataId);
+
+	RegisteredStudyPtr regStudy(new RegisteredStudy(study));
+	regStudy->setRegistered(true);
+	regStudy->setPersistent(mIsCrawlPersistent);
+	regStudy->setDataLoaded(false);
+
+	this->insertStudy(regStudy);
+	mCrawledStudies.insert(record.StudyUID.isEmpty() ? record.StudyID : record.StudyUID, regStudy);
+
+	// The signal may be handled after the crawl is done.
+	if (!mCrawler->isRunning()) {
+		this->onCrawlFinished();
+	}
+
+	emit addedStudy(regStudy);
+	this->updateDialogStudyList();
+}
+
+void DataManager::onCrawlFinished() {
+	if (mCrawler.isNull() || mCrawledStudies.isEmpty()) {
+		return;
+	}
+
+	for (const DicomStudyRecord& record : mCrawler->getStudies()) {
+		QString key = record.StudyUID.isEmpty() ? record.StudyID : record.StudyUID;
+		RegisteredStudyPtr regStudy = mCrawledStudies.value(key);
+		if (!regStudy.isNull()) {
+			regStudy->setAsDICOMStudy(DicomCrawler::getSeriesPaths(record));
+			if (regStudy->isPersistent()) {
+				this->catalogStudy(regStudy);
+			}
+		}
+	}
+	mCrawledStudies.clear();
+
+	// The studies asked for during the crawl have their files now.
+	QList<RegisteredStudyPtr> pendingLoads = mPendingStudyLoads;
+	mPendingStudyLoads.clear();
+	for (RegisteredStudyPtr regStudy : pendingLoads) {
+		DataManager::loadStudyData(regStudy);
+	}
+}
+
 void DataManager::loadStudyData(RegisteredStudyPtr regStudy) {
 	if (regStudy->getStudy().isNull() || regStudy->isDataLoaded()) {
 		return;
 	}
 
+	// A study found by a running scan only has its files once the scan is done.
+	if (INSTANCE->mCrawledStudies.values().contains(regStudy)) {
+		if (INSTANCE->mCrawler->isRunning()) {
+			qInfo() << "Loading study" << regStudy->getStudy()->getStudyID() << "once the scan of" <<
+				INSTANCE->mCrawler->getDirectory() << "is done.";
+			if (!INSTANCE->mPendingStudyLoads.contains(regStudy)) {
+				INSTANCE->mPendingStudyLoads.append(regStudy);
+			}
+			return;
+		}
+		INSTANCE->onCrawlFinished();
+	}
+
+	INSTANCE->restoreDICOMPaths(regStudy);
 	if (regStudy->isDICOMStudy()) {
 		Filer::readStudyDataFromDICOMs(regStudy->getDICOMPaths(), regStudy->getStudy());
 		regStudy->setDataLoaded(true);
@@ -399,8 +477,12 @@ EDM_State DataManager::updateImageDataPersistantState(const DataID& dataID,
 		return EDM_State::SUCCESS;
 	}
 
-	//TODO: This changes the persistent list. Need a way to update that.
 	regImage->setPersistent(isPersistent);
+	if (isPersistent) {
+		INSTANCE->catalogImage(regImage);
+	} else {
+		INSTANCE->mCatalog->remove(dataID);
+	}
 
 	return EDM_State::SUCCESS;
 }
@@ -415,8 +497,14 @@ EDM_State DataManager::updateStudyPersistantState(const DataID& dataID, const bo
 		return EDM_State::SUCCESS;
 	}
 
-	//TODO: This changes the persistent list. Need a way to update that.
+	// The files must be read before the catalog drops them.
+	INSTANCE->restoreDICOMPaths(regStudy);
 	regStudy->setPersistent(isPersistent);
+	if (isPersistent) {
+		INSTANCE->catalogStudy(regStudy);
+	} else {
+		INSTANCE->mCatalog->remove(dataID);
+	}
 
 	return EDM_State::SUCCESS;
 }
@@ -431,8 +519,12 @@ EDM_State DataManager::updateModelDataPersistantState(const DataID& dataName, co
 		return EDM_State::SUCCESS;
 	}
 
-	//TODO: This changes the persistent list. Need a way to update that.
 	regModel->setPersistent(isPersistent);
+	if (isPersistent) {
+		INSTANCE->catalogModel(regModel);
+	} else {
+		INSTANCE->mCatalog->remove(dataName);
+	}
 
 	return EDM_State::SUCCESS;
 }
@@ -450,16 +542,15 @@ ImageDataVPtr DataManager::getImageData(const DataID& dataID) {
 }
 
 ImageDataVPtr DataManager::getImageDataByName(const QString& dataName) {
-	for (RegisteredImagePtr image : INSTANCE->mRegisteredImages.values()) {
-		if (image->getImageData()->getDataName() == dataName) {
-			if (!image->isDataLoaded()) {
-				// TODO: Load image data
-			}
-			return image->getImageData();
-		}
+	RegisteredImagePtr image = INSTANCE->findImageByName(dataName);
+	if (image.isNull()) {
+		return Q_NULLPTR;
 	}
 
-	return Q_NULLPTR;
+	if (!image->isDataLoaded()) {
+		// TODO: Load image data
+	}
+	return image->getImageData();
 }
 
 ImageDataVPtr DataManager::getDataLessImageData(const DataID& dataID) {
@@ -472,13 +563,11 @@ ImageDataVPtr DataManager::getDataLessImageData(const DataID& dataID) {
 }
 
 ImageDataVPtr DataManager::getDataLessImageDataByName(const QString& dataName) {
-	for (RegisteredImagePtr image : INSTANCE->mRegisteredImages.values()) {
-		if (image->getImageData()->getDataName() == dataName) {
-			return image->getImageData();
-		}
+	RegisteredImagePtr image = INSTANCE->findImageByName(dataName);
+	if (image.isNull()) {
+		return Q_NULLPTR;
 	}
-
-	return Q_NULLPTR;
+	return image->getImageData();
 }
 
 StudyPtr DataManager::getStudy(const DataID& dataID) {
@@ -494,16 +583,15 @@ StudyPtr DataManager::getStudy(const DataID& dataID) {
 }
 
 StudyPtr DataManager::getStudyByStudyID(const QString& studyID) {
-	for (RegisteredStudyPtr study : INSTANCE->mRegisteredStudies.values()) {
-		if (study->getStudy()->getStudyID() == studyID) {
-			if (!study->isDataLoaded()) {
-				DataManager::loadStudyData(study);
-			}
-			return study->getStudy();
-		}
+	RegisteredStudyPtr study = INSTANCE->findStudyByStudyID(studyID);
+	if (study.isNull()) {
+		return Q_NULLPTR;
 	}
 
-	return Q_NULLPTR;
+	if (!study->isDataLoaded()) {
+		DataManager::loadStudyData(study);
+	}
+	return study->getStudy();
 }
 
 StudyPtr DataManager::getDataLessStudy(const DataID& dataID) {
@@ -516,13 +604,11 @@ StudyPtr DataManager::getDataLessStudy(const DataID& dataID) {
 }
 
 StudyPtr DataManager::getDataLessStydtByStudyID(const QString& studyID) {
-	for (RegisteredStudyPtr study : INSTANCE->mRegisteredStudies.values()) {
-		if (study->getStudy()->getStudyID() == studyID) {
-			return study->getStudy();
-		}
+	RegisteredStudyPtr study = INSTANCE->findStudyByStudyID(studyID);
+	if (study.isNull()) {
+		return Q_NULLPTR;
 	}
-
-	return Q_NULLPTR;
+	return study->getStudy();
 }
 
 ModelDataVPtr DataManager::getModelData(const DataID& dataID) {
@@ -539,17 +625,16 @@ ModelDataVPtr DataManager::getModelData(const DataID& dataID) {
 }
 
 ModelDataVPtr DataManager::getModelDataByName(const QString& dataName) {
-	for (RegisteredModelPtr model : INSTANCE->mRegisteredModels.values()) {
-		if (model->getModelData()->getDataName() == dataName) {
-			if (!model->isDataLoaded()) {
-				Filer::readModelData(model->getDataPath(), model->getModelData());
-				model->setDataLoaded(true);
-			}
-			return model->getModelData();
-		}
+	RegisteredModelPtr model = INSTANCE->findModelByName(dataName);
+	if (model.isNull()) {
+		return Q_NULLPTR;
 	}
 
-	return Q_NULLPTR;
+	if (!model->isDataLoaded()) {
+		Filer::readModelData(model->getDataPath(), model->getModelData());
+		model->setDataLoaded(true);
+	}
+	return model->getModelData();
 }
 
 ModelDataVPtr DataManager::getDataLessModelData(const DataID& dataID) {
@@ -562,42 +647,23 @@ ModelDataVPtr DataManager::getDataLessModelData(const DataID& dataID) {
 }
 
 ModelDataVPtr DataManager::getDataLessModelDataByName(const QString& dataName) {
-	for (RegisteredModelPtr model : INSTANCE->mRegisteredModels.values()) {
-		if (model->getModelData()->getDataName() == dataName) {
-			return model->getModelData();
-		}
+	RegisteredModelPtr model = INSTANCE->findModelByName(dataName);
+	if (model.isNull()) {
+		return Q_NULLPTR;
 	}
-
-	return Q_NULLPTR;
+	return model->getModelData();
 }
 
 bool DataManager::isImageNameTaken(const QString& dataName) {
-	for (RegisteredImagePtr image : INSTANCE->mRegisteredImages.values()) {
-		if (image->getImageData()->getDataName() == dataName) {
-			return true;
-		}
-	}
-	return false;
+	return !INSTANCE->findImageByName(dataName).isNull();
 }
 
 bool DataManager::isStudyIDTaken(const QString& studyID) {
-	for (RegisteredStudyPtr study : INSTANCE->mRegisteredStudies.values()) {
-		if (study->getStudy()->getStudyID() == studyID) {
-			return true;
-		}
-	}
-
-	return false;
+	return !INSTANCE->findStudyByStudyID(studyID).isNull();
 }
 
 bool DataManager::isModelNameTaken(const QString& dataName) {
-	for (RegisteredModelPtr model : INSTANCE->mRegisteredModels.values()) {
-		if (model->getModelData()->getDataName() == dataName) {
-			return true;
-		}
-	}
-
-	return false;
+	return !INSTANCE->findModelByName(dataName).isNull();
 }
 
 QList<DataID> DataManager::getImageDatas(const bool& persistentOnly) {
@@ -621,6 +687,49 @@ QList<DataID> DataManager::getModelDatas(const bool& persistentOnly) {
 	return INSTANCE->mRegisteredModels.keys();
 }
 
+bool DataManager::startStreamIngest(const QString& streamName, const int& frameCount) {
+	qDebug() << "Enter";
+	DataManager::stopStreamIngest();
+
+	StreamIngestPtr ingest(new StreamIngest(streamName, frameCount));
+	if (!ingest->listen()) {
+		qDebug() << "Exit - Failed to listen";
+		return false;
+	}
+
+	EDM_State state = DataManager::registerStudy(ingest->getStudy());
+	if (state != EDM_State::SUCCESS) {
+		qWarning() << "Failed to register the Study of stream" << streamName << "because:" << state.getName();
+		qDebug() << "Exit - Failed to register";
+		return false;
+	}
+
+	INSTANCE->mStreamIngest = ingest;
+	qDebug() << "Exit";
+	return true;
+}
+
+void DataManager::stopStreamIngest() {
+	if (INSTANCE->mStreamIngest.isNull()) {
+		return;
+	}
+
+	StreamStatistics statistics = INSTANCE->mStreamIngest->getStatistics();
+	qInfo() << "Stream" << INSTANCE->mStreamIngest->getServerName() << "stopped after" <<
+		statistics.WriteCount << "writes," << statistics.DroppedCount << "dropped, latency ms" <<
+		"average" << statistics.AverageLatency << "p50" << statistics.P50Latency <<
+		"p99" << statistics.P99Latency << "max" << statistics.MaxLatency;
+
+	// The Study is unregistered so the stream can be started again by name.
+	DataID dataID = INSTANCE->mStreamIngest->getStudy()->getDataID();
+	INSTANCE->mStreamIngest.clear();
+	DataManager::unregisterStudy(dataID);
+}
+
+StreamIngest* DataManager::getStreamIngest() {
+	return INSTANCE->mStreamIngest.data();
+}
+
 const DataManager* DataManager::getInstance() {
 	return DataManager::INSTANCE.data();
 }
@@ -629,9 +738,17 @@ const DataManager* DataManager::getInstance() {
 DataManager::DataManager()
 	: QObject(),
     M_PERSISTENT_PATH(tr("%1/FI3D/%2").arg(FI3D_DATA_PATH).arg("DM_PersistentData.json")),
+	mCatalog(new DataCatalog(DataCatalog::getDefaultPath())),
 	mUsedQUuIDs(),
 	mRegisteredImages(), mRegisteredStudies(), mRegisteredModels(),
+	mImageNames(), mStudyIDs(), mModelNames(),
 	mMessageEncoder(),
+	mStreamIngest(),
+	mCrawler(),
+	mIsCrawlPersistent(false),
+	mCrawledStudies(),
+	mPendingStudyLoads(),
+	mThumbnails(new ThumbnailService(ThumbnailService::getDefaultDirectory())),
 	mGUI()
 {
 	mMessageEncoder.reset(new DataMessageEncoder(this));
@@ -658,226 +775,380 @@ DataManager::DataManager()
 	QObject::connect(
 		mGUI.data(), &DataManagerDialog::requestedLoadModel, 
 		&DataManager::onLoadModel);
+	QObject::connect(
+		mGUI.data(), &DataManagerDialog::requestedThumbnails,
+		this, &DataManager::onRequestedThumbnails);
+	QObject::connect(
+		mThumbnails.data(), &ThumbnailService::renderedThumbnail,
+		mGUI.data(), &DataManagerDialog::setThumbnail);
 }
 
 DataManager::~DataManager() {
-	this->savePersistentData();
+	// The records of replaced and removed data are only dropped here, since
+	// rewriting the catalog takes as long as reading it.
+	if (mCatalog->isWorthCompacting()) {
+		mCatalog->compact();
+	}
 }
 
 void DataManager::loadPersistantData() {
 	qDebug() << "Enter - Loading Persistent Data";
+	bool isNewCatalog = !QFile::exists(DataCatalog::getDefaultPath());
+	if (!mCatalog->open()) {
+		qWarning() << "Failed to load persistent data because the catalog could not be opened.";
+		return;
+	}
+	if (isNewCatalog) {
+		this->importPersistentJson();
+	}
+
+	for (const CatalogEntry& entry : mCatalog->getEntries()) {
+		if (mUsedQUuIDs.contains(entry.ID)) {
+			qWarning() << "Failed to load persistent data" << entry.ID << "because the data ID is taken";
+			continue;
+		}
+
+		if (entry.Type == EData::IMAGE) {
+			ImageDataVPtr image = ImageDataVPtr::New();
+			image->setDataName(entry.Name);
+			mUsedQUuIDs.insert(entry.ID, image->getDataName());
+			image->setDataQUuID(entry.ID);
+
+			RegisteredImagePtr regImage(new RegisteredImage(image));
+			regImage->setRegistered(true);
+			regImage->setPersistent(true);
+			regImage->setDataLoaded(false);
+			regImage->setDataPath(entry.Path);
+
+			this->insertImage(regImage);
+		} else if (entry.Type == EData::STUDY) {
+			StudyPtr study(new Study(entry.Name));
+			study->setPatientID(entry.PatientID);
+			study->setPatientName(entry.PatientName);
+			study->setStudyDate(entry.StudyDate);
+			study->setStudyTime(entry.StudyTime);
+			mUsedQUuIDs.insert(entry.ID, study->getStudyID());
+			study->setDataQUuID(entry.ID);
+
+			RegisteredStudyPtr regStudy(new RegisteredStudy(study));
+			regStudy->setRegistered(true);
+			regStudy->setPersistent(true);
+			regStudy->setDataLoaded(false);
+
+			// The DICOM files are read from the catalog when the study is loaded.
+			if (entry.IsDICOM) {
+				regStudy->setAsDICOMStudy(QVector<vtkSmartPointer<vtkStringArray>>());
+			} else if (!entry.Path.isEmpty()) {
+				regStudy->setAsFI3DStudy(entry.Path);
+			} else {
+				qWarning() << "Failed to load Study" << regStudy->getDataID() << "because no path data was present.";
+				continue;
+			}
+
+			this->insertStudy(regStudy);
+		} else if (entry.Type == EData::MODEL) {
+			ModelDataVPtr model = ModelDataVPtr::New();
+			model->setDataName(entry.Name);
+			mUsedQUuIDs.insert(entry.ID, model->getDataName());
+			model->setDataQUuID(entry.ID);
+
+			RegisteredModelPtr regModel(new RegisteredModel(model));
+			regModel->setRegistered(true);
+			regModel->setPersistent(true);
+			regModel->setDataLoaded(false);
+			regModel->setDataPath(entry.Path);
+
+			this->insertModel(regModel);
+		}
+	}
+
+	qDebug() << "Exit - Loaded" << mRegisteredImages.count() << "images," << 
+		mRegisteredStudies.count() << "studies and" << mRegisteredModels.count() << "models";
+}
+
+void DataManager::importPersistentJson() {
+	if (!QFile::exists(M_PERSISTENT_PATH)) {
+		return;
+	}
+
+	qDebug() << "Enter - Importing" << M_PERSISTENT_PATH;
 	QString contents = Filer::readTextFile(M_PERSISTENT_PATH).trimmed();
 
 	QJsonParseError errorMessage;
 	QJsonObject config = QJsonDocument::fromJson(contents.toUtf8(), &errorMessage).object();
 	if (errorMessage.error != QJsonParseError::NoError) {
-		qWarning() << "Failed to load persistent file because:" << errorMessage.errorString();
+		qWarning() << "Failed to import persistent file because:" << errorMessage.errorString();
 		return;
 	}
 
-	qDebug() << "Loading Images";
 	QJsonArray images = config.value("Images").toArray();
 	for (int i = 0; i < images.count(); i++) {
 		QJsonObject imageJson = images[i].toObject();
 
-		ImageDataVPtr image = ImageDataVPtr::New();
-		image->setDataName(imageJson.value("DataName").toString());
-		
-		if (mRegisteredImages.contains(image->getDataID())) {
-			qWarning() << "Failed to load persistent ImageData" << 
-				image->getDataID() << "because the image ID is taken";
-			continue;
-		}
-
-		QUuid dataId(imageJson.value("DataID").toString());
-		mUsedQUuIDs.insert(dataId, image->getDataName());
-		image->setDataQUuID(dataId);
-
-		RegisteredImagePtr regImage(new RegisteredImage(image));
-		regImage->setRegistered(true);
-		regImage->setPersistent(true);
-		regImage->setDataLoaded(false);
-		regImage->setDataPath(imageJson.value("Path").toString());
-
-		mRegisteredImages.insert(regImage->getDataID(), regImage);
+		CatalogEntry entry;
+		entry.Type = EData::IMAGE;
+		entry.ID = QUuid(imageJson.value("DataID").toString());
+		entry.Name = imageJson.value("DataName").toString();
+		entry.Path = imageJson.value("Path").toString();
+		mCatalog->put(entry);
 	}
 
-	qDebug() << "Loading studies";
 	QJsonArray studies = config.value("Studies").toArray();
 	for (int i = 0; i < studies.count(); i++) {
 		QJsonObject studyJson = studies[i].toObject();
 
-		StudyPtr study(new Study(studyJson.value("DataName").toString()));
-		if (mRegisteredStudies.contains(study->getDataID())) {
-			qWarning() << "Failed to load persistent Study" << study->getDataID() << "because study ID is taken";
+		CatalogEntry entry;
+		entry.Type = EData::STUDY;
+		entry.ID = QUuid(studyJson.value("DataID").toString());
+		entry.Name = studyJson.value("DataName").toString();
+		entry.PatientID = studyJson.value("PatientID").toString();
+		entry.PatientName = studyJson.value("PatientName").toString();
+		entry.StudyDate = studyJson.value("StudyDate").toString();
+		entry.StudyTime = studyJson.value("StudyTime").toString();
+		entry.SeriesCount = studyJson.value("SeriesCount").toInt();
+		entry.IsDICOM = studyJson.value("isDICOM").toBool();
+
+		QVector<QStringList> dicomPaths;
+		if (entry.IsDICOM) {
+			QJsonArray studyPaths = studyJson.value("DICOMPaths").toArray();
+			for (int j = 0; j < studyPaths.count(); j++) {
+				QStringList files;
+				for (const QJsonValue& path : studyPaths[j].toArray()) {
+					files.append(path.toString());
+				}
+				dicomPaths.append(files);
+			}
+		} else if (studyJson.value("isFI3DFile").toBool()) {
+			entry.Path = studyJson.value("Path").toString();
+		} else {
+			qWarning() << "Failed to import Study" << entry.ID << "because no path data was present.";
 			continue;
 		}
+		mCatalog->put(entry, dicomPaths);
+	}
 
-		study->setPatientID(studyJson.value("PatientID").toString());
-		study->setPatientName(studyJson.value("PatientName").toString());
-		study->setStudyDate(studyJson.value("StudyDate").toString());
-		study->setStudyTime(studyJson.value("StudyTime").toString());
+	QJsonArray models = config.value("Models").toArray();
+	for (int i = 0; i < models.count(); i++) {
+		QJsonObject modelJson = models[i].toObject();
 
-		QUuid dataId(studyJson.value("DataID").toString());
-		mUsedQUuIDs.insert(dataId, study->getStudyID());
-		study->setDataQUuID(dataId);
+		CatalogEntry entry;
+		entry.Type = EData::MODEL;
+		entry.ID = QUuid(modelJson.value("DataID").toString());
+		entry.Name = modelJson.value("DataName").toString();
+		entry.Path = modelJson.value("Path").toString();
+		mCatalog->put(entry);
+	}
 
-		RegisteredStudyPtr regStudy(new RegisteredStudy(study));
-		regStudy->setRegistered(true);
-		regStudy->setPersistent(true);
-		regStudy->setDataLoaded(false);
-		
-		bool isDicom = studyJson.value("isDICOM").toBool();
-		bool isFI3D = studyJson.value("isFI3DFile").toBool();
-		int seriesCount = studyJson.value("SeriesCount").toInt();
+	// Renamed so it is not imported again if the catalog is deleted.
+	QFile::rename(M_PERSISTENT_PATH, M_PERSISTENT_PATH + ".imported");
+	qDebug() << "Exit - Imported" << mCatalog->count() << "entries";
+}
 
-		if (isDicom) {
-			QVector<vtkSmartPointer<vtkStringArray>> dicomFiles;
-			QJsonArray studyPaths = studyJson.value("DICOMPaths").toArray();
-			for (int j = 0; j < studyPaths.count(); j++) {
-				QJsonArray seriesPaths = studyPaths[j].toArray();
-				vtkSmartPointer<vtkStringArray> series = vtkSmartPointer<vtkStringArray>::New();
-				series->SetNumberOfValues(seriesPaths.count());
-				for (int k = 0; k < seriesPaths.count(); k++) {
-					series->SetValue(k, seriesPaths[k].toString().toStdString());
-				}
-				dicomFiles.push_back(series);
-			}
+void DataManager::catalogImage(RegisteredImagePtr regImage) {
+	CatalogEntry entry;
+	entry.Type = EData::IMAGE;
+	entry.ID = regImage->getDataID();
+	entry.Name = regImage->getImageData()->getDataName();
+	entry.Path = regImage->getDataPath();
+	mCatalog->put(entry);
+}
 
-			regStudy->setAsDICOMStudy(dicomFiles);
-		} else if (isFI3D) {
-			QString filePath = studyJson.value("Path").toString();
-			regStudy->setAsFI3DStudy(filePath);
-		} else {
-			qWarning() << "Failed to load Study" << regStudy->getDataID() << "because no path data was present.";
-			return;
-		}
+void DataManager::catalogStudy(RegisteredStudyPtr regStudy) {
+	StudyPtr study = regStudy->getStudy();
 
-		// Load the Thumbanil.
-		QString directory = tr("%1/FI3D/thumbnails").arg(FI3D_DATA_PATH);
-		Filer::checkAndCreateDirectory(directory);
-		QString filePath = tr("%1/%2.jpg").arg(directory).arg(study->getDataID().toString());
+	CatalogEntry entry;
+	entry.Type = EData::STUDY;
+	entry.ID = regStudy->getDataID();
+	entry.Name = study->getStudyID();
+	entry.PatientID = study->getPatientID();
+	entry.PatientName = study->getPatientName();
+	entry.StudyDate = study->getStudyDate();
+	entry.StudyTime = study->getStudyTime();
+	entry.SeriesCount = study->getSeriesCount();
+
+	QVector<QStringList> dicomPaths;
+	if (regStudy->isDICOMStudy()) {
+		entry.IsDICOM = true;
+		dicomPaths = toPathLists(regStudy->getDICOMPaths());
+		entry.SeriesCount = dicomPaths.count();
+	} else if (regStudy->isFI3DStudy()) {
+		entry.Path = regStudy->getFI3DStudyPath();
+	} else {
+		qWarning() << "Failed to save Study:" << study->getDataID() << 
+			"as persistent because no data path is present";
+		return;
+	}
+	mCatalog->put(entry, dicomPaths);
+}
+
+void DataManager::catalogModel(RegisteredModelPtr regModel) {
+	CatalogEntry entry;
+	entry.Type = EData::MODEL;
+	entry.ID = regModel->getDataID();
+	entry.Name = regModel->getModelData()->getDataName();
+	entry.Path = regModel->getDataPath();
+	mCatalog->put(entry);
+}
 
-		ImageDataVPtr thumbnail = Filer::readImageDataFromJPEG(filePath);
-		study->setThumbnail(thumbnail);
+void DataManager::restoreDICOMPaths(RegisteredStudyPtr regStudy) {
+	if (regStudy->isDICOMStudy() && regStudy->getDICOMPaths().isEmpty()) {
+		regStudy->setAsDICOMStudy(toSeriesPaths(mCatalog->readDICOMPaths(regStudy->getDataID())));
+	}
+}
 
-		qDebug() << "Loaded Persistant Study" << study->getStudyID() << 
-			"with DataID:" << study->getDataID().toString();
+void DataManager::insertImage(RegisteredImagePtr regImage) {
+	mRegisteredImages.insert(regImage->getDataID(), regImage);
 
-		mRegisteredStudies.insert(dataId, regStudy);
+	QString dataName = regImage->getImageData()->getDataName();
+	if (!mImageNames.contains(dataName)) {
+		mImageNames.insert(dataName, regImage->getDataID());
 	}
+}
 
-	qDebug() << "Loading Models";
-	QJsonArray models = config.value("Models").toArray();
-	for (int i = 0; i < models.count(); i++) {
-		QJsonObject modelJson = models[i].toObject();
+void DataManager::insertStudy(RegisteredStudyPtr regStudy) {
+	mRegisteredStudies.insert(regStudy->getDataID(), regStudy);
 
-		ModelDataVPtr model = ModelDataVPtr::New();
-		model->setDataName(modelJson.value("DataName").toString());
-		if (mRegisteredModels.contains(model->getDataID())) {
-			qWarning() << "Failed to load persistent ModelData" << 
-				model->getDataID() << "because the data ID is taken";
-			continue;
-		}
-		QUuid dataId(modelJson.value("DataID").toString());
-		mUsedQUuIDs.insert(dataId, model->getDataName());
-		model->setDataQUuID(dataId);
+	QString studyID = regStudy->getStudy()->getStudyID();
+	if (!mStudyIDs.contains(studyID)) {
+		mStudyIDs.insert(studyID, regStudy->getDataID());
+	}
+}
 
-		RegisteredModelPtr regModel(new RegisteredModel(model));
-		regModel->setRegistered(true);
-		regModel->setPersistent(true);
-		regModel->setDataLoaded(false);
-		regModel->setDataPath(modelJson.value("Path").toString());
+void DataManager::insertModel(RegisteredModelPtr regModel) {
+	mRegisteredModels.insert(regModel->getDataID(), regModel);
 
-		mRegisteredModels.insert(regModel->getDataID(), regModel);
+	QString dataName = regModel->getModelData()->getDataName();
+	if (!mModelNames.contains(dataName)) {
+		mModelNames.insert(dataName, regModel->getDataID());
 	}
+}
 
-	qDebug() << "Exit";
+void DataManager::removeStudy(RegisteredStudyPtr regStudy) {
+	mRegisteredStudies.remove(regStudy->getDataID());
+
+	QString studyID = regStudy->getStudy()->getStudyID();
+	if (mStudyIDs.value(studyID) == regStudy->getDataID()) {
+		mStudyIDs.remove(studyID);
+	}
 }
 
-void DataManager::savePersistentData() {
-	QJsonObject config;
+RegisteredImagePtr DataManager::findImageByName(const QString& dataName) {
+	RegisteredImagePtr regImage = mRegisteredImages.value(mImageNames.value(dataName));
+	if (!regImage.isNull() && regImage->getImageData()->getDataName() == dataName) {
+		return regImage;
+	}
 
-	QVariantList images;
-	images.reserve(mRegisteredImages.count());
-	auto imIt = mRegisteredImages.begin();
-	for (; imIt != mRegisteredImages.end(); imIt++) {
-		if (!imIt.value()->isPersistent()) {
-			continue;
+	// Data renamed since it was registered, or registered while another
+	// had its name, is not indexed.
+	mImageNames.remove(dataName);
+	for (RegisteredImagePtr image : mRegisteredImages.values()) {
+		if (image->getImageData()->getDataName() == dataName) {
+			mImageNames.insert(dataName, image->getDataID());
+			return image;
 		}
-		
-		QJsonObject imageJson;
-		imageJson.insert("DataID", imIt.value()->getDataID().toString());
-		imageJson.insert("DataName", imIt.value()->getImageData()->getDataName());
-		imageJson.insert("Path", imIt.value()->getDataPath());
-	}
-	config.insert("Images", QJsonArray::fromVariantList(images));
-
-	QVariantList studies;
-	studies.reserve(mRegisteredStudies.count());
-	auto stIt = mRegisteredStudies.begin();
-	for (; stIt != mRegisteredStudies.end(); stIt++) {
-		if (!stIt.value()->isPersistent()) {
-			continue;
+	}
+	return RegisteredImagePtr();
+}
+
+RegisteredStudyPtr DataManager::findStudyByStudyID(const QString& studyID) {
+	RegisteredStudyPtr regStudy = mRegisteredStudies.value(mStudyIDs.value(studyID));
+	if (!regStudy.isNull() && regStudy->getStudy()->getStudyID() == studyID) {
+		return regStudy;
+	}
+
+	// Studies whose ID changed since they were registered, or registered
+	// while another had their ID, are not indexed.
+	mStudyIDs.remove(studyID);
+	for (RegisteredStudyPtr study : mRegisteredStudies.values()) {
+		if (study->getStudy()->getStudyID() == studyID) {
+			mStudyIDs.insert(studyID, study->getDataID());
+			return study;
 		}
+	}
+	return RegisteredStudyPtr();
+}
 
-		StudyPtr study = stIt.value()->getStudy();
+RegisteredModelPtr DataManager::findModelByName(const QString& dataName) {
+	RegisteredModelPtr regModel = mRegisteredModels.value(mModelNames.value(dataName));
+	if (!regModel.isNull() && regModel->getModelData()->getDataName() == dataName) {
+		return regModel;
+	}
 
-		QJsonObject studyJson;
-		studyJson.insert("DataID", study->getDataID().toString());
-		studyJson.insert("DataName", study->getDataName());
-		studyJson.insert("PatientID", study->getPatientID());
-		studyJson.insert("PatientName", study->getPatientName());
-		studyJson.insert("StudyDate", study->getStudyDate());
-		studyJson.insert("StudyTime", study->getStudyTime());
-		studyJson.insert("SeriesCount", study->getSeriesCount());
-		studyJson.insert("isDICOM", stIt.value()->isDICOMStudy());
-		studyJson.insert("isFI3DFile", stIt.value()->isFI3DStudy());
+	// Data renamed since it was registered, or registered while another
+	// had its name, is not indexed.
+	mModelNames.remove(dataName);
+	for (RegisteredModelPtr model : mRegisteredModels.values()) {
+		if (model->getModelData()->getDataName() == dataName) {
+			mModelNames.insert(dataName, model->getDataID());
+			return model;
+		}
+	}
+	return RegisteredModelPtr();
+}
 
-		
-		if (stIt.value()->isDICOMStudy()) {
-			QJsonArray studyPaths;
-			for (vtkStringArray* paths : stIt.value()->getDICOMPaths()) {
-				QJsonArray seriesPaths;
-				for (int i = 0; i < paths->GetNumberOfValues(); i++) {
-					QString path(paths->GetValue(i));
-					seriesPaths.push_back(path);
-				}
-				studyPaths.push_back(seriesPaths);
-			}
-			studyJson.insert("DICOMPaths", studyPaths);
-		} else if (stIt.value()->isFI3DStudy()) {
-			QString filePath = stIt.value()->getFI3DStudyPath();
-			studyJson.insert("Path", filePath);
-		} else {
-			qWarning() << "Failed to save Study:" << study->getDataID() << 
-				"as persistent because no data path is present";
-			continue;
+void DataManager::onRequestedThumbnails(const QList<DataID>& studies) {
+	for (const DataID& dataID : studies) {
+		RegisteredStudyPtr regStudy = mRegisteredStudies.value(dataID);
+		ThumbnailSource source;
+		if (!regStudy.isNull() && this->getThumbnailSource(regStudy, source)) {
+			mThumbnails->request(dataID, source);
 		}
-		
-		studies.push_back(studyJson);
 	}
-	config.insert("Studies", QJsonArray::fromVariantList(studies));
+}
 
-	QVariantList models;
-	models.reserve(mRegisteredModels.count());
-	auto modIt = mRegisteredModels.begin();
-	for (; modIt != mRegisteredModels.end(); modIt++) {
-		if (!modIt.value()->isPersistent()) {
-			continue;
+bool DataManager::getThumbnailSource(RegisteredStudyPtr regStudy, ThumbnailSource& source) {
+	StudyPtr study = regStudy->getStudy();
+
+	// Studies with their data in memory give the slice itself.
+	if (regStudy->isDataLoaded()) {
+		if (study->getSeriesCount() == 0) {
+			return false;
+		}
+
+		SeriesDataVPtr series = study->getSeries(study->getSeriesCount() / 2);
+		int* dims = series->GetDimensions();
+		if (dims[0] <= 0 || dims[1] <= 0 || dims[2] <= 0) {
+			return false;
+		}
+
+		double window, level;
+		series->getWindowLevel(window, level);
+		source.Width = dims[0];
+		source.Height = dims[1];
+		source.Values.resize((qint64)dims[0] * dims[1]);
+
+		// A partial series only has the slice once copied.
+		vtkSmartPointer<vtkImageData> image = series;
+		int sliceIndex = dims[2] / 2;
+		if (series->isPartial()) {
+			image = vtkSmartPointer<vtkImageData>::New();
+			series->copySlice(sliceIndex, ESliceOrientation::XY, image);
+			sliceIndex = 0;
+		}
+		return ImageAlgorithms::applyWindowLevel(image, sliceIndex, ESliceOrientation::XY,
+			window, level, source.Values.data());
+	}
+
+	this->restoreDICOMPaths(regStudy);
+	if (regStudy->isDICOMStudy()) {
+		QVector<vtkSmartPointer<vtkStringArray>> seriesPaths = regStudy->getDICOMPaths();
+		if (seriesPaths.isEmpty()) {
+			return false;
 		}
 
-		QJsonObject model;
-		model.insert("DataID", modIt.value()->getDataID().toString());
-		model.insert("DataName", modIt.value()->getModelData()->getDataName());
-		model.insert("Path", modIt.value()->getDataPath());
-		models.push_back(model);
+		vtkStringArray* files = seriesPaths.at(seriesPaths.count() / 2);
+		if (files->GetNumberOfValues() == 0) {
+			return false;
+		}
+		source.DICOMFile = QString::fromStdString(files->GetValue(files->GetNumberOfValues() / 2));
+		return true;
+	} else if (regStudy->isFI3DStudy()) {
+		source.FI3DFile = regStudy->getFI3DStudyPath();
+		return true;
 	}
-	config.insert("Models", QJsonArray::fromVariantList(models));
 
-	QJsonDocument doc(config);
-	QString text = doc.toJson();
-	Filer::saveTextFile(text, M_PERSISTENT_PATH);
+	// E.g., a study found by a running scan, whose files are not known yet.
+	return false;
 }
 
 void DataManager::updateDialogImageList() {
@@ -5,7 +5,8 @@ using namespace fi3d;
 DataObject::DataObject() 
 	: QObject(),
 	mID(),
-	mIsCacheable(true)
+	mIsCacheable(true),
+	mDataVersion(0)
 {}
 
 DataObject::~DataObject() {}
@@ -34,7 +35,12 @@ void DataObject::setCacheable(const bool& isCacheable) {
 	emit changedCacheable(mIsCacheable);
 }
 
+qint64 DataObject::getDataVersion() const {
+	return mDataVersion;
+}
+
 void DataObject::dataUpdated() {
+	mDataVersion++;
 	emit changedData();
 }
 
@@ -2,7 +2,10 @@
 
 #include <fi3d/logger/Logger.h>
 #include <fi3d/data/EData.h>
+#include <fi3d/data/data_manager/crawler/DicomCrawler.h>
+#include <fi3d/data/data_manager/crawler/DicomScanCache.h>
 #include <fi3d/FI3D/FI3D.h>
+#include <fi3d/utilities/ImageAlgorithms.h>
 
 #include <QDir>
 #include <QFile>
@@ -11,9 +14,9 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QObject>
+#include <QVector>
 
-#include <vtkDICOMDirectory.h>
-#include <vtkDICOMItem.h>
+#include <vtkDICOMMetaData.h>
 #include <vtkDICOMParser.h>
 #include <vtkDICOMReader.h>
 
@@ -28,9 +31,6 @@
 #include <vtkSTLWriter.h>
 #include <vtkPLYWriter.h>
 
-#include <vtkImageMapToColors.h>
-#include <vtkLookupTable.h>
-
 using namespace fi3d;
 
 bool Filer::checkAndCreateDirectory(const QString &dirPath) {
@@ -222,21 +222,11 @@ vtkSmartPointer<ModelData> Filer::readModelDataFromOBJ(const QString& filePath)
 }
 
 vtkSmartPointer<SeriesData> Filer::readSeriesData(vtkSmartPointer<vtkStringArray> dicomFiles) {
+	// The series keeps the intensities of the files, at their own depth.
 	vtkSmartPointer<SeriesData> image = vtkSmartPointer<SeriesData>::New();
-
-	vtkNew<vtkLookupTable> bwLut;
-	bwLut->SetTableRange(0, 1300);
-	bwLut->SetSaturationRange(0, 0);
-	bwLut->SetHueRange(0, 0);
-	bwLut->SetValueRange(0, 1);
-	// Setting ramp to linear was suggested by Gobbi, creator of vtkDICOM.
-	bwLut->SetRampToLinear();
-	bwLut->Build();
-
-	vtkSmartPointer<SeriesData> readData = vtkSmartPointer<SeriesData>::New();
 	vtkSmartPointer<vtkDICOMReader> reader = vtkSmartPointer<vtkDICOMReader>::New();
 	reader->SetFileNames(dicomFiles);
-	reader->SetOutput(readData);
+	reader->SetOutput(image);
 	reader->Update();
 
 	if (reader->GetFileIndexArray()->GetNumberOfComponents() != 1) {
@@ -244,15 +234,20 @@ vtkSmartPointer<SeriesData> Filer::readSeriesData(vtkSmartPointer<vtkStringArray
 		reader->Update();
 	}
 
-	vtkNew<vtkImageMapToColors> readerColors;
-	readerColors->SetInputData(reader->GetOutput());
-	readerColors->SetLookupTable(bwLut);
-	readerColors->SetOutput(image);
-	readerColors->Update();
-
 	image->setPatientMatrix(reader->GetPatientMatrix());
 	image->setMetaData(reader->GetMetaData());
 
+	// Displays the series with the window/level of its first file if it has
+	// one, otherwise with the range of its intensities.
+	vtkDICOMMetaData* metaData = reader->GetMetaData();
+	if (metaData != Q_NULLPTR && metaData->GetNumberOfInstances() > 0) {
+		const vtkDICOMValue& center = metaData->Get(0, DC::WindowCenter);
+		const vtkDICOMValue& width = metaData->Get(0, DC::WindowWidth);
+		if (center.IsValid() && width.IsValid() && width.AsDouble() > 0) {
+			image->setWindowLevel(width.AsDouble(), center.AsDouble());
+		}
+	}
+
 	return image;
 }
 
@@ -260,81 +255,17 @@ QList<StudyPtr> Filer::findStudies(const QString& directoryPath,
 	QVector<QVector<vtkSmartPointer<vtkStringArray>>>& outStudiesPaths)
 {
 	qDebug() << "Enter - Searching studies from directory: " << directoryPath;
-	QList<StudyPtr> studies;
-
-	QDir currentDir(directoryPath);
-	QStringList dirs = currentDir.entryList(QDir::AllDirs | QDir::NoSymLinks);
-	for (QString dir : dirs) {
-		if (dir == "." || dir == "..") {
-			continue;
-		}
 
-		QVector<QVector<vtkSmartPointer<vtkStringArray>>> studyPaths;
-		QString dirPath = QObject::tr("%1/%2").arg(directoryPath).arg(dir);
-		QList<StudyPtr> foundStudies = Filer::findStudies(dirPath, studyPaths);
+	DicomCrawler crawler(directoryPath, DicomScanCache::getDefaultPath());
+	QList<DicomStudyRecord> records = crawler.crawl();
 
-		outStudiesPaths.append(studyPaths);
-		studies.append(foundStudies);
-	}
-
-	vtkNew<vtkDICOMDirectory> dicomFinder;
-	dicomFinder->SetDirectoryName(directoryPath.toStdString().c_str());
-	// Only looks for studies that have pixel data
-	dicomFinder->RequirePixelDataOn();		
-	dicomFinder->SetScanDepth(1);
-	dicomFinder->FollowSymlinksOff();
-	dicomFinder->Update();
-
-	int studyCount = dicomFinder->GetNumberOfStudies();
-	if (studyCount == 0) {
-		qDebug() << "Exit - no studies found.";
-		return studies;
-	}
-
-	QString studyID;
-	if (directoryPath.contains('/')) {
-		studyID = directoryPath.section('/', -1);
-	} else {
-		studyID = directoryPath;
-	}
-
-	for (int i = 0; i < studyCount; i++) {
-		StudyPtr study(new Study());
-
-		vtkDICOMItem patientMD = dicomFinder->GetPatientRecordForStudy(i);
-		vtkDICOMItem studyMD = dicomFinder->GetStudyRecord(i);
-		study->setPatientName(QString::fromStdString(patientMD.Get(DC::PatientName).AsString()));
-		study->setPatientID(QString::fromStdString(patientMD.Get(DC::PatientID).AsString()));
-		study->setStudyDate(QString::fromStdString(studyMD.Get(DC::StudyDate).AsString()));
-		study->setStudyTime(QString::fromStdString(studyMD.Get(DC::StudyTime).AsString()));
-
-		QString studyIDMD = QString::fromStdString(studyMD.Get(DC::StudyID).AsString());
-
-		if (studyIDMD.isEmpty()) {
-			if (studyCount == 1) {
-				studyIDMD = studyID;
-			} else {
-				studyIDMD = QObject::tr("%1_%2").arg(studyID).arg(i);
-			}
-		}
-
-		study->setStudyID(studyIDMD);
-
-		// Get the start and end indices for the series of the study
-		int startIndex = dicomFinder->GetFirstSeriesForStudy(i);
-		int endIndex = dicomFinder->GetLastSeriesForStudy(i);
-
-		QVector<vtkSmartPointer<vtkStringArray>> dicomFiles;
-		for (int j = startIndex; j <= endIndex; j++) {
-			vtkSmartPointer<vtkStringArray> foundFiles = dicomFinder->GetFileNamesForSeries(j);
-			dicomFiles.push_back(foundFiles);
-		}
-
-		outStudiesPaths.append(dicomFiles);
-		studies.push_back(study);
+	QList<StudyPtr> studies;
+	for (const DicomStudyRecord& record : records) {
+		studies.append(DicomCrawler::createStudy(record));
+		outStudiesPaths.append(DicomCrawler::getSeriesPaths(record));
 	}
 
-	qDebug() << "Exit - found" << studyCount << "studies";
+	qDebug() << "Exit - found" << studies.count() << "studies";
 	return studies;	
 }
 
@@ -450,87 +381,57 @@ void Filer::saveImageDataAsJPGs(ImageData* imageData,
 		QDir().mkdir(directory);
 	}
 
-	// Save the corresponding slices to the directory.
+	// Save the corresponding slices to the directory, with the intensities
+	// mapped through the window/level of the image.
 	int* dims = imageData->GetDimensions();
+	int sliceCount, sliceDims[3] = {dims[0], dims[1], dims[2]};
 	switch (sliceOrientation.toInt()) {
 		case ESliceOrientation::XY:
-			{
-				for (int i = 0; i < dims[2]; i++) {
-					ImageDataVPtr result = ImageDataVPtr::New();
-					result->SetDimensions(dims[0], dims[1], 1);
-					result->AllocateScalars(VTK_UNSIGNED_CHAR, 3);
-
-					for (int x = 0; x < dims[0]; x++) {
-						for (int y = 0; y < dims[1]; y++) {
-							unsigned char value = static_cast<unsigned char*>(imageData->GetScalarPointer(x, y, i))[0];
-							unsigned char* pixel = static_cast<unsigned char*>(result->GetScalarPointer(x, y, 0));
-							pixel[0] = value;
-							pixel[1] = value;
-							pixel[2] = value;
-						}
-					}
-
-					QString fileName = QObject::tr("%1/%2_%3.jpg").arg(directory).arg(fileName).arg(i);
-
-					vtkNew<vtkJPEGWriter> writer;
-					writer->SetInputData(result);
-					writer->SetFileName(fileName.toStdString().c_str());
-					writer->Write();
-				}
-			}
+			sliceCount = dims[2];
+			sliceDims[2] = 1;
 			break;
 		case ESliceOrientation::YZ:
-			{
-				for (int i = 0; i < dims[0]; i++) {
-					ImageDataVPtr result = ImageDataVPtr::New();
-					result->SetDimensions(1, dims[1], dims[2]);
-					result->AllocateScalars(VTK_UNSIGNED_CHAR, 3);
-
-					for (int y = 0; y < dims[1]; y++) {
-						for (int z = 0; z < dims[2]; z++) {
-							unsigned char value = static_cast<unsigned char*>(imageData->GetScalarPointer(i, y, z))[0];
-							unsigned char* pixel = static_cast<unsigned char*>(result->GetScalarPointer(0, y, z));
-							pixel[0] = value;
-							pixel[1] = value;
-							pixel[2] = value;
-						}
-					}
-
-					QString fileName = QObject::tr("%1/%2_%3.jpg").arg(directory).arg(fileName).arg(i);
-
-					vtkNew<vtkJPEGWriter> writer;
-					writer->SetInputData(result);
-					writer->SetFileName(fileName.toStdString().c_str());
-					writer->Write();
-				}
-			}
+			sliceCount = dims[0];
+			sliceDims[0] = 1;
 			break;
 		case ESliceOrientation::XZ:
-			{
-				for (int i = 0; i < dims[1]; i++) {
-					ImageDataVPtr result = ImageDataVPtr::New();
-					result->SetDimensions(dims[0], 1, dims[2]);
-					result->AllocateScalars(VTK_UNSIGNED_CHAR, 3);
-
-					for (int x = 0; x < dims[0]; x++) {
-						for (int z = 0; z < dims[2]; z++) {
-							unsigned char value = static_cast<unsigned char*>(imageData->GetScalarPointer(x, i, z))[0];
-							unsigned char* pixel = static_cast<unsigned char*>(result->GetScalarPointer(x, 0, z));
-							pixel[0] = value;
-							pixel[1] = value;
-							pixel[2] = value;
-						}
-					}
-
-					QString fileName = QObject::tr("%1/%2_%3.jpg").arg(directory).arg(fileName).arg(i);
-
-					vtkNew<vtkJPEGWriter> writer;
-					writer->SetInputData(result);
-					writer->SetFileName(fileName.toStdString().c_str());
-					writer->Write();
-				}
-			}
+			sliceCount = dims[1];
+			sliceDims[1] = 1;
 			break;
+		default:
+			return;
+	}
+
+	double window, level;
+	imageData->getWindowLevel(window, level);
+
+	// The windowed slice follows the memory order of the JPG image.
+	const qint64 pixelCount = (qint64)sliceDims[0] * sliceDims[1] * sliceDims[2];
+	QVector<float> values(pixelCount);
+	for (int i = 0; i < sliceCount; i++) {
+		if (!ImageAlgorithms::applyWindowLevel(imageData, i, sliceOrientation,
+			window, level, values.data()))
+		{
+			break;
+		}
+
+		ImageDataVPtr result = ImageDataVPtr::New();
+		result->SetDimensions(sliceDims);
+		result->AllocateScalars(VTK_UNSIGNED_CHAR, 3);
+		unsigned char* pixel = static_cast<unsigned char*>(result->GetScalarPointer());
+		for (qint64 p = 0; p < pixelCount; p++) {
+			unsigned char value = static_cast<unsigned char>(values.at(p) * 255.0f + 0.5f);
+			pixel[3 * p] = value;
+			pixel[3 * p + 1] = value;
+			pixel[3 * p + 2] = value;
+		}
+
+		QString slicePath = QObject::tr("%1/%2_%3.jpg").arg(directory).arg(fileName).arg(i);
+
+		vtkNew<vtkJPEGWriter> writer;
+		writer->SetInputData(result);
+		writer->SetFileName(slicePath.toStdString().c_str());
+		writer->Write();
 	}
 	qDebug() << "Exit";
 }
@@ -558,7 +459,11 @@ void Filer::saveStudyAsFI3DFile(const StudyPtr study, const QString& filePath) {
 	QVariantList seriesList;
 	seriesList.reserve(study->getSeriesCount());
 	for (int i = 0; i < study->getSeriesCount(); i++) {
-		vtkSmartPointer<SeriesData> series = study->getSeries(i);
+		vtkSmartPointer<SeriesData> series = study->getContiguousSeries(i);
+		if (series.Get() == Q_NULLPTR) {
+			qWarning() << "Failed to save study:" << study->getStudyID() << "because series" << i << "could not be read.";
+			return;
+		}
 		int* dims = series->GetDimensions();
 		double* spac = series->GetSpacing();
 		vtkSmartPointer<vtkMatrix4x4> patientMatrix = series->getPatientMatrix();
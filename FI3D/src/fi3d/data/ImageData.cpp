@@ -1,13 +1,20 @@
 #include <fi3d/data/ImageData.h>
 
+#include <fi3d/logger/Logger.h>
+
 #include <vtkObjectFactory.h>
+#include <vtkPointData.h>
 
 using namespace fi3d;
 
 vtkStandardNewMacro(ImageData)
 
 ImageData::ImageData()
-	: DataObject()
+	: DataObject(),
+	mDirtyExtents(),
+	mWindow(255.0),
+	mLevel(127.5),
+	mHasWindowLevel(false)
 {
 }
 
@@ -27,3 +34,163 @@ ImageDataVPtr ImageData::createImageData(
 		
 	return data;
 }
+
+bool ImageData::isPartial() const {
+	return false;
+}
+
+void ImageData::copySlice(const int& sliceIndex,
+	const ESliceOrientation& orientation, vtkImageData* slice)
+{
+	if (!this->prepareSliceImage(sliceIndex, orientation, slice)) {
+		return;
+	}
+
+	slice->AllocateScalars(this->GetScalarType(), this->GetNumberOfScalarComponents());
+	slice->CopyAndCastFrom(this, slice->GetExtent());
+}
+
+void ImageData::updateExtent(const int extent[6]) {
+	int imageExtent[6];
+	this->GetExtent(imageExtent);
+
+	DirtyExtent dirty;
+	dirty.DataVersion = this->getDataVersion() + 1;
+	for (int axis = 0; axis < 3; axis++) {
+		dirty.Extent[2 * axis] = qMax(extent[2 * axis], imageExtent[2 * axis]);
+		dirty.Extent[2 * axis + 1] = qMin(extent[2 * axis + 1], imageExtent[2 * axis + 1]);
+		if (dirty.Extent[2 * axis] > dirty.Extent[2 * axis + 1]) {
+			qWarning() << "Failed to update extent because it is outside of the image.";
+			return;
+		}
+	}
+
+	mDirtyExtents.append(dirty);
+	while (mDirtyExtents.count() > MAX_DIRTY_EXTENTS) {
+		mDirtyExtents.removeFirst();
+	}
+
+	this->Modified();
+	this->dataUpdated();
+}
+
+void ImageData::updateSlice(const int& sliceIndex, const ESliceOrientation& orientation) {
+	int extent[6];
+	this->GetExtent(extent);
+
+	int axis;
+	switch (orientation.toInt()) {
+		case ESliceOrientation::XY:
+			axis = 2;
+			break;
+		case ESliceOrientation::YZ:
+			axis = 0;
+			break;
+		case ESliceOrientation::XZ:
+			axis = 1;
+			break;
+		default:
+			qWarning() << "Failed to update slice because the orientation is unknown.";
+			return;
+	}
+	extent[2 * axis] = extent[2 * axis + 1] = sliceIndex;
+	this->updateExtent(extent);
+}
+
+bool ImageData::getChangedExtent(const qint64& sinceVersion, int extent[6]) const {
+	for (int axis = 0; axis < 3; axis++) {
+		extent[2 * axis] = VTK_INT_MAX;
+		extent[2 * axis + 1] = VTK_INT_MIN;
+	}
+
+	qint64 version = this->getDataVersion();
+	if (sinceVersion > version) {
+		return false;
+	}
+
+	// Every version after sinceVersion must have come from updateExtent.
+	qint64 expectedVersion = version;
+	for (int i = mDirtyExtents.count() - 1; i >= 0 && expectedVersion > sinceVersion; i--) {
+		const DirtyExtent& dirty = mDirtyExtents.at(i);
+		if (dirty.DataVersion != expectedVersion) {
+			return false;
+		}
+
+		for (int axis = 0; axis < 3; axis++) {
+			extent[2 * axis] = qMin(extent[2 * axis], dirty.Extent[2 * axis]);
+			extent[2 * axis + 1] = qMax(extent[2 * axis + 1], dirty.Extent[2 * axis + 1]);
+		}
+		expectedVersion--;
+	}
+	return expectedVersion == sinceVersion;
+}
+
+bool ImageData::prepareSliceImage(const int& sliceIndex,
+	const ESliceOrientation& orientation, vtkImageData* slice)
+{
+	if (slice == Q_NULLPTR) {
+		return false;
+	}
+
+	int axis;
+	switch (orientation.toInt()) {
+		case ESliceOrientation::XY:
+			axis = 2;
+			break;
+		case ESliceOrientation::YZ:
+			axis = 0;
+			break;
+		case ESliceOrientation::XZ:
+			axis = 1;
+			break;
+		default:
+			qWarning() << "Failed to copy slice because the orientation is unknown.";
+			return false;
+	}
+
+	int extent[6];
+	this->GetExtent(extent);
+	if (sliceIndex < extent[2 * axis] || sliceIndex > extent[2 * axis + 1]) {
+		qWarning() << "Failed to copy slice" << sliceIndex << "because it is out of range.";
+		return false;
+	}
+	extent[2 * axis] = extent[2 * axis + 1] = sliceIndex;
+
+	slice->SetOrigin(this->GetOrigin());
+	slice->SetSpacing(this->GetSpacing());
+	slice->SetDirectionMatrix(this->GetDirectionMatrix());
+	slice->SetExtent(extent);
+	return true;
+}
+
+void ImageData::setWindowLevel(const double& window, const double& level) {
+	// A window of 0 would divide by 0 when mapping.
+	double width = qMax(window, 1e-6);
+	if (mHasWindowLevel && width == mWindow && level == mLevel) {
+		return;
+	}
+
+	mWindow = width;
+	mLevel = level;
+	mHasWindowLevel = true;
+	emit changedWindowLevel(mWindow, mLevel);
+}
+
+void ImageData::getWindowLevel(double& window, double& level) {
+	if (mHasWindowLevel || this->GetScalarType() == VTK_UNSIGNED_CHAR ||
+		this->GetPointData()->GetScalars() == Q_NULLPTR)
+	{
+		window = mWindow;
+		level = mLevel;
+		return;
+	}
+
+	double range[2];
+	this->GetScalarRange(range);
+	window = qMax(range[1] - range[0], 1e-6);
+	level = (range[0] + range[1]) / 2.0;
+}
+
+bool ImageData::hasWindowLevel() const {
+	return mHasWindowLevel;
+}
@@ -10,7 +10,8 @@ SeriesData::SeriesData()
 	: ImageData(),
 	mSeriesIndex(-1),
 	mPatientMatrix(vtkSmartPointer<vtkMatrix4x4>::New()),
-	mMetaData(vtkSmartPointer<vtkDICOMMetaData>::New())
+	mMetaData(vtkSmartPointer<vtkDICOMMetaData>::New()),
+	mStorage()
 {
 }
 
@@ -22,6 +23,10 @@ void SeriesData::setSeriesIndex(const int& index) {
 	mSeriesIndex = index;
 }
 
+void SeriesData::setStorage(StudyStoragePtr storage) {
+	mStorage = storage;
+}
+
 int SeriesData::getSeriesIndex() {
 	return mSeriesIndex;
 }
@@ -41,3 +46,7 @@ void SeriesData::setMetaData(vtkSmartPointer<vtkDICOMMetaData> metaData) {
 vtkSmartPointer<vtkDICOMMetaData> SeriesData::getMetaData() {
 	return mMetaData;
 }
+
+StudyStoragePtr SeriesData::getStorage() const {
+	return mStorage;
+}
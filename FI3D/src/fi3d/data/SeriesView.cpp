@@ -0,0 +1,153 @@
+#include <fi3d/data/SeriesView.h>
+
+#include <fi3d/logger/Logger.h>
+
+#include <vtkObjectFactory.h>
+#include <vtkPointData.h>
+
+#include <cstring>
+
+using namespace fi3d;
+
+vtkStandardNewMacro(SeriesView)
+
+SeriesView::SeriesView()
+	: SeriesData(),
+	mBuffers(),
+	mPlanes(),
+	mVoxelBytes(0),
+	mPlaneBytes(0)
+{}
+
+bool SeriesView::setPlanes(const QVector<vtkSmartPointer<vtkDataArray>>& buffers,
+	const QVector<const void*>& planes, const int& scalarType, const int& components)
+{
+	if (planes.count() != this->GetDimensions()[2]) {
+		qWarning() << "Failed to set the planes of series view because there are" << planes.count() <<
+			"planes instead of" << this->GetDimensions()[2];
+		return false;
+	}
+
+	// Empty, only so the scalar type and components are known.
+	vtkSmartPointer<vtkDataArray> scalars = vtk::TakeSmartPointer(vtkDataArray::CreateDataArray(scalarType));
+	if (scalars.Get() == Q_NULLPTR) {
+		qWarning() << "Failed to set the planes of series view of unknown scalar type" << scalarType;
+		return false;
+	}
+	scalars->SetNumberOfComponents(components);
+	this->GetPointData()->SetScalars(scalars);
+
+	mBuffers = buffers;
+	mPlanes.resize(planes.count());
+	for (int z = 0; z < planes.count(); z++) {
+		mPlanes[z] = static_cast<const char*>(planes.at(z));
+	}
+	mVoxelBytes = scalars->GetDataTypeSize() * components;
+	mPlaneBytes = (qint64)this->GetDimensions()[0] * this->GetDimensions()[1] * mVoxelBytes;
+	this->Modified();
+	return true;
+}
+
+const void* SeriesView::getPlanePointer(const int& z) const {
+	if (z < 0 || z >= mPlanes.count()) {
+		return Q_NULLPTR;
+	}
+	return mPlanes.at(z);
+}
+
+bool SeriesView::copyPlanes(void* output) const {
+	if (mPlanes.isEmpty() || output == Q_NULLPTR) {
+		return false;
+	}
+
+	char* out = static_cast<char*>(output);
+	for (int z = 0; z < mPlanes.count(); z++) {
+		std::memcpy(out + z * mPlaneBytes, mPlanes.at(z), mPlaneBytes);
+	}
+	return true;
+}
+
+bool SeriesView::makeContiguous() {
+	if (mPlanes.isEmpty()) {
+		return this->GetScalarPointer() != Q_NULLPTR;
+	}
+
+	qDebug() << "Enter - Copying the planes of series" << this->getSeriesIndex();
+	vtkDataArray* empty = this->GetPointData()->GetScalars();
+	vtkSmartPointer<vtkDataArray> scalars = vtk::TakeSmartPointer(empty->NewInstance());
+	scalars->SetNumberOfComponents(empty->GetNumberOfComponents());
+	scalars->SetName(empty->GetName());
+	int* dims = this->GetDimensions();
+	if (!scalars->SetNumberOfTuples((vtkIdType)dims[0] * dims[1] * dims[2])) {
+		qWarning() << "Failed to allocate the scalars of series" << this->getSeriesIndex();
+		return false;
+	}
+
+	this->copyPlanes(scalars->GetVoidPointer(0));
+	this->GetPointData()->SetScalars(scalars);
+	this->releasePlanes();
+
+	// The voxels are the same, so the data version is too.
+	this->Modified();
+	emit changedData();
+	qDebug() << "Exit";
+	return true;
+}
+
+bool SeriesView::isPartial() const {
+	return !mPlanes.isEmpty();
+}
+
+void SeriesView::copySlice(const int& sliceIndex,
+	const ESliceOrientation& orientation, vtkImageData* slice)
+{
+	if (mPlanes.isEmpty()) {
+		SeriesData::copySlice(sliceIndex, orientation, slice);
+		return;
+	}
+
+	if (!this->prepareSliceImage(sliceIndex, orientation, slice)) {
+		return;
+	}
+
+	vtkDataArray* scalars = this->GetPointData()->GetScalars();
+	slice->AllocateScalars(scalars->GetDataType(), scalars->GetNumberOfComponents());
+	char* out = static_cast<char*>(slice->GetScalarPointer());
+
+	int* dims = this->GetDimensions();
+	int* extent = this->GetExtent();
+	const qint64 rowBytes = (qint64)dims[0] * mVoxelBytes;
+	switch (orientation.toInt()) {
+		case ESliceOrientation::XY:
+			std::memcpy(out, mPlanes.at(sliceIndex - extent[4]), mPlaneBytes);
+			break;
+		case ESliceOrientation::YZ:
+		{
+			// One voxel of every row of every plane.
+			const qint64 x = sliceIndex - extent[0];
+			for (int z = 0; z < dims[2]; z++) {
+				for (int y = 0; y < dims[1]; y++) {
+					std::memcpy(out, mPlanes.at(z) + y * rowBytes + x * mVoxelBytes, mVoxelBytes);
+					out += mVoxelBytes;
+				}
+			}
+			break;
+		}
+		case ESliceOrientation::XZ:
+		{
+			// One row of every plane.
+			const qint64 y = sliceIndex - extent[2];
+			for (int z = 0; z < dims[2]; z++) {
+				std::memcpy(out + z * rowBytes, mPlanes.at(z) + y * rowBytes, rowBytes);
+			}
+			break;
+		}
+		default:
+			break;
+	}
+}
+
+void SeriesView::releasePlanes() {
+	mPlanes.clear();
+	mBuffers.clear();
+}
@@ -4,10 +4,13 @@
 #include <vtkLookupTable.h>
 #include <vtkImageMapToColors.h>
 #include <vtkMatrix4x4.h>
+#include <vtkPointData.h>
 
 #include <QMap>
 #include <QtMath>
 
+#include <cstring>
+
 using namespace fi3d;
 
 Study::Study(QString studyID)
@@ -15,6 +18,8 @@ Study::Study(QString studyID)
 	mPatientID(""), mPatientName(""), 
 	mDate(""), mTime(""),
 	mSeriesSet(),
+	mView(),
+	mStorage(),
 	mThumbnail()
 {
 	this->setDataName(studyID);
@@ -52,13 +57,24 @@ bool Study::removeSeries(const int& index) {
 		return false;
 	}
 
+	// The series after it move, so they can no longer be created from the view.
+	if (!mView.isNull()) {
+		for (int i = index + 1; i < mSeriesSet.count(); i++) {
+			this->getSeries(i);
+		}
+	}
+
 	SeriesDataVPtr series = mSeriesSet.takeAt(index);
 	
 	for (int i = index; i < mSeriesSet.count(); i++) {
-		mSeriesSet.at(i)->setSeriesIndex(i);
+		if (mSeriesSet.at(i).Get() != Q_NULLPTR) {
+			mSeriesSet.at(i)->setSeriesIndex(i);
+		}
 	}
 
-	emit changedRemovedSeries(series);
+	if (series.Get() != Q_NULLPTR) {
+		emit changedRemovedSeries(series);
+	}
 	return true;
 }
 
@@ -67,7 +83,135 @@ int Study::getSeriesCount() const {
 }
 
 SeriesDataVPtr Study::getSeries(const int& index) {
-	return mSeriesSet.value(index, Q_NULLPTR);
+	if (!this->isSeriesIndexInRange(index)) {
+		return Q_NULLPTR;
+	}
+
+	// Series of the view are created the first time they are needed.
+	if (mSeriesSet.at(index).Get() == Q_NULLPTR && !mView.isNull() && index < mView->getPhaseCount()) {
+		SeriesDataVPtr series = mView->createSeries(index);
+		if (series.Get() != Q_NULLPTR) {
+			series->setDataName(this->getDataName());
+			series->setSeriesIndex(index);
+			mSeriesSet[index] = series;
+		}
+	}
+	return mSeriesSet.at(index);
+}
+
+SeriesDataVPtr Study::getContiguousSeries(const int& index) {
+	SeriesDataVPtr series = this->getSeries(index);
+	SeriesView* view = SeriesView::SafeDownCast(series);
+	if (view != Q_NULLPTR && !view->makeContiguous()) {
+		return Q_NULLPTR;
+	}
+	return series;
+}
+
+void Study::setView(StudyViewPtr view) {
+	while (!mSeriesSet.isEmpty()) {
+		this->removeSeries(mSeriesSet.count() - 1);
+	}
+
+	mView = view;
+	if (!mView.isNull()) {
+		mSeriesSet.fill(SeriesDataVPtr(), mView->getPhaseCount());
+	}
+}
+
+StudyViewPtr Study::getView() const {
+	return mView;
+}
+
+bool Study::packSeries() {
+	qDebug() << "Enter - Packing the series of study:" << this->getDataID();
+	if (mSeriesSet.isEmpty()) {
+		qWarning() << "Failed to pack study:" << this->getDataID() << "because it has no series.";
+		return false;
+	}
+
+	// Series of a view are only created as views of their planes, which copies nothing.
+	QVector<SeriesDataVPtr> seriesSet;
+	for (int i = 0; i < mSeriesSet.count(); i++) {
+		seriesSet.append(this->getSeries(i));
+	}
+
+	SeriesDataVPtr first = seriesSet.first();
+	if (first.Get() == Q_NULLPTR) {
+		qWarning() << "Failed to pack study:" << this->getDataID() << "because its series do not match.";
+		return false;
+	}
+	int dimensions[3];
+	first->GetDimensions(dimensions);
+	for (SeriesDataVPtr series : seriesSet) {
+		bool hasVoxels = series.Get() != Q_NULLPTR && (series->isPartial() ?
+			SeriesView::SafeDownCast(series) != Q_NULLPTR : series->GetScalarPointer() != Q_NULLPTR);
+		if (!hasVoxels ||
+			series->GetDimensions()[0] != dimensions[0] || series->GetDimensions()[1] != dimensions[1] ||
+			series->GetDimensions()[2] != dimensions[2] || series->GetScalarType() != first->GetScalarType() ||
+			series->GetNumberOfScalarComponents() != first->GetNumberOfScalarComponents())
+		{
+			qWarning() << "Failed to pack study:" << this->getDataID() << "because its series do not match.";
+			return false;
+		}
+	}
+
+	StudyStoragePtr storage(new StudyStorage(dimensions, seriesSet.count(),
+		first->GetScalarType(), first->GetNumberOfScalarComponents()));
+	if (!storage->isAllocated()) {
+		return false;
+	}
+
+	qint64 volumeBytes = storage->getPlaneBytes() * dimensions[2];
+	for (int i = 0; i < seriesSet.count(); i++) {
+		SeriesDataVPtr series = seriesSet.at(i);
+		SeriesView* view = SeriesView::SafeDownCast(series);
+		if (view != Q_NULLPTR && view->isPartial()) {
+			view->copyPlanes(storage->getPhasePointer(i));
+		} else {
+			std::memcpy(storage->getPhasePointer(i), series->GetScalarPointer(), volumeBytes);
+		}
+
+		vtkSmartPointer<vtkDataArray> scalars = storage->createPhaseArray(i);
+		scalars->SetName(series->GetPointData()->GetScalars()->GetName());
+		series->setStorage(storage);
+		series->GetPointData()->SetScalars(scalars);
+		if (view != Q_NULLPTR) {
+			view->releasePlanes();
+		}
+	}
+
+	// Every series was created, the view only holds the source arrays now.
+	mView.reset();
+	mStorage = storage;
+	qDebug() << "Exit - Packed" << seriesSet.count() << "series in" <<
+		storage->getPhaseStride() * seriesSet.count() << "bytes";
+	return true;
+}
+
+bool Study::allocateSeries(const int& phaseCount, const int dimensions[3],
+	const int& scalarType, const int& components)
+{
+	StudyStoragePtr storage(new StudyStorage(dimensions, phaseCount, scalarType, components));
+	if (!storage->isAllocated()) {
+		qWarning() << "Failed to allocate the series of study:" << this->getDataID();
+		return false;
+	}
+
+	for (int i = 0; i < phaseCount; i++) {
+		SeriesDataVPtr series = SeriesDataVPtr::New();
+		series->SetDimensions(dimensions[0], dimensions[1], dimensions[2]);
+		series->setStorage(storage);
+		series->GetPointData()->SetScalars(storage->createPhaseArray(i));
+		this->addSeries(series);
+	}
+
+	mStorage = storage;
+	return true;
+}
+
+StudyStoragePtr Study::getStorage() const {
+	return mStorage;
 }
 
 bool Study::isSeriesIndexInRange(const int& seriesIndex) const {
@@ -0,0 +1,149 @@
+#include <fi3d/data/StudyStorage.h>
+
+#include <fi3d/logger/Logger.h>
+
+#include <QtGlobal>
+
+#include <vtkDataArray.h>
+
+#include <cstring>
+
+using namespace fi3d;
+
+/// @brief Reads the same voxel component in every phase.
+template <typename T>
+static void readTimeCurve(const char* first, const qint64& phaseStride, const int& phaseCount,
+	QVector<double>& curve)
+{
+	for (int phase = 0; phase < phaseCount; phase++) {
+		curve[phase] = static_cast<double>(*reinterpret_cast<const T*>(first + phase * phaseStride));
+	}
+}
+
+StudyStorage::StudyStorage(const int dimensions[3], const int& phaseCount,
+	const int& scalarType, const int& components)
+	: mData(Q_NULLPTR),
+	mDimensions{qMax(0, dimensions[0]), qMax(0, dimensions[1]), qMax(0, dimensions[2])},
+	mPhaseCount(qMax(0, phaseCount)),
+	mScalarType(scalarType),
+	mComponents(qMax(1, components)),
+	mPlaneBytes(0),
+	mPhaseStride(0)
+{
+	vtkSmartPointer<vtkDataArray> probe = vtk::TakeSmartPointer(vtkDataArray::CreateDataArray(scalarType));
+	if (probe.Get() == Q_NULLPTR) {
+		qWarning() << "Failed to create study storage of unknown scalar type" << scalarType;
+		return;
+	}
+
+	mPlaneBytes = (qint64)mDimensions[0] * mDimensions[1] * mComponents * probe->GetDataTypeSize();
+	qint64 volumeBytes = mPlaneBytes * mDimensions[2];
+	mPhaseStride = (volumeBytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+
+	qint64 totalBytes = mPhaseStride * mPhaseCount;
+	if (totalBytes > 0) {
+		mData = qMallocAligned(static_cast<size_t>(totalBytes), ALIGNMENT);
+		if (mData == Q_NULLPTR) {
+			qWarning() << "Failed to allocate" << totalBytes << "bytes of study storage.";
+		}
+	}
+}
+
+StudyStorage::~StudyStorage() {
+	if (mData != Q_NULLPTR) {
+		qFreeAligned(mData);
+	}
+}
+
+bool StudyStorage::isAllocated() const {
+	return mData != Q_NULLPTR;
+}
+
+void StudyStorage::getDimensions(int dimensions[3]) const {
+	for (int i = 0; i < 3; i++) {
+		dimensions[i] = mDimensions[i];
+	}
+}
+
+int StudyStorage::getPhaseCount() const {
+	return mPhaseCount;
+}
+
+int StudyStorage::getScalarType() const {
+	return mScalarType;
+}
+
+int StudyStorage::getComponents() const {
+	return mComponents;
+}
+
+qint64 StudyStorage::getPlaneBytes() const {
+	return mPlaneBytes;
+}
+
+qint64 StudyStorage::getPhaseStride() const {
+	return mPhaseStride;
+}
+
+void* StudyStorage::getPhasePointer(const int& phase) const {
+	if (mData == Q_NULLPTR || phase < 0 || phase >= mPhaseCount) {
+		return Q_NULLPTR;
+	}
+	return static_cast<char*>(mData) + phase * mPhaseStride;
+}
+
+void* StudyStorage::getPlanePointer(const int& phase, const int& z) const {
+	char* phaseData = static_cast<char*>(this->getPhasePointer(phase));
+	if (phaseData == Q_NULLPTR || z < 0 || z >= mDimensions[2]) {
+		return Q_NULLPTR;
+	}
+	return phaseData + z * mPlaneBytes;
+}
+
+vtkSmartPointer<vtkDataArray> StudyStorage::createPhaseArray(const int& phase) const {
+	void* phaseData = this->getPhasePointer(phase);
+	if (phaseData == Q_NULLPTR) {
+		return vtkSmartPointer<vtkDataArray>();
+	}
+
+	vtkSmartPointer<vtkDataArray> array = vtk::TakeSmartPointer(vtkDataArray::CreateDataArray(mScalarType));
+	array->SetNumberOfComponents(mComponents);
+	// Save is set, so the array never frees the buffer.
+	array->SetVoidArray(phaseData,
+		(vtkIdType)mDimensions[0] * mDimensions[1] * mDimensions[2] * mComponents, 1);
+	return array;
+}
+
+void StudyStorage::extractPlaneOverPhases(const int& z, void* output) const {
+	if (mData == Q_NULLPTR || output == Q_NULLPTR || z < 0 || z >= mDimensions[2]) {
+		return;
+	}
+
+	// The planes are a fixed stride apart.
+	const char* plane = static_cast<const char*>(mData) + z * mPlaneBytes;
+	char* out = static_cast<char*>(output);
+	for (int phase = 0; phase < mPhaseCount; phase++) {
+		std::memcpy(out + phase * mPlaneBytes, plane + phase * mPhaseStride, mPlaneBytes);
+	}
+}
+
+QVector<double> StudyStorage::getTimeCurve(const int& x, const int& y, const int& z,
+	const int& component) const
+{
+	QVector<double> curve(mPhaseCount, 0.0);
+	if (mData == Q_NULLPTR || x < 0 || x >= mDimensions[0] || y < 0 || y >= mDimensions[1] ||
+		z < 0 || z >= mDimensions[2] || component < 0 || component >= mComponents)
+	{
+		return curve;
+	}
+
+	const qint64 valueBytes = mPlaneBytes / ((qint64)mDimensions[0] * mDimensions[1] * mComponents);
+	const qint64 valueIndex = (((qint64)z * mDimensions[1] + y) * mDimensions[0] + x) * mComponents + component;
+	const char* first = static_cast<const char*>(mData) + valueIndex * valueBytes;
+	switch (mScalarType) {
+		vtkTemplateMacro(readTimeCurve<VTK_TT>(first, mPhaseStride, mPhaseCount, curve));
+	default:
+		break;
+	}
+	return curve;
+}
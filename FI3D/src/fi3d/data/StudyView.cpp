@@ -0,0 +1,289 @@
+#include <fi3d/data/StudyView.h>
+
+#include <fi3d/logger/Logger.h>
+
+#include <vtkDataArray.h>
+#include <vtkPointData.h>
+
+#include <QtMath>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace fi3d;
+
+StudyView::StudyView()
+	: mBuffers(),
+	mDimensions{0, 0, 0, 0},
+	mSliceBuffers(),
+	mSliceOffsets(),
+	mPhaseBuffers(),
+	mPhaseOffsets(),
+	mBufferSeries(),
+	mSpacing{1.0, 1.0, 1.0},
+	mOrigin{0.0, 0.0, 0.0},
+	mScalarType(VTK_UNSIGNED_CHAR),
+	mComponents(1)
+{}
+
+StudyView::~StudyView() {}
+
+StudyViewPtr StudyView::fromSeries(const QVector<SeriesDataVPtr>& series, const bool& isTimeDomain) {
+	if (series.isEmpty() || series.first().Get() == Q_NULLPTR) {
+		qWarning() << "Failed to create a study view because there are no series.";
+		return StudyViewPtr();
+	}
+
+	SeriesDataVPtr first = series.first();
+	int dimensions[3];
+	first->GetDimensions(dimensions);
+
+	StudyViewPtr view(new StudyView());
+	view->mScalarType = first->GetScalarType();
+	view->mComponents = first->GetNumberOfScalarComponents();
+	first->GetSpacing(view->mSpacing);
+	first->GetOrigin(view->mOrigin);
+
+	qint64 volumeSize = (qint64)dimensions[0] * dimensions[1] * dimensions[2];
+	for (SeriesDataVPtr s : series) {
+		vtkDataArray* scalars = s.Get() == Q_NULLPTR ? Q_NULLPTR : s->GetPointData()->GetScalars();
+		if (scalars == Q_NULLPTR || scalars->GetNumberOfTuples() != volumeSize ||
+			s->GetDimensions()[0] != dimensions[0] || s->GetDimensions()[1] != dimensions[1] ||
+			s->GetDimensions()[2] != dimensions[2] || s->GetScalarType() != view->mScalarType ||
+			s->GetNumberOfScalarComponents() != view->mComponents)
+		{
+			qWarning() << "Failed to create a study view because the series do not match.";
+			return StudyViewPtr();
+		}
+		view->mBuffers.append(scalars);
+		view->mBufferSeries.append(s);
+	}
+
+	const qint64 planeSize = (qint64)dimensions[0] * dimensions[1];
+	const int seriesCount = series.count();
+	view->mDimensions[0] = dimensions[0];
+	view->mDimensions[1] = dimensions[1];
+	view->mDimensions[2] = isTimeDomain ? seriesCount : dimensions[2];
+	view->mDimensions[3] = isTimeDomain ? dimensions[2] : seriesCount;
+
+	// Each series is a slice and its planes are the phases, or the opposite.
+	for (int i = 0; i < seriesCount; i++) {
+		QVector<int>& buffers = isTimeDomain ? view->mSliceBuffers : view->mPhaseBuffers;
+		QVector<qint64>& offsets = isTimeDomain ? view->mSliceOffsets : view->mPhaseOffsets;
+		buffers.append(i);
+		offsets.append(0);
+	}
+	for (int i = 0; i < dimensions[2]; i++) {
+		QVector<int>& buffers = isTimeDomain ? view->mPhaseBuffers : view->mSliceBuffers;
+		QVector<qint64>& offsets = isTimeDomain ? view->mPhaseOffsets : view->mSliceOffsets;
+		buffers.append(0);
+		offsets.append(i * planeSize);
+	}
+
+	return view;
+}
+
+int StudyView::getDimension(const int& axis) const {
+	if (axis < 0 || axis > 3) {
+		return 0;
+	}
+	return mDimensions[axis];
+}
+
+int StudyView::getSliceCount() const {
+	return mDimensions[2];
+}
+
+int StudyView::getPhaseCount() const {
+	return mDimensions[3];
+}
+
+void StudyView::swapSlicesAndPhases() {
+	std::swap(mDimensions[2], mDimensions[3]);
+	std::swap(mSliceBuffers, mPhaseBuffers);
+	std::swap(mSliceOffsets, mPhaseOffsets);
+}
+
+bool StudyView::reorderSlices(const QVector<int>& order) {
+	if (order.count() != mDimensions[2]) {
+		qWarning() << "Failed to reorder slices because the order has" << order.count() <<
+			"slices instead of" << mDimensions[2];
+		return false;
+	}
+
+	QVector<bool> isUsed(order.count(), false);
+	for (int index : order) {
+		if (index < 0 || index >= order.count() || isUsed.at(index)) {
+			qWarning() << "Failed to reorder slices because the order is not a permutation.";
+			return false;
+		}
+		isUsed[index] = true;
+	}
+
+	QVector<int> buffers(order.count());
+	QVector<qint64> offsets(order.count());
+	for (int i = 0; i < order.count(); i++) {
+		buffers[i] = mSliceBuffers.at(order.at(i));
+		offsets[i] = mSliceOffsets.at(order.at(i));
+	}
+	mSliceBuffers = buffers;
+	mSliceOffsets = offsets;
+	return true;
+}
+
+QVector<int> StudyView::getSpatialSliceOrder() const {
+	QVector<vtkSmartPointer<vtkMatrix4x4>> matrices;
+	if (mDimensions[3] > 0) {
+		for (int i = 0; i < mDimensions[2]; i++) {
+			matrices.append(this->getPatientMatrix(i));
+		}
+	}
+	return StudyView::getSpatialOrder(matrices);
+}
+
+QVector<int> StudyView::getSpatialOrder(const QVector<vtkSmartPointer<vtkMatrix4x4>>& matrices) {
+	QVector<int> order(matrices.count());
+	for (int i = 0; i < order.count(); i++) {
+		order[i] = i;
+	}
+	if (order.count() < 2) {
+		return order;
+	}
+
+	vtkMatrix4x4* first = matrices.first();
+	double normal[3] = {first->GetElement(0, 2), first->GetElement(1, 2), first->GetElement(2, 2)};
+
+	QVector<double> positions(order.count());
+	for (int i = 0; i < order.count(); i++) {
+		vtkMatrix4x4* matrix = matrices.at(i);
+		positions[i] = matrix->GetElement(0, 3) * normal[0] +
+			matrix->GetElement(1, 3) * normal[1] + matrix->GetElement(2, 3) * normal[2];
+	}
+
+	std::stable_sort(order.begin(), order.end(), [&positions](const int& a, const int& b) {
+		return positions.at(a) < positions.at(b);
+	});
+	return order;
+}
+
+void StudyView::setSliceSpacing(const double& spacing) {
+	mSpacing[2] = spacing;
+}
+
+double StudyView::getSliceSpacing() const {
+	return mSpacing[2];
+}
+
+vtkSmartPointer<vtkMatrix4x4> StudyView::getPatientMatrix(const int& slice, const int& phase) const {
+	return mBufferSeries.at(mSliceBuffers.at(slice) + mPhaseBuffers.at(phase))->getPatientMatrix();
+}
+
+double StudyView::getSliceDistance(const int& first, const int& second) const {
+	vtkSmartPointer<vtkMatrix4x4> a = this->getPatientMatrix(first);
+	vtkSmartPointer<vtkMatrix4x4> b = this->getPatientMatrix(second);
+	double distance = 0;
+	for (int i = 0; i < 3; i++) {
+		double delta = b->GetElement(i, 3) - a->GetElement(i, 3);
+		distance += delta * delta;
+	}
+	return qSqrt(distance);
+}
+
+const void* StudyView::getPlanePointer(const int& slice, const int& phase) const {
+	return this->getBuffer(slice, phase)->GetVoidPointer(this->getOffset(slice, phase) * mComponents);
+}
+
+double StudyView::getValue(const int& x, const int& y, const int& slice, const int& phase,
+	const int& component) const
+{
+	qint64 tuple = this->getOffset(slice, phase) + (qint64)y * mDimensions[0] + x;
+	return this->getBuffer(slice, phase)->GetComponent(tuple, component);
+}
+
+bool StudyView::isPhaseContiguous(const int& phase) const {
+	const qint64 planeSize = (qint64)mDimensions[0] * mDimensions[1];
+	vtkDataArray* buffer = this->getBuffer(0, phase);
+	if (buffer->GetNumberOfTuples() != planeSize * mDimensions[2]) {
+		return false;
+	}
+
+	for (int slice = 0; slice < mDimensions[2]; slice++) {
+		if (this->getBuffer(slice, phase) != buffer || this->getOffset(slice, phase) != slice * planeSize) {
+			return false;
+		}
+	}
+	return true;
+}
+
+SeriesDataVPtr StudyView::createSeries(const int& phase) const {
+	if (phase < 0 || phase >= mDimensions[3] || mDimensions[2] == 0) {
+		qWarning() << "Failed to create series of phase" << phase << "because it is out of range.";
+		return SeriesDataVPtr();
+	}
+
+	if (this->isPhaseContiguous(phase)) {
+		return this->createContiguousSeries(phase);
+	}
+
+	QVector<vtkSmartPointer<vtkDataArray>> buffers;
+	QVector<const void*> planes(mDimensions[2]);
+	for (int slice = 0; slice < mDimensions[2]; slice++) {
+		vtkSmartPointer<vtkDataArray> buffer = this->getBuffer(slice, phase);
+		if (!buffers.contains(buffer)) {
+			buffers.append(buffer);
+		}
+		planes[slice] = this->getPlanePointer(slice, phase);
+	}
+
+	SeriesViewVPtr series = this->createEmptySeries<SeriesView>(phase);
+	if (!series->setPlanes(buffers, planes, mScalarType, mComponents)) {
+		return SeriesDataVPtr();
+	}
+	return series;
+}
+
+SeriesDataVPtr StudyView::createContiguousSeries(const int& phase) const {
+	if (phase < 0 || phase >= mDimensions[3] || mDimensions[2] == 0) {
+		qWarning() << "Failed to create series of phase" << phase << "because it is out of range.";
+		return SeriesDataVPtr();
+	}
+
+	SeriesDataVPtr series = this->createEmptySeries<SeriesData>(phase);
+	if (this->isPhaseContiguous(phase)) {
+		series->GetPointData()->SetScalars(this->getBuffer(0, phase));
+		return series;
+	}
+
+	series->AllocateScalars(mScalarType, mComponents);
+	char* output = static_cast<char*>(series->GetScalarPointer());
+	const qint64 planeBytes = (qint64)mDimensions[0] * mDimensions[1] * mComponents *
+		series->GetScalarSize();
+	for (int slice = 0; slice < mDimensions[2]; slice++) {
+		std::memcpy(output + slice * planeBytes, this->getPlanePointer(slice, phase), planeBytes);
+	}
+	return series;
+}
+
+template <typename T>
+vtkSmartPointer<T> StudyView::createEmptySeries(const int& phase) const {
+	vtkSmartPointer<T> series = vtkSmartPointer<T>::New();
+	series->SetDimensions(mDimensions[0], mDimensions[1], mDimensions[2]);
+	series->SetSpacing(mSpacing[0], mSpacing[1], mSpacing[2]);
+	series->SetOrigin(mOrigin[0], mOrigin[1], mOrigin[2]);
+	series->setPatientMatrix(this->getPatientMatrix(0, phase));
+
+	// A view has no scalars to compute the default from, the source has.
+	SeriesDataVPtr source = mBufferSeries.at(mSliceBuffers.at(0) + mPhaseBuffers.at(phase));
+	double window, level;
+	source->getWindowLevel(window, level);
+	series->setWindowLevel(window, level);
+	return series;
+}
+
+vtkDataArray* StudyView::getBuffer(const int& slice, const int& phase) const {
+	return mBuffers.at(mSliceBuffers.at(slice) + mPhaseBuffers.at(phase));
+}
+
+qint64 StudyView::getOffset(const int& slice, const int& phase) const {
+	return mSliceOffsets.at(slice) + mPhaseOffsets.at(phase);
+}
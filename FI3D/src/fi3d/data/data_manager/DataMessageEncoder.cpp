@@ -7,6 +7,8 @@
 
 #include <fi3d/server/message_keys/MessageKeys.h>
 
+#include <fi3d/utilities/ImageAlgorithms.h>
+
 #include <QJsonArray>
 
 using namespace fi3d;
@@ -23,8 +25,15 @@ void prepareDataResponse(QJsonObject& jsonObject,
 
 DataMessageEncoder::DataMessageEncoder(DataManager* manager)
 	: MessageEncoder(EMessage::DATA),
-	mDataManager(manager)
+	mDataManager(manager),
+	mPendingRequests(),
+	mPendingTimer()
 {
+	mPendingTimer.setSingleShot(true);
+	mPendingTimer.setInterval(0);
+	QObject::connect(
+		&mPendingTimer, &QTimer::timeout,
+		this, &DataMessageEncoder::answerPendingRequests);
 }
 
 DataMessageEncoder::~DataMessageEncoder() {}
@@ -33,6 +42,52 @@ void DataMessageEncoder::parseRequest(const QJsonObject& request, const QString&
 	qDebug() << "Enter - Parsing request from" << clientID;
 	qDebug() << "Request:\n" << request;
 
+	if (request.contains(CANCEL_DATA_REQUESTS)) {
+		QList<int> requestIDs;
+		QJsonArray cancelArray = request.value(CANCEL_DATA_REQUESTS).toArray();
+		for (QJsonValue value : cancelArray) {
+			requestIDs.append(value.toInt(-1));
+		}
+		int cancelled = 0;
+		if (!requestIDs.isEmpty()) {
+			cancelled = this->removePendingRequests(clientID, requestIDs);
+		}
+		qDebug() << "Exit - Cancelled" << cancelled << "requests from" << clientID;
+		return;
+	}
+
+	PendingDataRequest pending;
+	pending.ClientID = clientID;
+	pending.RequestID = request.value(DATA_REQUEST_ID).toInt(-1);
+	pending.Request = request;
+
+	mPendingRequests.append(pending);
+	if (!mPendingTimer.isActive()) {
+		mPendingTimer.start();
+	}
+
+	qDebug() << "Exit";
+}
+
+void DataMessageEncoder::onDisconnectedClient(const QString& clientID) {
+	this->removePendingRequests(clientID, QList<int>());
+}
+
+void DataMessageEncoder::answerPendingRequests() {
+	qDebug() << "Enter - Answering" << mPendingRequests.count() << "requests";
+
+	// Requests received while answering wait for the next iteration.
+	QList<PendingDataRequest> requests = mPendingRequests;
+	mPendingRequests.clear();
+
+	for (const PendingDataRequest& pending : requests) {
+		this->answerRequest(pending.Request, pending.ClientID);
+	}
+
+	qDebug() << "Exit";
+}
+
+void DataMessageEncoder::answerRequest(const QJsonObject& request, const QString& clientID) {
 	EData dataType = request.value(DATA_TYPE).toInt();
 	switch (dataType.toInt()) {
 		case EData::IMAGE:
@@ -48,8 +103,26 @@ void DataMessageEncoder::parseRequest(const QJsonObject& request, const QString&
 			qWarning() << "Received data request for an unknown data type";
 			break;
 	}
+}
 
-	qDebug() << "Exit";
+int DataMessageEncoder::removePendingRequests(const QString& clientID, const QList<int>& requestIDs) {
+	// Without IDs, all the requests of the client match.
+	int removed = 0;
+	QList<PendingDataRequest>::iterator it = mPendingRequests.begin();
+	while (it != mPendingRequests.end()) {
+		bool isMatch = it->ClientID == clientID;
+		if (isMatch && !requestIDs.isEmpty()) {
+			isMatch = it->RequestID != -1 && requestIDs.contains(it->RequestID);
+		}
+
+		if (isMatch) {
+			it = mPendingRequests.erase(it);
+			removed++;
+		} else {
+			it++;
+		}
+	}
+	return removed;
 }
 
 void DataMessageEncoder::parseImageDataRequest(const QJsonObject& request, const QString& clientID) {
@@ -69,6 +142,29 @@ void DataMessageEncoder::parseImageDataRequest(const QJsonObject& request, const
 		return;
 	}
 
+	// A window/level of the client's own is encoded for it alone.
+	if (request.contains(WINDOW_WIDTH) && request.contains(WINDOW_CENTER)) {
+		MessagePtr clientMessage(new Message());
+		if (!DataMessageEncoder::toMessage(regImage->getImageData(), sliceIndex, orientation,
+			request.value(WINDOW_WIDTH).toDouble(), request.value(WINDOW_CENTER).toDouble(),
+			clientMessage))
+		{
+			QString message = tr("ImageData %1 slice was not found").arg(dataID.getDataName());
+			QJsonObject response;
+			this->prepareDataErrorResponse(response, message);
+			this->sendMessage(response, clientID);
+			return;
+		}
+
+		QSharedPointer<QJsonObject> infoJson(new QJsonObject());
+		prepareDataResponse(*infoJson.data());
+		infoJson->insert(DATA, *clientMessage->getInfo());
+		clientMessage->setInfoAndPayload(infoJson, clientMessage->getPayload());
+		this->sendMessage(clientMessage, clientID);
+		qDebug() << "Exit - Sent slice with the client's window/level";
+		return;
+	}
+
 	MessagePtr dataMessage = regImage->getMessage(sliceIndex, orientation);
 	if (dataMessage.isNull()) {
 		QString message = tr("ImageData %1 slice was not found").arg(dataID.getDataName());
@@ -89,11 +185,6 @@ void DataMessageEncoder::parseImageDataRequest(const QJsonObject& request, const
 	}
 
 	this->sendMessage(dataMessage, clientID);
-	
-	// If the ImageData is not cacheable, get rid of the message data.
-	if (!regImage->getImageData()->getCacheable()) {
-		dataMessage->invalidate();
-	}
 
 	qDebug() << "Exit";
 }
@@ -115,7 +206,25 @@ void DataMessageEncoder::parseStudyDataRequest(const QJsonObject& request, const
 		return;
 	}
 	
-	MessagePtr dataMessage = regStudy->getMessage(sliceIndex, orientation, seriesIndex);
+	MessagePtr dataMessage;
+	if (request.contains(WINDOW_WIDTH) && request.contains(WINDOW_CENTER)) {
+		// A window/level of the client's own is encoded for it alone.
+		dataMessage.reset(new Message());
+		if (DataMessageEncoder::toMessage(regStudy->getStudy().data(), sliceIndex, orientation,
+			seriesIndex, request.value(WINDOW_WIDTH).toDouble(),
+			request.value(WINDOW_CENTER).toDouble(), dataMessage))
+		{
+			QSharedPointer<QJsonObject> infoJson(new QJsonObject());
+			prepareDataResponse(*infoJson.data());
+			infoJson->insert(DATA, *dataMessage->getInfo());
+			dataMessage->setInfoAndPayload(infoJson, dataMessage->getPayload());
+		} else {
+			dataMessage.reset();
+		}
+	} else {
+		dataMessage = regStudy->getMessage(sliceIndex, orientation, seriesIndex);
+	}
+
 	if (dataMessage.isNull()) {
 		QString message = tr("Requested slice for Study %1 was not found").arg(dataID.toString());
 		QJsonObject response;
@@ -136,9 +245,10 @@ void DataMessageEncoder::parseStudyDataRequest(const QJsonObject& request, const
 
 	this->sendMessage(dataMessage, clientID);
 
-	// If the Study is not cacheable, get rid of the message data.
-	if (!regStudy->getStudy()->getCacheable()) {
-		dataMessage->invalidate();
+	// Measures the latency of live frames.
+	if (!mDataManager->mStreamIngest.isNull()) {
+		mDataManager->mStreamIngest->onDataSent(
+			regStudy->getStudy()->getSeries(seriesIndex).Get(), sliceIndex, orientation);
 	}
 
 	qDebug() << "Exit";
@@ -177,9 +287,6 @@ void DataMessageEncoder::parseModelDataRequest(const QJsonObject& request, const
 	}
 
 	this->sendMessage(dataMessage, clientID);
-	if (!regModel->getModelData()->getCacheable()) {
-		dataMessage->invalidate();
-	}
 
 	qDebug() << "Exit";
 }
@@ -197,6 +304,20 @@ MessagePtr DataMessageEncoder::toMessage(ImageData* data, const int& sliceIndex,
 
 bool DataMessageEncoder::toMessage(ImageData* data, const int& sliceIndex,
 	const ESliceOrientation& orientation, MessagePtr dataMessage)
+{
+	if (data == Q_NULLPTR) {
+		qWarning() << "Failed to convert ImageSlice to JSON: data is null";
+		return false;
+	}
+
+	double window, level;
+	data->getWindowLevel(window, level);
+	return DataMessageEncoder::toMessage(data, sliceIndex, orientation, window, level, dataMessage);
+}
+
+bool DataMessageEncoder::toMessage(ImageData* data, const int& sliceIndex,
+	const ESliceOrientation& orientation, const double& window, const double& level,
+	MessagePtr dataMessage)
 {
 	qDebug() << "Enter - Converting ImageSlice: SliceIndex=" << sliceIndex <<
 		"Orientation=" << orientation.getName();
@@ -214,58 +335,41 @@ bool DataMessageEncoder::toMessage(ImageData* data, const int& sliceIndex,
 	data->GetOrigin(orig);
 	data->GetSpacing(spac);
 
-	QSharedPointer<QByteArray> payload(new QByteArray());
-	if (orientation == ESliceOrientation::XY) {
-		int z = sliceIndex;
-		if (sliceIndex < 0 || sliceIndex >= dims[2]) {
-			qWarning() << "Failed to convert Study ImageSlice to JSON: slice index is out of range";
-			qDebug() << "Exit - Slice out of range";
+	qint64 sliceSize;
+	switch (orientation.toInt()) {
+		case ESliceOrientation::XY:
+			sliceSize = (qint64)dims[0] * dims[1];
+			break;
+		case ESliceOrientation::YZ:
+			sliceSize = (qint64)dims[1] * dims[2];
+			break;
+		case ESliceOrientation::XZ:
+			sliceSize = (qint64)dims[0] * dims[2];
+			break;
+		default:
+			qWarning() << "Failed to convert Study ImageSlice to JSON: orientation is unknown";
+			qDebug() << "Exit - Unknown orientation";
 			return false;
-		}
-		payload->reserve(dims[0] * dims[1] * sizeof(float));
-		for (int y = 0; y < dims[1]; y++) {
-			for (int x = 0; x < dims[0]; x++) {
-				unsigned char* val = static_cast<unsigned char*>(data->GetScalarPointer(x, y, z));
+	}
 
-				float value = val[0] / 255.0f;
-				payload->append((const char*)&value, sizeof(float));
-			}
-		}
-	} else if (orientation == ESliceOrientation::YZ) {
-		int x = sliceIndex;
-		if (sliceIndex < 0 || sliceIndex >= dims[0]) {
-			qWarning() << "Failed to convert Study ImageSlice to JSON: slice index is out of range";
-			qDebug() << "Exit - Slice out of range";
-			return false;
-		}
-		payload->reserve(dims[1] * dims[2] * sizeof(float));
-		for (int z = 0; z < dims[2]; z++) {
-			for (int y = 0; y < dims[1]; y++) {
-				unsigned char* val = static_cast<unsigned char*>(data->GetScalarPointer(x, y, z));
+	// A partial image only has the slice in memory once it is copied.
+	vtkImageData* source = data;
+	int sourceIndex = sliceIndex;
+	vtkSmartPointer<vtkImageData> slice;
+	if (data->isPartial()) {
+		slice = vtkSmartPointer<vtkImageData>::New();
+		data->copySlice(sliceIndex, orientation, slice);
+		source = slice;
+		sourceIndex = 0;
+	}
 
-				float value = val[0] / 255.0f;
-				payload->append((const char*)&value, sizeof(float));
-			}
-		}
-	} else if (orientation == ESliceOrientation::XZ) {
-		int y = sliceIndex;
-		if (sliceIndex < 0 || sliceIndex >= dims[1]) {
-			qWarning() << "Failed to convert Study ImageSlice to JSON: slice index is out of range";
-			qDebug() << "Exit - Slice out of range";
-			return false;
-		}
-		payload->reserve(dims[0] * dims[2] * sizeof(float));
-		for (int z = 0; z < dims[2]; z++) {
-			for (int x = 0; x < dims[0]; x++) {
-				unsigned char* val = static_cast<unsigned char*>(data->GetScalarPointer(x, y, z));
-				
-				float value = val[0] / 255.0f;
-				payload->append((const char*)&value, sizeof(float));
-			}
-		}
-	} else {
-		qWarning() << "Failed to convert Study ImageSlice to JSON: orientation is unknown";
-		qDebug() << "Exit - Unknown orientation";
+	QSharedPointer<QByteArray> payload(new QByteArray());
+	payload->resize(sliceSize * sizeof(float));
+	if (!ImageAlgorithms::applyWindowLevel(source, sourceIndex, orientation,
+		window, level, reinterpret_cast<float*>(payload->data())))
+	{
+		qWarning() << "Failed to convert Study ImageSlice to JSON: slice index is out of range";
+		qDebug() << "Exit - Slice out of range";
 		return false;
 	}
 
@@ -274,6 +378,7 @@ bool DataMessageEncoder::toMessage(ImageData* data, const int& sliceIndex,
 	imageInfo->insert(DATA_NAME, data->getDataName());
 	imageInfo->insert(DATA_TYPE, EData::STUDY);
 	imageInfo->insert(CACHEABLE, data->getCacheable());
+	imageInfo->insert(DATA_VERSION, data->getDataVersion());
 	imageInfo->insert(SLICE_ORIENTATION, orientation.toInt());
 	imageInfo->insert(SLICE_INDEX, sliceIndex);
 
@@ -289,6 +394,9 @@ bool DataMessageEncoder::toMessage(ImageData* data, const int& sliceIndex,
 	// TODO: Need enumeration, 1 indicates gray scale.
 	imageInfo->insert(DATA_FORMAT, 1);
 
+	imageInfo->insert(WINDOW_WIDTH, window);
+	imageInfo->insert(WINDOW_CENTER, level);
+
 	qDebug() << "Converted an Image to Message with" << payload->count() << "bytes";
 	dataMessage->setInfoAndPayload(imageInfo, payload);
 
@@ -306,6 +414,27 @@ MessagePtr DataMessageEncoder::toMessage(Study* study, const int& sliceIndex,
 bool DataMessageEncoder::toMessage(Study* study, const int& sliceIndex, 
 	const ESliceOrientation& orientation,const int& seriesIndex, 
 	MessagePtr dataMessage) 
+{
+	if (study == Q_NULLPTR) {
+		qWarning() << "Failed to convert study image slice: data is null";
+		return false;
+	}
+
+	ImageDataVPtr series = study->getSeries(seriesIndex);
+	if (series.Get() == Q_NULLPTR) {
+		qWarning() << "Failed to convert study image slice: series" << seriesIndex << "is null";
+		return false;
+	}
+
+	double window, level;
+	series->getWindowLevel(window, level);
+	return DataMessageEncoder::toMessage(study, sliceIndex, orientation, seriesIndex,
+		window, level, dataMessage);
+}
+
+bool DataMessageEncoder::toMessage(Study* study, const int& sliceIndex,
+	const ESliceOrientation& orientation, const int& seriesIndex,
+	const double& window, const double& level, MessagePtr dataMessage)
 {
 	qDebug() << "Enter - Converting StudySlice: SliceIndex=" << sliceIndex << 
 		"Orientation=" << orientation.getName() << "seriesIndex=" <<
@@ -320,14 +449,16 @@ bool DataMessageEncoder::toMessage(Study* study, const int& sliceIndex,
 	qDebug() << "Study has" << study->getSeriesCount() << "series";
 
 	ImageDataVPtr series = study->getSeries(seriesIndex);
-	bool imageDataOk = DataMessageEncoder::toMessage(series, sliceIndex, orientation, dataMessage);
+	bool imageDataOk = DataMessageEncoder::toMessage(series, sliceIndex, orientation,
+		window, level, dataMessage);
 	if (imageDataOk) {
 		QSharedPointer<QJsonObject> imageInfo = dataMessage->getInfo();
 
 		// Replace the DataID, with the study's DataID.
 		imageInfo->insert(DATA_ID, study->getDataID().toString());
 
-		// Replace cacheable flag with the study's flag
+		// Replace cacheable flag with the study's flag. The data version
+		// stays the one of the series, each series changes on its own.
 		imageInfo->insert(CACHEABLE, study->getCacheable());
 		imageInfo->insert(SERIES_INDEX, seriesIndex);
 		imageInfo->insert(SERIES_COUNT, study->getSeriesCount());
@@ -389,6 +520,7 @@ bool DataMessageEncoder::toMessage(ModelData* data, MessagePtr dataMessage) {
 	modelInfo->insert(DATA_NAME, data->getDataName());
 	modelInfo->insert(DATA_TYPE, EData::MODEL);
 	modelInfo->insert(CACHEABLE, data->getCacheable());
+	modelInfo->insert(DATA_VERSION, data->getDataVersion());
 	//TODO: Needs enumeration, 1 is XYZ (coordinates)
 	modelInfo->insert(DATA_FORMAT, 1);
 	modelInfo->insert(PAYLOAD_POINTS_LENGTH, pointBytes);
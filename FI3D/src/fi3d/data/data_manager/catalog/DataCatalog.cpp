@@ -0,0 +1,383 @@
+#include <fi3d/data/data_manager/catalog/DataCatalog.h>
+
+#include <fi3d/logger/Logger.h>
+
+#include <QDataStream>
+#include <QDir>
+#include <QFileInfo>
+#include <QObject>
+#include <QSaveFile>
+
+using namespace fi3d;
+
+/// @brief Encodes the meta-data of an entry, only its type and DataID for a removal.
+static QByteArray encodeMeta(const CatalogEntry& entry) {
+	QByteArray meta;
+	QDataStream stream(&meta, QIODevice::WriteOnly);
+	stream << (quint8)entry.Type << entry.ID;
+	if (entry.Type != EData::UNKNOWN) {
+		stream << entry.Name << entry.Path << entry.PatientID << entry.PatientName <<
+			entry.StudyDate << entry.StudyTime << (qint32)entry.SeriesCount << entry.IsDICOM;
+	}
+	return meta;
+}
+
+/// @brief Decodes the meta-data of an entry. False if it is malformed.
+static bool decodeMeta(const QByteArray& meta, CatalogEntry& entry) {
+	QDataStream stream(meta);
+	quint8 type;
+	stream >> type >> entry.ID;
+	entry.Type = type;
+	if (entry.Type != EData::UNKNOWN) {
+		qint32 seriesCount;
+		stream >> entry.Name >> entry.Path >> entry.PatientID >> entry.PatientName >>
+			entry.StudyDate >> entry.StudyTime >> seriesCount >> entry.IsDICOM;
+		entry.SeriesCount = seriesCount;
+	}
+	return stream.status() == QDataStream::Ok;
+}
+
+/// @brief Encodes the files of each series. Each path is stored as the
+/// number of bytes it shares with the path before it and the rest of it.
+static QByteArray encodePaths(const QVector<QStringList>& dicomPaths) {
+	QByteArray paths;
+	QDataStream stream(&paths, QIODevice::WriteOnly);
+	stream << (qint32)dicomPaths.count();
+
+	QByteArray previous;
+	for (const QStringList& files : dicomPaths) {
+		stream << (qint32)files.count();
+		for (const QString& file : files) {
+			QByteArray path = file.toUtf8();
+			const int limit = qMin(qMin(path.size(), previous.size()), 0xFFFF);
+			int shared = 0;
+			while (shared < limit && path.at(shared) == previous.at(shared)) {
+				shared++;
+			}
+			stream << (quint16)shared << path.mid(shared);
+			previous = path;
+		}
+	}
+	return paths;
+}
+
+/// @brief Decodes the files of each series. False if they are malformed.
+static bool decodePaths(const QByteArray& paths, QVector<QStringList>& dicomPaths) {
+	QDataStream stream(paths);
+	qint32 seriesCount;
+	stream >> seriesCount;
+
+	QByteArray previous;
+	for (int s = 0; s < seriesCount && stream.status() == QDataStream::Ok; s++) {
+		qint32 fileCount;
+		stream >> fileCount;
+
+		QStringList files;
+		for (int f = 0; f < fileCount && stream.status() == QDataStream::Ok; f++) {
+			quint16 shared;
+			QByteArray suffix;
+			stream >> shared >> suffix;
+			if (shared > previous.size()) {
+				return false;
+			}
+			QByteArray path = previous.left(shared) + suffix;
+			files.append(QString::fromUtf8(path));
+			previous = path;
+		}
+		dicomPaths.append(files);
+	}
+	return stream.status() == QDataStream::Ok;
+}
+
+/// @brief Creates the bytes of a record: its sizes, checksums, meta-data and paths.
+static QByteArray createRecord(const QByteArray& meta, const QByteArray& paths) {
+	QByteArray record;
+	record.reserve(DataCatalog::RECORD_HEADER_SIZE + meta.size() + paths.size());
+	QDataStream stream(&record, QIODevice::WriteOnly);
+	stream << (quint32)meta.size() << (quint32)paths.size() << qChecksum(meta) << qChecksum(paths);
+	stream.writeRawData(meta.constData(), meta.size());
+	stream.writeRawData(paths.constData(), paths.size());
+	return record;
+}
+
+/// @brief Creates the bytes at the start of a catalog file.
+static QByteArray createFileHeader() {
+	QByteArray header;
+	QDataStream stream(&header, QIODevice::WriteOnly);
+	stream << DataCatalog::MAGIC << DataCatalog::VERSION;
+	return header;
+}
+
+DataCatalog::DataCatalog(const QString& filePath)
+	: mFilePath(filePath),
+	mFile(),
+	mEntries(),
+	mRecordCount(0)
+{}
+
+DataCatalog::~DataCatalog() {}
+
+QString DataCatalog::getDefaultPath() {
+	return QObject::tr("%1/FI3D/DM_Catalog.bin").arg(FI3D_DATA_PATH);
+}
+
+bool DataCatalog::open() {
+	qDebug() << "Enter - Opening data catalog" << mFilePath;
+	if (mFile.isOpen()) {
+		qDebug() << "Exit - Already open";
+		return true;
+	}
+
+	QDir().mkpath(QFileInfo(mFilePath).absolutePath());
+	mFile.setFileName(mFilePath);
+	if (!mFile.open(QIODevice::ReadWrite)) {
+		qWarning() << "Failed to open data catalog" << mFilePath << "because:" << mFile.errorString();
+		return false;
+	}
+
+	mEntries.clear();
+	mRecordCount = 0;
+	if (mFile.size() == 0) {
+		QByteArray header = createFileHeader();
+		bool isWritten = mFile.write(header) == header.size() && mFile.flush();
+		qDebug() << "Exit - Created a new catalog";
+		return isWritten;
+	}
+
+	quint32 magic = 0, version = 0;
+	QDataStream header(mFile.read(FILE_HEADER_SIZE));
+	header >> magic >> version;
+	if (header.status() != QDataStream::Ok || magic != MAGIC || version != VERSION) {
+		qWarning() << "Moving data catalog" << mFilePath << "aside because its format is unknown.";
+		qDebug() << "Exit - Unknown format";
+		return this->reset();
+	}
+
+	// Only the meta-data is read, the paths of each record are skipped.
+	const qint64 fileSize = mFile.size();
+	qint64 position = FILE_HEADER_SIZE;
+	while (position < fileSize) {
+		QDataStream recordHeader(mFile.read(RECORD_HEADER_SIZE));
+		quint32 metaSize, pathsSize;
+		quint16 metaChecksum, pathsChecksum;
+		recordHeader >> metaSize >> pathsSize >> metaChecksum >> pathsChecksum;
+		if (recordHeader.status() != QDataStream::Ok) {
+			break;
+		}
+
+		const qint64 end = position + RECORD_HEADER_SIZE + metaSize + pathsSize;
+		if (end > fileSize) {
+			break;
+		}
+
+		QByteArray meta = mFile.read(metaSize);
+		CatalogEntry entry;
+		if (meta.size() != (int)metaSize || qChecksum(meta) != metaChecksum || !decodeMeta(meta, entry)) {
+			break;
+		}
+
+		if (entry.Type == EData::UNKNOWN) {
+			mEntries.remove(entry.ID);
+		} else {
+			if (pathsSize > 0) {
+				entry.PathsOffset = position + RECORD_HEADER_SIZE + metaSize;
+				entry.PathsSize = pathsSize;
+				entry.PathsChecksum = pathsChecksum;
+			}
+			mEntries.insert(entry.ID, entry);
+		}
+		mRecordCount++;
+
+		position = end;
+		if (pathsSize > 0) {
+			mFile.seek(position);
+		}
+	}
+
+	// Whatever follows the last whole record was being written during a crash.
+	if (position < fileSize) {
+		qWarning() << "Cutting off the torn end of data catalog" << mFilePath << "at byte" << position;
+		mFile.resize(position);
+	}
+
+	qDebug() << "Exit - Read" << mEntries.count() << "entries from" << mRecordCount << "records";
+	return true;
+}
+
+bool DataCatalog::isOpen() const {
+	return mFile.isOpen();
+}
+
+QList<CatalogEntry> DataCatalog::getEntries() const {
+	return mEntries.values();
+}
+
+bool DataCatalog::contains(const QUuid& dataID) const {
+	return mEntries.contains(dataID);
+}
+
+int DataCatalog::count() const {
+	return mEntries.count();
+}
+
+bool DataCatalog::put(const CatalogEntry& entry, const QVector<QStringList>& dicomPaths) {
+	if (!this->isOpen() || entry.Type == EData::UNKNOWN) {
+		return false;
+	}
+
+	CatalogEntry stored = entry;
+	stored.PathsOffset = -1;
+	stored.PathsSize = 0;
+	stored.PathsChecksum = 0;
+
+	QByteArray meta = encodeMeta(stored);
+	QByteArray paths;
+	if (stored.IsDICOM && !dicomPaths.isEmpty()) {
+		paths = encodePaths(dicomPaths);
+	}
+
+	qint64 pathsOffset;
+	if (!this->append(meta, paths, pathsOffset)) {
+		return false;
+	}
+
+	if (!paths.isEmpty()) {
+		stored.PathsOffset = pathsOffset;
+		stored.PathsSize = paths.size();
+		stored.PathsChecksum = qChecksum(paths);
+	}
+	mEntries.insert(stored.ID, stored);
+	return true;
+}
+
+bool DataCatalog::remove(const QUuid& dataID) {
+	if (!this->isOpen() || !mEntries.contains(dataID)) {
+		return false;
+	}
+
+	CatalogEntry removal;
+	removal.ID = dataID;
+
+	qint64 pathsOffset;
+	if (!this->append(encodeMeta(removal), QByteArray(), pathsOffset)) {
+		return false;
+	}
+
+	mEntries.remove(dataID);
+	return true;
+}
+
+QVector<QStringList> DataCatalog::readDICOMPaths(const QUuid& dataID) {
+	QVector<QStringList> dicomPaths;
+	CatalogEntry entry = mEntries.value(dataID);
+	if (!this->isOpen() || entry.PathsOffset < 0) {
+		return dicomPaths;
+	}
+
+	mFile.seek(entry.PathsOffset);
+	QByteArray paths = mFile.read(entry.PathsSize);
+	if (paths.size() != (int)entry.PathsSize || qChecksum(paths) != entry.PathsChecksum ||
+		!decodePaths(paths, dicomPaths))
+	{
+		qWarning() << "Failed to read the DICOM files of" << dataID << "because they are corrupt.";
+		return QVector<QStringList>();
+	}
+	return dicomPaths;
+}
+
+bool DataCatalog::isWorthCompacting() const {
+	const int deadCount = mRecordCount - mEntries.count();
+	return deadCount > qMax(mEntries.count(), 16);
+}
+
+bool DataCatalog::compact() {
+	qDebug() << "Enter - Compacting" << mRecordCount << "records into" << mEntries.count();
+	if (!this->isOpen()) {
+		qDebug() << "Exit - Not open";
+		return false;
+	}
+
+	QSaveFile file(mFilePath);
+	if (!file.open(QIODevice::WriteOnly)) {
+		qWarning() << "Failed to compact data catalog" << mFilePath << "because:" << file.errorString();
+		return false;
+	}
+
+	QByteArray header = createFileHeader();
+	file.write(header);
+
+	QHash<QUuid, CatalogEntry> entries;
+	entries.reserve(mEntries.count());
+	qint64 position = header.size();
+	for (const CatalogEntry& entry : mEntries) {
+		QByteArray paths;
+		if (entry.PathsOffset >= 0) {
+			mFile.seek(entry.PathsOffset);
+			paths = mFile.read(entry.PathsSize);
+			if (paths.size() != (int)entry.PathsSize) {
+				qWarning() << "Failed to compact data catalog" << mFilePath << "because it could not be read.";
+				file.cancelWriting();
+				return false;
+			}
+		}
+
+		QByteArray meta = encodeMeta(entry);
+		file.write(createRecord(meta, paths));
+
+		CatalogEntry compacted = entry;
+		if (!paths.isEmpty()) {
+			compacted.PathsOffset = position + RECORD_HEADER_SIZE + meta.size();
+		}
+		entries.insert(compacted.ID, compacted);
+		position += RECORD_HEADER_SIZE + meta.size() + paths.size();
+	}
+
+	// The file is closed first since some platforms do not replace open files.
+	mFile.close();
+	bool isCommitted = file.commit();
+	if (!mFile.open(QIODevice::ReadWrite)) {
+		qWarning() << "Failed to reopen data catalog" << mFilePath << "because:" << mFile.errorString();
+		return false;
+	}
+	if (!isCommitted) {
+		qWarning() << "Failed to compact data catalog" << mFilePath << "because:" << file.errorString();
+		return false;
+	}
+
+	mEntries = entries;
+	mRecordCount = entries.count();
+	qDebug() << "Exit";
+	return true;
+}
+
+bool DataCatalog::append(const QByteArray& meta, const QByteArray& paths, qint64& pathsOffset) {
+	QByteArray record = createRecord(meta, paths);
+	const qint64 position = mFile.size();
+	mFile.seek(position);
+	if (mFile.write(record) != record.size() || !mFile.flush()) {
+		qWarning() << "Failed to write to data catalog" << mFilePath << "because:" << mFile.errorString();
+		mFile.resize(position);
+		return false;
+	}
+
+	pathsOffset = position + RECORD_HEADER_SIZE + meta.size();
+	mRecordCount++;
+	return true;
+}
+
+bool DataCatalog::reset() {
+	mFile.close();
+	QString oldPath = mFilePath + ".old";
+	QFile::remove(oldPath);
+	QFile::rename(mFilePath, oldPath);
+
+	mEntries.clear();
+	mRecordCount = 0;
+	if (!mFile.open(QIODevice::ReadWrite | QIODevice::Truncate)) {
+		qWarning() << "Failed to create data catalog" << mFilePath << "because:" << mFile.errorString();
+		return false;
+	}
+
+	QByteArray header = createFileHeader();
+	return mFile.write(header) == header.size() && mFile.flush();
+}
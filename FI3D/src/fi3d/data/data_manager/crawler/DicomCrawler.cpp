@@ -0,0 +1,297 @@
+#include <fi3d/data/data_manager/crawler/DicomCrawler.h>
+
+#include <fi3d/logger/Logger.h>
+
+#include <fi3d/data/data_manager/crawler/DicomScanCache.h>
+#include <fi3d/utilities/ParallelAlgorithms.h>
+
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QHash>
+#include <QMetaType>
+#include <QPair>
+#include <QSet>
+#include <QThread>
+
+#include <vtkDICOMMetaData.h>
+#include <vtkDICOMParser.h>
+#include <vtkDICOMUtilities.h>
+#include <vtkNew.h>
+
+#include <algorithm>
+
+using namespace fi3d;
+
+/// @brief Parses the header of a file, up to its pixel data.
+static void parseHeader(const QString& path, DicomFileRecord& record) {
+	std::string fileName = path.toStdString();
+	if (!vtkDICOMUtilities::IsDICOMFile(fileName.c_str())) {
+		return;
+	}
+
+	vtkNew<vtkDICOMMetaData> metaData;
+	vtkNew<vtkDICOMParser> parser;
+	parser->SetMetaData(metaData);
+	parser->SetFileName(fileName.c_str());
+	parser->Update();
+	if (parser->GetErrorCode() != 0) {
+		return;
+	}
+
+	record.IsDICOM = true;
+	record.HasPixelData = parser->GetPixelDataFound();
+	record.StudyUID = QString::fromStdString(metaData->Get(DC::StudyInstanceUID).AsString());
+	record.SeriesUID = QString::fromStdString(metaData->Get(DC::SeriesInstanceUID).AsString());
+	record.StudyID = QString::fromStdString(metaData->Get(DC::StudyID).AsString());
+	record.PatientID = QString::fromStdString(metaData->Get(DC::PatientID).AsString());
+	record.PatientName = QString::fromStdString(metaData->Get(DC::PatientName).AsString());
+	record.StudyDate = QString::fromStdString(metaData->Get(DC::StudyDate).AsString());
+	record.StudyTime = QString::fromStdString(metaData->Get(DC::StudyTime).AsString());
+	record.InstanceNumber = metaData->Get(DC::InstanceNumber).AsInt();
+}
+
+DicomCrawler::DicomCrawler(const QString& directory, const QString& cachePath, QObject* parent)
+	: QObject(parent),
+	mDirectory(QDir(directory).absolutePath()),
+	mCachePath(cachePath),
+	mStudies(),
+	mIsCancelled(0),
+	mThread(Q_NULLPTR)
+{
+	// Found studies cross to the receiver's thread through queued connections.
+	qRegisterMetaType<DicomStudyRecord>("fi3d::DicomStudyRecord");
+}
+
+DicomCrawler::~DicomCrawler() {
+	if (mThread != Q_NULLPTR) {
+		this->cancel();
+		mThread->wait();
+		delete mThread;
+	}
+}
+
+QString DicomCrawler::getDirectory() const {
+	return mDirectory;
+}
+
+QList<DicomStudyRecord> DicomCrawler::crawl() {
+	qDebug() << "Enter - Crawling" << mDirectory;
+
+	DicomScanCache cache;
+	if (!mCachePath.isEmpty()) {
+		cache.load(mCachePath);
+	}
+
+	QList<DicomStudyRecord> studies;
+	QHash<QString, int> studyIndices;
+	QVector<QHash<QString, int>> seriesIndices;
+	QVector<QVector<QVector<QPair<int, QString>>>> seriesFiles;
+	QHash<QString, int> directoryStudyCounts;
+	QSet<QString> seenPaths;
+	int checkedCount = 0;
+	int listedCount = 0;
+	int parsedCount = 0;
+
+	QStringList level = {mDirectory};
+	for (int depth = 0; depth <= MAX_DEPTH && !level.isEmpty() && !this->isCancelled(); depth++) {
+		// List the directories of the level in parallel.
+		QVector<QStringList> levelDirectories(level.count());
+		QVector<QFileInfoList> levelFiles(level.count());
+		ParallelAlgorithms::forRange(level.count(), [&](const int& i) {
+			if (this->isCancelled()) {
+				return;
+			}
+			QFileInfoList entries = QDir(level.at(i)).entryInfoList(
+				QDir::AllDirs | QDir::Files | QDir::Hidden | QDir::NoDotAndDotDot | QDir::NoSymLinks,
+				QDir::Name);
+			for (const QFileInfo& entry : entries) {
+				if (entry.isDir()) {
+					levelDirectories[i].append(entry.absoluteFilePath());
+				} else {
+					levelFiles[i].append(entry);
+				}
+			}
+		});
+
+		QFileInfoList files;
+		level.clear();
+		for (int i = 0; i < levelDirectories.count(); i++) {
+			level.append(levelDirectories.at(i));
+			files.append(levelFiles.at(i));
+		}
+		listedCount += files.count();
+
+		for (int first = 0; first < files.count() && !this->isCancelled(); first += PARSE_BATCH) {
+			const int batchCount = qMin(PARSE_BATCH, files.count() - first);
+
+			// Parse the headers of the files the cache does not know, in parallel.
+			QVector<DicomFileRecord> records(batchCount);
+			QVector<int> unknown;
+			for (int i = 0; i < batchCount; i++) {
+				const QFileInfo& file = files.at(first + i);
+				QString path = file.absoluteFilePath();
+				seenPaths.insert(path);
+				if (!cache.find(path, file.size(), file.lastModified().toMSecsSinceEpoch(), records[i])) {
+					records[i].Size = file.size();
+					records[i].Modified = file.lastModified().toMSecsSinceEpoch();
+					unknown.append(i);
+				}
+			}
+			ParallelAlgorithms::forRange(unknown.count(), [&](const int& u) {
+				if (!this->isCancelled()) {
+					parseHeader(files.at(first + unknown.at(u)).absoluteFilePath(), records[unknown.at(u)]);
+				}
+			});
+			if (this->isCancelled()) {
+				break;
+			}
+			for (int i : unknown) {
+				cache.insert(files.at(first + i).absoluteFilePath(), records.at(i));
+			}
+			parsedCount += unknown.count();
+
+			// Group the files into studies and series, in listing order.
+			for (int i = 0; i < batchCount; i++) {
+				const DicomFileRecord& record = records.at(i);
+				if (!record.IsDICOM || !record.HasPixelData) {
+					continue;
+				}
+
+				const QFileInfo& file = files.at(first + i);
+				QString directory = file.absolutePath();
+				QString studyKey = record.StudyUID.isEmpty() ? directory : record.StudyUID;
+				int studyIndex = studyIndices.value(studyKey, -1);
+				if (studyIndex == -1) {
+					DicomStudyRecord study;
+					study.StudyUID = record.StudyUID;
+					study.StudyID = record.StudyID;
+					study.PatientID = record.PatientID;
+					study.PatientName = record.PatientName;
+					study.StudyDate = record.StudyDate;
+					study.StudyTime = record.StudyTime;
+					if (study.StudyID.isEmpty()) {
+						int sameDirectory = directoryStudyCounts.value(directory, 0);
+						directoryStudyCounts.insert(directory, sameDirectory + 1);
+						study.StudyID = QFileInfo(directory).fileName();
+						if (sameDirectory > 0) {
+							study.StudyID = tr("%1_%2").arg(study.StudyID).arg(sameDirectory);
+						}
+					}
+
+					studyIndex = studies.count();
+					studyIndices.insert(studyKey, studyIndex);
+					studies.append(study);
+					seriesIndices.append(QHash<QString, int>());
+					seriesFiles.append(QVector<QVector<QPair<int, QString>>>());
+					emit foundStudy(study);
+				}
+
+				QString seriesKey = record.SeriesUID.isEmpty() ? directory : record.SeriesUID;
+				int seriesIndex = seriesIndices[studyIndex].value(seriesKey, -1);
+				if (seriesIndex == -1) {
+					seriesIndex = seriesFiles[studyIndex].count();
+					seriesIndices[studyIndex].insert(seriesKey, seriesIndex);
+					seriesFiles[studyIndex].append(QVector<QPair<int, QString>>());
+				}
+				seriesFiles[studyIndex][seriesIndex].append(
+					qMakePair(record.InstanceNumber, file.absoluteFilePath()));
+			}
+
+			checkedCount += batchCount;
+			emit progressed(checkedCount, listedCount);
+		}
+	}
+
+	if (!this->isCancelled()) {
+		cache.prune(mDirectory, seenPaths);
+	}
+	if (!mCachePath.isEmpty()) {
+		cache.save(mCachePath);
+	}
+
+	if (this->isCancelled()) {
+		qDebug() << "Exit - Cancelled after parsing" << parsedCount << "headers";
+		return QList<DicomStudyRecord>();
+	}
+
+	for (int s = 0; s < studies.count(); s++) {
+		for (QVector<QPair<int, QString>>& files : seriesFiles[s]) {
+			std::sort(files.begin(), files.end());
+			QStringList paths;
+			paths.reserve(files.count());
+			for (const QPair<int, QString>& file : files) {
+				paths.append(file.second);
+			}
+			studies[s].Series.append(paths);
+		}
+	}
+	mStudies = studies;
+
+	qDebug() << "Exit - Found" << studies.count() << "studies in" << listedCount <<
+		"files, parsed" << parsedCount << "headers";
+	return studies;
+}
+
+void DicomCrawler::start() {
+	if (mThread != Q_NULLPTR) {
+		qWarning() << "DICOM crawler was already started.";
+		return;
+	}
+
+	mThread = QThread::create([this]() {
+		this->crawl();
+		if (this->isCancelled()) {
+			emit this->cancelled();
+		} else {
+			emit this->finished();
+		}
+	});
+	mThread->setObjectName("FI3D DICOM Crawler");
+	mThread->start();
+}
+
+void DicomCrawler::cancel() {
+	mIsCancelled.storeRelaxed(1);
+}
+
+bool DicomCrawler::isRunning() const {
+	return mThread != Q_NULLPTR && mThread->isRunning();
+}
+
+void DicomCrawler::wait() {
+	if (mThread != Q_NULLPTR) {
+		mThread->wait();
+	}
+}
+
+QList<DicomStudyRecord> DicomCrawler::getStudies() const {
+	return mStudies;
+}
+
+StudyPtr DicomCrawler::createStudy(const DicomStudyRecord& record) {
+	StudyPtr study(new Study());
+	study->setStudyID(record.StudyID);
+	study->setPatientID(record.PatientID);
+	study->setPatientName(record.PatientName);
+	study->setStudyDate(record.StudyDate);
+	study->setStudyTime(record.StudyTime);
+	return study;
+}
+
+QVector<vtkSmartPointer<vtkStringArray>> DicomCrawler::getSeriesPaths(const DicomStudyRecord& record) {
+	QVector<vtkSmartPointer<vtkStringArray>> seriesPaths;
+	for (const QStringList& files : record.Series) {
+		vtkSmartPointer<vtkStringArray> paths = vtkSmartPointer<vtkStringArray>::New();
+		paths->SetNumberOfValues(files.count());
+		for (int i = 0; i < files.count(); i++) {
+			paths->SetValue(i, files.at(i).toStdString());
+		}
+		seriesPaths.append(paths);
+	}
+	return seriesPaths;
+}
+
+bool DicomCrawler::isCancelled() const {
+	return mIsCancelled.loadRelaxed() != 0;
+}
@@ -0,0 +1,142 @@
+#include <fi3d/data/data_manager/crawler/DicomScanCache.h>
+
+#include <fi3d/logger/Logger.h>
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QObject>
+#include <QSaveFile>
+
+using namespace fi3d;
+
+/// @brief Writes a record to the stream.
+static void writeRecord(QDataStream& stream, const DicomFileRecord& record) {
+	stream << record.Size << record.Modified << record.IsDICOM << record.HasPixelData <<
+		record.StudyUID << record.SeriesUID << record.StudyID << record.PatientID <<
+		record.PatientName << record.StudyDate << record.StudyTime <<
+		(qint32)record.InstanceNumber;
+}
+
+/// @brief Reads a record from the stream.
+static void readRecord(QDataStream& stream, DicomFileRecord& record) {
+	qint32 instanceNumber;
+	stream >> record.Size >> record.Modified >> record.IsDICOM >> record.HasPixelData >>
+		record.StudyUID >> record.SeriesUID >> record.StudyID >> record.PatientID >>
+		record.PatientName >> record.StudyDate >> record.StudyTime >> instanceNumber;
+	record.InstanceNumber = instanceNumber;
+}
+
+DicomScanCache::DicomScanCache()
+	: mRecords(),
+	mIsChanged(false)
+{}
+
+DicomScanCache::~DicomScanCache() {}
+
+QString DicomScanCache::getDefaultPath() {
+	return QObject::tr("%1/FI3D/DM_DicomScanCache.bin").arg(FI3D_DATA_PATH);
+}
+
+bool DicomScanCache::load(const QString& filePath) {
+	QFile file(filePath);
+	if (!file.open(QIODevice::ReadOnly)) {
+		return false;
+	}
+
+	QDataStream stream(&file);
+	quint32 magic, version;
+	qint32 count;
+	stream >> magic >> version >> count;
+	if (magic != MAGIC || version != VERSION || count < 0) {
+		qWarning() << "Ignoring DICOM scan cache" << filePath << "because its format is unknown.";
+		return false;
+	}
+
+	QHash<QString, DicomFileRecord> records;
+	records.reserve(count);
+	for (int i = 0; i < count && stream.status() == QDataStream::Ok; i++) {
+		QString path;
+		DicomFileRecord record;
+		stream >> path;
+		readRecord(stream, record);
+		records.insert(path, record);
+	}
+
+	if (stream.status() != QDataStream::Ok) {
+		qWarning() << "Ignoring DICOM scan cache" << filePath << "because it is truncated.";
+		return false;
+	}
+
+	mRecords = records;
+	mIsChanged = false;
+	qDebug() << "Loaded" << mRecords.count() << "DICOM scan records from" << filePath;
+	return true;
+}
+
+bool DicomScanCache::save(const QString& filePath) {
+	if (!mIsChanged) {
+		return true;
+	}
+
+	QDir().mkpath(QFileInfo(filePath).absolutePath());
+	QSaveFile file(filePath);
+	if (!file.open(QIODevice::WriteOnly)) {
+		qWarning() << "Failed to save DICOM scan cache to" << filePath;
+		return false;
+	}
+
+	QDataStream stream(&file);
+	stream << MAGIC << VERSION << (qint32)mRecords.count();
+	for (auto it = mRecords.constBegin(); it != mRecords.constEnd(); it++) {
+		stream << it.key();
+		writeRecord(stream, it.value());
+	}
+
+	if (stream.status() != QDataStream::Ok || !file.commit()) {
+		qWarning() << "Failed to save DICOM scan cache to" << filePath;
+		return false;
+	}
+
+	mIsChanged = false;
+	return true;
+}
+
+bool DicomScanCache::find(const QString& path, const qint64& size, const qint64& modified,
+	DicomFileRecord& record) const
+{
+	auto it = mRecords.constFind(path);
+	if (it == mRecords.constEnd() || it->Size != size || it->Modified != modified) {
+		return false;
+	}
+	record = it.value();
+	return true;
+}
+
+void DicomScanCache::insert(const QString& path, const DicomFileRecord& record) {
+	mRecords.insert(path, record);
+	mIsChanged = true;
+}
+
+int DicomScanCache::prune(const QString& directory, const QSet<QString>& seenPaths) {
+	QString prefix = directory.endsWith('/') ? directory : directory + '/';
+	int removed = 0;
+	for (auto it = mRecords.begin(); it != mRecords.end();) {
+		if (it.key().startsWith(prefix) && !seenPaths.contains(it.key())) {
+			it = mRecords.erase(it);
+			removed++;
+		} else {
+			it++;
+		}
+	}
+
+	if (removed > 0) {
+		mIsChanged = true;
+	}
+	return removed;
+}
+
+int DicomScanCache::count() const {
+	return mRecords.count();
+}
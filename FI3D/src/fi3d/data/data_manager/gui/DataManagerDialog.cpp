@@ -2,13 +2,21 @@
 
 #include "ui_DataManagerDialog.h"
 
+#include <fi3d/data/data_manager/thumbnail/ThumbnailService.h>
+
+#include <QIcon>
+#include <QPixmap>
+#include <QScrollBar>
+#include <QTimer>
+
 using namespace fi3d;
 
 DataManagerDialog::DataManagerDialog()
 	: QDialog(),
 	mGUI(new Ui::DataManagerDialog),
 	mStudyTableHeader(new QHeaderView(Qt::Orientation::Horizontal, this)),
-	mModelTableHeader(new QHeaderView(Qt::Orientation::Horizontal, this))
+	mModelTableHeader(new QHeaderView(Qt::Orientation::Horizontal, this)),
+	mThumbnailItems()
 {
 	mGUI->setupUi(this);
 	QItemSelectionModel model;
@@ -19,6 +27,8 @@ DataManagerDialog::DataManagerDialog()
 	mGUI->studyList_table->setColumnCount(6);
 	mGUI->studyList_table->setColumnHidden(0, true);
 	mGUI->studyList_table->setHorizontalHeaderLabels(studyListHeaderLabels);
+	mGUI->studyList_table->verticalHeader()->setDefaultSectionSize(ThumbnailService::SIZE + 4);
+	mGUI->studyList_table->setIconSize(QSize(ThumbnailService::SIZE, ThumbnailService::SIZE));
 
 	QStringList modelListHeaderLabels = {"Data ID", "Model Name"};
 	mGUI->modelList_table->setColumnCount(2);
@@ -42,6 +52,9 @@ DataManagerDialog::DataManagerDialog()
 	QObject::connect(
 		mGUI->loadModel_btn, &QPushButton::clicked,
 		this, &DataManagerDialog::requestedLoadModel);
+	QObject::connect(
+		mGUI->studyList_table->verticalScrollBar(), &QScrollBar::valueChanged,
+		this, &DataManagerDialog::requestVisibleThumbnails);
 }
 
 DataManagerDialog::~DataManagerDialog() {}
@@ -65,6 +78,7 @@ void DataManagerDialog::setImages(const QList<RegisteredImagePtr> images) {
 }
 
 void DataManagerDialog::setStudies(const QList<RegisteredStudyPtr> studies) {
+	mThumbnailItems.clear();
 	mGUI->studyList_table->setRowCount(studies.count());
 
 	for (int i = 0; i < studies.count(); i++) {
@@ -89,11 +103,15 @@ void DataManagerDialog::setStudies(const QList<RegisteredStudyPtr> studies) {
 		mGUI->studyList_table->setItem(i, 3, patientNameItem);
 		mGUI->studyList_table->setItem(i, 4, studyDateItem);
 		mGUI->studyList_table->setItem(i, 5, studyTimeItem);
+		mThumbnailItems.insert(study->getDataID(), studyIDItem);
 	}
 
 	mGUI->studyList_table->sortByColumn(1, Qt::SortOrder::AscendingOrder);
 	mGUI->studyList_table->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Stretch);
 	mGUI->studyList_table->resizeColumnsToContents();
+
+	// Requested once the rows are laid out.
+	QTimer::singleShot(0, this, &DataManagerDialog::requestVisibleThumbnails);
 }
 
 void DataManagerDialog::setModels(const QList<RegisteredModelPtr> models) {
@@ -112,4 +130,37 @@ void DataManagerDialog::setModels(const QList<RegisteredModelPtr> models) {
 
 	mGUI->modelList_table->sortByColumn(1, Qt::SortOrder::AscendingOrder);
 	mGUI->modelList_table->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Stretch);
-}
\ No newline at end of file
+}
+
+void DataManagerDialog::setThumbnail(const QUuid& dataID, const QImage& thumbnail) {
+	QTableWidgetItem* item = mThumbnailItems.value(dataID);
+	if (item != Q_NULLPTR) {
+		item->setIcon(QIcon(QPixmap::fromImage(thumbnail)));
+	}
+}
+
+void DataManagerDialog::requestVisibleThumbnails() {
+	QTableWidget* table = mGUI->studyList_table;
+	if (table->rowCount() == 0 || !this->isVisible()) {
+		return;
+	}
+
+	int firstRow = qMax(0, table->rowAt(0));
+	int lastRow = table->rowAt(table->viewport()->height() - 1);
+	if (lastRow == -1) {
+		lastRow = table->rowCount() - 1;
+	}
+
+	QList<DataID> studies;
+	for (int row = firstRow; row <= lastRow; row++) {
+		QTableWidgetItem* dataID = table->item(row, 0);
+		QTableWidgetItem* studyID = table->item(row, 1);
+		if (dataID != Q_NULLPTR && studyID != Q_NULLPTR && studyID->icon().isNull()) {
+			studies.append(DataID(QUuid(dataID->text()), studyID->text()));
+		}
+	}
+
+	if (!studies.isEmpty()) {
+		emit requestedThumbnails(studies);
+	}
+}
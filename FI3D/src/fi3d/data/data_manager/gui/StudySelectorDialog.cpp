@@ -2,12 +2,20 @@
 
 #include "ui_StudySelectorDialog.h"
 
+#include <fi3d/data/data_manager/thumbnail/ThumbnailService.h>
+
+#include <QIcon>
+#include <QPixmap>
+#include <QScrollBar>
+#include <QTimer>
+
 using namespace fi3d;
 
 StudySelectorDialog::StudySelectorDialog(QWidget *parent) :
     QDialog(parent),
     mGUI(new Ui::StudySelectorDialog),
-	mSelectedStudyID()
+	mSelectedStudyID(),
+	mThumbnailItems()
 {
 	mGUI->setupUi(this);
 	
@@ -18,6 +26,12 @@ StudySelectorDialog::StudySelectorDialog(QWidget *parent) :
 	mGUI->studyList_table->setColumnHidden(0, true);
 	mGUI->studyList_table->setHorizontalHeaderLabels(studyListHeaderLabels);
 	mGUI->studyList_table->verticalHeader()->setVisible(false);
+	mGUI->studyList_table->verticalHeader()->setDefaultSectionSize(ThumbnailService::SIZE + 4);
+	mGUI->studyList_table->setIconSize(QSize(ThumbnailService::SIZE, ThumbnailService::SIZE));
+
+	QObject::connect(
+		mGUI->studyList_table->verticalScrollBar(), &QScrollBar::valueChanged,
+		this, &StudySelectorDialog::requestVisibleThumbnails);
 
 	QObject::connect(
 		mGUI->studyList_table, &QTableWidget::cellDoubleClicked,
@@ -36,40 +50,93 @@ StudySelectorDialog::~StudySelectorDialog() {}
 
 void StudySelectorDialog::setStudies(const QList<RegisteredStudyPtr>& studies) 
 {
+	mThumbnailItems.clear();
 	mGUI->studyList_table->setRowCount(studies.count());
 
 	for (int i = 0; i < studies.count(); i++) {
-		StudyPtr study = studies[i]->getStudy();
-
-		QString dataID = study->getDataID().toString();
-		QString studyID = study->getStudyID();
-		QString patientID = study->getPatientID();
-		QString patientName = study->getPatientName();
-		QString studyDate = study->getStudyDate();
-		QString studyTime = study->getStudyTime();
-
-		QTableWidgetItem* dataIDItem = new QTableWidgetItem(dataID);
-		QTableWidgetItem* studyIDItem = new QTableWidgetItem(studyID);
-		QTableWidgetItem* patientIDItem = new QTableWidgetItem(patientID);
-		QTableWidgetItem* patientNameItem = new QTableWidgetItem(patientName);
-		QTableWidgetItem* studyDateItem = new QTableWidgetItem(studyDate);
-		QTableWidgetItem* studyTimeItem = new QTableWidgetItem(studyTime);
-		mGUI->studyList_table->setItem(i, 0, dataIDItem);
-		mGUI->studyList_table->setItem(i, 1, studyIDItem);
-		mGUI->studyList_table->setItem(i, 2, patientIDItem);
-		mGUI->studyList_table->setItem(i, 3, patientNameItem);
-		mGUI->studyList_table->setItem(i, 4, studyDateItem);
-		mGUI->studyList_table->setItem(i, 5, studyTimeItem);
+		this->setStudyRow(i, studies[i]->getStudy());
 	}
 
 	mGUI->studyList_table->sortByColumn(1, Qt::SortOrder::AscendingOrder);
 	mGUI->studyList_table->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Stretch);
+
+	// Requested once the rows are laid out.
+	QTimer::singleShot(0, this, &StudySelectorDialog::requestVisibleThumbnails);
+}
+
+void StudySelectorDialog::addStudy(RegisteredStudyPtr study) {
+	if (study.isNull() || study->getStudy().isNull()) {
+		return;
+	}
+
+	int row = mGUI->studyList_table->rowCount();
+	mGUI->studyList_table->insertRow(row);
+	this->setStudyRow(row, study->getStudy());
+	mGUI->studyList_table->sortByColumn(1, Qt::SortOrder::AscendingOrder);
+
+	QTimer::singleShot(0, this, &StudySelectorDialog::requestVisibleThumbnails);
+}
+
+void StudySelectorDialog::setThumbnail(const QUuid& dataID, const QImage& thumbnail) {
+	QTableWidgetItem* item = mThumbnailItems.value(dataID);
+	if (item != Q_NULLPTR) {
+		item->setIcon(QIcon(QPixmap::fromImage(thumbnail)));
+	}
+}
+
+void StudySelectorDialog::setStudyRow(const int& row, StudyPtr study) {
+	QString dataID = study->getDataID().toString();
+	QString studyID = study->getStudyID();
+	QString patientID = study->getPatientID();
+	QString patientName = study->getPatientName();
+	QString studyDate = study->getStudyDate();
+	QString studyTime = study->getStudyTime();
+
+	QTableWidgetItem* dataIDItem = new QTableWidgetItem(dataID);
+	QTableWidgetItem* studyIDItem = new QTableWidgetItem(studyID);
+	QTableWidgetItem* patientIDItem = new QTableWidgetItem(patientID);
+	QTableWidgetItem* patientNameItem = new QTableWidgetItem(patientName);
+	QTableWidgetItem* studyDateItem = new QTableWidgetItem(studyDate);
+	QTableWidgetItem* studyTimeItem = new QTableWidgetItem(studyTime);
+	mGUI->studyList_table->setItem(row, 0, dataIDItem);
+	mGUI->studyList_table->setItem(row, 1, studyIDItem);
+	mGUI->studyList_table->setItem(row, 2, patientIDItem);
+	mGUI->studyList_table->setItem(row, 3, patientNameItem);
+	mGUI->studyList_table->setItem(row, 4, studyDateItem);
+	mGUI->studyList_table->setItem(row, 5, studyTimeItem);
+	mThumbnailItems.insert(study->getDataID(), studyIDItem);
 }
 
 DataID StudySelectorDialog::getSelectedStudy() {
 	return mSelectedStudyID;
 }
 
+void StudySelectorDialog::requestVisibleThumbnails() {
+	QTableWidget* table = mGUI->studyList_table;
+	if (table->rowCount() == 0) {
+		return;
+	}
+
+	int firstRow = qMax(0, table->rowAt(0));
+	int lastRow = table->rowAt(table->viewport()->height() - 1);
+	if (lastRow == -1) {
+		lastRow = table->rowCount() - 1;
+	}
+
+	QList<DataID> studies;
+	for (int row = firstRow; row <= lastRow; row++) {
+		QTableWidgetItem* dataID = table->item(row, 0);
+		QTableWidgetItem* studyID = table->item(row, 1);
+		if (dataID != Q_NULLPTR && studyID != Q_NULLPTR && studyID->icon().isNull()) {
+			studies.append(DataID(QUuid(dataID->text()), studyID->text()));
+		}
+	}
+
+	if (!studies.isEmpty()) {
+		emit requestedThumbnails(studies);
+	}
+}
+
 void StudySelectorDialog::onCellDoubleClick(const int& row, 
 	const int& column) 
 {
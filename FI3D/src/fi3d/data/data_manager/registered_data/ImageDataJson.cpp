@@ -6,22 +6,16 @@ ImageDataJson::ImageDataJson(ImageDataVPtr imageData)
 	: mImageData(imageData),
 	mTransverseJson(),
 	mSagittalJson(),
-	mCoronalJson()
+	mCoronalJson(),
+	mMessagesVersion(0),
+	mMessagesWindow(0),
+	mMessagesLevel(0)
 {
 	if (mImageData.Get() == Q_NULLPTR) {
 		return;
 	}
 
-	int* dims = mImageData->GetDimensions();
-	for (int i = 0; i < dims[2]; i++) {
-		mTransverseJson.append(MessagePtr(new Message()));
-	}
-	for (int i = 0; i < dims[0]; i++) {
-		mSagittalJson.append(MessagePtr(new Message()));
-	}
-	for (int i = 0; i < dims[1]; i++) {
-		mCoronalJson.append(MessagePtr(new Message()));
-	}
+	this->resetMessages();
 }
 
 ImageDataJson::~ImageDataJson() {}
@@ -35,6 +29,16 @@ MessagePtr ImageDataJson::getMessage(const int& sliceIndex, const ESliceOrientat
 		return Q_NULLPTR;
 	}
 
+	// The window/level is not part of the data version, the slices are
+	// encoded through it so they are all encoded again when it changes.
+	double window, level;
+	mImageData->getWindowLevel(window, level);
+	if (window != mMessagesWindow || level != mMessagesLevel) {
+		this->resetMessages();
+	} else if (mImageData->getDataVersion() != mMessagesVersion) {
+		this->refreshMessages();
+	}
+
 	int* dims = mImageData->GetDimensions();
 	switch (orientation.toInt()) {
 		case ESliceOrientation::XY:
@@ -82,4 +86,48 @@ void ImageDataJson::setMessage(const int& sliceIndex, const ESliceOrientation& o
 		default:
 			break;
 	}
+}
+
+void ImageDataJson::resetMessages() {
+	// New messages are used, the old ones may still be queued for delivery.
+	int* dims = mImageData->GetDimensions();
+	mTransverseJson.resize(dims[2]);
+	mSagittalJson.resize(dims[0]);
+	mCoronalJson.resize(dims[1]);
+	for (int i = 0; i < mTransverseJson.count(); i++) {
+		mTransverseJson[i].reset(new Message());
+	}
+	for (int i = 0; i < mSagittalJson.count(); i++) {
+		mSagittalJson[i].reset(new Message());
+	}
+	for (int i = 0; i < mCoronalJson.count(); i++) {
+		mCoronalJson[i].reset(new Message());
+	}
+	mMessagesVersion = mImageData->getDataVersion();
+	mImageData->getWindowLevel(mMessagesWindow, mMessagesLevel);
+}
+
+void ImageDataJson::refreshMessages() {
+	int* dims = mImageData->GetDimensions();
+	int changedExtent[6];
+	if (mTransverseJson.count() != dims[2] || mSagittalJson.count() != dims[0] ||
+		mCoronalJson.count() != dims[1] ||
+		!mImageData->getChangedExtent(mMessagesVersion, changedExtent))
+	{
+		this->resetMessages();
+		return;
+	}
+
+	// Slice indices start at 0, the extent may not.
+	int* extent = mImageData->GetExtent();
+	for (int i = changedExtent[4]; i <= changedExtent[5]; i++) {
+		mTransverseJson[i - extent[4]].reset(new Message());
+	}
+	for (int i = changedExtent[0]; i <= changedExtent[1]; i++) {
+		mSagittalJson[i - extent[0]].reset(new Message());
+	}
+	for (int i = changedExtent[2]; i <= changedExtent[3]; i++) {
+		mCoronalJson[i - extent[2]].reset(new Message());
+	}
+	mMessagesVersion = mImageData->getDataVersion();
 }
\ No newline at end of file
@@ -6,7 +6,8 @@ RegisteredModel::RegisteredModel(ModelDataVPtr modelData, const QString& path)
 	: RegisteredData(),
 	mModelData(modelData),
 	mPath(path),
-	mMessage(new Message())
+	mMessage(new Message()),
+	mMessageVersion(modelData.Get() == Q_NULLPTR ? 0 : modelData->getDataVersion())
 {}
 
 RegisteredModel::~RegisteredModel() {}
@@ -32,6 +33,11 @@ void RegisteredModel::setDataPath(const QString& path) {
 }
 
 MessagePtr RegisteredModel::getMessage() {
+	// A new message is used, the old one may still be queued for delivery.
+	if (mModelData.Get() != Q_NULLPTR && mModelData->getDataVersion() != mMessageVersion) {
+		mMessage.reset(new Message());
+		mMessageVersion = mModelData->getDataVersion();
+	}
 	return mMessage;
 }
 
@@ -0,0 +1,110 @@
+#include <fi3d/data/data_manager/stream/FrameRing.h>
+
+#include <fi3d/logger/Logger.h>
+
+#include <cstring>
+
+using namespace fi3d;
+
+FrameRing::FrameRing(const QString& studyID, const int& frameCount)
+	: mStudy(new Study(studyID)),
+	mDimensions{1, 1, 1},
+	mSpacing{1.0, 1.0, 1.0},
+	mScalarType(STREAM_SCALAR_UNSIGNED_CHAR),
+	mFrameNumbers(qMax(1, frameCount), -1)
+{
+	for (int i = 0; i < mFrameNumbers.count(); i++) {
+		SeriesDataVPtr series = mStudy->createAndAddSeries();
+		series->SetDimensions(mDimensions);
+		series->SetSpacing(mSpacing);
+		series->AllocateScalars(mScalarType, 1);
+		*static_cast<unsigned char*>(series->GetScalarPointer()) = 0;
+	}
+}
+
+FrameRing::~FrameRing() {}
+
+StudyPtr FrameRing::getStudy() {
+	return mStudy;
+}
+
+int FrameRing::getFrameCount() const {
+	return mFrameNumbers.count();
+}
+
+int FrameRing::getSeriesIndex(const qint64& frameNumber) const {
+	qint64 count = mFrameNumbers.count();
+	return (int)(((frameNumber % count) + count) % count);
+}
+
+qint64 FrameRing::getFrameNumber(const int& seriesIndex) const {
+	return mFrameNumbers.value(seriesIndex, -1);
+}
+
+bool FrameRing::hasGeometry(const StreamFrameHeader& header) const {
+	return header.ScalarType == mScalarType &&
+		header.Dimensions[0] == mDimensions[0] &&
+		header.Dimensions[1] == mDimensions[1] &&
+		header.Dimensions[2] == mDimensions[2] &&
+		header.Spacing[0] == mSpacing[0] &&
+		header.Spacing[1] == mSpacing[1] &&
+		header.Spacing[2] == mSpacing[2];
+}
+
+bool FrameRing::isGeometryAllowed(const StreamFrameHeader& header) const {
+	qint64 frameBytes = getStreamFrameBytes(header);
+	return frameBytes > 0 && frameBytes <= MAX_RING_BYTES / mFrameNumbers.count();
+}
+
+bool FrameRing::setGeometry(const StreamFrameHeader& header) {
+	qDebug() << "Enter - Allocating" << mFrameNumbers.count() << "frames of" <<
+		header.Dimensions[0] << "x" << header.Dimensions[1] << "x" << header.Dimensions[2];
+
+	if (!this->isGeometryAllowed(header)) {
+		qWarning() << "Failed to allocate the frames because the geometry is not valid or too large.";
+		qDebug() << "Exit - Geometry not allowed";
+		return false;
+	}
+
+	mScalarType = header.ScalarType;
+	for (int axis = 0; axis < 3; axis++) {
+		mDimensions[axis] = header.Dimensions[axis];
+		mSpacing[axis] = header.Spacing[axis];
+	}
+
+	for (int i = 0; i < mFrameNumbers.count(); i++) {
+		SeriesDataVPtr series = mStudy->getSeries(i);
+		series->SetDimensions(mDimensions);
+		series->SetSpacing(mSpacing);
+		series->AllocateScalars(mScalarType, 1);
+		std::memset(series->GetScalarPointer(), 0,
+			(size_t)series->GetNumberOfPoints() * getStreamScalarSize(mScalarType));
+		series->Modified();
+		series->dataUpdated();
+		mFrameNumbers[i] = -1;
+	}
+
+	qDebug() << "Exit";
+	return true;
+}
+
+char* FrameRing::getWritePointer(const StreamFrameHeader& header, qint64& length) {
+	int seriesIndex = this->getSeriesIndex(header.FrameNumber);
+	SeriesDataVPtr series = mStudy->getSeries(seriesIndex);
+
+	qint64 sliceLength = (qint64)mDimensions[0] * mDimensions[1] * getStreamScalarSize(mScalarType);
+	char* scalars = static_cast<char*>(series->GetScalarPointer());
+	if (header.SliceIndex < 0) {
+		length = sliceLength * mDimensions[2];
+	} else if (header.SliceIndex < mDimensions[2]) {
+		length = sliceLength;
+		scalars += sliceLength * header.SliceIndex;
+	} else {
+		qWarning() << "Failed to write frame" << header.FrameNumber << "because slice" <<
+			header.SliceIndex << "is out of range.";
+		return Q_NULLPTR;
+	}
+
+	mFrameNumbers[seriesIndex] = header.FrameNumber;
+	return scalars;
+}
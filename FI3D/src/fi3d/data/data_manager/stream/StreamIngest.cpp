@@ -0,0 +1,290 @@
+#include <fi3d/data/data_manager/stream/StreamIngest.h>
+
+#include <fi3d/logger/Logger.h>
+
+#include <QLocalSocket>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace fi3d;
+
+StreamIngest::StreamIngest(const QString& streamName, const int& frameCount)
+	: QObject(),
+	mServer(),
+	mRing(streamName, frameCount),
+	mProducers(),
+	mClock(),
+	mPendingWrites(),
+	mStatistics(),
+	mLatencySamples(),
+	mNextLatencySample(0),
+	mTotalReceiveTime(0),
+	mTotalLatency(0)
+{
+	mClock.start();
+	mServer.setSocketOptions(QLocalServer::UserAccessOption);
+	QObject::connect(
+		&mServer, &QLocalServer::newConnection,
+		this, &StreamIngest::onNewConnection);
+}
+
+StreamIngest::~StreamIngest() {
+	QList<QLocalSocket*> sockets = mProducers.keys();
+	mProducers.clear();
+	for (QLocalSocket* socket : sockets) {
+		socket->disconnect(this);
+		socket->abort();
+		socket->deleteLater();
+	}
+	mServer.close();
+}
+
+bool StreamIngest::listen() {
+	QString streamName = mRing.getStudy()->getStudyID();
+
+	// A previous instance that crashed may have left its socket behind.
+	QLocalServer::removeServer(streamName);
+	if (!mServer.listen(streamName)) {
+		qWarning() << "Failed to listen for stream" << streamName << "because:" << mServer.errorString();
+		return false;
+	}
+
+	qInfo() << "Listening for stream frames on" << mServer.fullServerName();
+	return true;
+}
+
+QString StreamIngest::getServerName() const {
+	return mServer.fullServerName();
+}
+
+StudyPtr StreamIngest::getStudy() {
+	return mRing.getStudy();
+}
+
+StreamStatistics StreamIngest::getStatistics() const {
+	StreamStatistics statistics = mStatistics;
+	if (mLatencySamples.isEmpty()) {
+		return statistics;
+	}
+
+	QVector<double> samples = mLatencySamples;
+	int p50 = (samples.count() - 1) / 2;
+	std::nth_element(samples.begin(), samples.begin() + p50, samples.end());
+	statistics.P50Latency = samples.at(p50);
+
+	int p99 = qBound(0, (int)std::ceil(0.99 * samples.count()) - 1, samples.count() - 1);
+	std::nth_element(samples.begin(), samples.begin() + p99, samples.end());
+	statistics.P99Latency = samples.at(p99);
+	return statistics;
+}
+
+void StreamIngest::resetStatistics() {
+	mStatistics = StreamStatistics();
+	mLatencySamples.clear();
+	mNextLatencySample = 0;
+	mTotalReceiveTime = 0;
+	mTotalLatency = 0;
+}
+
+void StreamIngest::onDataSent(SeriesData* series, const int& sliceIndex, const ESliceOrientation& orientation) {
+	qint64 now = mClock.nsecsElapsed();
+
+	// YZ and XZ slices cross every XY slice that was written.
+	QList<StreamWrite>::iterator it = mPendingWrites.begin();
+	while (it != mPendingWrites.end()) {
+		if (it->Series != series || (orientation == ESliceOrientation::XY &&
+			(sliceIndex < it->FirstSlice || sliceIndex > it->LastSlice)))
+		{
+			it++;
+			continue;
+		}
+
+		double latency = (now - it->ArrivalTime) / 1.0e6;
+		mStatistics.SentCount++;
+		mStatistics.MaxLatency = qMax(mStatistics.MaxLatency, latency);
+		mTotalLatency += latency;
+		mStatistics.AverageLatency = mTotalLatency / mStatistics.SentCount;
+
+		if (mLatencySamples.count() < MAX_LATENCY_SAMPLES) {
+			mLatencySamples.append(latency);
+		} else {
+			mLatencySamples[mNextLatencySample] = latency;
+		}
+		mNextLatencySample = (mNextLatencySample + 1) % MAX_LATENCY_SAMPLES;
+
+		it = mPendingWrites.erase(it);
+	}
+}
+
+void StreamIngest::onNewConnection() {
+	while (mServer.hasPendingConnections()) {
+		QLocalSocket* socket = mServer.nextPendingConnection();
+		qInfo() << "Stream producer connected to" << mServer.fullServerName();
+
+		mProducers.insert(socket, QSharedPointer<StreamProducer>(new StreamProducer()));
+		QObject::connect(
+			socket, &QLocalSocket::readyRead,
+			this, &StreamIngest::onReadyRead);
+		QObject::connect(
+			socket, &QLocalSocket::disconnected,
+			this, &StreamIngest::onDisconnected);
+	}
+}
+
+void StreamIngest::onReadyRead() {
+	QLocalSocket* socket = qobject_cast<QLocalSocket*>(QObject::sender());
+	QSharedPointer<StreamProducer> producer = mProducers.value(socket);
+	if (producer.isNull()) {
+		return;
+	}
+
+	while (socket->state() == QLocalSocket::ConnectedState) {
+		if (!producer->IsReadingPayload) {
+			if (socket->bytesAvailable() < STREAM_FRAME_HEADER_SIZE ||
+				!this->readHeader(socket, producer.data()))
+			{
+				return;
+			}
+		}
+
+		// The payload goes from the socket straight into the series.
+		qint64 read = socket->read(producer->Destination, producer->Remaining);
+		if (read <= 0) {
+			return;
+		}
+		producer->Destination += read;
+		producer->Remaining -= read;
+
+		if (producer->Remaining == 0) {
+			this->completeWrite(producer.data());
+		}
+	}
+}
+
+void StreamIngest::onDisconnected() {
+	QLocalSocket* socket = qobject_cast<QLocalSocket*>(QObject::sender());
+	if (socket == Q_NULLPTR) {
+		return;
+	}
+
+	QSharedPointer<StreamProducer> producer = mProducers.take(socket);
+	if (!producer.isNull() && producer->IsReadingPayload) {
+		qWarning() << "Stream producer disconnected in the middle of a frame.";
+		mStatistics.DroppedCount++;
+	}
+	socket->deleteLater();
+	qInfo() << "Stream producer disconnected from" << mServer.fullServerName();
+}
+
+bool StreamIngest::readHeader(QLocalSocket* socket, StreamProducer* producer) {
+	char bytes[STREAM_FRAME_HEADER_SIZE];
+	socket->read(bytes, STREAM_FRAME_HEADER_SIZE);
+	producer->Header = readStreamFrameHeader(bytes);
+	producer->ArrivalTime = mClock.nsecsElapsed();
+
+	// The geometry is checked before the ring allocates anything for it.
+	const StreamFrameHeader& header = producer->Header;
+	QString error;
+	if (header.Magic != STREAM_FRAME_MAGIC || header.Version != STREAM_FRAME_VERSION) {
+		error = "the header is not a stream frame header";
+	} else if (getStreamScalarSize(header.ScalarType) == 0) {
+		error = QString("scalar type %1 is not supported").arg(header.ScalarType);
+	} else if (getStreamFrameBytes(header) < 0) {
+		error = "the geometry is not valid or larger than a frame may be";
+	} else if (!mRing.isGeometryAllowed(header)) {
+		error = "the frames do not fit in the ring";
+	} else if (header.SliceIndex < -1) {
+		error = QString("slice %1 is out of range").arg(header.SliceIndex);
+	}
+
+	if (error.isEmpty() && !mRing.hasGeometry(header)) {
+		// The other producers' payloads would go to the released scalars.
+		QList<QLocalSocket*> sockets = mProducers.keys();
+		for (QLocalSocket* other : sockets) {
+			QSharedPointer<StreamProducer> otherProducer = mProducers.value(other);
+			if (other != socket && !otherProducer.isNull() && otherProducer->IsReadingPayload) {
+				qWarning() << "Closing stream producer because the frame geometry changed.";
+				other->abort();
+			}
+		}
+		mStatistics.DroppedCount += mPendingWrites.count();
+		mPendingWrites.clear();
+		if (!mRing.setGeometry(header)) {
+			error = "the frames could not be allocated";
+		}
+	}
+
+	// Writes of the frame that was in this series are no longer reachable.
+	int seriesIndex = mRing.getSeriesIndex(header.FrameNumber);
+	if (error.isEmpty() && mRing.getFrameNumber(seriesIndex) != header.FrameNumber) {
+		SeriesData* series = mRing.getStudy()->getSeries(seriesIndex).Get();
+		QList<StreamWrite>::iterator it = mPendingWrites.begin();
+		while (it != mPendingWrites.end()) {
+			if (it->Series == series) {
+				mStatistics.DroppedCount++;
+				it = mPendingWrites.erase(it);
+			} else {
+				it++;
+			}
+		}
+	}
+
+	qint64 length = 0;
+	if (error.isEmpty()) {
+		producer->Destination = mRing.getWritePointer(header, length);
+		if (producer->Destination == Q_NULLPTR) {
+			error = QString("slice %1 is out of range").arg(header.SliceIndex);
+		} else if (header.PayloadLength != length) {
+			error = QString("the payload has %1 bytes instead of %2").arg(header.PayloadLength).arg(length);
+		}
+	}
+
+	if (!error.isEmpty()) {
+		qWarning() << "Closing stream producer because" << error;
+		mStatistics.DroppedCount++;
+		socket->abort();
+		return false;
+	}
+
+	producer->Remaining = length;
+	producer->IsReadingPayload = true;
+	return true;
+}
+
+void StreamIngest::completeWrite(StreamProducer* producer) {
+	const StreamFrameHeader& header = producer->Header;
+	producer->IsReadingPayload = false;
+	producer->Destination = Q_NULLPTR;
+
+	int seriesIndex = mRing.getSeriesIndex(header.FrameNumber);
+	SeriesDataVPtr series = mRing.getStudy()->getSeries(seriesIndex);
+
+	StreamWrite write;
+	write.Series = series.Get();
+	write.FirstSlice = header.SliceIndex < 0 ? 0 : header.SliceIndex;
+	write.LastSlice = header.SliceIndex < 0 ? header.Dimensions[2] - 1 : header.SliceIndex;
+	write.ArrivalTime = producer->ArrivalTime;
+
+	double receiveTime = (mClock.nsecsElapsed() - producer->ArrivalTime) / 1.0e6;
+	mStatistics.WriteCount++;
+	mStatistics.ByteCount += header.PayloadLength;
+	mStatistics.MaxReceiveTime = qMax(mStatistics.MaxReceiveTime, receiveTime);
+	mTotalReceiveTime += receiveTime;
+	mStatistics.AverageReceiveTime = mTotalReceiveTime / mStatistics.WriteCount;
+
+	mPendingWrites.append(write);
+	while (mPendingWrites.count() > MAX_PENDING_WRITES) {
+		mPendingWrites.removeFirst();
+		mStatistics.DroppedCount++;
+	}
+
+	// Only the written slices are re-encoded and announced to the clients.
+	int extent[6];
+	series->GetExtent(extent);
+	extent[4] += write.FirstSlice;
+	extent[5] = extent[4] + (write.LastSlice - write.FirstSlice);
+	series->updateExtent(extent);
+
+	emit changedFrame(seriesIndex, header.FrameNumber);
+}
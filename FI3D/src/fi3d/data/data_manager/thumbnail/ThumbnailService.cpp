@@ -0,0 +1,250 @@
+#include <fi3d/data/data_manager/thumbnail/ThumbnailService.h>
+
+#include <fi3d/logger/Logger.h>
+
+#include <fi3d/data/Filer.h>
+#include <fi3d/utilities/ImageAlgorithms.h>
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QThread>
+
+#include <vtkDICOMMetaData.h>
+#include <vtkDICOMReader.h>
+#include <vtkImageData.h>
+#include <vtkNew.h>
+
+using namespace fi3d;
+
+/// @brief Maps the middle XY slice of an image through a window/level.
+static bool readMiddleSlice(vtkImageData* image, const double& window, const double& level,
+	QVector<float>& values, int& width, int& height)
+{
+	int* dims = image->GetDimensions();
+	if (dims[0] <= 0 || dims[1] <= 0 || dims[2] <= 0) {
+		return false;
+	}
+
+	width = dims[0];
+	height = dims[1];
+	values.resize((qint64)width * height);
+	return ImageAlgorithms::applyWindowLevel(image, dims[2] / 2, ESliceOrientation::XY,
+		window, level, values.data());
+}
+
+ThumbnailService::ThumbnailService(const QString& directory, QObject* parent)
+	: QObject(parent),
+	mDirectory(directory),
+	mThumbnails(),
+	mQueue(),
+	mPending(),
+	mMutex(),
+	mCondition(),
+	mIsStopped(0),
+	mThread(Q_NULLPTR)
+{}
+
+ThumbnailService::~ThumbnailService() {
+	if (mThread != Q_NULLPTR) {
+		mMutex.lock();
+		mIsStopped.storeRelaxed(1);
+		mCondition.wakeAll();
+		mMutex.unlock();
+
+		mThread->wait();
+		delete mThread;
+	}
+}
+
+QString ThumbnailService::getDefaultDirectory() {
+	return QObject::tr("%1/FI3D/thumbnails").arg(FI3D_DATA_PATH);
+}
+
+QImage ThumbnailService::getThumbnail(const QUuid& dataID) {
+	QMutexLocker locker(&mMutex);
+	return mThumbnails.value(dataID);
+}
+
+void ThumbnailService::request(const QUuid& dataID, const ThumbnailSource& source) {
+	QMutexLocker locker(&mMutex);
+	QImage thumbnail = mThumbnails.value(dataID);
+	if (!thumbnail.isNull()) {
+		locker.unlock();
+		emit renderedThumbnail(dataID, thumbnail);
+		return;
+	}
+
+	if (mPending.contains(dataID)) {
+		return;
+	}
+	mPending.insert(dataID);
+	mQueue.prepend(qMakePair(dataID, source));
+
+	if (mThread == Q_NULLPTR) {
+		mThread = QThread::create([this]() {
+			this->run();
+		});
+		mThread->setObjectName("FI3D Thumbnails");
+		mThread->start(QThread::LowPriority);
+	}
+	mCondition.wakeOne();
+}
+
+void ThumbnailService::forget(const QUuid& dataID) {
+	QMutexLocker locker(&mMutex);
+	mThumbnails.remove(dataID);
+}
+
+void ThumbnailService::run() {
+	QMutexLocker locker(&mMutex);
+	while (true) {
+		while (mQueue.isEmpty() && mIsStopped.loadRelaxed() == 0) {
+			mCondition.wait(&mMutex);
+		}
+		if (mIsStopped.loadRelaxed() != 0) {
+			return;
+		}
+
+		QPair<QUuid, ThumbnailSource> job = mQueue.takeFirst();
+		locker.unlock();
+		QImage thumbnail = this->loadOrRender(job.second);
+		locker.relock();
+
+		mPending.remove(job.first);
+		if (thumbnail.isNull()) {
+			continue;
+		}
+		mThumbnails.insert(job.first, thumbnail);
+
+		locker.unlock();
+		emit renderedThumbnail(job.first, thumbnail);
+		locker.relock();
+	}
+}
+
+QImage ThumbnailService::loadOrRender(const ThumbnailSource& source) const {
+	QString key = ThumbnailService::getKey(source);
+	if (key.isEmpty()) {
+		return QImage();
+	}
+
+	QString filePath = tr("%1/%2.png").arg(mDirectory).arg(key);
+	QImage thumbnail;
+	if (thumbnail.load(filePath, "PNG")) {
+		return thumbnail;
+	}
+
+	thumbnail = ThumbnailService::render(source);
+	if (thumbnail.isNull()) {
+		return thumbnail;
+	}
+
+	// Replaced at once, so a crash never leaves a partial thumbnail.
+	QDir().mkpath(mDirectory);
+	QSaveFile file(filePath);
+	if (!file.open(QIODevice::WriteOnly) || !thumbnail.save(&file, "PNG") || !file.commit()) {
+		qWarning() << "Failed to save thumbnail" << filePath;
+	}
+	return thumbnail;
+}
+
+QString ThumbnailService::getKey(const ThumbnailSource& source) {
+	QByteArray identity;
+	QDataStream stream(&identity, QIODevice::WriteOnly);
+	stream << VERSION << (qint32)SIZE;
+
+	QString filePath = !source.DICOMFile.isEmpty() ? source.DICOMFile : source.FI3DFile;
+	if (!filePath.isEmpty()) {
+		QFileInfo info(filePath);
+		if (!info.exists()) {
+			return QString();
+		}
+		stream << info.absoluteFilePath() << info.size() << info.lastModified().toMSecsSinceEpoch();
+	} else if (!source.Values.isEmpty()) {
+		stream << (qint32)source.Width << (qint32)source.Height;
+	} else {
+		return QString();
+	}
+
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+	hash.addData(identity);
+	if (filePath.isEmpty()) {
+		hash.addData(QByteArrayView(reinterpret_cast<const char*>(source.Values.constData()),
+			source.Values.count() * sizeof(float)));
+	}
+	return QString::fromLatin1(hash.result().toHex());
+}
+
+QImage ThumbnailService::render(const ThumbnailSource& source) {
+	QVector<float> values;
+	int width = 0, height = 0;
+
+	if (!source.DICOMFile.isEmpty()) {
+		vtkNew<vtkDICOMReader> reader;
+		reader->SetFileName(source.DICOMFile.toStdString().c_str());
+		reader->Update();
+		if (reader->GetErrorCode() != 0) {
+			qWarning() << "Failed to render the thumbnail of" << source.DICOMFile << "because it could not be read.";
+			return QImage();
+		}
+
+		// The window/level of the file if it has one, otherwise the range of its intensities.
+		vtkImageData* image = reader->GetOutput();
+		double range[2];
+		image->GetScalarRange(range);
+		double window = qMax(range[1] - range[0], 1e-6);
+		double level = (range[0] + range[1]) / 2.0;
+		vtkDICOMMetaData* metaData = reader->GetMetaData();
+		const vtkDICOMValue& center = metaData->Get(DC::WindowCenter);
+		const vtkDICOMValue& windowWidth = metaData->Get(DC::WindowWidth);
+		if (center.IsValid() && windowWidth.IsValid() && windowWidth.AsDouble() > 0) {
+			window = windowWidth.AsDouble();
+			level = center.AsDouble();
+		}
+
+		if (!readMiddleSlice(image, window, level, values, width, height)) {
+			return QImage();
+		}
+	} else if (!source.FI3DFile.isEmpty()) {
+		StudyPtr study = Filer::readStudyFromFI3DFile(source.FI3DFile);
+		if (study.isNull() || study->getSeriesCount() == 0) {
+			return QImage();
+		}
+
+		SeriesDataVPtr series = study->getSeries(study->getSeriesCount() / 2);
+		double window, level;
+		series->getWindowLevel(window, level);
+		if (!readMiddleSlice(series, window, level, values, width, height)) {
+			return QImage();
+		}
+	} else {
+		values = source.Values;
+		width = source.Width;
+		height = source.Height;
+	}
+
+	return ThumbnailService::toThumbnail(values, width, height);
+}
+
+QImage ThumbnailService::toThumbnail(const QVector<float>& values, const int& width, const int& height) {
+	if (width <= 0 || height <= 0 || values.count() < (qint64)width * height) {
+		return QImage();
+	}
+
+	// The rows of the slice go bottom to top, the ones of the image top to bottom.
+	QImage slice(width, height, QImage::Format_Grayscale8);
+	for (int y = 0; y < height; y++) {
+		uchar* line = slice.scanLine(height - 1 - y);
+		const float* row = values.constData() + (qint64)y * width;
+		for (int x = 0; x < width; x++) {
+			line[x] = static_cast<uchar>(row[x] * 255.0f + 0.5f);
+		}
+	}
+
+	return slice.scaled(SIZE, SIZE, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+}
@@ -2,11 +2,17 @@
 
 #include <fi3d/logger/Logger.h>
 
+#include <fi3d/server/Server.h>
 #include <fi3d/server/message_keys/MessageKeys.h>
 
 #include <fi3d/data/EData.h>
 
+#include <fi3d/rendering/visuals/AnimationClock.h>
+
 #include <QJsonArray>
+#include <QPair>
+#include <QSet>
+#include <QUuid>
 #include <QVariantList>
 
 using namespace fi3d;
@@ -17,7 +23,24 @@ ModuleMessageEncoder::ModuleMessageEncoder()
 	mSubscriberList(),
 	mScene(Q_NULLPTR),
 	mSubscriberUpdateTimer(),
-	mSceneUpdates()
+	mSceneUpdates(),
+	mSentImageVersions(),
+	mHandleSubscribers(),
+	mVisualHandles(),
+	mHandleVisualIDs(),
+	mDataHandles(),
+	mNextHandle(1),
+	mPoseSubscribers(),
+	mPosePorts(),
+	mPoseSocket(),
+	mPoseSequence(0),
+	mDatagramPoses(),
+	mSceneEpoch(QUuid::createUuid().toString(QUuid::WithoutBraces)),
+	mSceneVersion(0),
+	mSceneLog(),
+	mSceneLogStart(0),
+	mSceneLogCount(0),
+	mUnsubscribedTime()
 {
 	// TODO: What is the optimal value here? Determine proper value.
 	mSubscriberUpdateTimer.setInterval(60);
@@ -25,6 +48,11 @@ ModuleMessageEncoder::ModuleMessageEncoder()
 	QObject::connect(
 		&mSubscriberUpdateTimer, &QTimer::timeout,
 		this, &ModuleMessageEncoder::sendSceneUpdates);
+
+	// Each animation tick is sent as its own batch.
+	QObject::connect(
+		AnimationClock::getInstance(), &AnimationClock::advanced,
+		this, &ModuleMessageEncoder::sendAnimationUpdates);
 }
 
 ModuleMessageEncoder::~ModuleMessageEncoder() {}
@@ -113,10 +141,13 @@ void ModuleMessageEncoder::onDisconnectedClient(const QString& clientID) {
 	qDebug() << "Enter";
 	if (mSubscriberList.contains(clientID)) {
 		mSubscriberList.removeOne(clientID);
+		mHandleSubscribers.removeOne(clientID);
+		this->removePoseSubscriber(clientID);
 		qInfo() << "Subscriber=" << clientID << "has been removed";
 
+		// The scene is still logged for a while in case the client comes back.
 		if (mSubscriberList.isEmpty()) {
-			mSubscriberUpdateTimer.stop();
+			mUnsubscribedTime.start();
 		}
 	}
 	qDebug() << "Exit";
@@ -188,7 +219,7 @@ bool ModuleMessageEncoder::isRequestBad(const QJsonObject& params, const QString
 			break;
 	}
 
-	if (!params.contains(TARGET_VISUAL) || params.value(TARGET_VISUAL).toString("").isEmpty()) {
+	if (this->getTargetVisualID(params).isEmpty()) {
 		this->sendErrorMessage("No visual object was given", clientID);
 		return true;
 	}
@@ -221,24 +252,43 @@ void ModuleMessageEncoder::parseSubscribeToModule(const QJsonObject& params, con
 		return;
 	}
 	mSubscriberList.push_back(clientID);
+	if (params.value(USE_HANDLES).toBool(false)) {
+		mHandleSubscribers.push_back(clientID);
+
+		// Poses refer to visuals by their handle only.
+		if (params.value(USE_POSE_STREAM).toBool(false)) {
+			mPoseSubscribers.push_back(clientID);
+			int port = params.value(POSE_PORT).toInt(0);
+			// The FI only accepts datagrams from the port it is told here.
+			if (mPoseSocket.state() != QAbstractSocket::BoundState &&
+				!mPoseSocket.bind(QHostAddress::Any, 0))
+			{
+				qWarning() << "Failed to bind pose socket because:" << mPoseSocket.errorString();
+			} else if (port > 0 && port <= 65535) {
+				mPosePorts.insert(clientID, (quint16)port);
+			}
+		}
+	}
 
 	// If there were no subscribers, activate auto sending of updates
+	mUnsubscribedTime.invalidate();
 	if (!mSubscriberUpdateTimer.isActive()) {
 		mSceneUpdates.clear();
 		mSubscriberUpdateTimer.start();
 	}
 	
-	// Prepare the visual information
-	QList<Visual3DPtr> visuals = mScene->getVisuals3D();
-	QVariantList visualsInfo;
-	visualsInfo.reserve(visuals.count());
-	for (int i = 0; i < visuals.count(); i++) {
-		if (!visuals.at(i)->isHolographic()) {
-			continue;
-		}
-		QJsonObject visualJson = ModuleMessageEncoder::toJson(visuals.at(i).data());
-		visualJson.insert(RESPONSE_ID, EModuleResponse::ADD_VISUAL);
-		visualsInfo.push_back(visualJson);
+	// A subscriber that comes back is only sent what changed since.
+	QJsonObject moduleInfo;
+	if (this->canResync(params)) {
+		moduleInfo.insert(VISUALS_INFO, this->getSceneChangesSince(params.value(SCENE_VERSION).toInteger()));
+		moduleInfo.insert(SCENE_SNAPSHOT, false);
+	} else {
+		moduleInfo.insert(VISUALS_INFO, this->getSceneSnapshot(EModuleResponse::ADD_VISUAL));
+		moduleInfo.insert(SCENE_SNAPSHOT, true);
+	}
+	moduleInfo.insert(SCENE_EPOCH, mSceneEpoch);
+	if (mPosePorts.contains(clientID)) {
+		moduleInfo.insert(POSE_PORT, mPoseSocket.localPort());
 	}
 
 	// Prepare the module interaction information
@@ -255,8 +305,6 @@ void ModuleMessageEncoder::parseSubscribeToModule(const QJsonObject& params, con
 	}
 
 	// Send Module Information
-	QJsonObject moduleInfo;
-	moduleInfo.insert(VISUALS_INFO, QJsonArray::fromVariantList(visualsInfo));
 	moduleInfo.insert(MODULE_INTERACTIONS, QJsonArray::fromVariantList(interactionsJson));
 
 	// Send Response
@@ -271,7 +319,11 @@ void ModuleMessageEncoder::parseSubscribeToModule(const QJsonObject& params, con
 void ModuleMessageEncoder::parseUnbuscribeToModule(const QJsonObject& params, const QString& clientID) {
 	qDebug() << "Enter - Client:" << clientID << "unsubscribed from module";
 	mSubscriberList.removeOne(clientID);
-	// TODO: Remove auto sending of scene updates.
+	mHandleSubscribers.removeOne(clientID);
+	this->removePoseSubscriber(clientID);
+	if (mSubscriberList.isEmpty()) {
+		mUnsubscribedTime.start();
+	}
 	emit feedbackColor(tr("User %1 has unsubscribed from module").arg(clientID), Qt::GlobalColor::darkBlue);
 	qDebug() << "Exit";
 }
@@ -279,22 +331,16 @@ void ModuleMessageEncoder::parseUnbuscribeToModule(const QJsonObject& params, co
 void ModuleMessageEncoder::parseGetScene(const QJsonObject& params, const QString& clientID) {
 	qDebug() << "Enter - Scene requested by=" << clientID;
 
-	// Prepare the Visuals information
-	QList<Visual3DPtr> visuals = mScene->getVisuals3D();
-	QVariantList visualsInfo;
-	visualsInfo.reserve(visuals.count());
-	for (int i = 0; i < visuals.count(); i++) {
-		if (!visuals.at(i)->isHolographic()) {
-			continue;
-		}
-		QJsonObject visual = ModuleMessageEncoder::toJson(visuals.at(i).data());
-		visual.insert(RESPONSE_ID, EModuleResponse::REFRESH_VISUAL);
-		visualsInfo.push_back(visual);
-	}
-	
 	// Prepare Module information.
 	QJsonObject moduleInfo;
-	moduleInfo.insert(VISUALS_INFO, QJsonArray::fromVariantList(visualsInfo));
+	if (this->canResync(params)) {
+		moduleInfo.insert(VISUALS_INFO, this->getSceneChangesSince(params.value(SCENE_VERSION).toInteger()));
+		moduleInfo.insert(SCENE_SNAPSHOT, false);
+	} else {
+		moduleInfo.insert(VISUALS_INFO, this->getSceneSnapshot(EModuleResponse::REFRESH_VISUAL));
+		moduleInfo.insert(SCENE_SNAPSHOT, true);
+	}
+	moduleInfo.insert(SCENE_EPOCH, mSceneEpoch);
 
 	// Send Response
 	QJsonObject response = this->prepareModuleResponse(moduleInfo);
@@ -307,7 +353,7 @@ void ModuleMessageEncoder::parseGetobject(const QJsonObject& params, const QStri
 	qDebug() << "Enter - client=" << clientID << "requested an object";
 
 	// Prepare Visual information
-	QString visualID = params.value(TARGET_VISUAL).toString("");
+	QString visualID = this->getTargetVisualID(params);
 	Visual3DPtr visual = mScene->getVisual3D(visualID);
 	if (visual == Q_NULLPTR) {
 		this->sendErrorMessage("Object with given name not found", clientID);
@@ -332,7 +378,7 @@ void ModuleMessageEncoder::parseGetobject(const QJsonObject& params, const QStri
 void ModuleMessageEncoder::parseHideObject(const QJsonObject& params, const QString& clientID) {
 	qDebug() << "Enter";
 	bool isVisible = params.value(IS_VISIBLE).toBool(false);
-	QString visualID = params.value(TARGET_VISUAL).toString("");
+	QString visualID = this->getTargetVisualID(params);
 	if (!mScene.isNull()) {
 		mScene->setVisualVisible(isVisible, visualID);
 	}
@@ -347,7 +393,7 @@ void ModuleMessageEncoder::parseTranslateObject(const QJsonObject& params, const
 	double x = translate.at(0).toDouble(0);
 	double y = translate.at(1).toDouble(0);
 	double z = translate.at(2).toDouble(0);
-	QString visualID = params.value(TARGET_VISUAL).toString("");
+	QString visualID = this->getTargetVisualID(params);
 	if (!mScene.isNull()) {
 		mScene->translateVisual(x, y, z, visualID);
 	}
@@ -363,7 +409,7 @@ void ModuleMessageEncoder::parseRotateObject(const QJsonObject& params, const QS
 	double x = rotate.at(0).toDouble(0);
 	double y = rotate.at(1).toDouble(0);
 	double z = rotate.at(2).toDouble(0);
-	QString visualID = params.value(TARGET_VISUAL).toString("");
+	QString visualID = this->getTargetVisualID(params);
 	if (!mScene.isNull()) {
 		mScene->rotateVisual(x, y, z, visualID);
 	}
@@ -376,7 +422,7 @@ void ModuleMessageEncoder::parseSelectSlice(const QJsonObject& params, const QSt
 
 	int sliceIndex = params.value(SLICE_INDEX).toInt(0);
 	ESliceOrientation orientation(params.value(SLICE_ORIENTATION).toInt(0));
-	QString visualID = params.value(TARGET_VISUAL).toString("");
+	QString visualID = this->getTargetVisualID(params);
 
 	// If the orientation was not provided, only assign the slice
 	if (orientation == ESliceOrientation::UNKNOWN) {
@@ -396,7 +442,7 @@ void ModuleMessageEncoder::parseSelectOrientation(const QJsonObject& params, con
 	qDebug() << "Enter - client:" << clientID << "selects orientation";
 
 	ESliceOrientation orientation(params.value(SLICE_ORIENTATION).toInt(0));
-	QString visualID = params.value(TARGET_VISUAL).toString("");
+	QString visualID = this->getTargetVisualID(params);
 	if (!mScene.isNull()) {
 		mScene->setImageSliceOrientation(orientation, visualID);
 	}
@@ -408,7 +454,7 @@ void ModuleMessageEncoder::parseSelectSeries(const QJsonObject& params, const QS
 	qDebug() << "Enter - client:" << clientID << "requested to select series";
 	
 	int seriesIndex = params.value(SERIES_INDEX).toInt(0);
-	QString visualID = params.value(TARGET_VISUAL).toString("");
+	QString visualID = this->getTargetVisualID(params);
 
 	if (!mScene.isNull()) {
 		mScene->setStudySliceSeriesIndex(seriesIndex, visualID);
@@ -420,6 +466,7 @@ void ModuleMessageEncoder::parseSelectSeries(const QJsonObject& params, const QS
 QJsonObject ModuleMessageEncoder::prepareModuleResponse(QJsonObject& modInfo, const QString& message) {
 	modInfo.insert(MODULE_ID, this->getModuleID());
 	modInfo.insert(SCENE_ID, this->getMainScene()->getSceneID());
+	modInfo.insert(SCENE_VERSION, mSceneVersion);
 
 	QJsonObject response;
 	response.insert(RESPONSE_STATUS, EResponseStatus::SUCCESS);
@@ -429,6 +476,13 @@ QJsonObject ModuleMessageEncoder::prepareModuleResponse(QJsonObject& modInfo, co
 	return response;
 }
 
+QString ModuleMessageEncoder::getTargetVisualID(const QJsonObject& params) const {
+	if (params.contains(TARGET_HANDLE)) {
+		return mHandleVisualIDs.value(params.value(TARGET_HANDLE).toInt(0), "");
+	}
+	return params.value(TARGET_VISUAL).toString("");
+}
+
 void ModuleMessageEncoder::prepareAddInteraction(const QString& interactionID) {
 	qDebug() << "Enter";
 
@@ -568,7 +622,7 @@ void ModuleMessageEncoder::prepareAddObject(VisualPtr visual) {
 	}
 
 	// If there are subscribers, send them information on new added object
-	if (!mSubscriberList.empty()) {
+	if (this->isTrackingScene()) {
 		SceneUpdateKey updateKey{visual->getVisualID(), EModuleResponse::ADD_VISUAL};
 		if (!mSceneUpdates.contains(updateKey)) {
 			mSceneUpdates.insert(updateKey, true);
@@ -593,7 +647,7 @@ void ModuleMessageEncoder::prepareAddObject(VisualPtr visual) {
 
 void ModuleMessageEncoder::prepareDataChange() {
 	qDebug() << "Enter";
-	if (mSubscriberList.empty()) {
+	if (!this->isTrackingScene()) {
 		return;
 	}
 
@@ -613,7 +667,7 @@ void ModuleMessageEncoder::prepareDataChange() {
 
 void ModuleMessageEncoder::prepareRefreshObject() {
 	qDebug() << "Enter";
-	if (mSubscriberList.empty()) {
+	if (!this->isTrackingScene()) {
 		return;
 	}
 
@@ -633,7 +687,7 @@ void ModuleMessageEncoder::prepareRefreshObject() {
 
 void ModuleMessageEncoder::prepareRemoveObject(VisualPtr visual) {
 	qDebug() << "Enter";
-	if (!mSubscriberList.empty()) {
+	if (this->isTrackingScene()) {
 		if (visual == Q_NULLPTR || !visual->is3D()) {
 			return;
 		}
@@ -655,13 +709,14 @@ void ModuleMessageEncoder::prepareRemoveObject(VisualPtr visual) {
 	QObject::disconnect(
 		visual3D, &Visual3D::changedHolographicState,
 		this, &ModuleMessageEncoder::onVisualHolographicStateChange);
+	mSentImageVersions.remove(visual3D->getVisualID());
 
 	qDebug() << "Exit";
 }
 
 void ModuleMessageEncoder::prepareHideObject(const bool& isVisible) {
 	qDebug() << "Enter";
-	if (mSubscriberList.empty()) {
+	if (!this->isTrackingScene()) {
 		return;
 	}
 
@@ -684,7 +739,7 @@ void ModuleMessageEncoder::prepareHideObject(const bool& isVisible) {
 
 void ModuleMessageEncoder::prepareTransformObject() {
 	qDebug() << "Enter";
-	if (mSubscriberList.empty()) {
+	if (!this->isTrackingScene()) {
 		return;
 	}
 
@@ -707,7 +762,7 @@ void ModuleMessageEncoder::prepareTransformObject() {
 
 void ModuleMessageEncoder::prepareParentChange(Visual3DPtr parentVisual) {
 	qDebug() << "Enter";
-	if (mSubscriberList.empty()) {
+	if (!this->isTrackingScene()) {
 		return;
 	}
 
@@ -727,7 +782,7 @@ void ModuleMessageEncoder::prepareParentChange(Visual3DPtr parentVisual) {
 
 void ModuleMessageEncoder::prepareSetObjectOpacity(const double& a) {
 	qDebug() << "Enter";
-	if (mSubscriberList.empty()) {
+	if (!this->isTrackingScene()) {
 		return;
 	}
 
@@ -750,7 +805,7 @@ void ModuleMessageEncoder::prepareSetObjectOpacity(const double& a) {
 
 void ModuleMessageEncoder::prepareSetSliceIndex() {
 	qDebug() << "Enter";
-	if (mSubscriberList.empty()) {
+	if (!this->isTrackingScene()) {
 		return;
 	}
 
@@ -774,7 +829,7 @@ void ModuleMessageEncoder::prepareSetSliceIndex() {
 
 void ModuleMessageEncoder::prepareSetObjectColor(const double& r, const double& g, const double& b) {
 	qDebug() << "Enter";
-	if (mSubscriberList.empty()) {
+	if (!this->isTrackingScene()) {
 		return;
 	}
 
@@ -798,7 +853,7 @@ void ModuleMessageEncoder::prepareSetObjectColor(const double& r, const double&
 
 void ModuleMessageEncoder::prepareAssemblyAddPart(ModelPtr part) {
 	qDebug() << "Enter";
-	if (mSubscriberList.empty()) {
+	if (!this->isTrackingScene()) {
 		return;
 	}
 
@@ -822,7 +877,7 @@ void ModuleMessageEncoder::prepareAssemblyAddPart(ModelPtr part) {
 
 void ModuleMessageEncoder::prepareAssemblyRemovePart(ModelPtr part) {
 	qDebug() << "Enter";
-	if (mSubscriberList.empty()) {
+	if (!this->isTrackingScene()) {
 		return;
 	}
 
@@ -846,7 +901,7 @@ void ModuleMessageEncoder::prepareAssemblyRemovePart(ModelPtr part) {
 
 void ModuleMessageEncoder::prepareAssemblyPartOpacity(const double& a, ModelPtr part) {
 	qDebug() << "Enter";
-	if (mSubscriberList.empty()) {
+	if (!this->isTrackingScene()) {
 		return;
 	}
 
@@ -870,7 +925,7 @@ void ModuleMessageEncoder::prepareAssemblyPartOpacity(const double& a, ModelPtr
 
 void ModuleMessageEncoder::prepareAssemblyPartHide(const bool& isVisible, ModelPtr part) {
 	qDebug() << "Enter";
-	if (mSubscriberList.empty()) {
+	if (!this->isTrackingScene()) {
 		return;
 	}
 
@@ -894,7 +949,7 @@ void ModuleMessageEncoder::prepareAssemblyPartHide(const bool& isVisible, ModelP
 
 void ModuleMessageEncoder::prepareAssemblyPartTransform(ModelPtr part) {
 	qDebug() << "Enter";
-	if (mSubscriberList.empty()) {
+	if (!this->isTrackingScene()) {
 		return;
 	}
 
@@ -918,7 +973,7 @@ void ModuleMessageEncoder::prepareAssemblyPartTransform(ModelPtr part) {
 
 void ModuleMessageEncoder::prepareAssemblyPartData(ModelDataVPtr data, ModelPtr part) {
 	qDebug() << "Enter";
-	if (mSubscriberList.empty()) {
+	if (!this->isTrackingScene()) {
 		return;
 	}
 
@@ -942,7 +997,7 @@ void ModuleMessageEncoder::prepareAssemblyPartData(ModelDataVPtr data, ModelPtr
 
 void ModuleMessageEncoder::prepareAssemblyPartColor(const double& r, const double& g, const double& b, ModelPtr part) {
 	qDebug() << "Enter";
-	if (mSubscriberList.empty()) {
+	if (!this->isTrackingScene()) {
 		return;
 	}
 
@@ -1027,9 +1082,11 @@ void ModuleMessageEncoder::encodeVisualInfo(Visual3DPtr visual,
 				visualInfo.insert(SERIES_INDEX, studyImageSlice->getSeriesIndex());
 				visualInfo.insert(DATA_TYPE, EData::STUDY);
 				visualInfo.insert(DATA_ID, studyImageSlice->getStudy()->getDataID().toString());
+				visualInfo.insert(DATA_VERSION, studyImageSlice->getCurrentSeries()->getDataVersion());
 			} else {
 				visualInfo.insert(DATA_TYPE, EData::IMAGE);
 				visualInfo.insert(DATA_ID, imageSlice->getImageData()->getDataID().toString());
+				visualInfo.insert(DATA_VERSION, imageSlice->getImageData()->getDataVersion());
 			}
 			break;
 		}
@@ -1054,23 +1111,174 @@ void ModuleMessageEncoder::encodeVisualInfo(Visual3DPtr visual,
 			break;
 	}
 
+	if (visual->getVisualType() == EVisual::IMAGE_SLICE || visual->getVisualType().isStudySlice()) {
+		this->encodeChangedExtent(visual, responseType, visualInfo);
+	}
+
 	qDebug() << "Exit";
 }
 
+void ModuleMessageEncoder::encodeChangedExtent(Visual3DPtr visual,
+	const EModuleResponse& responseType, QJsonObject& visualInfo)
+{
+	switch (responseType.toInt()) {
+		case EModuleResponse::ADD_VISUAL:
+		case EModuleResponse::REFRESH_VISUAL:
+		case EModuleResponse::DATA_CHANGE:
+		case EModuleResponse::SET_SLICE:
+			break;
+		default:
+			return;
+	}
+
+	ImageSlice* imageSlice = qobject_cast<ImageSlice*>(visual.data());
+	ImageDataVPtr image = imageSlice->getImageData();
+	if (image.Get() == Q_NULLPTR) {
+		mSentImageVersions.remove(visual->getVisualID());
+		return;
+	}
+
+	SentImageVersion& sent = mSentImageVersions[visual->getVisualID()];
+	int changedExtent[6];
+	if (responseType == EModuleResponse::DATA_CHANGE && sent.Image == image.Get() &&
+		sent.DataVersion < image->getDataVersion() &&
+		image->getChangedExtent(sent.DataVersion, changedExtent))
+	{
+		// Sent as slice indices, which start at 0.
+		int* extent = image->GetExtent();
+		QJsonArray changedSlices;
+		for (int i = 0; i < 6; i++) {
+			changedSlices.push_back(changedExtent[i] - extent[2 * (i / 2)]);
+		}
+		visualInfo.insert(CHANGED_EXTENT, changedSlices);
+		visualInfo.insert(CHANGED_SINCE_VERSION, sent.DataVersion);
+	}
+
+	sent.Image = image.Get();
+	sent.DataVersion = image->getDataVersion();
+
+	// The window/level is not part of the data version, FIs compare it with
+	// the one their cached slices were encoded with.
+	double window, level;
+	image->getWindowLevel(window, level);
+	visualInfo.insert(WINDOW_WIDTH, window);
+	visualInfo.insert(WINDOW_CENTER, level);
+}
+
 QJsonObject ModuleMessageEncoder::encodeVisualInfo(Visual3DPtr visual, const EModuleResponse& responseType) {
 	QJsonObject visualInfo;
 	this->encodeVisualInfo(visual, responseType, visualInfo);
 	return visualInfo;
 }
 
+int ModuleMessageEncoder::getVisualHandle(const QString& visualID) {
+	int handle = mVisualHandles.value(visualID, 0);
+	if (handle == 0) {
+		handle = mNextHandle++;
+		mVisualHandles.insert(visualID, handle);
+		mHandleVisualIDs.insert(handle, visualID);
+	}
+	return handle;
+}
+
+int ModuleMessageEncoder::getDataHandle(const QString& dataID) {
+	int handle = mDataHandles.value(dataID, 0);
+	if (handle == 0) {
+		handle = mNextHandle++;
+		mDataHandles.insert(dataID, handle);
+	}
+	return handle;
+}
+
+void ModuleMessageEncoder::insertHandles(QJsonObject& visualInfo, const QString& assemblyID) {
+	QString visualID = visualInfo.value(ID).toString("");
+	if (!visualID.isEmpty()) {
+		// Part IDs are only unique within their assembly.
+		QString handleKey = assemblyID.isEmpty() ? visualID : assemblyID + "/" + visualID;
+		visualInfo.insert(HANDLE, this->getVisualHandle(handleKey));
+	}
+
+	QString dataID = visualInfo.value(DATA_ID).toString("");
+	if (!dataID.isEmpty()) {
+		visualInfo.insert(DATA_HANDLE, this->getDataHandle(dataID));
+	}
+
+	if (visualInfo.contains(ASSEMBLY_PARTS_INFO)) {
+		QJsonArray partsInfo = visualInfo.value(ASSEMBLY_PARTS_INFO).toArray();
+		for (int i = 0; i < partsInfo.count(); i++) {
+			QJsonObject partInfo = partsInfo.at(i).toObject();
+			this->insertHandles(partInfo, visualID);
+			partsInfo.replace(i, partInfo);
+		}
+		visualInfo.insert(ASSEMBLY_PARTS_INFO, partsInfo);
+	}
+}
+
+QJsonObject ModuleMessageEncoder::compactVisualInfo(const QJsonObject& visualInfo, const int& announcedHandles) const {
+	QJsonObject compactInfo = visualInfo;
+
+	// Additions keep their IDs, that is how the handles are announced.
+	int responseID = visualInfo.value(RESPONSE_ID).toInt();
+	if (responseID != EModuleResponse::ADD_VISUAL && responseID != EModuleResponse::REFRESH_VISUAL) {
+		int handle = visualInfo.value(HANDLE).toInt(0);
+		if (handle != 0 && handle < announcedHandles) {
+			compactInfo.remove(ID);
+		}
+
+		int dataHandle = visualInfo.value(DATA_HANDLE).toInt(0);
+		if (dataHandle != 0 && dataHandle < announcedHandles) {
+			compactInfo.remove(DATA_ID);
+		}
+	}
+
+	if (visualInfo.contains(ASSEMBLY_PARTS_INFO)) {
+		QJsonArray partsInfo = visualInfo.value(ASSEMBLY_PARTS_INFO).toArray();
+		for (int i = 0; i < partsInfo.count(); i++) {
+			partsInfo.replace(i, this->compactVisualInfo(partsInfo.at(i).toObject(), announcedHandles));
+		}
+		compactInfo.insert(ASSEMBLY_PARTS_INFO, partsInfo);
+	}
+
+	return compactInfo;
+}
+
+void ModuleMessageEncoder::sendAnimationUpdates() {
+	if (!mSubscriberUpdateTimer.isActive()) {
+		return;
+	}
+
+	this->sendSceneUpdates();
+	mSubscriberUpdateTimer.start();
+}
+
 void ModuleMessageEncoder::sendSceneUpdates() {
-	if (mSceneUpdates.empty() && mAssemblyUpdates.empty() && mInteractionUpdates.empty()) {
+	// Once nobody came back for a while, stop tracking the scene.
+	if (!this->isTrackingScene()) {
+		mSubscriberUpdateTimer.stop();
+		this->clearSceneLog();
+		mSceneUpdates.clear();
+		mAssemblyUpdates.clear();
+		mInteractionUpdates.clear();
+		return;
+	}
+
+	bool hasUpdates = !mSceneUpdates.empty() || !mAssemblyUpdates.empty() || !mInteractionUpdates.empty();
+
+	// A batch with no updates may still have to send the final poses.
+	if (!hasUpdates && mDatagramPoses.isEmpty()) {
 		return;
 	}
 
+	// Handles given out from here on are announced by this batch.
+	int announcedHandles = mNextHandle;
+
 	QVariantList visualUpdates;
 	visualUpdates.reserve(mSceneUpdates.count() + mAssemblyUpdates.count());
 
+	// Transforms sent as PoseRecords, and where their VisualInfo is.
+	QVector<PoseRecord> poseRecords;
+	QSet<int> poseIndices;
+
 	QHash<SceneUpdateKey, bool>::iterator it = mSceneUpdates.begin();
 	for (; it != mSceneUpdates.end(); it++) {
 		Visual3DPtr visual = mScene->getVisual3D(it.key().VisualID);
@@ -1081,6 +1289,18 @@ void ModuleMessageEncoder::sendSceneUpdates() {
 
 		// Prepare Visual info
 		QJsonObject visualInfo = this->encodeVisualInfo(visual, it.key().ResponseID);
+		this->insertHandles(visualInfo);
+
+		if (!mPoseSubscribers.isEmpty() && it.key().ResponseID == EModuleResponse::TRANSFORM_VISUAL) {
+			int handle = visualInfo.value(HANDLE).toInt(0);
+			if (handle > 0 && handle < announcedHandles) {
+				PoseRecord record;
+				record.Handle = handle;
+				toPoseRecord(visual->getRelativeMatrix(), record);
+				poseRecords.append(record);
+				poseIndices.insert(visualUpdates.count());
+			}
+		}
 		visualUpdates.append(visualInfo);
 	}
 
@@ -1107,6 +1327,7 @@ void ModuleMessageEncoder::sendSceneUpdates() {
 		visualInfo.insert(ID, assembly->getVisualID());
 		visualInfo.insert(TYPE, assembly->getVisualType().toInt());
 		visualInfo.insert(ASSEMBLY_PARTS_INFO, assemblyPartsInfo);
+		this->insertHandles(visualInfo);
 
 		visualUpdates.append(visualInfo);
 	}
@@ -1150,17 +1371,252 @@ void ModuleMessageEncoder::sendSceneUpdates() {
 		}
 	}
 
+	if (!visualUpdates.isEmpty()) {
+		mSceneVersion++;
+		this->appendSceneLog(QJsonArray::fromVariantList(visualUpdates));
+	}
+
 	QJsonObject moduleInfo;
 	moduleInfo.insert(VISUALS_INFO, QJsonArray::fromVariantList(visualUpdates));
 	moduleInfo.insert(MODULE_INTERACTIONS, QJsonArray::fromVariantList(interactionUpdates));
-	QJsonObject response = this->prepareModuleResponse(moduleInfo);
-	this->sendSelectMessage(response, mSubscriberList);
+
+	QVector<QString> idSubscribers;
+	for (const QString& subscriber : mSubscriberList) {
+		if (!mHandleSubscribers.contains(subscriber)) {
+			idSubscribers.push_back(subscriber);
+		}
+	}
+
+	if (hasUpdates && !idSubscribers.isEmpty()) {
+		QJsonObject response = this->prepareModuleResponse(moduleInfo);
+		this->sendSelectMessage(response, idSubscribers);
+	}
+
+	if (!mHandleSubscribers.isEmpty()) {
+		QJsonArray compactUpdates;
+		QJsonArray poseUpdates;
+		for (int i = 0; i < visualUpdates.count(); i++) {
+			QJsonObject compactInfo = this->compactVisualInfo(visualUpdates.at(i).toJsonObject(), announcedHandles);
+			compactUpdates.append(compactInfo);
+			if (!poseIndices.contains(i)) {
+				poseUpdates.append(compactInfo);
+			}
+		}
+
+		QVector<QString> jsonSubscribers;
+		QVector<QString> streamSubscribers;
+		QVector<QString> datagramSubscribers;
+		for (const QString& subscriber : mHandleSubscribers) {
+			if (!mPoseSubscribers.contains(subscriber)) {
+				jsonSubscribers.push_back(subscriber);
+			} else if (mPosePorts.contains(subscriber)) {
+				datagramSubscribers.push_back(subscriber);
+			} else {
+				streamSubscribers.push_back(subscriber);
+			}
+		}
+
+		if (hasUpdates && !jsonSubscribers.isEmpty()) {
+			moduleInfo.insert(VISUALS_INFO, compactUpdates);
+			QJsonObject response = this->prepareModuleResponse(moduleInfo);
+			this->sendSelectMessage(response, jsonSubscribers);
+		}
+
+		if (!mPoseSubscribers.isEmpty()) {
+			mPoseSequence++;
+			for (PoseRecord& record : poseRecords) {
+				record.Sequence = mPoseSequence;
+			}
+			moduleInfo.insert(VISUALS_INFO, poseUpdates);
+		}
+
+		if (hasUpdates && !streamSubscribers.isEmpty()) {
+			this->sendPoseMessage(moduleInfo, poseRecords, streamSubscribers);
+		}
+
+		if (!datagramSubscribers.isEmpty()) {
+			this->sendPoseDatagrams(poseRecords, datagramSubscribers);
+
+			// The last pose of the visuals that stopped moving is sent reliably.
+			QHash<int, PoseRecord> datagramPoses;
+			for (const PoseRecord& record : poseRecords) {
+				datagramPoses.insert(record.Handle, record);
+			}
+			QVector<PoseRecord> finalRecords;
+			QHash<int, PoseRecord>::const_iterator poseIt = mDatagramPoses.constBegin();
+			for (; poseIt != mDatagramPoses.constEnd(); poseIt++) {
+				if (!datagramPoses.contains(poseIt.key())) {
+					PoseRecord record = poseIt.value();
+					record.Sequence = mPoseSequence;
+					finalRecords.append(record);
+				}
+			}
+			mDatagramPoses = datagramPoses;
+
+			if (!poseUpdates.isEmpty() || !interactionUpdates.isEmpty() || !finalRecords.isEmpty()) {
+				this->sendPoseMessage(moduleInfo, finalRecords, datagramSubscribers);
+			}
+		}
+	}
 
 	mSceneUpdates.clear();
 	mAssemblyUpdates.clear();
 	mInteractionUpdates.clear();
 }
 
+void ModuleMessageEncoder::sendPoseMessage(QJsonObject& moduleInfo, 
+	const QVector<PoseRecord>& records, const QVector<QString>& subscribers)
+{
+	moduleInfo.insert(POSE_RECORD_COUNT, records.count());
+	QSharedPointer<QJsonObject> info(new QJsonObject(this->prepareModuleResponse(moduleInfo)));
+	moduleInfo.remove(POSE_RECORD_COUNT);
+
+	if (records.isEmpty()) {
+		this->sendSelectMessage(*info, subscribers);
+		return;
+	}
+
+	QSharedPointer<QByteArray> payload(new QByteArray());
+	appendPoseRecords(records.constData(), records.count(), *payload);
+	this->sendSelectMessage(MessagePtr(new Message(info, payload)), subscribers);
+}
+
+void ModuleMessageEncoder::sendPoseDatagrams(const QVector<PoseRecord>& records, const QVector<QString>& subscribers) {
+	if (records.isEmpty()) {
+		return;
+	}
+
+	QVector<QByteArray> datagrams;
+	for (int first = 0; first < records.count(); first += POSE_RECORDS_PER_DATAGRAM) {
+		PoseDatagramHeader header;
+		header.RecordCount = (quint16)qMin(POSE_RECORDS_PER_DATAGRAM, records.count() - first);
+		header.Sequence = records.at(first).Sequence;
+
+		QByteArray datagram;
+		appendPoseDatagramHeader(header, datagram);
+		appendPoseRecords(records.constData() + first, header.RecordCount, datagram);
+		datagrams.append(datagram);
+	}
+
+	for (const QString& subscriber : subscribers) {
+		QHostAddress address = Server::getClientAddress(subscriber);
+		if (address.isNull()) {
+			continue;
+		}
+
+		quint16 port = mPosePorts.value(subscriber);
+		for (const QByteArray& datagram : datagrams) {
+			if (mPoseSocket.writeDatagram(datagram, address, port) < 0) {
+				qWarning() << "Failed to send pose datagram to" << subscriber << "because:" << mPoseSocket.errorString();
+				break;
+			}
+		}
+	}
+}
+
+void ModuleMessageEncoder::removePoseSubscriber(const QString& clientID) {
+	mPoseSubscribers.removeOne(clientID);
+	mPosePorts.remove(clientID);
+	if (mPosePorts.isEmpty()) {
+		mDatagramPoses.clear();
+	}
+}
+
+bool ModuleMessageEncoder::isTrackingScene() const {
+	return !mSubscriberList.isEmpty() ||
+		(mUnsubscribedTime.isValid() && !mUnsubscribedTime.hasExpired(SCENE_LOG_RETENTION));
+}
+
+void ModuleMessageEncoder::appendSceneLog(const QJsonArray& visualsInfo) {
+	SceneLogEntry entry;
+	entry.Version = mSceneVersion;
+	entry.VisualsInfo = visualsInfo;
+	mSceneLog.append(entry);
+	mSceneLogCount += visualsInfo.count();
+
+	while (mSceneLogCount > MAX_SCENE_LOG_UPDATES && !mSceneLog.isEmpty()) {
+		SceneLogEntry oldest = mSceneLog.takeFirst();
+		mSceneLogCount -= oldest.VisualsInfo.count();
+		mSceneLogStart = oldest.Version;
+	}
+}
+
+void ModuleMessageEncoder::clearSceneLog() {
+	mSceneLog.clear();
+	mSceneLogCount = 0;
+	mUnsubscribedTime.invalidate();
+
+	// Changes from here on are not logged, no version sent so far is valid.
+	mSceneVersion++;
+	mSceneLogStart = mSceneVersion;
+}
+
+bool ModuleMessageEncoder::canResync(const QJsonObject& params) const {
+	if (!params.contains(SCENE_VERSION) || params.value(SCENE_EPOCH).toString() != mSceneEpoch) {
+		return false;
+	}
+
+	qint64 version = params.value(SCENE_VERSION).toInteger(-1);
+	return version >= mSceneLogStart && version <= mSceneVersion;
+}
+
+QJsonArray ModuleMessageEncoder::getSceneChangesSince(const qint64& version) const {
+	// Only the last of the updates that set a property of a visual is needed.
+	QVector<QJsonObject> changes;
+	QHash<QPair<QString, int>, int> propertyChanges;
+	for (const SceneLogEntry& entry : mSceneLog) {
+		if (entry.Version <= version) {
+			continue;
+		}
+
+		for (const QJsonValue& value : entry.VisualsInfo) {
+			QJsonObject visualInfo = value.toObject();
+			int responseID = visualInfo.value(RESPONSE_ID).toInt();
+			switch (responseID) {
+				case EModuleResponse::HIDE_VISUAL:
+				case EModuleResponse::TRANSFORM_VISUAL:
+				case EModuleResponse::SET_VISUAL_OPACITY:
+				case EModuleResponse::SET_SLICE:
+				case EModuleResponse::SET_OBJECT_COLOR:
+				{
+					QPair<QString, int> key(visualInfo.value(ID).toString(), responseID);
+					if (propertyChanges.contains(key)) {
+						changes[propertyChanges.value(key)] = QJsonObject();
+					}
+					propertyChanges.insert(key, changes.count());
+				}
+				break;
+				default:
+					break;
+			}
+			changes.append(visualInfo);
+		}
+	}
+
+	QJsonArray visualsInfo;
+	for (const QJsonObject& visualInfo : changes) {
+		if (!visualInfo.isEmpty()) {
+			visualsInfo.append(visualInfo);
+		}
+	}
+	return visualsInfo;
+}
+
+QJsonArray ModuleMessageEncoder::getSceneSnapshot(const EModuleResponse& responseID) {
+	QList<Visual3DPtr> visuals = mScene->getVisuals3D();
+	QJsonArray visualsInfo;
+	for (int i = 0; i < visuals.count(); i++) {
+		if (!visuals.at(i)->isHolographic()) {
+			continue;
+		}
+		QJsonObject visualJson = ModuleMessageEncoder::toJson(visuals.at(i).data());
+		visualJson.insert(RESPONSE_ID, responseID.toInt());
+		this->insertHandles(visualJson);
+		visualsInfo.append(visualJson);
+	}
+	return visualsInfo;
+}
+
 void ModuleMessageEncoder::setupScene() {
 	qDebug() << "Enter - Setting up scene for" << this->getModuleID();
 
@@ -1270,6 +1726,10 @@ void ModuleMessageEncoder::connectVisual3DSignals(Visual3D* visual) {
 			imageSlice, &ImageSlice::changedSlice, 
 			this, &ModuleMessageEncoder::prepareSetSliceIndex,
 			Qt::UniqueConnection);
+		QObject::connect(
+			imageSlice, &ImageSlice::changedWindowLevel,
+			this, &ModuleMessageEncoder::prepareDataChange,
+			Qt::UniqueConnection);
 	} else if (visual->getVisualType().isStudySlice()) {
 		StudySlice* studyImageSlice = qobject_cast<StudySlice*>(visual);
 		QObject::connect(
@@ -1280,6 +1740,10 @@ void ModuleMessageEncoder::connectVisual3DSignals(Visual3D* visual) {
 			studyImageSlice, &StudySlice::changedSlice,
 			this, &ModuleMessageEncoder::prepareSetSliceIndex,
 			Qt::UniqueConnection);
+		QObject::connect(
+			studyImageSlice, &StudySlice::changedWindowLevel,
+			this, &ModuleMessageEncoder::prepareDataChange,
+			Qt::UniqueConnection);
 	} else if (visual->getVisualType().isModel()) {
 		Model* model = qobject_cast<Model*>(visual);
 		QObject::connect(
@@ -1349,6 +1813,9 @@ void ModuleMessageEncoder::disconnectVisual3DSignals(Visual3D* visual) {
 		QObject::disconnect(
 			imageSlice, &ImageSlice::changedSlice, 
 			this, &ModuleMessageEncoder::prepareSetSliceIndex);
+		QObject::disconnect(
+			imageSlice, &ImageSlice::changedWindowLevel,
+			this, &ModuleMessageEncoder::prepareDataChange);
 	} else if (visual->getVisualType().isStudySlice()) {
 		StudySlice* studyImageSlice = qobject_cast<StudySlice*>(visual);
 		QObject::disconnect(
@@ -1357,6 +1824,9 @@ void ModuleMessageEncoder::disconnectVisual3DSignals(Visual3D* visual) {
 		QObject::disconnect(
 			studyImageSlice, &StudySlice::changedSlice, 
 			this, &ModuleMessageEncoder::prepareSetSliceIndex);
+		QObject::disconnect(
+			studyImageSlice, &StudySlice::changedWindowLevel,
+			this, &ModuleMessageEncoder::prepareDataChange);
 	} else if (visual->getVisualType().isModel()) {
 		Model* model = qobject_cast<Model*>(visual);
 		QObject::disconnect(
@@ -1434,6 +1904,7 @@ void ModuleMessageEncoder::toJson(Visual3D* visual, QJsonObject& jsonObject) {
 		jsonObject.insert(DATA_TYPE, EData::IMAGE);
 		jsonObject.insert(DATA_ID, imageSlice->getImageData()->getDataID().toString());
 		jsonObject.insert(DATA_NAME, imageSlice->getImageData()->getDataName());
+		jsonObject.insert(DATA_VERSION, imageSlice->getImageData()->getDataVersion());
 		jsonObject.insert(SLICE_INDEX, imageSlice->getSliceIndex());
 		jsonObject.insert(SLICE_ORIENTATION, imageSlice->getSliceOrientation().toInt());
 	} else if (visual->getVisualType().isStudySlice()) {
@@ -1444,11 +1915,13 @@ void ModuleMessageEncoder::toJson(Visual3D* visual, QJsonObject& jsonObject) {
 		jsonObject.insert(SLICE_INDEX, studyImageSlice->getSliceIndex());
 		jsonObject.insert(SLICE_ORIENTATION, studyImageSlice->getSliceOrientation().toInt());
 		jsonObject.insert(SERIES_INDEX, studyImageSlice->getSeriesIndex());
+		jsonObject.insert(DATA_VERSION, studyImageSlice->getCurrentSeries()->getDataVersion());
 	} else if (visual->getVisualType().isModel()) {
 		Model* md = qobject_cast<Model*>(visual);
 		jsonObject.insert(DATA_TYPE, EData::MODEL);
 		jsonObject.insert(DATA_ID, md->getModelData()->getDataID().toString());
 		jsonObject.insert(DATA_NAME, md->getModelData()->getDataName());
+		jsonObject.insert(DATA_VERSION, md->getModelData()->getDataVersion());
 
 		double r, g, b;
 		md->getColor(r, g, b);
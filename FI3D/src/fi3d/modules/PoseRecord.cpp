@@ -0,0 +1,133 @@
+#include <fi3d/modules/PoseRecord.h>
+
+#include <vtkMath.h>
+#include <vtkMatrix4x4.h>
+
+#include <QtEndian>
+
+#include <cmath>
+#include <cstring>
+
+using namespace fi3d;
+
+void fi3d::toPoseRecord(vtkMatrix4x4* matrix, PoseRecord& record) {
+	double rotation[3][3];
+	double scale[3];
+	for (int column = 0; column < 3; column++) {
+		double squared = 0.0;
+		for (int row = 0; row < 3; row++) {
+			squared += matrix->GetElement(row, column) * matrix->GetElement(row, column);
+		}
+		scale[column] = std::sqrt(squared);
+		for (int row = 0; row < 3; row++) {
+			rotation[row][column] = scale[column] > 0.0 ?
+				matrix->GetElement(row, column) / scale[column] : (row == column ? 1.0 : 0.0);
+		}
+	}
+
+	// A quaternion cannot hold a reflection, it goes in the x scale.
+	if (vtkMath::Determinant3x3(rotation) < 0.0) {
+		scale[0] = -scale[0];
+		for (int row = 0; row < 3; row++) {
+			rotation[row][0] = -rotation[row][0];
+		}
+	}
+
+	// VTK's quaternions are w, x, y, z.
+	double quaternion[4];
+	vtkMath::Matrix3x3ToQuaternion(rotation, quaternion);
+
+	record.Flags = 0;
+	for (int axis = 0; axis < 3; axis++) {
+		record.Position[axis] = (float)matrix->GetElement(axis, 3);
+		record.Rotation[axis] = (float)quaternion[axis + 1];
+		record.Scale[axis] = (float)scale[axis];
+		if (std::abs(scale[axis] - 1.0) > 1e-6) {
+			record.Flags |= POSE_HAS_SCALE;
+		}
+	}
+	record.Rotation[3] = (float)quaternion[0];
+}
+
+void fi3d::fromPoseRecord(const PoseRecord& record, vtkMatrix4x4* matrix) {
+	double quaternion[4] = {
+		record.Rotation[3], record.Rotation[0], record.Rotation[1], record.Rotation[2]
+	};
+	double norm = std::sqrt(quaternion[0] * quaternion[0] + quaternion[1] * quaternion[1] +
+		quaternion[2] * quaternion[2] + quaternion[3] * quaternion[3]);
+	if (norm > 0.0) {
+		for (int i = 0; i < 4; i++) {
+			quaternion[i] /= norm;
+		}
+	} else {
+		quaternion[0] = 1.0;
+	}
+
+	double rotation[3][3];
+	vtkMath::QuaternionToMatrix3x3(quaternion, rotation);
+
+	bool hasScale = (record.Flags & POSE_HAS_SCALE) != 0;
+	matrix->Identity();
+	for (int row = 0; row < 3; row++) {
+		for (int column = 0; column < 3; column++) {
+			matrix->SetElement(row, column,
+				hasScale ? rotation[row][column] * record.Scale[column] : rotation[row][column]);
+		}
+		matrix->SetElement(row, 3, record.Position[row]);
+	}
+}
+
+namespace {
+/// @brief Swaps the fields of the record between host and little endian.
+PoseRecord swapPoseRecord(const PoseRecord& record, const bool& isToLittleEndian) {
+	PoseRecord swapped;
+	swapped.Handle = isToLittleEndian ? qToLittleEndian(record.Handle) : qFromLittleEndian(record.Handle);
+	swapped.Sequence = isToLittleEndian ? qToLittleEndian(record.Sequence) : qFromLittleEndian(record.Sequence);
+	swapped.Flags = isToLittleEndian ? qToLittleEndian(record.Flags) : qFromLittleEndian(record.Flags);
+	for (int i = 0; i < 3; i++) {
+		swapped.Position[i] = isToLittleEndian ? qToLittleEndian(record.Position[i]) : qFromLittleEndian(record.Position[i]);
+		swapped.Scale[i] = isToLittleEndian ? qToLittleEndian(record.Scale[i]) : qFromLittleEndian(record.Scale[i]);
+	}
+	for (int i = 0; i < 4; i++) {
+		swapped.Rotation[i] = isToLittleEndian ? qToLittleEndian(record.Rotation[i]) : qFromLittleEndian(record.Rotation[i]);
+	}
+	return swapped;
+}
+}
+
+void fi3d::appendPoseRecords(const PoseRecord* records, const int& count, QByteArray& bytes) {
+	bytes.reserve(bytes.size() + count * (int)sizeof(PoseRecord));
+	for (int i = 0; i < count; i++) {
+		PoseRecord record = swapPoseRecord(records[i], true);
+		bytes.append(reinterpret_cast<const char*>(&record), sizeof(PoseRecord));
+	}
+}
+
+QVector<PoseRecord> fi3d::readPoseRecords(const char* bytes, const int& count) {
+	QVector<PoseRecord> records(count);
+	for (int i = 0; i < count; i++) {
+		PoseRecord record;
+		std::memcpy(&record, bytes + i * sizeof(PoseRecord), sizeof(PoseRecord));
+		records[i] = swapPoseRecord(record, false);
+	}
+	return records;
+}
+
+void fi3d::appendPoseDatagramHeader(const PoseDatagramHeader& header, QByteArray& bytes) {
+	PoseDatagramHeader swapped;
+	swapped.Magic = qToLittleEndian(header.Magic);
+	swapped.Version = qToLittleEndian(header.Version);
+	swapped.RecordCount = qToLittleEndian(header.RecordCount);
+	swapped.Sequence = qToLittleEndian(header.Sequence);
+	bytes.append(reinterpret_cast<const char*>(&swapped), sizeof(PoseDatagramHeader));
+}
+
+PoseDatagramHeader fi3d::readPoseDatagramHeader(const char* bytes) {
+	PoseDatagramHeader header;
+	std::memcpy(&header, bytes, sizeof(PoseDatagramHeader));
+	header.Magic = qFromLittleEndian(header.Magic);
+	header.Version = qFromLittleEndian(header.Version);
+	header.RecordCount = qFromLittleEndian(header.RecordCount);
+	header.Sequence = qFromLittleEndian(header.Sequence);
+	return header;
+}
@@ -0,0 +1,223 @@
+#include <fi3d/rendering/scenes/RenderScheduler.h>
+
+#include <fi3d/logger/Logger.h>
+
+#include <fi3d/rendering/scenes/Scene.h>
+
+#include <QEvent>
+#include <QVTKOpenGLStereoWidget.h>
+#include <QWidget>
+
+using namespace fi3d;
+
+/************************ Static Members ************************/
+QSharedPointer<RenderScheduler> RenderScheduler::INSTANCE = Q_NULLPTR;
+
+void RenderScheduler::requestRender(Scene* scene) {
+	if (scene == Q_NULLPTR) {
+		return;
+	}
+
+	RenderScheduler* scheduler = RenderScheduler::getInstance();
+	if (scheduler->mDirtyScenes.contains(scene)) {
+		scheduler->mStatistics.CoalescedCount++;
+		return;
+	}
+
+	scheduler->mDirtyScenes.insert(scene);
+	scheduler->scheduleFrame();
+}
+
+void RenderScheduler::cancelRender(Scene* scene) {
+	if (INSTANCE.isNull()) {
+		return;
+	}
+
+	INSTANCE->mDirtyScenes.remove(scene);
+	if (INSTANCE->mDeferredScenes.remove(scene)) {
+		INSTANCE->unwatchWidget(scene->mWidget);
+	}
+}
+
+void RenderScheduler::setFrameInterval(const int& interval) {
+	RenderScheduler::getInstance()->mFrameInterval = qMax(0, interval);
+}
+
+int RenderScheduler::getFrameInterval() {
+	return RenderScheduler::getInstance()->mFrameInterval;
+}
+
+RenderStatistics RenderScheduler::getStatistics() {
+	return RenderScheduler::getInstance()->mStatistics;
+}
+
+void RenderScheduler::resetStatistics() {
+	RenderScheduler* scheduler = RenderScheduler::getInstance();
+	scheduler->mStatistics = RenderStatistics();
+	scheduler->mTotalFrameTime = 0;
+	scheduler->mTotalFrameInterval = 0;
+	scheduler->mFrameIntervalCount = 0;
+}
+
+RenderScheduler* RenderScheduler::getInstance() {
+	if (INSTANCE.isNull()) {
+		INSTANCE.reset(new RenderScheduler());
+	}
+	return INSTANCE.data();
+}
+
+/************************ Singleton Members ************************/
+RenderScheduler::RenderScheduler()
+	: QObject(),
+	mDirtyScenes(),
+	mDeferredScenes(),
+	mFrameTimer(),
+	mClock(),
+	mLastFrameTime(0),
+	mFrameInterval(16),
+	mStatistics(),
+	mTotalFrameTime(0),
+	mTotalFrameInterval(0),
+	mFrameIntervalCount(0)
+{
+	mClock.start();
+	mFrameTimer.setSingleShot(true);
+	mFrameTimer.setTimerType(Qt::PreciseTimer);
+	QObject::connect(
+		&mFrameTimer, &QTimer::timeout,
+		this, &RenderScheduler::renderFrame);
+}
+
+RenderScheduler::~RenderScheduler() {}
+
+bool RenderScheduler::eventFilter(QObject* watched, QEvent* event) {
+	if (event->type() != QEvent::Show && event->type() != QEvent::WindowStateChange) {
+		return QObject::eventFilter(watched, event);
+	}
+
+	// Once shown, the deferred scenes render on the next frame.
+	QSet<Scene*>::iterator it = mDeferredScenes.begin();
+	while (it != mDeferredScenes.end()) {
+		QWidget* widget = (*it)->mWidget;
+		if (widget != Q_NULLPTR && (widget == watched || widget->window() == watched) && isShown(widget)) {
+			mDirtyScenes.insert(*it);
+			it = mDeferredScenes.erase(it);
+			this->unwatchWidget(widget);
+		} else {
+			it++;
+		}
+	}
+
+	if (!mDirtyScenes.isEmpty()) {
+		this->scheduleFrame();
+	}
+	return QObject::eventFilter(watched, event);
+}
+
+void RenderScheduler::renderFrame() {
+	qint64 frameStart = mClock.nsecsElapsed();
+
+	// Scenes made dirty while rendering are rendered on the next frame.
+	QSet<Scene*> scenes = mDirtyScenes;
+	mDirtyScenes.clear();
+
+	quint64 renderCount = 0;
+	for (Scene* scene : scenes) {
+		// The Scene renders once when resumed.
+		if (scene->isRenderPaused()) {
+			scene->mIsRenderPending = true;
+			continue;
+		}
+
+		// Scenes without a widget have nowhere to render or be shown.
+		QWidget* widget = scene->mWidget;
+		if (widget == Q_NULLPTR) {
+			continue;
+		}
+
+		if (!isShown(widget)) {
+			if (!mDeferredScenes.contains(scene)) {
+				mDeferredScenes.insert(scene);
+				widget->installEventFilter(this);
+				widget->window()->installEventFilter(this);
+				QObject::connect(
+					widget, &QObject::destroyed,
+					this, &RenderScheduler::onWidgetDestroyed, Qt::UniqueConnection);
+			}
+			mStatistics.DeferredCount++;
+			continue;
+		}
+
+		scene->renderScene();
+		renderCount++;
+	}
+
+	if (renderCount == 0) {
+		return;
+	}
+
+	qint64 frameEnd = mClock.nsecsElapsed();
+	double frameTime = (frameEnd - frameStart) / 1.0e6;
+	double frameInterval = (frameStart - mLastFrameTime) / 1.0e6;
+
+	mStatistics.RenderCount += renderCount;
+	mStatistics.FrameCount++;
+	mStatistics.MaxFrameTime = qMax(mStatistics.MaxFrameTime, frameTime);
+	mTotalFrameTime += frameTime;
+	mStatistics.AverageFrameTime = mTotalFrameTime / mStatistics.FrameCount;
+
+	// Only consecutive frames count towards the interval, not idle gaps.
+	if (mStatistics.FrameCount > 1 && frameInterval < 1000) {
+		mTotalFrameInterval += frameInterval;
+		mFrameIntervalCount++;
+		mStatistics.AverageFrameInterval = mTotalFrameInterval / mFrameIntervalCount;
+	}
+
+	mLastFrameTime = frameStart;
+}
+
+void RenderScheduler::onWidgetDestroyed(QObject* widget) {
+	// The widget is gone, so are the event filters on it.
+	QSet<Scene*>::iterator it = mDeferredScenes.begin();
+	while (it != mDeferredScenes.end()) {
+		if (static_cast<QObject*>((*it)->mWidget) == widget) {
+			it = mDeferredScenes.erase(it);
+		} else {
+			it++;
+		}
+	}
+}
+
+void RenderScheduler::scheduleFrame() {
+	if (mFrameTimer.isActive()) {
+		return;
+	}
+
+	qint64 sinceLastFrame = (mClock.nsecsElapsed() - mLastFrameTime) / 1000000;
+	mFrameTimer.start((int)qMax((qint64)0, mFrameInterval - sinceLastFrame));
+}
+
+void RenderScheduler::unwatchWidget(QWidget* widget) {
+	if (widget == Q_NULLPTR) {
+		return;
+	}
+
+	// Other deferred scenes may be shown in the same widget or window.
+	for (Scene* scene : mDeferredScenes) {
+		if (scene->mWidget != Q_NULLPTR &&
+			(scene->mWidget == widget || scene->mWidget->window() == widget->window()))
+		{
+			return;
+		}
+	}
+
+	widget->removeEventFilter(this);
+	widget->window()->removeEventFilter(this);
+	QObject::disconnect(
+		widget, &QObject::destroyed,
+		this, &RenderScheduler::onWidgetDestroyed);
+}
+
+bool RenderScheduler::isShown(QWidget* widget) {
+	return widget != Q_NULLPTR && widget->isVisible() && !widget->window()->isMinimized();
+}
@@ -2,10 +2,10 @@
 
 #include <fi3d/logger/Logger.h>
 
+#include <fi3d/rendering/scenes/RenderScheduler.h>
+
 #include <QVTKOpenGLStereoWidget.h>
 #include <QVTKInteractor.h>
-#include <QTimer>
-#include <QTime>
 
 #include <vtkAxesActor.h>
 #include <vtkEventQtSlotConnect.h>
@@ -32,7 +32,8 @@ Scene::Scene(QVTKOpenGLStereoWidget* widget, const QString& id)
 	mImageSlices(), mStudySlices(), mModels(), mAnimatedStudySlices(),
 	mAnimatedModels(), mAssemblies(), mSubtitles(),
 	mActorsToNames(),
-	mTimeFromLastRender(0), mIsRenderScheduled(false), mIsRenderPaused(false)
+	mIsRenderPaused(false),
+	mIsRenderPending(false)
 {
 	mRenderWindow->AddRenderer(mRenderer);
 	mRenderWindow->SetInteractor(mInteractor);
@@ -64,7 +65,9 @@ Scene::Scene(QVTKOpenGLStereoWidget* widget, const QString& id)
 		this, &Scene::render);
 }
 
-Scene::~Scene() {}
+Scene::~Scene() {
+	RenderScheduler::cancelRender(this);
+}
 
 QString Scene::getSceneID() const {
 	return mSceneID;
@@ -773,22 +776,15 @@ bool Scene::getAxesVisible() const {
 
 void Scene::render() {
 	if (mIsRenderPaused) {
+		mIsRenderPending = true;
 		return;
 	}
 
-	int currentTime = QTime::currentTime().msecsSinceStartOfDay();
-	int dif = currentTime - mTimeFromLastRender;
+	RenderScheduler::requestRender(this);
+}
 
-	if (dif > 16) {
-		mIsRenderScheduled = false;
-		mRenderWindow->Render();
-		mTimeFromLastRender = currentTime;
-	} else {
-		if (!mIsRenderScheduled) {
-			QTimer::singleShot(16, this, &Scene::render);
-			mIsRenderScheduled = true;
-		}
-	}
+void Scene::renderScene() {
+	mRenderWindow->Render();
 }
 
 void Scene::resetCamera() {
@@ -801,8 +797,14 @@ void Scene::pauseRender() {
 }
 
 void Scene::resumeRender() {
+	bool wasPaused = mIsRenderPaused;
 	mIsRenderPaused = false;
-	this->render();
+
+	// The renders requested while paused are coalesced into this one.
+	if (!wasPaused || mIsRenderPending) {
+		mIsRenderPending = false;
+		this->render();
+	}
 }
 
 bool Scene::isRenderPaused() const {
@@ -2,7 +2,7 @@
 
 #include <fi3d/logger/Logger.h>
 
-#include <fi3d/utilities/ModelAlgorithms.h>
+#include <fi3d/data/SeriesView.h>
 
 #include <QVTKOpenGLStereoWidget.h>
 
@@ -29,7 +29,8 @@ ImageSliceViewer2D::ImageSliceViewer2D(QVTKOpenGLStereoWidget* widget, const QSt
 	mMessageText2D(),
 	mOrientationText2D(),
 	mSliceIndexText2D(),
-	mOriginalModels()
+	mOriginalModels(),
+	mCapper()
 {
 	mViewer->SetRenderWindow(mRenderWindow);
 	mViewer->SetRenderer(mRenderer);
@@ -94,18 +95,17 @@ void ImageSliceViewer2D::enableInputInteractions(const bool& isEnable) {
 }
 
 void ImageSliceViewer2D::capModels() {
-	vtkSmartPointer<vtkPlane> cutPlane = this->getCutPlane();
+	QHash<QString, ModelDataVPtr> caps = mCapper.capModels(mOriginalModels, this->getCutPlane());
 
-	QHash<QString, ModelPtr>::iterator it = mOriginalModels.begin();
-	for (; it != mOriginalModels.end(); it++) {
+	QHash<QString, ModelDataVPtr>::iterator it = caps.begin();
+	for (; it != caps.end(); it++) {
 		QSharedPointer<Model> cappedModel = mModels.value(it.key());
 		if (cappedModel.isNull()) {
 			qWarning() << "Trying to cap a model that is not existing in the list of models.";
 			continue;
 		}
 
-		ModelDataVPtr tData = ModelAlgorithms::transform(it.value()->getModelData(), it.value()->getTransformCopy());
-		cappedModel->setModelData(ModelAlgorithms::capClip(tData, cutPlane));
+		cappedModel->setModelData(it.value());
 	}
 }
 
@@ -118,9 +118,7 @@ void ImageSliceViewer2D::capModel(const QString& visualID) {
 		return;
 	}
 
-	vtkSmartPointer<vtkPlane> cutPlane = this->getCutPlane();
-	ModelDataVPtr tData = ModelAlgorithms::transform(originalModel->getModelData(), originalModel->getTransformCopy());
-	cappedModel->setModelData(ModelAlgorithms::capClip(tData, cutPlane));
+	cappedModel->setModelData(mCapper.capModel(visualID, originalModel, this->getCutPlane()));
 }
 
 void ImageSliceViewer2D::capModel(ModelPtr model) {
@@ -136,10 +134,7 @@ void ImageSliceViewer2D::capModel(ModelPtr model) {
 		return;
 	}
 
-	vtkSmartPointer<vtkPlane> cutPlane = this->getCutPlane();
-	ModelDataVPtr tData = ModelAlgorithms::transform(originalModel->getModelData(), originalModel->getTransformCopy());
-	model->setModelData(ModelAlgorithms::capClip(tData, cutPlane));
-
+	model->setModelData(mCapper.capModel(model->getVisualID(), originalModel, this->getCutPlane()));
 }
 
 void ImageSliceViewer2D::updateCapModel() {
@@ -301,11 +296,13 @@ QList<ModelPtr> ImageSliceViewer2D::getModels() {
 
 void ImageSliceViewer2D::removeVisual(const QString& visualID) {
 	mOriginalModels.remove(visualID);
+	mCapper.removeModel(visualID);
 	Scene::removeVisual(visualID);
 }
 
 void ImageSliceViewer2D::clearScene() {
 	mOriginalModels.clear();
+	mCapper.clear();
 	Scene::clearScene();
 }
 
@@ -421,15 +418,31 @@ void ImageSliceViewer2D::setImageData(ImageDataVPtr data) {
 		return;
 	}
 
+	QObject::disconnect(
+		mImageData.Get(), &ImageData::changedWindowLevel,
+		this, &ImageSliceViewer2D::applyWindowLevel);
+
 	if (data.Get() == Q_NULLPTR) {
 		mImageData = ImageDataVPtr::New();
 	} else {
 		mImageData = data;
 	}
 
+	// The viewer reslices the whole volume, so a view needs its own voxels.
+	SeriesView* view = SeriesView::SafeDownCast(mImageData);
+	if (view != Q_NULLPTR && !view->makeContiguous()) {
+		qWarning() << "Failed to show series" << view->getSeriesIndex() << "in the 2D viewer.";
+	}
+
 	mViewer->SetInputData(mImageData);
 	this->calculateSliceIndices();
 
+	QObject::connect(
+		mImageData.Get(), &ImageData::changedWindowLevel,
+		this, &ImageSliceViewer2D::applyWindowLevel,
+		Qt::UniqueConnection);
+	this->applyWindowLevel();
+
 	switch (mOrientation.toInt()) {
 		case ESliceOrientation::XY:
 			mViewer->SetSlice(mOrientationSliceIndices.transverseIndex);
@@ -455,6 +468,14 @@ void ImageSliceViewer2D::setImageData(ImageDataVPtr data) {
 	emit changedSlice(this->getSliceIndex(), mOrientation);
 }
 
+void ImageSliceViewer2D::applyWindowLevel() {
+	double window, level;
+	mImageData->getWindowLevel(window, level);
+	mViewer->SetColorWindow(window);
+	mViewer->SetColorLevel(level);
+	this->render();
+}
+
 void ImageSliceViewer2D::setMessageText(const QString& messageText) {
 	if (mMessageText2D->getText() == messageText) {
 		return;
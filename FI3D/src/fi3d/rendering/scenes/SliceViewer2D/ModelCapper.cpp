@@ -0,0 +1,338 @@
+#include <fi3d/rendering/scenes/SliceViewer2D/ModelCapper.h>
+
+#include <fi3d/logger/Logger.h>
+
+#include <fi3d/utilities/ModelAlgorithms.h>
+#include <fi3d/utilities/ParallelAlgorithms.h>
+
+#include <vtkCellArray.h>
+#include <vtkMath.h>
+#include <vtkMatrix4x4.h>
+#include <vtkNew.h>
+#include <vtkPlane.h>
+#include <vtkPoints.h>
+#include <vtkTransform.h>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+using namespace fi3d;
+
+/// @brief The most slabs a mesh is sorted into.
+static const int MAX_SLAB_COUNT = 4096;
+
+/// @brief Vertices this close to the plane, relative to the mesh depth, are on it.
+static const double PLANE_SNAP_TOLERANCE = 1e-9;
+
+/// @brief Struct used internally to cap a model on a worker thread.
+typedef struct CapJob {
+	QString VisualID;
+	vtkSmartPointer<vtkPolyData> Data;
+	double Matrix[16];
+	QSharedPointer<CapMesh> Mesh;
+	ModelDataVPtr Cap;
+} CapJob;
+
+ModelCapper::ModelCapper()
+	: mMeshes()
+{}
+
+ModelCapper::~ModelCapper() {}
+
+QHash<QString, ModelDataVPtr> ModelCapper::capModels(const QHash<QString, ModelPtr>& models, vtkPlane* cutPlane) {
+	QHash<QString, ModelDataVPtr> caps;
+	if (cutPlane == Q_NULLPTR) {
+		return caps;
+	}
+
+	double origin[3];
+	double normal[3];
+	cutPlane->GetOrigin(origin);
+	cutPlane->GetNormal(normal);
+	if (vtkMath::Normalize(normal) == 0.0) {
+		qWarning() << "Failed to cap models because the cut plane has no normal.";
+		return caps;
+	}
+
+	// The models are only read here, the workers use the copies.
+	QVector<CapJob> jobs;
+	jobs.reserve(models.count());
+	QHash<QString, ModelPtr>::const_iterator it = models.constBegin();
+	for (; it != models.constEnd(); it++) {
+		if (it.value().isNull()) {
+			continue;
+		}
+
+		CapJob job;
+		job.VisualID = it.key();
+		job.Data = it.value()->getModelData();
+		vtkMatrix4x4::DeepCopy(job.Matrix, it.value()->getTransformCopy()->GetMatrix());
+
+		job.Mesh = mMeshes.value(it.key());
+		if (job.Mesh.isNull()) {
+			job.Mesh.reset(new CapMesh());
+			mMeshes.insert(it.key(), job.Mesh);
+		}
+		jobs.append(job);
+	}
+
+	ParallelAlgorithms::forRange(jobs.count(), [&jobs, &origin, &normal](const int& i) {
+		CapJob& job = jobs[i];
+		if (job.Data.Get() == Q_NULLPTR) {
+			return;
+		}
+
+		ModelCapper::updateMesh(job.Mesh.data(), job.Data, job.Matrix);
+		ModelCapper::updateSlabs(job.Mesh.data(), normal);
+		job.Cap = ModelCapper::intersect(job.Mesh.data(), origin);
+	});
+
+	for (const CapJob& job : jobs) {
+		caps.insert(job.VisualID, job.Cap);
+	}
+	return caps;
+}
+
+ModelDataVPtr ModelCapper::capModel(const QString& visualID, ModelPtr model, vtkPlane* cutPlane) {
+	QHash<QString, ModelPtr> models;
+	models.insert(visualID, model);
+	return this->capModels(models, cutPlane).value(visualID);
+}
+
+void ModelCapper::removeModel(const QString& visualID) {
+	mMeshes.remove(visualID);
+}
+
+void ModelCapper::clear() {
+	mMeshes.clear();
+}
+
+void ModelCapper::updateMesh(CapMesh* mesh, vtkPolyData* data, const double matrix[16]) {
+	if (mesh->Data == data && mesh->DataTime == data->GetMTime() &&
+		std::memcmp(mesh->Matrix, matrix, sizeof(mesh->Matrix)) == 0)
+	{
+		return;
+	}
+
+	mesh->Data = data;
+	mesh->DataTime = data->GetMTime();
+	std::memcpy(mesh->Matrix, matrix, sizeof(mesh->Matrix));
+	mesh->IsIndexed = false;
+	mesh->Triangles.clear();
+
+	vtkPoints* points = data->GetPoints();
+	vtkIdType pointCount = points == Q_NULLPTR ? 0 : points->GetNumberOfPoints();
+	mesh->Points.resize(pointCount * 3);
+	for (vtkIdType i = 0; i < pointCount; i++) {
+		double point[3];
+		points->GetPoint(i, point);
+
+		double w = matrix[12] * point[0] + matrix[13] * point[1] + matrix[14] * point[2] + matrix[15];
+		if (w == 0.0) {
+			w = 1.0;
+		}
+		for (int row = 0; row < 3; row++) {
+			mesh->Points[i * 3 + row] = (matrix[row * 4] * point[0] + matrix[row * 4 + 1] * point[1] +
+				matrix[row * 4 + 2] * point[2] + matrix[row * 4 + 3]) / w;
+		}
+	}
+
+	if (pointCount > 0) {
+		mesh->Triangles = ModelAlgorithms::getTriangles(data);
+	}
+}
+
+void ModelCapper::updateSlabs(CapMesh* mesh, const double normal[3]) {
+	if (mesh->IsIndexed && mesh->Normal[0] == normal[0] &&
+		mesh->Normal[1] == normal[1] && mesh->Normal[2] == normal[2])
+	{
+		return;
+	}
+
+	mesh->IsIndexed = true;
+	for (int axis = 0; axis < 3; axis++) {
+		mesh->Normal[axis] = normal[axis];
+	}
+
+	int pointCount = mesh->Points.count() / 3;
+	mesh->Projections.resize(pointCount);
+	double low = std::numeric_limits<double>::max();
+	double high = std::numeric_limits<double>::lowest();
+	for (int i = 0; i < pointCount; i++) {
+		double projection = vtkMath::Dot(mesh->Points.constData() + i * 3, normal);
+		mesh->Projections[i] = projection;
+		low = qMin(low, projection);
+		high = qMax(high, projection);
+	}
+
+	int triangleCount = mesh->Triangles.count() / 3;
+	if (triangleCount == 0) {
+		mesh->SlabStart = 0;
+		mesh->SlabWidth = 1;
+		mesh->SlabOffsets.fill(0, 2);
+		mesh->SlabTriangles.clear();
+		return;
+	}
+
+	int slabCount = qBound(1, (int)std::sqrt((double)triangleCount), MAX_SLAB_COUNT);
+	mesh->SlabStart = low;
+	mesh->SlabWidth = high > low ? (high - low) / slabCount : 1.0;
+
+	auto getSlab = [mesh, slabCount](const double& projection) {
+		return qBound(0, (int)((projection - mesh->SlabStart) / mesh->SlabWidth), slabCount - 1);
+	};
+
+	// Count the triangles of each slab, then place them.
+	QVector<int> firstSlabs(triangleCount);
+	QVector<int> lastSlabs(triangleCount);
+	mesh->SlabOffsets.fill(0, slabCount + 1);
+	for (int t = 0; t < triangleCount; t++) {
+		const vtkIdType* vertices = mesh->Triangles.constData() + t * 3;
+		double p0 = mesh->Projections.at(vertices[0]);
+		double p1 = mesh->Projections.at(vertices[1]);
+		double p2 = mesh->Projections.at(vertices[2]);
+		firstSlabs[t] = getSlab(qMin(p0, qMin(p1, p2)));
+		lastSlabs[t] = getSlab(qMax(p0, qMax(p1, p2)));
+		for (int slab = firstSlabs.at(t); slab <= lastSlabs.at(t); slab++) {
+			mesh->SlabOffsets[slab + 1]++;
+		}
+	}
+	for (int slab = 0; slab < slabCount; slab++) {
+		mesh->SlabOffsets[slab + 1] += mesh->SlabOffsets.at(slab);
+	}
+
+	QVector<int> nextPlace = mesh->SlabOffsets;
+	mesh->SlabTriangles.resize(mesh->SlabOffsets.at(slabCount));
+	for (int t = 0; t < triangleCount; t++) {
+		for (int slab = firstSlabs.at(t); slab <= lastSlabs.at(t); slab++) {
+			mesh->SlabTriangles[nextPlace[slab]++] = t;
+		}
+	}
+}
+
+ModelDataVPtr ModelCapper::intersect(const CapMesh* mesh, const double origin[3]) {
+	ModelDataVPtr cap = ModelDataVPtr::New();
+	vtkNew<vtkPoints> points;
+	points->SetDataTypeToDouble();
+	vtkNew<vtkCellArray> polys;
+	cap->SetPoints(points);
+	cap->SetPolys(polys);
+
+	int slabCount = mesh->SlabOffsets.count() - 1;
+	double offset = vtkMath::Dot(origin, mesh->Normal);
+	if (slabCount <= 0 || mesh->SlabTriangles.isEmpty() || offset < mesh->SlabStart ||
+		offset > mesh->SlabStart + mesh->SlabWidth * slabCount)
+	{
+		return cap;
+	}
+	int slab = qBound(0, (int)((offset - mesh->SlabStart) / mesh->SlabWidth), slabCount - 1);
+	double tolerance = PLANE_SNAP_TOLERANCE * mesh->SlabWidth * slabCount;
+
+	// Each crossed edge gives one point, shared by the triangles around it.
+	// A vertex on the plane is the point of all its crossed edges, keyed as
+	// the edge from the vertex to itself, so its contour is not split.
+	QHash<quint64, vtkIdType> edgePoints;
+	QVector<vtkIdType> links;
+	for (int k = mesh->SlabOffsets.at(slab); k < mesh->SlabOffsets.at(slab + 1); k++) {
+		const vtkIdType* vertices = mesh->Triangles.constData() + mesh->SlabTriangles.at(k) * 3;
+
+		// Vertices on the plane count as above, so a crossing has two edges.
+		bool isAbove[3];
+		bool isOnPlane[3];
+		for (int j = 0; j < 3; j++) {
+			double distance = mesh->Projections.at(vertices[j]) - offset;
+			isOnPlane[j] = std::abs(distance) <= tolerance;
+			isAbove[j] = isOnPlane[j] || distance > 0.0;
+		}
+		if (isAbove[0] == isAbove[1] && isAbove[1] == isAbove[2]) {
+			continue;
+		}
+
+		vtkIdType ends[2];
+		int endCount = 0;
+		for (int j = 0; j < 3; j++) {
+			if (isAbove[j] == isAbove[(j + 1) % 3]) {
+				continue;
+			}
+
+			// Only the end above may be on the plane.
+			int onPlane = isOnPlane[j] ? j : (isOnPlane[(j + 1) % 3] ? (j + 1) % 3 : -1);
+			vtkIdType a = onPlane >= 0 ? vertices[onPlane] : qMin(vertices[j], vertices[(j + 1) % 3]);
+			vtkIdType b = onPlane >= 0 ? vertices[onPlane] : qMax(vertices[j], vertices[(j + 1) % 3]);
+			quint64 edge = ((quint64)a << 32) | (quint64)b;
+
+			QHash<quint64, vtkIdType>::const_iterator found = edgePoints.constFind(edge);
+			if (found != edgePoints.constEnd()) {
+				ends[endCount++] = found.value();
+				continue;
+			}
+
+			double point[3];
+			const double* pa = mesh->Points.constData() + a * 3;
+			const double* pb = mesh->Points.constData() + b * 3;
+			if (a == b) {
+				std::memcpy(point, pa, sizeof(point));
+			} else {
+				double da = mesh->Projections.at(a) - offset;
+				double db = mesh->Projections.at(b) - offset;
+				double t = da / (da - db);
+				for (int axis = 0; axis < 3; axis++) {
+					point[axis] = pa[axis] + t * (pb[axis] - pa[axis]);
+				}
+			}
+
+			vtkIdType id = points->InsertNextPoint(point);
+			edgePoints.insert(edge, id);
+			links.append(-1);
+			links.append(-1);
+			ends[endCount++] = id;
+		}
+
+		// A triangle touching the plane at one vertex adds no segment.
+		if (ends[0] == ends[1]) {
+			continue;
+		}
+
+		// Points of non-manifold edges keep their first two links.
+		for (int j = 0; j < 2; j++) {
+			vtkIdType* slots = links.data() + ends[j] * 2;
+			vtkIdType other = ends[1 - j];
+			if (slots[0] < 0) {
+				slots[0] = other;
+			} else if (slots[1] < 0) {
+				slots[1] = other;
+			}
+		}
+	}
+
+	// Open chains are walked from their ends first, then the closed loops.
+	vtkIdType pointCount = points->GetNumberOfPoints();
+	QVector<bool> isVisited(pointCount, false);
+	QVector<vtkIdType> contour;
+	for (int pass = 0; pass < 2; pass++) {
+		for (vtkIdType start = 0; start < pointCount; start++) {
+			if (isVisited.at(start) || (pass == 0 && links.at(start * 2 + 1) >= 0)) {
+				continue;
+			}
+
+			contour.clear();
+			vtkIdType previous = -1;
+			vtkIdType current = start;
+			while (current >= 0 && !isVisited.at(current)) {
+				isVisited[current] = true;
+				contour.append(current);
+
+				vtkIdType next = links.at(current * 2) != previous ? links.at(current * 2) : links.at(current * 2 + 1);
+				previous = current;
+				current = next;
+			}
+
+			if (contour.count() >= 2) {
+				polys->InsertNextCell(contour.count(), contour.constData());
+			}
+		}
+	}
+
+	return cap;
+}
@@ -117,7 +117,7 @@ void StudySliceViewer2D::setSeriesIndex(const int& seriesIndex) {
 	// Set the new series
 	mSeriesIndex = seriesIndex;
 
-	vtkSmartPointer<SeriesData> series = mStudy->getSeries(mSeriesIndex);
+	vtkSmartPointer<SeriesData> series = mStudy->getContiguousSeries(mSeriesIndex);
 	mViewer->SetInputData(series);
 
 	// Update the patient matrix in all the visualized models
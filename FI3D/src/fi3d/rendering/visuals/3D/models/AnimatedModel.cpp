@@ -2,6 +2,10 @@
 
 #include <fi3d/logger/Logger.h>
 
+#include <fi3d/rendering/visuals/AnimationClock.h>
+
+#include <vtkPolyDataMapper.h>
+
 using namespace fi3d;
 
 AnimatedModel::AnimatedModel(const QString& id, 
@@ -10,31 +14,35 @@ AnimatedModel::AnimatedModel(const QString& id,
 	mAnimatedModelData(animatedModel),
 	mFrameIndex(0),
 	mAnimationSpeed(1000),
-	mAnimationTimer(),
-	mExternalTimer(Q_NULLPTR)
+	mIsAnimationActive(false),
+	mIsFrameCacheEnabled(false),
+	mFrameMappers()
 {
 	if (mAnimatedModelData.isNull()) {
 		mAnimatedModelData.reset(new AnimatedModelData());
 	}
 
 	this->setModelData(mAnimatedModelData->getAnimationFrame(mFrameIndex));
-	
-	QObject::connect(
-		&mAnimationTimer, SIGNAL(timeout()), 
-		this, SLOT(setNextFrameCycle())
-	);
 }
 
-AnimatedModel::~AnimatedModel() {}
+AnimatedModel::~AnimatedModel() {
+	AnimationClock::removeAnimation(this);
+}
 
 void AnimatedModel::setAnimatedModelData(AnimatedModelDataPtr animatedModel) {
 	mAnimatedModelData = animatedModel;
 	mFrameIndex = 0;
+	mFrameMappers.clear();
 	if (mAnimatedModelData.isNull()) {
 		mAnimatedModelData.reset(new AnimatedModelData());
 	}
 
-	this->setModelData(mAnimatedModelData->getAnimationFrame(mFrameIndex));
+	if (mIsFrameCacheEnabled) {
+		for (int i = 0; i < mAnimatedModelData->getAnimationFrameCount(); i++) {
+			this->getFrameMapper(i)->Update();
+		}
+	}
+	this->showCurrentFrame();
 
 	emit changedAnimatedModelData(mAnimatedModelData);
 }
@@ -45,36 +53,30 @@ void AnimatedModel::setAnimationSpeed(const int& animationSpeed) {
 	}
 
 	mAnimationSpeed = animationSpeed;
-	if (mAnimationTimer.isActive()) {
-		mAnimationTimer.stop();
-		mAnimationTimer.start(mAnimationSpeed);
+	if (mIsAnimationActive) {
+		AnimationClock::addAnimation(this, mAnimationSpeed);
 	}
 
 	emit changedAnimationSpeed(mAnimationSpeed);
 }
 
 void AnimatedModel::setAnimate(const bool& animate) {
-	if (mAnimationTimer.isActive() == animate) {
-		return;
-	}
-
-	if (mExternalTimer != Q_NULLPTR) {
-		qWarning() << "Animation failed to start because the AnimatedModel" <<
-			this->getVisualID() << "has an external timer.";
+	if (mIsAnimationActive == animate) {
 		return;
 	}
 
-	if (animate) {
-		mAnimationTimer.start(mAnimationSpeed);
+	mIsAnimationActive = animate;
+	if (mIsAnimationActive) {
+		AnimationClock::addAnimation(this, mAnimationSpeed);
 	} else {
-		mAnimationTimer.stop();
+		AnimationClock::removeAnimation(this);
 	}
 
-	emit changedAnimationActive(mAnimationTimer.isActive());
+	emit changedAnimationActive(mIsAnimationActive);
 }
 
 void AnimatedModel::toggleAnimation() {
-	this->setAnimate(!mAnimationTimer.isActive());
+	this->setAnimate(!mIsAnimationActive);
 }
 
 void AnimatedModel::setFrame(const int& frameIndex) {
@@ -86,7 +88,7 @@ void AnimatedModel::setFrame(const int& frameIndex) {
 	}
 
 	mFrameIndex = frameIndex;
-	this->setModelData(mAnimatedModelData->getAnimationFrame(mFrameIndex));	
+	this->showCurrentFrame();
 }
 
 void AnimatedModel::setNextFrame() {
@@ -99,7 +101,7 @@ void AnimatedModel::setNextFrame() {
 	}
 
 	mFrameIndex++;
-	this->setModelData(mAnimatedModelData->getAnimationFrame(mFrameIndex));
+	this->showCurrentFrame();
 }
 
 void AnimatedModel::setPreviousFrame() {
@@ -112,7 +114,7 @@ void AnimatedModel::setPreviousFrame() {
 	}
 
 	mFrameIndex--;
-	this->setModelData(mAnimatedModelData->getAnimationFrame(mFrameIndex));
+	this->showCurrentFrame();
 }
 
 void AnimatedModel::setNextFrameCycle() {
@@ -121,7 +123,23 @@ void AnimatedModel::setNextFrameCycle() {
 	}
 
 	mFrameIndex = (mFrameIndex + 1) % mAnimatedModelData->getAnimationFrameCount();
-	this->setModelData(mAnimatedModelData->getAnimationFrame(mFrameIndex));
+	this->showCurrentFrame();
+}
+
+void AnimatedModel::setFrameCacheEnabled(const bool& isEnabled) {
+	if (mIsFrameCacheEnabled == isEnabled) {
+		return;
+	}
+
+	mIsFrameCacheEnabled = isEnabled;
+	mFrameMappers.clear();
+	if (mIsFrameCacheEnabled) {
+		for (int i = 0; i < mAnimatedModelData->getAnimationFrameCount(); i++) {
+			this->getFrameMapper(i)->Update();
+		}
+	}
+
+	this->showCurrentFrame();
 }
 
 AnimatedModelDataPtr AnimatedModel::getAnimatedModelData() {
@@ -133,41 +151,50 @@ int AnimatedModel::getAnimationSpeed() {
 }
 
 bool AnimatedModel::isAnimationActive() {
-	return mAnimationTimer.isActive();
+	return mIsAnimationActive;
 }
 
 int AnimatedModel::getCurrentFrameIndex() {
 	return mFrameIndex;
 }
 
-void AnimatedModel::setExternalTimer(QTimer* timer) {
-	if (timer == Q_NULLPTR) {
-		this->disableExternalTimer();
+bool AnimatedModel::isFrameCacheEnabled() {
+	return mIsFrameCacheEnabled;
+}
+
+void AnimatedModel::advanceAnimation(const int& frameCount) {
+	if (mAnimatedModelData->getAnimationFrameCount() == 0) {
 		return;
 	}
 
-	if (this->isAnimationActive()) {
-		this->setAnimate(false);
+	mFrameIndex = (mFrameIndex + frameCount) % mAnimatedModelData->getAnimationFrameCount();
+	this->showCurrentFrame();
+}
+
+void AnimatedModel::showCurrentFrame() {
+	ModelDataVPtr frame = mAnimatedModelData->getAnimationFrame(mFrameIndex);
+	if (!mIsFrameCacheEnabled || frame.Get() == Q_NULLPTR) {
+		this->setModelData(frame);
+		return;
 	}
 
-	mExternalTimer = timer;
-	QObject::connect(
-		mExternalTimer, SIGNAL(timeout()), 
-		this, SLOT(setNextFrameCycle()), 
-		Qt::UniqueConnection
-	);
+	this->showModelData(frame, this->getFrameMapper(mFrameIndex));
 }
 
-void AnimatedModel::disableExternalTimer() {
-	if (mExternalTimer == Q_NULLPTR) {
-		return;
+vtkSmartPointer<vtkPolyDataMapper> AnimatedModel::getFrameMapper(const int& frameIndex) {
+	if (mFrameMappers.count() != mAnimatedModelData->getAnimationFrameCount()) {
+		mFrameMappers.resize(mAnimatedModelData->getAnimationFrameCount());
+	}
+
+	ModelDataVPtr frame = mAnimatedModelData->getAnimationFrame(frameIndex);
+	vtkSmartPointer<vtkPolyDataMapper> mapper = mFrameMappers.at(frameIndex);
+	if (mapper.Get() == Q_NULLPTR || mapper->GetInput() != frame.Get()) {
+		mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
+		mapper->SetInputData(frame);
+		mFrameMappers[frameIndex] = mapper;
 	}
 
-	QObject::disconnect(
-		mExternalTimer, SIGNAL(timeout()), 
-		this, SLOT(setNextFrameCycle())
-	);
-	mExternalTimer = Q_NULLPTR;
+	return mapper;
 }
 
 EVisual AnimatedModel::getVisualType() const {
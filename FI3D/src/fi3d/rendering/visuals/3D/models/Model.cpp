@@ -12,10 +12,11 @@ Model::Model(const QString& name, ModelDataVPtr data)
 	: Visual3D(name),
 	mData(data),
 	mMapper(vtkSmartPointer<vtkPolyDataMapper>::New()),
+	mActiveMapper(mMapper),
 	mActor(vtkSmartPointer<vtkActor>::New())
 {
 	mMapper->SetInputData(mData);
-	mActor->SetMapper(mMapper);
+	mActor->SetMapper(mActiveMapper);
 	mActor->SetUserTransform(this->getTransform());
 
 	// Re-emit signal when visualized data changes internally
@@ -28,7 +29,23 @@ Model::Model(const QString& name, ModelDataVPtr data)
 Model::~Model() {}
 
 void Model::setModelData(ModelDataVPtr data) {
-	if (mData == data) {
+	if (mData == data && mActiveMapper == mMapper) {
+		return;
+	}
+
+	ModelDataVPtr shownData = data;
+	if (shownData.Get() == Q_NULLPTR) {
+		shownData = ModelDataVPtr::New();
+	}
+
+	if (mMapper->GetInput() != shownData.Get()) {
+		mMapper->SetInputData(shownData);
+	}
+	this->showModelData(shownData, mMapper);
+}
+
+void Model::showModelData(ModelDataVPtr data, vtkSmartPointer<vtkPolyDataMapper> mapper) {
+	if (mData == data && mActiveMapper == mapper) {
 		return;
 	}
 
@@ -37,13 +54,11 @@ void Model::setModelData(ModelDataVPtr data) {
 		mData.Get(), &ModelData::changedData,
 		this, &Model::onDataUpdated);
 
-	if (data.Get() == Q_NULLPTR) {
-		mData = ModelDataVPtr::New();
-	} else {
-		mData = data;
+	mData = data;
+	if (mActiveMapper != mapper) {
+		mActiveMapper = mapper;
+		mActor->SetMapper(mActiveMapper);
 	}
-
-	mMapper->SetInputData(mData);
 	emit changedModelData(mData);
 
 	// Re-emit signal when visualized data changes internally
@@ -2,22 +2,31 @@
 
 #include <fi3d/logger/Logger.h>
 
+#include <fi3d/rendering/visuals/AnimationClock.h>
+
+#include <vtkImageSliceMapper.h>
+
 using namespace fi3d;
 
 AnimatedStudySlice::AnimatedStudySlice(const QString& name, 
 	ESliceOrientation orientation, StudyPtr study)
 	: StudySlice(name, orientation, study),
 	mAnimationSpeed(1000),
-	mAnimationTimer(),
-	mExternalTimer(Q_NULLPTR)
+	mIsAnimationActive(false),
+	mIsFrameCacheEnabled(false),
+	mFrameMappers()
 {
 	QObject::connect(
-		&mAnimationTimer, SIGNAL(timeout()),
-		this, SLOT(setSeriesIndexToNextCycle())
-	);
+		this, &StudySlice::changedStudy,
+		this, &AnimatedStudySlice::onStudyChanged);
+
+	// The base constructor set the Study before setStudy was overridden.
+	this->watchStudy(Q_NULLPTR, this->getStudy());
 }
 
-AnimatedStudySlice::~AnimatedStudySlice() {}
+AnimatedStudySlice::~AnimatedStudySlice() {
+	AnimationClock::removeAnimation(this);
+}
 
 void AnimatedStudySlice::setAnimationSpeed(const int& animationSpeed) {
 	if (mAnimationSpeed == animationSpeed) {
@@ -25,37 +34,30 @@ void AnimatedStudySlice::setAnimationSpeed(const int& animationSpeed) {
 	}
 
 	mAnimationSpeed = animationSpeed;
-	if (mAnimationTimer.isActive()) {
-		mAnimationTimer.stop();
-		mAnimationTimer.start(mAnimationSpeed);
+	if (mIsAnimationActive) {
+		AnimationClock::addAnimation(this, mAnimationSpeed);
 	}
 
 	emit changedAnimationSpeed(mAnimationSpeed);
 }
 
 void AnimatedStudySlice::setAnimate(const bool& animate) {
-	if (mAnimationTimer.isActive() == animate) {
+	if (mIsAnimationActive == animate) {
 		return;
 	}
 
-	if (mExternalTimer != Q_NULLPTR) {
-		qWarning() << "Animation failed to start because the" <<
-			"AnimatedStudySlice" << this->getVisualID() <<
-			"has an external timer.";
-		return;
-	}
-
-	if (animate) {
-		mAnimationTimer.start(mAnimationSpeed);
+	mIsAnimationActive = animate;
+	if (mIsAnimationActive) {
+		AnimationClock::addAnimation(this, mAnimationSpeed);
 	} else {
-		mAnimationTimer.stop();
+		AnimationClock::removeAnimation(this);
 	}
 
-	emit changedAnimationActive(mAnimationTimer.isActive());
+	emit changedAnimationActive(mIsAnimationActive);
 }
 
 void AnimatedStudySlice::toggleAnimation() {
-	this->setAnimate(!mAnimationTimer.isActive());
+	this->setAnimate(!mIsAnimationActive);
 }
 
 void AnimatedStudySlice::setSeriesIndexToNextCycle() {
@@ -69,42 +71,116 @@ void AnimatedStudySlice::setSeriesIndexToNextCycle() {
 	this->setSeriesIndex(seriesIndex);
 }
 
+void AnimatedStudySlice::setFrameCacheEnabled(const bool& isEnabled) {
+	if (mIsFrameCacheEnabled == isEnabled) {
+		return;
+	}
+
+	mIsFrameCacheEnabled = isEnabled;
+	mFrameMappers.clear();
+	if (mIsFrameCacheEnabled) {
+		this->prepareFrameMappers();
+	}
+
+	this->setImageData(this->getImageData());
+}
+
+void AnimatedStudySlice::setStudy(StudyPtr study) {
+	StudyPtr previous = this->getStudy();
+	StudySlice::setStudy(study);
+	this->watchStudy(previous, this->getStudy());
+}
+
+void AnimatedStudySlice::setImageData(ImageDataVPtr imageData) {
+	// Partial data has no voxels to map, the slice is copied for it instead.
+	if (!mIsFrameCacheEnabled || imageData.Get() == Q_NULLPTR || imageData->isPartial()) {
+		ImageSlice::setImageData(imageData);
+		return;
+	}
+
+	// Data that is not a series of the Study, e.g. set directly, gets its
+	// mapper the first time it is shown.
+	vtkSmartPointer<vtkImageSliceMapper> mapper = mFrameMappers.value(imageData.Get());
+	if (mapper.Get() == Q_NULLPTR) {
+		mapper = vtkSmartPointer<vtkImageSliceMapper>::New();
+		mapper->SetInputData(imageData);
+		mFrameMappers.insert(imageData.Get(), mapper);
+	}
+
+	this->showImageData(imageData, mapper);
+}
+
 int AnimatedStudySlice::getAnimationSpeed() {
 	return mAnimationSpeed;
 }
 
 bool AnimatedStudySlice::isAnimationActive() {
-	return mAnimationTimer.isActive();
+	return mIsAnimationActive;
+}
+
+bool AnimatedStudySlice::isFrameCacheEnabled() {
+	return mIsFrameCacheEnabled;
 }
 
-void AnimatedStudySlice::setExternalTimer(QTimer* timer) {
-	if (timer == Q_NULLPTR) {
-		this->disableExternalTimer();
+void AnimatedStudySlice::advanceAnimation(const int& frameCount) {
+	if (this->getSeriesMaxIndex() <= 0) {
 		return;
 	}
 
-	if (this->isAnimationActive()) {
-		this->setAnimate(false);
+	int seriesIndex = this->getSeriesIndex();
+	seriesIndex = (seriesIndex + frameCount) % (this->getSeriesMaxIndex() + 1);
+
+	this->setSeriesIndex(seriesIndex);
+}
+
+void AnimatedStudySlice::onStudyChanged() {
+	if (!mIsFrameCacheEnabled) {
+		return;
 	}
 
-	mExternalTimer = timer;
-	QObject::connect(
-		mExternalTimer, SIGNAL(timeout()),
-		this,SLOT(setSeriesIndexToNextCycle()),
-		Qt::UniqueConnection
-	);
+	// The mappers keep the series of the previous Study alive.
+	mFrameMappers.clear();
+	this->prepareFrameMappers();
+	this->setImageData(this->getCurrentSeries());
 }
 
-void AnimatedStudySlice::disableExternalTimer() {
-	if (mExternalTimer == Q_NULLPTR) {
+void AnimatedStudySlice::onSeriesRemoved(SeriesDataVPtr series) {
+	mFrameMappers.remove(series.Get());
+}
+
+void AnimatedStudySlice::watchStudy(StudyPtr previous, StudyPtr study) {
+	if (previous == study) {
+		return;
+	}
+
+	if (!previous.isNull()) {
+		QObject::disconnect(
+			previous.get(), &Study::changedRemovedSeries,
+			this, &AnimatedStudySlice::onSeriesRemoved);
+	}
+	if (!study.isNull()) {
+		QObject::connect(
+			study.get(), &Study::changedRemovedSeries,
+			this, &AnimatedStudySlice::onSeriesRemoved,
+			Qt::UniqueConnection);
+	}
+}
+
+void AnimatedStudySlice::prepareFrameMappers() {
+	StudyPtr study = this->getStudy();
+	if (study.isNull()) {
 		return;
 	}
 
-	QObject::disconnect(
-		mExternalTimer, SIGNAL(timeout()),
-		this, SLOT(setNextFrameCycle())
-	);
-	mExternalTimer = Q_NULLPTR;
+	for (int i = 0; i < study->getSeriesCount(); i++) {
+		SeriesDataVPtr series = study->getSeries(i);
+		if (series.Get() == Q_NULLPTR || series->isPartial()) {
+			continue;
+		}
+		vtkSmartPointer<vtkImageSliceMapper> mapper = vtkSmartPointer<vtkImageSliceMapper>::New();
+		mapper->SetInputData(series);
+		mFrameMappers.insert(series.Get(), mapper);
+	}
 }
 
 EVisual AnimatedStudySlice::getVisualType() const {
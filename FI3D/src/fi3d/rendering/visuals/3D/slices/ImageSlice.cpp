@@ -2,10 +2,13 @@
 
 #include <fi3d/logger/Logger.h>
 
+#include <vtkImageProperty.h>
 #include <vtkImageSliceMapper.h>
 #include <vtkPlane.h>
 #include <vtkOutlineFilter.h>
 
+#include <algorithm>
+
 using namespace fi3d;
 
 ImageSlice::ImageSlice(const QString& name, ESliceOrientation orientation,
@@ -16,7 +19,9 @@ ImageSlice::ImageSlice(const QString& name, ESliceOrientation orientation,
 	mOrientation(orientation),
 	mOrientationSliceIndices(),
 	mMapper(vtkSmartPointer<vtkImageSliceMapper>::New()),
-	mActor(vtkSmartPointer<vtkImageActor>::New())
+	mImageMapper(mMapper),
+	mActor(vtkSmartPointer<vtkImageActor>::New()),
+	mSliceImage(vtkSmartPointer<vtkImageData>::New())
 {
 	if (data.Get() == Q_NULLPTR) {
 		mImageData = ImageDataVPtr::New();
@@ -25,6 +30,7 @@ ImageSlice::ImageSlice(const QString& name, ESliceOrientation orientation,
 	mMapper->SetInputData(mImageData);
 	mActor->SetMapper(mMapper);
 	mActor->SetUserTransform(this->getTransform());
+	this->applyWindowLevel();
 	
 	// Ensures that opaque models are not blocked by the iamge
 	mActor->ForceOpaqueOn();
@@ -47,6 +53,10 @@ ImageSlice::ImageSlice(const QString& name, ESliceOrientation orientation,
 		mImageData.Get(), &ImageData::changedData,
 		this, &ImageSlice::onDataUpdated,
 		Qt::UniqueConnection);
+	QObject::connect(
+		mImageData.Get(), &ImageData::changedWindowLevel,
+		this, &ImageSlice::onWindowLevelChanged,
+		Qt::UniqueConnection);
 
 	// Update the data frame position when the slice position changes
 	QObject::connect(
@@ -58,7 +68,24 @@ ImageSlice::ImageSlice(const QString& name, ESliceOrientation orientation,
 ImageSlice::~ImageSlice() {}
 
 void ImageSlice::setImageData(ImageDataVPtr data) {
-	if (mImageData == data) {
+	if (mImageData == data && mMapper == mImageMapper) {
+		return;
+	}
+
+	ImageDataVPtr shownData = data;
+	if (shownData.Get() == Q_NULLPTR) {
+		shownData = ImageDataVPtr::New();
+	}
+
+	// A partial ImageData is shown through its copied slice instead.
+	if (!shownData->isPartial() && mImageMapper->GetInput() != shownData.Get()) {
+		mImageMapper->SetInputData(shownData);
+	}
+	this->showImageData(shownData, mImageMapper);
+}
+
+void ImageSlice::showImageData(ImageDataVPtr data, vtkSmartPointer<vtkImageSliceMapper> mapper) {
+	if (mImageData == data && mMapper == mapper) {
 		return;
 	}
 
@@ -66,14 +93,21 @@ void ImageSlice::setImageData(ImageDataVPtr data) {
 	QObject::disconnect(
 		mImageData.Get(), &ImageData::changedData,
 		this, &ImageSlice::onDataUpdated);
-	
-	if (data.Get() == Q_NULLPTR) {
-		mImageData = ImageDataVPtr::New();
-	} else {
-		mImageData = data;
+	QObject::disconnect(
+		mImageData.Get(), &ImageData::changedWindowLevel,
+		this, &ImageSlice::onWindowLevelChanged);
+
+	// The outline only has to be rebuilt when the geometry changes, which
+	// is not the case when cycling through the series of a Study.
+	double previousBounds[6], bounds[6];
+	mImageData->GetBounds(previousBounds);
+	data->GetBounds(bounds);
+
+	mImageData = data;
+	if (mMapper != mapper) {
+		mMapper = mapper;
+		mActor->SetMapper(mMapper);
 	}
-
-	mMapper->SetInputData(mImageData);
 	this->calculateSliceIndices();
 
 	// Re-emit signal when visualized data changes internally
@@ -81,24 +115,34 @@ void ImageSlice::setImageData(ImageDataVPtr data) {
 		mImageData.Get(), &ImageData::changedData,
 		this, &ImageSlice::onDataUpdated,
 		Qt::UniqueConnection);
+	QObject::connect(
+		mImageData.Get(), &ImageData::changedWindowLevel,
+		this, &ImageSlice::onWindowLevelChanged,
+		Qt::UniqueConnection);
+	this->applyWindowLevel();
 
 	switch (mOrientation.toInt()) {
 		case ESliceOrientation::XY:
-			mMapper->SetSliceNumber(mOrientationSliceIndices.transverseIndex);
+			mMapper->SetOrientationToZ();
+			this->applySliceNumber(mOrientationSliceIndices.transverseIndex);
 			break;
 		case ESliceOrientation::YZ:
-			mMapper->SetSliceNumber(mOrientationSliceIndices.sagittalIndex);
+			mMapper->SetOrientationToX();
+			this->applySliceNumber(mOrientationSliceIndices.sagittalIndex);
 			break;
 		case ESliceOrientation::XZ:
-			mMapper->SetSliceNumber(mOrientationSliceIndices.coronalIndex);
+			mMapper->SetOrientationToY();
+			this->applySliceNumber(mOrientationSliceIndices.coronalIndex);
 			break;
 	}
 
 	// Update the data frame.
-	vtkNew<vtkOutlineFilter> frameFilter;
-	frameFilter->SetInputData(mImageData);
-	frameFilter->SetOutput(mDataFrame->getModelData());
-	frameFilter->Update();
+	if (!std::equal(bounds, bounds + 6, previousBounds)) {
+		vtkNew<vtkOutlineFilter> frameFilter;
+		frameFilter->SetInputData(mImageData);
+		frameFilter->SetOutput(mDataFrame->getModelData());
+		frameFilter->Update();
+	}
 
 	emit changedImageData(mImageData);
 	emit changedSliceIndices(this->getSliceMinIndex(), this->getSliceMaxIndex());
@@ -173,15 +217,15 @@ void ImageSlice::applyOrientationChange() {
 	switch (mOrientation.toInt()) {
 		case ESliceOrientation::XY:
 			mMapper->SetOrientationToZ();
-			mMapper->SetSliceNumber(mOrientationSliceIndices.transverseIndex);
+			this->applySliceNumber(mOrientationSliceIndices.transverseIndex);
 			break;
 		case ESliceOrientation::YZ:
 			mMapper->SetOrientationToX();
-			mMapper->SetSliceNumber(mOrientationSliceIndices.sagittalIndex);
+			this->applySliceNumber(mOrientationSliceIndices.sagittalIndex);
 			break;
 		case ESliceOrientation::XZ:
 			mMapper->SetOrientationToY();
-			mMapper->SetSliceNumber(mOrientationSliceIndices.coronalIndex);
+			this->applySliceNumber(mOrientationSliceIndices.coronalIndex);
 			break;
 	}
 	emit changedOrientation(mOrientation);
@@ -217,17 +261,17 @@ void ImageSlice::setSlice(const int& sliceIndex, const ESliceOrientation& orient
 		case ESliceOrientation::XY:
 			mMapper->SetOrientationToZ();
 			mOrientationSliceIndices.transverseIndex = sliceIndex;
-			mMapper->SetSliceNumber(mOrientationSliceIndices.transverseIndex);
+			this->applySliceNumber(mOrientationSliceIndices.transverseIndex);
 			break;
 		case ESliceOrientation::YZ:
 			mMapper->SetOrientationToX();
 			mOrientationSliceIndices.sagittalIndex = sliceIndex;
-			mMapper->SetSliceNumber(mOrientationSliceIndices.sagittalIndex);
+			this->applySliceNumber(mOrientationSliceIndices.sagittalIndex);
 			break;
 		case ESliceOrientation::XZ:
 			mMapper->SetOrientationToY();
 			mOrientationSliceIndices.coronalIndex = sliceIndex;
-			mMapper->SetSliceNumber(mOrientationSliceIndices.coronalIndex);
+			this->applySliceNumber(mOrientationSliceIndices.coronalIndex);
 			break;
 	}
 
@@ -245,7 +289,7 @@ void ImageSlice::setSliceIndex(const int& sliceIndex) {
 		return;
 	}
 
-	mMapper->SetSliceNumber(sliceIndex);
+	this->applySliceNumber(sliceIndex);
 
 	// Save the new index
 	switch (this->getSliceOrientation().toInt()) {
@@ -294,11 +338,19 @@ int ImageSlice::getSliceIndex() const {
 }
 
 int ImageSlice::getSliceMinIndex() const {
-	return mMapper->GetSliceNumberMinValue();
+	int axis = this->getSliceAxis();
+	if (axis == -1) {
+		return 0;
+	}
+	return mImageData->GetExtent()[2 * axis];
 }
 
 int ImageSlice::getSliceMaxIndex() const {
-	return mMapper->GetSliceNumberMaxValue();
+	int axis = this->getSliceAxis();
+	if (axis == -1) {
+		return 0;
+	}
+	return mImageData->GetExtent()[2 * axis + 1];
 }
 
 void ImageSlice::getSliceRange(int& min, int& max) const {
@@ -324,8 +376,8 @@ vtkSmartPointer<vtkPlane> ImageSlice::getSliceAsPlane() const {
 	vtkSmartPointer<vtkPlane> plane = vtkSmartPointer<vtkPlane>::New();
 	double normal[3] = {0.0, 0.0, 0.0};
 	double origin[3] = {0.0, 0.0, 0.0};
-	mMapper->GetInput()->GetOrigin(origin);
-	double* spacing = mMapper->GetInput()->GetSpacing();
+	mImageData->GetOrigin(origin);
+	double* spacing = mImageData->GetSpacing();
 	switch (this->getSliceOrientation().toInt()) {
 		case ESliceOrientation::XY:
 			origin[2] += this->getSliceIndex() * spacing[2];
@@ -362,13 +414,13 @@ bool ImageSlice::getVoxelCoordinates(const int& i, const int& j, const int& k, d
 
 	// if an index is out of range with their corresponding dimension, 
 	// they are bad
-	int* dims = mMapper->GetInput()->GetDimensions();
+	int* dims = mImageData->GetDimensions();
 	if (i >= dims[0] || j >= dims[1] || k >= dims[2]) {
 		return false;
 	}
 	
-	double* spacing = mMapper->GetInput()->GetSpacing();
-	double* origin = mMapper->GetInput()->GetOrigin();
+	double* spacing = mImageData->GetSpacing();
+	double* origin = mImageData->GetOrigin();
 
 	// Compute its (x, y, z) based on the data origin and spacing
 	x = origin[0] + i * spacing[0];
@@ -389,8 +441,8 @@ bool ImageSlice::getVoxelCoordinates(const int& i, const int& j, const int& k, d
 bool ImageSlice::getVoxelFromCoordinates(const double& x, const double& y, 
 	const double& z, int& i, int& j, int& k) const 
 {
-	double* spacing = mMapper->GetInput()->GetSpacing();
-	double* origin = mMapper->GetInput()->GetOrigin();
+	double* spacing = mImageData->GetSpacing();
+	double* origin = mImageData->GetOrigin();
 
 	// Transform global coordinate by the inverse of this Visual's transform. 
 	double coord[3] = {x, y, z};
@@ -409,7 +461,7 @@ bool ImageSlice::getVoxelFromCoordinates(const double& x, const double& y,
 
 	// if a calculated index is out of range with their corresponding dimension,
 	// they are bad
-	int* dims = mMapper->GetInput()->GetDimensions();
+	int* dims = mImageData->GetDimensions();
 	if (ii >= dims[0] || ij >= dims[1] || ik >= dims[2]) {
 		return false;
 	}
@@ -422,7 +474,7 @@ bool ImageSlice::getVoxelFromCoordinates(const double& x, const double& y,
 }
 
 void ImageSlice::calculateSliceIndices() {
-	int* dimensions = mMapper->GetInput()->GetDimensions();
+	int* dimensions = mImageData->GetDimensions();
 
 	if (mOrientationSliceIndices.transverseIndex >= dimensions[2]) {
 		mOrientationSliceIndices.transverseIndex = dimensions[2] / 2;
@@ -437,6 +489,32 @@ void ImageSlice::calculateSliceIndices() {
 	}
 }
 
+void ImageSlice::applySliceNumber(const int& sliceIndex) {
+	if (mImageData->isPartial()) {
+		mImageData->copySlice(sliceIndex, mOrientation, mSliceImage);
+		if (mMapper->GetInput() != mSliceImage.Get()) {
+			mMapper->SetInputData(mSliceImage);
+		}
+	} else if (mMapper->GetInput() == mSliceImage.Get()) {
+		// The data has its voxels now, e.g. a SeriesView made contiguous.
+		mMapper->SetInputData(mImageData);
+	}
+	mMapper->SetSliceNumber(sliceIndex);
+}
+
+int ImageSlice::getSliceAxis() const {
+	switch (mOrientation.toInt()) {
+		case ESliceOrientation::XY:
+			return 2;
+		case ESliceOrientation::YZ:
+			return 0;
+		case ESliceOrientation::XZ:
+			return 1;
+		default:
+			return -1;
+	}
+}
+
 void ImageSlice::onTransformChange() {
 	mDataFrame->setTransformData(this->getTransform());
 }
@@ -453,7 +531,27 @@ double ImageSlice::getOpacity() const {
 	return mActor->GetOpacity();
 }
 
+void ImageSlice::applyWindowLevel() {
+	// The property maps the native intensities when the slice is drawn.
+	double window, level;
+	mImageData->getWindowLevel(window, level);
+	mActor->GetProperty()->SetColorWindow(window);
+	mActor->GetProperty()->SetColorLevel(level);
+}
+
+void ImageSlice::onWindowLevelChanged() {
+	this->applyWindowLevel();
+
+	double window, level;
+	mImageData->getWindowLevel(window, level);
+	emit changedWindowLevel(window, level);
+}
+
 void ImageSlice::onDataUpdated() {
+	// The displayed slice of a partial ImageData is a copy, refresh it.
+	if (mImageData->isPartial() || mMapper->GetInput() == mSliceImage.Get()) {
+		this->applySliceNumber(this->getSliceIndex());
+	}
 	emit changedImageData(mImageData);
 }
 
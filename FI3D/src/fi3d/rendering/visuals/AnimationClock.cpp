@@ -0,0 +1,132 @@
+#include <fi3d/rendering/visuals/AnimationClock.h>
+
+#include <fi3d/logger/Logger.h>
+
+#include <fi3d/rendering/visuals/IAnimated.h>
+
+using namespace fi3d;
+
+/************************ Static Members ************************/
+QSharedPointer<AnimationClock> AnimationClock::INSTANCE = Q_NULLPTR;
+
+void AnimationClock::addAnimation(IAnimated* animation, const int& interval) {
+	if (animation == Q_NULLPTR) {
+		return;
+	}
+
+	AnimationClock* clock = AnimationClock::getInstance();
+
+	// The first frame is shown on the next interval boundary, the same one
+	// as every other animation with that interval.
+	AnimationTrack track;
+	track.Interval = qMax(1, interval);
+	track.Frame = clock->mClock.elapsed() / track.Interval;
+	clock->mAnimations.insert(animation, track);
+
+	clock->mTickTimer.stop();
+	clock->scheduleTick();
+}
+
+void AnimationClock::removeAnimation(IAnimated* animation) {
+	if (INSTANCE.isNull()) {
+		return;
+	}
+
+	INSTANCE->mAnimations.remove(animation);
+	if (INSTANCE->mAnimations.isEmpty()) {
+		INSTANCE->mTickTimer.stop();
+	}
+}
+
+bool AnimationClock::hasAnimation(IAnimated* animation) {
+	if (INSTANCE.isNull()) {
+		return false;
+	}
+
+	return INSTANCE->mAnimations.contains(animation);
+}
+
+AnimationStatistics AnimationClock::getStatistics() {
+	return AnimationClock::getInstance()->mStatistics;
+}
+
+void AnimationClock::resetStatistics() {
+	AnimationClock::getInstance()->mStatistics = AnimationStatistics();
+}
+
+AnimationClock* AnimationClock::getInstance() {
+	if (INSTANCE.isNull()) {
+		INSTANCE.reset(new AnimationClock());
+	}
+	return INSTANCE.data();
+}
+
+/************************ Singleton Members ************************/
+AnimationClock::AnimationClock()
+	: QObject(),
+	mAnimations(),
+	mTickTimer(),
+	mClock(),
+	mStatistics()
+{
+	mClock.start();
+	mTickTimer.setSingleShot(true);
+	mTickTimer.setTimerType(Qt::PreciseTimer);
+	QObject::connect(
+		&mTickTimer, &QTimer::timeout,
+		this, &AnimationClock::tick);
+}
+
+AnimationClock::~AnimationClock() {}
+
+void AnimationClock::tick() {
+	qint64 now = mClock.elapsed();
+
+	// Advancing may start or stop animations, so work on a snapshot.
+	QList<IAnimated*> animations = mAnimations.keys();
+	bool hasAdvanced = false;
+	for (IAnimated* animation : animations) {
+		QHash<IAnimated*, AnimationTrack>::iterator it = mAnimations.find(animation);
+		if (it == mAnimations.end()) {
+			continue;
+		}
+
+		qint64 frame = now / it->Interval;
+		int frameCount = (int)(frame - it->Frame);
+		if (frameCount <= 0) {
+			continue;
+		}
+
+		it->Frame = frame;
+		mStatistics.FrameCount++;
+		mStatistics.DroppedCount += frameCount - 1;
+		hasAdvanced = true;
+
+		animation->advanceAnimation(frameCount);
+	}
+
+	if (hasAdvanced) {
+		mStatistics.TickCount++;
+		emit advanced();
+	}
+
+	this->scheduleTick();
+}
+
+void AnimationClock::scheduleTick() {
+	if (mAnimations.isEmpty() || mTickTimer.isActive()) {
+		return;
+	}
+
+	qint64 now = mClock.elapsed();
+	qint64 nextTick = -1;
+	QHash<IAnimated*, AnimationTrack>::const_iterator it = mAnimations.constBegin();
+	for (; it != mAnimations.constEnd(); it++) {
+		qint64 due = (it->Frame + 1) * it->Interval;
+		if (nextTick < 0 || due < nextTick) {
+			nextTick = due;
+		}
+	}
+
+	mTickTimer.start((int)qMax((qint64)0, nextTick - now));
+}
@@ -47,15 +47,13 @@ void Server::sendMessage(MessagePtr message, const QString& clientID) {
 
 	QJsonDocument doc(*message->getInfo().data());
 	QByteArray info = doc.toJson(QJsonDocument::JsonFormat::Compact);
-	QByteArray header = Server::createHeader(info.count(), message->hasPayload(), message->getPayload()->count());
 
 	qDebug() << "Sending Message to" << clientID << "with Info=\n" << info;
 
-	client->write(header);
-	client->write(info);
-	if (message->hasPayload()) {
-		client->write(*message->getPayload().data());
-	}
+	client->writeMessage(info, message->hasPayload() ? message->getPayload().data() : Q_NULLPTR);
+
+	INSTANCE->mTrafficRecorder.recordOutbound(clientID, info,
+		message->hasPayload() ? message->getPayload().data() : Q_NULLPTR);
 	qDebug() << "Exit";
 }
 
@@ -69,12 +67,11 @@ void Server::sendMessage(const QJsonObject& message, const QString& clientID) {
 
 	QJsonDocument doc(message);
 	QByteArray info = doc.toJson(QJsonDocument::JsonFormat::Compact);
-	QByteArray header = Server::createHeader(info.count());
 
 	qDebug() << "Sending Message to" << clientID << "with Info=\n" << info;
 
-	client->write(header);
-	client->write(info);
+	client->writeMessage(info);
+	INSTANCE->mTrafficRecorder.recordOutbound(clientID, info);
 	qDebug() << "Exit";
 }
 
@@ -91,18 +88,16 @@ void Server::sendSelectMessage(MessagePtr message, const QVector<QString>& clien
 
 	QJsonDocument doc(*message->getInfo().data());
 	QByteArray info = doc.toJson(QJsonDocument::JsonFormat::Compact);
-	QByteArray header = Server::createHeader(info.count(), message->hasPayload(), message->getPayload()->count());
 
 	qDebug() << "Sending Message to " << clientIDs.count() << " clients with Info=\n" << info;
 
 	for (int i = 0; i < clientIDs.size(); i++) {
 		FrameworkInterface* client = INSTANCE->mAuthenticatedClients.value(clientIDs.at(i), Q_NULLPTR);
 		if (client != Q_NULLPTR) {
-			client->write(header);
-			client->write(info);
-			if (message->hasPayload()) {
-				client->write(*message->getPayload().data());
-			}
+			client->writeMessage(info, message->hasPayload() ? message->getPayload().data() : Q_NULLPTR);
+
+			INSTANCE->mTrafficRecorder.recordOutbound(clientIDs.at(i), info,
+				message->hasPayload() ? message->getPayload().data() : Q_NULLPTR);
 		} else {
 			qWarning() << "Failed to send message to" << clientIDs.at(i) << "because the client was not found.";
 		}
@@ -118,15 +113,14 @@ void Server::sendSelectMessage(const QJsonObject& message, const QVector<QString
 
 	QJsonDocument doc(message);
 	QByteArray info = doc.toJson(QJsonDocument::JsonFormat::Compact);
-	QByteArray header = Server::createHeader(info.count());
 
 	qDebug() << "Sending Message to " << clientIDs.count() << " clients with Info=\n" << info;
 
 	for (int i = 0; i < clientIDs.size(); i++) {
 		FrameworkInterface* client = INSTANCE->mAuthenticatedClients.value(clientIDs.at(i), Q_NULLPTR);
 		if (client != Q_NULLPTR) {
-			client->write(header);
-			client->write(info);
+			client->writeMessage(info);
+			INSTANCE->mTrafficRecorder.recordOutbound(clientIDs.at(i), info);
 		} else {
 			qWarning() << "Failed to send message to" << clientIDs.at(i) << "because the client was not found.";
 		}
@@ -147,17 +141,15 @@ void Server::sendGlobalMessage(MessagePtr message) {
 
 	QJsonDocument doc(*message->getInfo().data());
 	QByteArray info = doc.toJson(QJsonDocument::JsonFormat::Compact);
-	QByteArray header = Server::createHeader(info.count(), message->hasPayload(), message->getPayload()->count());
 
 	qDebug() << "Sending Message to all clients with Info=\n" << info;
 
 	QHash<QString, FrameworkInterface*>::iterator it = INSTANCE->mAuthenticatedClients.begin();
 	for (; it != INSTANCE->mAuthenticatedClients.end(); it++) {
-		it.value()->write(header);
-		it.value()->write(info);
-		if (message->hasPayload()) {
-			it.value()->write(*message->getPayload().data());
-		}
+		it.value()->writeMessage(info, message->hasPayload() ? message->getPayload().data() : Q_NULLPTR);
+
+		INSTANCE->mTrafficRecorder.recordOutbound(it.key(), info,
+			message->hasPayload() ? message->getPayload().data() : Q_NULLPTR);
 	}
 	qDebug() << "Exit";
 }
@@ -170,14 +162,13 @@ void Server::sendGlobalMessage(const QJsonObject& message) {
 
 	QJsonDocument doc(message);
 	QByteArray info = doc.toJson(QJsonDocument::JsonFormat::Compact);
-	QByteArray header = Server::createHeader(info.count());
 
 	qDebug() << "Sending Message to all clients with Info=\n" << info;
 
 	QHash<QString, FrameworkInterface*>::iterator it = INSTANCE->mAuthenticatedClients.begin();
 	for (; it != INSTANCE->mAuthenticatedClients.end(); it++) {
-		it.value()->write(header);
-		it.value()->write(info);
+		it.value()->writeMessage(info);
+		INSTANCE->mTrafficRecorder.recordOutbound(it.key(), info);
 	}
 	qDebug() << "Exit";
 }
@@ -211,10 +202,55 @@ int Server::getUnidentifiedCount() {
 	return INSTANCE->mUnauthenticatedClients.size();
 }
 
+QHostAddress Server::getClientAddress(const QString& clientID) {
+	FrameworkInterface* client = INSTANCE->mAuthenticatedClients.value(clientID, Q_NULLPTR);
+	if (client == Q_NULLPTR) {
+		return QHostAddress();
+	}
+	// The socket lives in a network thread, so only the cached address is read.
+	return client->getAcceptedPeerAddress();
+}
+
 const Server* Server::getInstance() {
 	return INSTANCE.data();
 }
 
+bool Server::startTrafficCapture(const QString& filePath, const bool& includePayloads) {
+	qDebug() << "Enter";
+	if (!INSTANCE->mTrafficRecorder.open(filePath, includePayloads)) {
+		INSTANCE->mDialog->updateTrafficCapture(false, "");
+		qDebug() << "Exit - Failed to open the capture";
+		return false;
+	}
+
+	// Clients connected before the capture are announced so that the replay
+	// can open their connections.
+	QHash<QString, FrameworkInterface*>::iterator it = INSTANCE->mAuthenticatedClients.begin();
+	for (; it != INSTANCE->mAuthenticatedClients.end(); it++) {
+		INSTANCE->mTrafficRecorder.recordConnected(it.key());
+	}
+	it = INSTANCE->mUnauthenticatedClients.begin();
+	for (; it != INSTANCE->mUnauthenticatedClients.end(); it++) {
+		INSTANCE->mTrafficRecorder.recordConnected(it.key());
+	}
+
+	INSTANCE->mDialog->updateTrafficCapture(true, filePath);
+	qInfo() << "Capturing server traffic to" << filePath;
+	qDebug() << "Exit";
+	return true;
+}
+
+void Server::stopTrafficCapture() {
+	qDebug() << "Enter";
+	INSTANCE->mTrafficRecorder.close();
+	INSTANCE->mDialog->updateTrafficCapture(false, "");
+	qDebug() << "Exit";
+}
+
+bool Server::isCapturingTraffic() {
+	return INSTANCE->mTrafficRecorder.isOpen();
+}
+
 /************************ Singleton Members ************************/
 Server::Server()
 	: mIPAddress("Server Down"),
@@ -222,7 +258,8 @@ Server::Server()
 	mPassword("admin"),
 	mAuthenticatedClients(),
 	mUnauthenticatedClients(),
-	mDeviceCount(0)
+	mDeviceCount(0),
+	mTrafficRecorder()
 {
 	mDialog.reset(new ServerDialog(mIPAddress, mPort, mPassword, 
 		mAuthenticatedClients.count(), mUnauthenticatedClients.count()));
@@ -230,6 +267,16 @@ Server::Server()
 	QObject::connect(
 		mDialog.data(), &ServerDialog::changePassword, 
 		this, &Server::setPassword);
+	QObject::connect(
+		mDialog.data(), &ServerDialog::startTrafficCapture,
+		[=](const QString& filePath, const bool& includePayloads) {
+			Server::startTrafficCapture(filePath, includePayloads);
+		});
+	QObject::connect(
+		mDialog.data(), &ServerDialog::stopTrafficCapture,
+		[=]() {
+			Server::stopTrafficCapture();
+		});
 
 	this->startServer(mPort);
 
@@ -251,18 +298,20 @@ void Server::stopServer() {
 	qDebug() << "Enter";
 	QHash<QString, FrameworkInterface*>::iterator it = mAuthenticatedClients.begin();
 	for (; it != mAuthenticatedClients.end(); it++){
-		it.value()->close();
+		it.value()->closeConnection();
 	}
 
 	it = mUnauthenticatedClients.begin();
 	for (; it != mUnauthenticatedClients.end(); it++) {
-		it.value()->close();
+		it.value()->closeConnection();
 	}
 
 	mAuthenticatedClients.clear();
 	mUnauthenticatedClients.clear();
 	
 	this->close();
+	mTrafficRecorder.close();
+	mDialog->updateTrafficCapture(false, "");
 
 	mDialog->updateServerIP("Server Down");
 	mDialog->updateServerPort(mPort);
@@ -327,6 +376,11 @@ void Server::authenticateConnection(const QString& clientID, const QString& pass
 void Server::onNewConnection() {
 	qDebug() << "Enter";
 	FrameworkInterface* fiSocket = qobject_cast<FrameworkInterface*>(this->nextPendingConnection());
+	if (fiSocket == Q_NULLPTR) {
+		// Sockets are announced again once their network thread set them up.
+		qDebug() << "Exit - No connection ready";
+		return;
+	}
 
 	QString FIID = tr("HMD-%1").arg(mDeviceCount++);
 	fiSocket->setFIID(FIID);
@@ -340,6 +394,7 @@ void Server::onNewConnection() {
 
 	mUnauthenticatedClients.insert(FIID, fiSocket);
 	mDialog->updateUnidentifiedConnections(mUnauthenticatedClients.count());
+	mTrafficRecorder.recordConnected(FIID);
 
 	QJsonObject authResponse{
 		{RESPONSE_STATUS, EResponseStatus::INFO_REQUIRED},
@@ -347,11 +402,14 @@ void Server::onNewConnection() {
 		{CLIENT_ID, FIID},
 		{MESSAGE, ""}
 	};
+	// Local FIs offer the shared memory transport only once it is advertised.
+	if (fiSocket->isLocalTransportEnabled()) {
+		authResponse.insert(LOCAL_TRANSPORT, "Available");
+	}
 	QJsonDocument doc(authResponse);
 	QByteArray info = doc.toJson(QJsonDocument::JsonFormat::Compact);
-	QByteArray header = Server::createHeader(info.count());
-	fiSocket->write(header);
-	fiSocket->write(info);
+	fiSocket->writeMessage(info);
+	mTrafficRecorder.recordOutbound(FIID, info);
 	
 	//TODO: Connect to a timer that deletes this connection if they don't 
 	//provide password after some time
@@ -382,6 +440,7 @@ void Server::onCloseConnection() {
 
 	mAuthenticatedClients.remove(FIID);
 	mUnauthenticatedClients.remove(FIID);
+	mTrafficRecorder.recordDisconnected(FIID);
 	
 	mDialog->updateConnectedDevices(mAuthenticatedClients.count());
 	mDialog->updateUnidentifiedConnections(mUnauthenticatedClients.count());
@@ -412,6 +471,8 @@ void Server::onMessage(MessagePtr message) {
 		return;
 	}
 
+	mTrafficRecorder.recordInbound(fi->getFIID(), message);
+
 	QSharedPointer<QJsonObject> info = message->getInfo();
 
 	qDebug() << "New request from: " << fi->getFIID() << "\n" << *info.data();
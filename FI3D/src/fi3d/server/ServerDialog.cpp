@@ -1,5 +1,10 @@
 #include <fi3d/server/ServerDialog.h>
 
+#include <fi3d/FI3D/FI3D.h>
+
+#include <QDateTime>
+#include <QFileDialog>
+#include <QFileInfo>
 #include <QInputDialog>
 
 using namespace fi3d;
@@ -7,7 +12,8 @@ using namespace fi3d;
 ServerDialog::ServerDialog(const QString& ip, const int& port, 
 	const QString& password, const int& connections, 
 	const int& unidentifiedConnections)
-	: QDialog()
+	: QDialog(),
+	mIsCapturingTraffic(false)
 {
 	ui.setupUi(this);
 	ui.serverAddress_label->setText(ip);
@@ -20,6 +26,9 @@ ServerDialog::ServerDialog(const QString& ip, const int& port,
 	QObject::connect(
 		ui.changePassword_button, &QPushButton::clicked, 
 		this, &ServerDialog::onChangePasswordClick); //
+	QObject::connect(
+		ui.trafficCapture_button, &QPushButton::clicked,
+		this, &ServerDialog::onTrafficCaptureClick);
 }
 
 ServerDialog::~ServerDialog() {}
@@ -35,6 +44,23 @@ void ServerDialog::onChangePasswordClick() {
 	}
 }
 
+void ServerDialog::onTrafficCaptureClick() {
+	if (mIsCapturingTraffic) {
+		emit stopTrafficCapture();
+		return;
+	}
+
+	QString defaultPath = tr("%1/FI3D/traffic_%2.fi3dcap")
+		.arg(FI3D::DATA_DIRECTORY)
+		.arg(QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss"));
+	QString filePath = QFileDialog::getSaveFileName(this, tr("Save traffic capture"),
+		defaultPath, tr("Traffic Capture (*.fi3dcap)"));
+
+	if (!filePath.isEmpty()) {
+		emit startTrafficCapture(filePath, ui.capturePayloads_checkBox->isChecked());
+	}
+}
+
 void ServerDialog::updateServerIP(const QString& ip) {
 	ui.serverAddress_label->setText(ip);
 }
@@ -54,3 +80,11 @@ void ServerDialog::updateConnectedDevices(const int& count) {
 void ServerDialog::updateUnidentifiedConnections(const int& count) {
 	ui.unidentifiedDevices_label->setText(tr("%1").arg(count));
 }
+
+void ServerDialog::updateTrafficCapture(const bool& isCapturing, const QString& filePath) {
+	mIsCapturingTraffic = isCapturing;
+	ui.trafficCapture_label->setText(isCapturing ? QFileInfo(filePath).fileName() : tr("Off"));
+	ui.trafficCapture_label->setToolTip(filePath);
+	ui.trafficCapture_button->setText(isCapturing ? tr("Stop") : tr("Start"));
+	ui.capturePayloads_checkBox->setEnabled(!isCapturing);
+}
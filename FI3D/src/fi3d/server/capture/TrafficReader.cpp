@@ -0,0 +1,109 @@
+#include <fi3d/server/capture/TrafficReader.h>
+
+#include <QDebug>
+
+using namespace fi3d;
+
+TrafficReader::TrafficReader()
+	: mFile(),
+	mStream(),
+	mStartTime(0),
+	mIncludesPayloads(false),
+	mClientIDs()
+{}
+
+TrafficReader::~TrafficReader() {
+	this->close();
+}
+
+bool TrafficReader::open(const QString& filePath) {
+	qDebug() << "Enter - Reading traffic capture" << filePath;
+	this->close();
+
+	mFile.setFileName(filePath);
+	if (!mFile.open(QIODevice::ReadOnly)) {
+		qWarning() << "Failed to open traffic capture" << filePath << "because:" << mFile.errorString();
+		return false;
+	}
+
+	mStream.setDevice(&mFile);
+	mStream.setByteOrder(QDataStream::LittleEndian);
+	mStream.setVersion(QDataStream::Qt_6_0);
+
+	quint32 magic = 0;
+	quint16 version = 0;
+	quint8 includesPayloads = 0;
+	mStream >> magic >> version >> mStartTime >> includesPayloads;
+	if (mStream.status() != QDataStream::Ok || magic != TRAFFIC_CAPTURE_MAGIC) {
+		qWarning() << filePath << "is not a traffic capture.";
+		this->close();
+		return false;
+	}
+	if (version != TRAFFIC_CAPTURE_VERSION) {
+		qWarning() << "Traffic capture version" << version << "is not supported.";
+		this->close();
+		return false;
+	}
+	mIncludesPayloads = includesPayloads != 0;
+
+	qDebug() << "Exit";
+	return true;
+}
+
+void TrafficReader::close() {
+	mStream.setDevice(Q_NULLPTR);
+	mFile.close();
+	mClientIDs.clear();
+}
+
+bool TrafficReader::atEnd() const {
+	return !mFile.isOpen() || mFile.atEnd();
+}
+
+bool TrafficReader::readNext(TrafficRecord& record) {
+	if (this->atEnd()) {
+		return false;
+	}
+
+	quint8 event = 0;
+	quint16 clientIndex = 0;
+	mStream >> event >> record.Timestamp >> clientIndex;
+	record.Event = event;
+	record.Info.clear();
+	record.PayloadLength = 0;
+	record.Payload.clear();
+
+	if (event == TRAFFIC_CONNECTED) {
+		mStream >> record.ClientID;
+		if (clientIndex >= mClientIDs.count()) {
+			mClientIDs.resize(clientIndex + 1);
+		}
+		mClientIDs[clientIndex] = record.ClientID;
+	} else {
+		record.ClientID = mClientIDs.value(clientIndex);
+	}
+
+	if (event == TRAFFIC_INBOUND || event == TRAFFIC_OUTBOUND) {
+		mStream >> record.Info >> record.PayloadLength;
+		if (mIncludesPayloads && record.PayloadLength > 0) {
+			record.Payload.resize(record.PayloadLength);
+			mStream.readRawData(record.Payload.data(), record.PayloadLength);
+		}
+	}
+
+	// A capture that was not closed properly may end with a partial record.
+	if (mStream.status() != QDataStream::Ok) {
+		qWarning() << "Traffic capture is truncated, stopping at the last complete record.";
+		this->close();
+		return false;
+	}
+	return true;
+}
+
+qint64 TrafficReader::getStartTime() const {
+	return mStartTime;
+}
+
+bool TrafficReader::includesPayloads() const {
+	return mIncludesPayloads;
+}
@@ -0,0 +1,144 @@
+#include <fi3d/server/capture/TrafficRecorder.h>
+
+#include <QDateTime>
+#include <QDebug>
+#include <QJsonDocument>
+
+using namespace fi3d;
+
+TrafficRecorder::TrafficRecorder()
+	: mFile(),
+	mStream(),
+	mClock(),
+	mIncludePayloads(false),
+	mClientIndices()
+{}
+
+TrafficRecorder::~TrafficRecorder() {
+	this->close();
+}
+
+bool TrafficRecorder::open(const QString& filePath, const bool& includePayloads) {
+	qDebug() << "Enter - Capturing traffic to" << filePath;
+	this->close();
+
+	mFile.setFileName(filePath);
+	if (!mFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+		qWarning() << "Failed to open traffic capture" << filePath << "because:" << mFile.errorString();
+		return false;
+	}
+
+	mStream.setDevice(&mFile);
+	mStream.setByteOrder(QDataStream::LittleEndian);
+	mStream.setVersion(QDataStream::Qt_6_0);
+
+	mIncludePayloads = includePayloads;
+	mClientIndices.clear();
+
+	mStream << TRAFFIC_CAPTURE_MAGIC;
+	mStream << TRAFFIC_CAPTURE_VERSION;
+	mStream << QDateTime::currentMSecsSinceEpoch();
+	mStream << (quint8)mIncludePayloads;
+	mClock.start();
+
+	qDebug() << "Exit";
+	return true;
+}
+
+void TrafficRecorder::close() {
+	if (!mFile.isOpen()) {
+		return;
+	}
+
+	mStream.setDevice(Q_NULLPTR);
+	mFile.close();
+	mClientIndices.clear();
+	qInfo() << "Traffic capture saved to" << mFile.fileName();
+}
+
+bool TrafficRecorder::isOpen() const {
+	return mFile.isOpen();
+}
+
+QString TrafficRecorder::getFilePath() const {
+	return mFile.fileName();
+}
+
+void TrafficRecorder::flush() {
+	if (mFile.isOpen()) {
+		mFile.flush();
+	}
+}
+
+void TrafficRecorder::recordConnected(const QString& clientID) {
+	if (!mFile.isOpen() || mClientIndices.contains(clientID)) {
+		return;
+	}
+
+	// The client is indexed by the next index, the ID itself is only written
+	// in this record.
+	mClientIndices.insert(clientID, (quint16)mClientIndices.count());
+	this->writeRecordHeader(TRAFFIC_CONNECTED, clientID);
+	mStream << clientID;
+}
+
+void TrafficRecorder::recordDisconnected(const QString& clientID) {
+	if (!mFile.isOpen()) {
+		return;
+	}
+
+	this->writeRecordHeader(TRAFFIC_DISCONNECTED, clientID);
+	mFile.flush();
+}
+
+void TrafficRecorder::recordInbound(const QString& clientID, MessagePtr message) {
+	if (!mFile.isOpen() || message.isNull()) {
+		return;
+	}
+
+	QByteArray info = QJsonDocument(*message->getInfo().data()).toJson(QJsonDocument::JsonFormat::Compact);
+	this->writeMessage(TRAFFIC_INBOUND, clientID, info,
+		message->hasPayload() ? message->getPayload().data() : Q_NULLPTR);
+}
+
+void TrafficRecorder::recordInbound(const QString& clientID, const QByteArray& info, const QByteArray* payload) {
+	this->writeMessage(TRAFFIC_INBOUND, clientID, info, payload);
+}
+
+void TrafficRecorder::recordOutbound(const QString& clientID, const QByteArray& info, const QByteArray* payload) {
+	this->writeMessage(TRAFFIC_OUTBOUND, clientID, info, payload);
+}
+
+void TrafficRecorder::writeRecordHeader(const int& event, const QString& clientID) {
+	// Clients that connected before the capture started are announced the
+	// first time they are seen.
+	if (!mClientIndices.contains(clientID)) {
+		this->recordConnected(clientID);
+	}
+
+	mStream << (quint8)event;
+	mStream << (qint64)(mClock.nsecsElapsed() / 1000);
+	mStream << mClientIndices.value(clientID);
+}
+
+void TrafficRecorder::writeMessage(const int& event, const QString& clientID,
+	const QByteArray& info, const QByteArray* payload)
+{
+	if (!mFile.isOpen()) {
+		return;
+	}
+
+	qint32 payloadLength = payload != Q_NULLPTR ? payload->count() : 0;
+
+	this->writeRecordHeader(event, clientID);
+	mStream << info;
+	mStream << payloadLength;
+	if (mIncludePayloads && payloadLength > 0) {
+		mStream.writeRawData(payload->constData(), payloadLength);
+	}
+
+	if (mStream.status() != QDataStream::Ok) {
+		qWarning() << "Failed to write to traffic capture, closing it.";
+		this->close();
+	}
+}
@@ -9,6 +9,9 @@ const QString fi3d::APPLICATION_PARAMS = "ApplicationParams";
 const QString fi3d::MODULE_PARAMS = "ModuleParams";
 const QString fi3d::DATA_PARAMS = "DataParams";
 const QString fi3d::ERROR_CODE = "ErrorCode";
+const QString fi3d::LOCAL_TRANSPORT = "LocalTransport";
+const QString fi3d::SEGMENT_KEY = "SegmentKey";
+const QString fi3d::TRANSPORT_NONCE = "TransportNonce";
 
 const QString fi3d::ACTION_TYPE = "ActionType";
 const QString fi3d::MODULE_NAME = "ModuleName";
@@ -20,6 +23,13 @@ const QString fi3d::ACTIVE_MODULES = "ActiveModules";
 const QString fi3d::MODULE_ID = "ModuleID";
 const QString fi3d::REQUEST_ID = "RequestID";
 const QString fi3d::TARGET_VISUAL = "TargetVisual";
+const QString fi3d::TARGET_HANDLE = "TargetHandle";
+const QString fi3d::USE_HANDLES = "UseHandles";
+const QString fi3d::USE_POSE_STREAM = "UsePoseStream";
+const QString fi3d::POSE_PORT = "PosePort";
+const QString fi3d::SCENE_VERSION = "SceneVersion";
+const QString fi3d::SCENE_EPOCH = "SceneEpoch";
+const QString fi3d::SCENE_SNAPSHOT = "SceneSnapshot";
 const QString fi3d::IS_VISIBLE = "Visible";
 const QString fi3d::TRANSLATE = "Translate";
 const QString fi3d::ROTATE = "Rotate";
@@ -35,6 +45,7 @@ const QString fi3d::SCENE_ID = "SceneID";
 const QString fi3d::VISUALS_INFO = "VisualsInfo";
 const QString fi3d::MODULE_INTERACTIONS = "ModuleInteractions";
 const QString fi3d::ID = "ID";
+const QString fi3d::HANDLE = "Handle";
 const QString fi3d::TYPE = "Type";
 const QString fi3d::VALUE = "Value";
 const QString fi3d::CONSTRAINT = "Constraint";
@@ -47,6 +58,8 @@ const QString fi3d::OPACITY = "Opacity";
 const QString fi3d::TRANSFORMATION = "Transformation";
 const QString fi3d::PARENT_ID = "ParentID";
 const QString fi3d::DATA_ID = "DataID";
+const QString fi3d::DATA_HANDLE = "DataHandle";
+const QString fi3d::POSE_RECORD_COUNT = "PoseRecordCount";
 const QString fi3d::DATA_NAME = "DataName";
 const QString fi3d::DATA_TYPE = "DataType";
 const QString fi3d::COLOR = "Color";
@@ -57,14 +70,21 @@ const QString fi3d::UPDATE_CONSTRAINT = "UpdateConstraint";
 
 const QString fi3d::DATA = "Data";
 const QString fi3d::CACHEABLE = "Cacheable";
+const QString fi3d::DATA_VERSION = "DataVersion";
+const QString fi3d::CHANGED_EXTENT = "ChangedExtent";
+const QString fi3d::CHANGED_SINCE_VERSION = "ChangedSinceVersion";
 const QString fi3d::SERIES_COUNT = "SeriesCount";
 const QString fi3d::DIMENSIONS = "Dimensions";
 const QString fi3d::ORIGIN = "Origin";
 const QString fi3d::SPACING = "Spacing";
 const QString fi3d::DATA_FORMAT = "DataFormat";
+const QString fi3d::WINDOW_WIDTH = "WindowWidth";
+const QString fi3d::WINDOW_CENTER = "WindowCenter";
 const QString fi3d::VALUES = "Values";
 const QString fi3d::POINTS = "Points";
 const QString fi3d::LINE_INDICES = "LineIndices";
 const QString fi3d::TRIANGLE_INDICES = "TriangleIndices";
 const QString fi3d::PAYLOAD_POINTS_LENGTH = "PayloadPointsLength";
 const QString fi3d::PAYLOAD_TRIANGLES_LENGTH = "PayloadTrianglesLength";
+const QString fi3d::DATA_REQUEST_ID = "DataRequestID";
+const QString fi3d::CANCEL_DATA_REQUESTS = "CancelDataRequests";
@@ -1,26 +1,82 @@
 #include <fi3d/server/network/ClientFI3D.h>
 
+#include <fi3d/server/message_keys/MessageKeys.h>
+
+#include <QAtomicInt>
+#include <QCoreApplication>
 #include <QJsonDocument>
+#include <QMetaObject>
+#include <QSharedMemory>
+#include <QThread>
+#include <QUuid>
 #include <QtEndian>
 
+#include <cstring>
+
 using namespace fi3d;
 
 ClientFI3D::ClientFI3D()
 	: ClientTCP(),
 	mReadPayloadFlag(false),
+	mPayloadFlag(NO_PAYLOAD),
 	mHasPayload(false),
 	mInfoLength(-1),
 	mPayloadLength(-1),
 	mReceivingMessage(new Message()),
-	mReceivingBytes()
+	mReceivingBytes(),
+	mIsLocalTransportEnabled(true),
+	mIsSharingPayloads(false),
+	mProbeSegment(),
+	mProbeNonce(),
+	mSharedSegments(),
+	mFreeSegments()
 {
 	QObject::connect(
 		this, &ClientFI3D::readyRead,
 		this, &ClientFI3D::onPacket);
+	QObject::connect(
+		this, &ClientFI3D::disconnected,
+		this, &ClientFI3D::onDisconnected);
 }
 
 ClientFI3D::~ClientFI3D() {}
 
+void ClientFI3D::writeMessage(const QByteArray& info, const QByteArray* payload) {
+	if (QThread::currentThread() != this->thread()) {
+		// The byte arrays are implicitly shared, so queuing does not copy them.
+		bool hasPayload = payload != Q_NULLPTR;
+		QByteArray queuedPayload = hasPayload ? *payload : QByteArray();
+		QMetaObject::invokeMethod(this, [this, info, hasPayload, queuedPayload]() {
+			this->writeMessage(info, hasPayload ? &queuedPayload : Q_NULLPTR);
+		}, Qt::QueuedConnection);
+		return;
+	}
+
+	if (payload == Q_NULLPTR) {
+		this->writeFrame(NO_PAYLOAD, info, QByteArray());
+		return;
+	}
+
+	if (mIsSharingPayloads && payload->count() >= SHARED_PAYLOAD_THRESHOLD &&
+		this->writeSharedPayload(info, *payload))
+	{
+		return;
+	}
+	this->writeFrame(INLINE_PAYLOAD, info, *payload);
+}
+
+void ClientFI3D::setLocalTransportEnabled(const bool& isEnabled) {
+	mIsLocalTransportEnabled = isEnabled;
+}
+
+bool ClientFI3D::isLocalTransportEnabled() const {
+	return mIsLocalTransportEnabled;
+}
+
+bool ClientFI3D::isSharingPayloads() const {
+	return mIsSharingPayloads;
+}
+
 void ClientFI3D::sendMessage(MessagePtr message) {
 	qDebug() << "Enter";
 	QSharedPointer<QJsonObject> infoJson = message->getInfo();
@@ -28,33 +84,10 @@ void ClientFI3D::sendMessage(MessagePtr message) {
 	QByteArray info = doc.toJson(QJsonDocument::JsonFormat::Compact);
 
 	QSharedPointer<QByteArray> payload = message->getPayload();
-
-	int infoCount = info.count();
-	int payloadCount = payload->count();
-
-	int byteCount = sizeof(qint32) + 1;
-	byteCount += infoCount;
-	if (message->hasPayload()) {
-		byteCount += sizeof(qint32);
-	}
-
-	QByteArray bytes;
-	bytes.reserve(byteCount);
-
-	bytes.append(message->hasPayload());
-	bytes.append((const char*)&infoCount, sizeof(qint32));
-	if (message->hasPayload()) {
-		bytes.append((const char*)&payloadCount, sizeof(qint32));
-	}
-	bytes.append(info);
-
-	this->write(bytes);
-	if (message->hasPayload()) {
-		this->write(*payload.data());
-	}
+	this->writeMessage(info, message->hasPayload() ? payload.data() : Q_NULLPTR);
 
 	qDebug() << "Message sent: WithPayload=" << message->hasPayload() <<
-		"InfoLen=" << infoCount << ", PayloadLen=" << payloadCount;
+		"InfoLen=" << info.count() << ", PayloadLen=" << payload->count();
 	qDebug() << "Exit";
 }
 
@@ -63,8 +96,10 @@ void ClientFI3D::onPacket() {
 	int packetSize = this->bytesAvailable();
 	qDebug() << "Available bytes:" << packetSize;
 	while (packetSize != 0) {
+		bool isDelivered = true;
 		if (!mReadPayloadFlag) {
-			mHasPayload = (bool)this->read(1).at(0);
+			mPayloadFlag = (quint8)this->read(1).at(0);
+			mHasPayload = mPayloadFlag == INLINE_PAYLOAD || mPayloadFlag == SHARED_PAYLOAD;
 			mReadPayloadFlag = true;
 
 			qDebug() << "New message being received. Payload=" << mHasPayload;
@@ -141,7 +176,13 @@ void ClientFI3D::onPacket() {
 			packetSize -= receivedBytes.count();
 
 			mReceivingBytes.append(receivedBytes);
-			if (mPayloadLength == 0) {
+			if (mPayloadLength == 0 && mPayloadFlag == SHARED_PAYLOAD) {
+				isDelivered = this->readSharedPayload(mReceivingBytes);
+				if (!this->isOpen()) {
+					qDebug() << "Exit";
+					return;
+				}
+			} else if (mPayloadLength == 0) {
 				QSharedPointer<QByteArray> payload(new QByteArray(mReceivingBytes));
 				mReceivingMessage->setPayloadAndKeepInfo(payload);
 				qDebug() << "New message payload fully received:" << payload->count();
@@ -150,10 +191,18 @@ void ClientFI3D::onPacket() {
 			}
 		}
 
-		qDebug() << "Message fully received";
-		emit messageReceived(mReceivingMessage);
+		if (mPayloadFlag == TRANSPORT_CONTROL) {
+			this->onTransportControl(*mReceivingMessage->getInfo().data());
+		} else if (isDelivered) {
+			qDebug() << "Message fully received";
+			if (mReceivingMessage->getInfo()->value(LOCAL_TRANSPORT).toString("") == "Available") {
+				this->offerLocalTransport();
+			}
+			emit messageReceived(mReceivingMessage);
+		}
 
 		mReadPayloadFlag = false;
+		mPayloadFlag = NO_PAYLOAD;
 		mHasPayload = false;
 		mInfoLength = -1;
 		mPayloadLength = -1;
@@ -161,4 +210,214 @@ void ClientFI3D::onPacket() {
 		mReceivingBytes.clear();
 	}
 	qDebug() << "Exit";
-}
\ No newline at end of file
+}
+
+void ClientFI3D::offerLocalTransport() {
+	if (!mIsLocalTransportEnabled || mIsSharingPayloads || !mProbeSegment.isNull() ||
+		!this->isLocalPeer())
+	{
+		return;
+	}
+
+	// The peer proves it can map the segments by answering with the nonce.
+	mProbeNonce = QUuid::createUuid().toRfc4122();
+	mProbeSegment.reset(new QSharedMemory(ClientFI3D::createSegmentKey(mProbeNonce)));
+	if (!mProbeSegment->create(mProbeNonce.count())) {
+		qWarning() << "Failed to offer the local transport because:" << mProbeSegment->errorString();
+		mProbeSegment.reset();
+		return;
+	}
+	std::memcpy(mProbeSegment->data(), mProbeNonce.constData(), mProbeNonce.count());
+
+	QJsonObject offer;
+	offer.insert(LOCAL_TRANSPORT, "Offer");
+	offer.insert(SEGMENT_KEY, mProbeSegment->key());
+	this->sendTransportControl(offer);
+	qDebug() << "Offered the local transport with segment" << mProbeSegment->key();
+}
+
+void ClientFI3D::onDisconnected() {
+	mIsSharingPayloads = false;
+	mProbeSegment.reset();
+	mProbeNonce.clear();
+	mSharedSegments.clear();
+	mFreeSegments.clear();
+}
+
+void ClientFI3D::writeFrame(const quint8& payloadFlag, const QByteArray& info, const QByteArray& payload) {
+	bool hasPayload = payloadFlag == INLINE_PAYLOAD || payloadFlag == SHARED_PAYLOAD;
+	int infoCount = info.count();
+	int payloadCount = payload.count();
+
+	int byteCount = sizeof(qint32) + 1;
+	byteCount += infoCount;
+	if (hasPayload) {
+		byteCount += sizeof(qint32);
+	}
+
+	QByteArray bytes;
+	bytes.reserve(byteCount);
+
+	bytes.append((char)payloadFlag);
+	bytes.append((const char*)&infoCount, sizeof(qint32));
+	if (hasPayload) {
+		bytes.append((const char*)&payloadCount, sizeof(qint32));
+	}
+	bytes.append(info);
+
+	this->write(bytes);
+	if (hasPayload) {
+		this->write(payload);
+	}
+}
+
+bool ClientFI3D::writeSharedPayload(const QByteArray& info, const QByteArray& payload) {
+	if (mSharedSegments.count() >= MAX_SHARED_SEGMENTS) {
+		qDebug() << "Sending payload inline because the peer has not released its segments.";
+		return false;
+	}
+
+	QSharedPointer<QSharedMemory> segment;
+	for (int i = 0; i < mFreeSegments.count(); i++) {
+		if (mFreeSegments.at(i)->size() >= payload.count()) {
+			segment = mFreeSegments.takeAt(i);
+			break;
+		}
+	}
+
+	if (segment.isNull()) {
+		// Sizes are rounded up so that segments can be reused by most payloads.
+		qint64 size = MIN_SEGMENT_SIZE;
+		while (size < payload.count()) {
+			size *= 2;
+		}
+
+		segment.reset(new QSharedMemory(ClientFI3D::createSegmentKey(mProbeNonce)));
+		if (!segment->create(size)) {
+			qWarning() << "Sending payload inline because a segment could not be created:" << segment->errorString();
+			return false;
+		}
+	}
+
+	std::memcpy(segment->data(), payload.constData(), payload.count());
+	mSharedSegments.insert(segment->key(), segment);
+
+	QByteArray descriptor;
+	qint32 payloadCount = qToLittleEndian<qint32>(payload.count());
+	descriptor.append((const char*)&payloadCount, sizeof(qint32));
+	descriptor.append(segment->key().toUtf8());
+	this->writeFrame(SHARED_PAYLOAD, info, descriptor);
+	return true;
+}
+
+bool ClientFI3D::readSharedPayload(const QByteArray& descriptor) {
+	if (descriptor.count() <= (int)sizeof(qint32)) {
+		qWarning() << "Dropping message because its shared payload has a bad descriptor.";
+		return false;
+	}
+
+	qint32 payloadCount = qFromLittleEndian<qint32>(descriptor.constData());
+	QString key = QString::fromUtf8(descriptor.mid(sizeof(qint32)));
+
+	// Only the local peer that accepted the offer knows the nonce in the keys.
+	if (!mIsSharingPayloads || !this->isLocalPeer() || payloadCount < 0 ||
+		!key.startsWith(ClientFI3D::getSegmentPrefix(mProbeNonce)))
+	{
+		qWarning() << "Closing connection with" << this->peerAddress().toString() <<
+			"because it sent a shared payload that was not negotiated:" << key;
+		this->close();
+		return false;
+	}
+
+	bool isRead = false;
+	QSharedMemory segment(key);
+	if (!segment.attach(QSharedMemory::ReadOnly)) {
+		qWarning() << "Dropping message because its payload segment" << key << 
+			"could not be attached:" << segment.errorString();
+	} else if (segment.size() < payloadCount) {
+		qWarning() << "Dropping message because its payload segment" << key << "is too small.";
+		segment.detach();
+	} else {
+		QSharedPointer<QByteArray> payload(new QByteArray(
+			static_cast<const char*>(segment.constData()), payloadCount));
+		segment.detach();
+		mReceivingMessage->setPayloadAndKeepInfo(payload);
+		qDebug() << "New message payload read from segment:" << payload->count();
+		isRead = true;
+	}
+
+	// The sender reuses the segment once released.
+	QJsonObject release;
+	release.insert(LOCAL_TRANSPORT, "Release");
+	release.insert(SEGMENT_KEY, key);
+	this->sendTransportControl(release);
+	return isRead;
+}
+
+void ClientFI3D::sendTransportControl(const QJsonObject& control) {
+	QJsonDocument doc(control);
+	this->writeFrame(TRANSPORT_CONTROL, doc.toJson(QJsonDocument::JsonFormat::Compact), QByteArray());
+}
+
+void ClientFI3D::onTransportControl(const QJsonObject& control) {
+	QString action = control.value(LOCAL_TRANSPORT).toString("");
+	if (action == "Offer") {
+		if (!mIsLocalTransportEnabled || !this->isLocalPeer()) {
+			qDebug() << "Ignoring local transport offer from a peer that is not local.";
+			return;
+		}
+
+		QString key = control.value(SEGMENT_KEY).toString("");
+		QSharedMemory probe(key);
+		if (!key.startsWith("FI3D-") || !probe.attach(QSharedMemory::ReadOnly)) {
+			qWarning() << "Declining local transport because the offered segment could not be attached:" <<
+				probe.errorString();
+			return;
+		}
+		// The segment may be rounded up to a page, the nonce is a UUID.
+		QByteArray nonce(static_cast<const char*>(probe.constData()), qMin<qsizetype>(probe.size(), 16));
+		probe.detach();
+		if (!key.startsWith(ClientFI3D::getSegmentPrefix(nonce))) {
+			qWarning() << "Declining local transport because the offered segment does not hold its nonce.";
+			return;
+		}
+		mProbeNonce = nonce;
+
+		QJsonObject accept;
+		accept.insert(LOCAL_TRANSPORT, "Accept");
+		accept.insert(TRANSPORT_NONCE, QString(nonce.toBase64()));
+		this->sendTransportControl(accept);
+
+		mIsSharingPayloads = true;
+		qInfo() << "Sharing payloads with local peer" << this->peerAddress().toString();
+	} else if (action == "Accept") {
+		QByteArray nonce = QByteArray::fromBase64(control.value(TRANSPORT_NONCE).toString("").toUtf8());
+		if (mProbeSegment.isNull() || nonce != mProbeNonce) {
+			qWarning() << "Ignoring local transport accept that does not match the offer.";
+			return;
+		}
+
+		mProbeSegment.reset();
+		mIsSharingPayloads = true;
+		qInfo() << "Sharing payloads with local peer" << this->peerAddress().toString();
+	} else if (action == "Release") {
+		QSharedPointer<QSharedMemory> segment = mSharedSegments.take(control.value(SEGMENT_KEY).toString(""));
+		if (!segment.isNull() && mFreeSegments.count() < MAX_FREE_SEGMENTS) {
+			mFreeSegments.append(segment);
+		}
+	} else {
+		qWarning() << "Received an unknown transport control message:" << action;
+	}
+}
+
+QString ClientFI3D::getSegmentPrefix(const QByteArray& nonce) {
+	return QString("FI3D-%1-").arg(QString(nonce.toHex()));
+}
+
+QString ClientFI3D::createSegmentKey(const QByteArray& nonce) {
+	static QAtomicInt sSegmentCount(0);
+	return QString("%1%2-%3")
+		.arg(ClientFI3D::getSegmentPrefix(nonce))
+		.arg(QCoreApplication::applicationPid())
+		.arg(sSegmentCount.fetchAndAddRelaxed(1));
+}
@@ -1,13 +1,64 @@
 #include "fi3d/server/network/ClientTCP.h"
 
 #include <QJsonDocument>
+#include <QMetaObject>
+#include <QNetworkInterface>
+#include <QThread>
 #include <QtEndian>
 
 using namespace fi3d;
 
 ClientTCP::ClientTCP()
-	: QSslSocket()
+	: QSslSocket(),
+	mAcceptedPeerAddress()
 {
 }
 
-ClientTCP::~ClientTCP() {}
\ No newline at end of file
+ClientTCP::~ClientTCP() {}
+
+bool ClientTCP::isLocalPeer() const {
+	QHostAddress peer = this->peerAddress();
+	if (peer.isNull()) {
+		return false;
+	}
+	if (peer.isLoopback()) {
+		return true;
+	}
+
+	// A peer may connect through one of the addresses of this machine.
+	bool isIPv4 = false;
+	QHostAddress peerIPv4(peer.toIPv4Address(&isIPv4));
+	for (const QHostAddress& address : QNetworkInterface::allAddresses()) {
+		if (address.isEqual(peer) || (isIPv4 && address.isEqual(peerIPv4))) {
+			return true;
+		}
+	}
+	return false;
+}
+
+QHostAddress ClientTCP::getAcceptedPeerAddress() const {
+	return mAcceptedPeerAddress;
+}
+
+bool ClientTCP::setSocketDescriptor(qintptr socketDescriptor,
+	QAbstractSocket::SocketState state, QIODevice::OpenMode openMode)
+{
+	if (!QSslSocket::setSocketDescriptor(socketDescriptor, state, openMode)) {
+		return false;
+	}
+
+	// Set before the socket is handed to other threads, never written again.
+	mAcceptedPeerAddress = this->peerAddress();
+	return true;
+}
+
+void ClientTCP::closeConnection() {
+	if (QThread::currentThread() == this->thread()) {
+		this->close();
+		return;
+	}
+
+	QMetaObject::invokeMethod(this, [this]() {
+		this->close();
+	}, Qt::QueuedConnection);
+}
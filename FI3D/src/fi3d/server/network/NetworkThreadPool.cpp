@@ -0,0 +1,101 @@
+#include <fi3d/server/network/NetworkThreadPool.h>
+
+#include <fi3d/server/network/Message.h>
+
+#include <fi3d/logger/Logger.h>
+
+#include <QAbstractSocket>
+#include <QMetaObject>
+#include <QMetaType>
+#include <QMutexLocker>
+#include <QThread>
+
+using namespace fi3d;
+
+NetworkThreadPool::NetworkThreadPool(const int& threadCount)
+	: mThreads(),
+	mThreadContexts(),
+	mNextThread(0),
+	mSockets(),
+	mSocketsMutex()
+{
+	// Messages cross to the main thread through queued connections.
+	qRegisterMetaType<MessagePtr>("MessagePtr");
+
+	for (int i = 0; i < threadCount; i++) {
+		QThread* thread = new QThread();
+		thread->setObjectName(QString("FI3D Network %1").arg(i));
+		thread->start();
+		mThreads.append(thread);
+
+		QObject* context = new QObject();
+		context->moveToThread(thread);
+		mThreadContexts.append(context);
+	}
+	qDebug() << "Started" << mThreads.count() << "network threads";
+}
+
+NetworkThreadPool::~NetworkThreadPool() {
+	// The sockets are closed and deleted in their thread while it still runs.
+	for (int i = 0; i < mThreads.count(); i++) {
+		QThread* thread = mThreads.at(i);
+		QObject* context = mThreadContexts.at(i);
+		QMetaObject::invokeMethod(context, [this, thread, context]() {
+			QList<QAbstractSocket*> sockets;
+			{
+				QMutexLocker locker(&mSocketsMutex);
+				sockets = mSockets.take(thread);
+			}
+			for (QAbstractSocket* socket : sockets) {
+				socket->abort();
+				delete socket;
+			}
+			delete context;
+		}, Qt::BlockingQueuedConnection);
+	}
+	mThreadContexts.clear();
+
+	for (QThread* thread : mThreads) {
+		thread->quit();
+	}
+	for (QThread* thread : mThreads) {
+		thread->wait();
+		delete thread;
+	}
+	mThreads.clear();
+}
+
+int NetworkThreadPool::getThreadCount() const {
+	return mThreads.count();
+}
+
+QThread* NetworkThreadPool::nextThread() {
+	if (mThreads.isEmpty()) {
+		return Q_NULLPTR;
+	}
+
+	QThread* thread = mThreads.at(mNextThread);
+	mNextThread = (mNextThread + 1) % mThreads.count();
+	return thread;
+}
+
+void NetworkThreadPool::adoptSocket(QAbstractSocket* socket, QThread* thread) {
+	{
+		QMutexLocker locker(&mSocketsMutex);
+		mSockets[thread].append(socket);
+	}
+
+	// Sockets deleted before the pool, e.g. once disconnected, are forgotten.
+	QObject::connect(socket, &QObject::destroyed, [this, socket, thread]() {
+		QMutexLocker locker(&mSocketsMutex);
+		QHash<QThread*, QList<QAbstractSocket*>>::iterator it = mSockets.find(thread);
+		if (it != mSockets.end()) {
+			it.value().removeOne(socket);
+		}
+	});
+	socket->moveToThread(thread);
+}
+
+int NetworkThreadPool::getDefaultThreadCount() {
+	return qBound(1, QThread::idealThreadCount() / 2, 4);
+}
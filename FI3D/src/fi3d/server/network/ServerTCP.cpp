@@ -4,7 +4,9 @@
 
 #include <QFile>
 #include <QJsonDocument>
+#include <QMetaObject>
 #include <QNetworkInterface>
+#include <QThread>
 #include <QtEndian>
 
 using namespace fi3d;
@@ -13,7 +15,8 @@ ServerTCP::ServerTCP(const bool& enableSSL)
 	: QTcpServer(),
 	ENABLE_SSL(enableSSL),
 	mSslKey(),
-	mSslCertificate()
+	mSslCertificate(),
+	mIOThreads()
 {
 	if (ENABLE_SSL) {
 		QByteArray key;
@@ -93,11 +96,41 @@ void ServerTCP::incomingConnection(qintptr socketDescriptor) {
 
 	ClientTCP* client = this->makeClientTCPSocket();
 
-	if (!client->setSocketDescriptor(socketDescriptor)) {
-		delete client;
+	QThread* ioThread = mIOThreads.nextThread();
+	if (ioThread == Q_NULLPTR) {
+		if (!this->setUpConnection(client, socketDescriptor)) {
+			delete client;
+			return;
+		}
+		this->addPendingConnection(client);
+		qDebug() << "Exit";
 		return;
 	}
 
+	// The socket notifiers must be created in the thread of the socket, so it
+	// is set up there and handed back to be announced.
+	mIOThreads.adoptSocket(client, ioThread);
+	QMetaObject::invokeMethod(client, [=]() {
+		bool isSetUp = this->setUpConnection(client, socketDescriptor);
+		QMetaObject::invokeMethod(this, [=]() {
+			if (!isSetUp) {
+				client->deleteLater();
+				return;
+			}
+			this->addPendingConnection(client);
+			emit this->newConnection();
+		}, Qt::QueuedConnection);
+	}, Qt::QueuedConnection);
+
+	qDebug() << "Exit";
+}
+
+bool ServerTCP::setUpConnection(ClientTCP* client, qintptr socketDescriptor) const {
+	if (!client->setSocketDescriptor(socketDescriptor)) {
+		qWarning() << "Failed to open incoming connection because:" << client->errorString();
+		return false;
+	}
+
 	if (ENABLE_SSL) {
 		client->setPrivateKey(mSslKey);
 		client->setLocalCertificate(mSslCertificate);
@@ -116,10 +149,7 @@ void ServerTCP::incomingConnection(qintptr socketDescriptor) {
 			client->ignoreSslErrors();
 		});
 	}
-
-	this->addPendingConnection(client);
-
-	qDebug() << "Exit";
+	return true;
 }
 
 ClientTCP* ServerTCP::makeClientTCPSocket() const {
@@ -4,12 +4,68 @@
 
 #include <fi3d/data/Filer.h>
 
-#include <vtkImageThreshold.h>
+#include <fi3d/utilities/ParallelAlgorithms.h>
+
+#include <QAtomicInt>
+#include <QVector>
+
+#include <vtkAppendPolyData.h>
+#include <vtkCleanPolyData.h>
+#include <vtkDecimatePro.h>
 #include <vtkFlyingEdges2D.h>
+#include <vtkFlyingEdges3D.h>
+#include <vtkImageGaussianSmooth.h>
+#include <vtkImageThreshold.h>
 #include <vtkPointData.h>
 
+#include <cmath>
+#include <cstring>
+
 using namespace fi3d;
 
+/// @brief The value of thresholded voxels, the surface is at half of it.
+static const float SEGMENT_INSIDE_VALUE = 255.0f;
+
+/// @brief The fewest slices given to each slab.
+static const int MIN_SLAB_SLICES = 8;
+
+/// @brief Sets the output to SEGMENT_INSIDE_VALUE where the first component is within [min, max], 0 elsewhere.
+template <typename T>
+static void thresholdValues(const T* source, const qint64& count, const int& components,
+	const double& min, const double& max, float* output)
+{
+	for (qint64 v = 0; v < count; v++) {
+		double value = static_cast<double>(source[v * components]);
+		output[v] = value >= min && value <= max ? SEGMENT_INSIDE_VALUE : 0.0f;
+	}
+}
+
+/// @brief Maps the values to [0, 1], output = clamp((value - low) * scale).
+template <typename T>
+static void windowValues(const T* values, const qint64& count, const qint64& stride,
+	const float& low, const float& scale, float* output)
+{
+	for (qint64 i = 0; i < count; i++) {
+		float value = (static_cast<float>(values[i * stride]) - low) * scale;
+		output[i] = qBound(0.0f, value, 1.0f);
+	}
+}
+
+/// @brief Same as windowValues for 8-bit values, through a table of every result.
+template <typename T>
+static void windowBytes(const T* values, const qint64& count, const qint64& stride,
+	const float& low, const float& scale, float* output)
+{
+	float table[256];
+	for (int i = 0; i < 256; i++) {
+		float value = (static_cast<float>(static_cast<T>(i)) - low) * scale;
+		table[i] = qBound(0.0f, value, 1.0f);
+	}
+	for (qint64 i = 0; i < count; i++) {
+		output[i] = table[static_cast<unsigned char>(values[i * stride])];
+	}
+}
+
 void ImageAlgorithms::applyThreshold(const double& min, const double& max, 
 	vtkSmartPointer<vtkImageData> source, vtkSmartPointer<vtkImageData> output) 
 {
@@ -48,6 +104,265 @@ ModelDataVPtr ImageAlgorithms::computeEdges(vtkSmartPointer<vtkImageData> image)
 	return segmentation;
 }
 
+ModelDataVPtr ImageAlgorithms::segment(vtkSmartPointer<vtkImageData> image,
+	const SegmentationSettings& settings, const SegmentationProgress& progress)
+{
+	qDebug() << "Enter - Segmenting image between" << settings.Min << "and" << settings.Max;
+
+	if (image.Get() == Q_NULLPTR || image->GetScalarPointer() == Q_NULLPTR) {
+		qWarning() << "Failed to segment because the image has no scalars.";
+		return ModelDataVPtr();
+	}
+
+	int extent[6];
+	image->GetExtent(extent);
+	int dimensions[3];
+	image->GetDimensions(dimensions);
+	if (dimensions[0] < 2 || dimensions[1] < 2 || dimensions[2] < 2) {
+		qWarning() << "Failed to segment because the image is not 3D.";
+		return ModelDataVPtr();
+	}
+
+	// The slices a slab reads beyond its own so smoothing matches the whole volume.
+	const bool isSmoothing = settings.SmoothingDeviation > 0;
+	const bool isDecimating = settings.DecimationReduction > 0;
+	const int margin = isSmoothing ? (int)std::ceil(3.0 * settings.SmoothingDeviation) : 0;
+
+	// The cells between slice z and z + 1 belong to the slab owning z.
+	const int cellSlices = dimensions[2] - 1;
+	const int slabCount = qBound(1, cellSlices / MIN_SLAB_SLICES, ParallelAlgorithms::getThreadCount() * 2);
+	const int stepCount = slabCount * (2 + (isSmoothing ? 1 : 0) + (isDecimating ? 1 : 0)) + 1;
+	qDebug() << "Segmenting" << dimensions[2] << "slices in" << slabCount << "slabs";
+
+	QAtomicInt doneSteps(0);
+	QAtomicInt isCancelled(0);
+	auto step = [&]() {
+		int done = doneSteps.fetchAndAddOrdered(1) + 1;
+		if (progress && !progress((double)done / stepCount)) {
+			isCancelled.storeRelaxed(1);
+		}
+		return isCancelled.loadRelaxed() == 0;
+	};
+
+	const void* scalars = image->GetScalarPointer();
+	const int scalarType = image->GetScalarType();
+	const int components = image->GetNumberOfScalarComponents();
+	const qint64 sliceSize = (qint64)dimensions[0] * dimensions[1];
+
+	// Every slab builds its own images, the source image is only read.
+	QVector<vtkSmartPointer<vtkPolyData>> pieces(slabCount);
+	ParallelAlgorithms::forRange(slabCount, [&](const int& slab) {
+		if (isCancelled.loadRelaxed() != 0) {
+			return;
+		}
+
+		const int first = (int)((qint64)slab * cellSlices / slabCount);
+		const int last = (int)((qint64)(slab + 1) * cellSlices / slabCount);
+		const int low = qMax(0, first - margin);
+		const int high = qMin(dimensions[2] - 1, last + margin);
+
+		vtkSmartPointer<vtkImageData> mask = vtkSmartPointer<vtkImageData>::New();
+		mask->SetOrigin(image->GetOrigin());
+		mask->SetSpacing(image->GetSpacing());
+		mask->SetExtent(extent[0], extent[1], extent[2], extent[3], extent[4] + low, extent[4] + high);
+		mask->AllocateScalars(VTK_FLOAT, 1);
+
+		float* maskValues = static_cast<float*>(mask->GetScalarPointer());
+		qint64 offset = sliceSize * low * components;
+		qint64 count = sliceSize * (high - low + 1);
+		switch (scalarType) {
+			vtkTemplateMacro(thresholdValues(static_cast<const VTK_TT*>(scalars) + offset,
+				count, components, settings.Min, settings.Max, maskValues));
+		default:
+			qWarning() << "Failed to threshold unsupported scalar type" << scalarType;
+			return;
+		}
+		if (!step()) {
+			return;
+		}
+
+		vtkSmartPointer<vtkImageData> volume = mask;
+		if (isSmoothing) {
+			vtkNew<vtkImageGaussianSmooth> smoother;
+			smoother->SetEnableSMP(false);
+			smoother->SetNumberOfThreads(1);
+			smoother->SetDimensionality(3);
+			smoother->SetStandardDeviations(settings.SmoothingDeviation,
+				settings.SmoothingDeviation, settings.SmoothingDeviation);
+			smoother->SetRadiusFactors(3.0, 3.0, 3.0);
+			smoother->SetInputData(mask);
+			smoother->Update();
+
+			// Keep the slices of the slab, the margin is no longer needed.
+			volume = vtkSmartPointer<vtkImageData>::New();
+			volume->SetOrigin(image->GetOrigin());
+			volume->SetSpacing(image->GetSpacing());
+			volume->SetExtent(extent[0], extent[1], extent[2], extent[3], extent[4] + first, extent[4] + last);
+			volume->AllocateScalars(VTK_FLOAT, 1);
+			const float* smoothed = static_cast<const float*>(smoother->GetOutput()->GetScalarPointer());
+			std::memcpy(volume->GetScalarPointer(), smoothed + sliceSize * (first - low),
+				sliceSize * (last - first + 1) * sizeof(float));
+			if (!step()) {
+				return;
+			}
+		}
+
+		vtkNew<vtkFlyingEdges3D> contour;
+		contour->SetInputData(volume);
+		contour->SetValue(0, SEGMENT_INSIDE_VALUE / 2);
+		contour->ComputeNormalsOff();
+		contour->ComputeGradientsOff();
+		contour->ComputeScalarsOff();
+		contour->Update();
+		vtkSmartPointer<vtkPolyData> piece = contour->GetOutput();
+		if (!step()) {
+			return;
+		}
+
+		// The cut at the shared slices is the boundary of the piece, and it is kept.
+		if (isDecimating) {
+			if (piece->GetNumberOfPolys() > 0) {
+				vtkNew<vtkDecimatePro> decimator;
+				decimator->SetInputData(piece);
+				decimator->SetTargetReduction(qMin(settings.DecimationReduction, 0.99));
+				decimator->PreserveTopologyOn();
+				decimator->SplittingOff();
+				decimator->BoundaryVertexDeletionOff();
+				decimator->Update();
+				piece = decimator->GetOutput();
+			}
+			if (!step()) {
+				return;
+			}
+		}
+
+		pieces[slab] = piece;
+	});
+
+	if (isCancelled.loadRelaxed() != 0) {
+		qDebug() << "Exit - Segmentation was cancelled";
+		return ModelDataVPtr();
+	}
+
+	// Merge the pieces, the vertices on the shared slices are identical.
+	ModelDataVPtr segmentation = ModelDataVPtr::New();
+	vtkNew<vtkAppendPolyData> appender;
+	for (vtkSmartPointer<vtkPolyData> piece : pieces) {
+		if (piece.Get() != Q_NULLPTR && piece->GetNumberOfPoints() > 0) {
+			appender->AddInputData(piece);
+		}
+	}
+	if (appender->GetNumberOfInputConnections(0) > 0) {
+		vtkNew<vtkCleanPolyData> cleaner;
+		cleaner->SetInputConnection(appender->GetOutputPort());
+		cleaner->PointMergingOn();
+		cleaner->SetTolerance(0.0);
+		cleaner->SetOutput(segmentation);
+		cleaner->Update();
+		segmentation->GetPointData()->Initialize();
+	}
+	step();
+
+	qDebug() << "Exit - Segmented" << segmentation->GetNumberOfPolys() << "triangles";
+	return segmentation;
+}
+
+ModelDataVPtr ImageAlgorithms::segment(StudyPtr study, const int& seriesIndex,
+	const SegmentationSettings& settings, const SegmentationProgress& progress)
+{
+	if (study.isNull()) {
+		qWarning() << "Failed to segment because the study is null.";
+		return ModelDataVPtr();
+	}
+
+	SeriesDataVPtr series = study->getContiguousSeries(seriesIndex);
+	if (series.Get() == Q_NULLPTR) {
+		qWarning() << "Failed to segment series" << seriesIndex << "of study" << study->getStudyID();
+		return ModelDataVPtr();
+	}
+
+	return ImageAlgorithms::segment(series, settings, progress);
+}
+
+void ImageAlgorithms::applyWindowLevel(const void* values, const int& scalarType,
+	const qint64& count, const qint64& stride,
+	const double& window, const double& level, float* output)
+{
+	const float low = static_cast<float>(level - window / 2.0);
+	const float scale = static_cast<float>(1.0 / qMax(window, 1e-6));
+	if (scalarType == VTK_UNSIGNED_CHAR) {
+		windowBytes(static_cast<const unsigned char*>(values), count, stride, low, scale, output);
+		return;
+	} else if (scalarType == VTK_SIGNED_CHAR) {
+		windowBytes(static_cast<const signed char*>(values), count, stride, low, scale, output);
+		return;
+	} else if (scalarType == VTK_CHAR) {
+		windowBytes(static_cast<const char*>(values), count, stride, low, scale, output);
+		return;
+	}
+
+	switch (scalarType) {
+		vtkTemplateMacro(windowValues(static_cast<const VTK_TT*>(values), count, stride, low, scale, output));
+		default:
+			qWarning() << "Failed to apply window/level to unknown scalar type" << scalarType;
+			break;
+	}
+}
+
+bool ImageAlgorithms::applyWindowLevel(vtkImageData* image, const int& sliceIndex,
+	const ESliceOrientation& orientation,
+	const double& window, const double& level, float* output)
+{
+	if (image == Q_NULLPTR || image->GetPointData()->GetScalars() == Q_NULLPTR) {
+		qWarning() << "Failed to apply window/level because the image has no scalars.";
+		return false;
+	}
+
+	int dims[3];
+	image->GetDimensions(dims);
+	int* extent = image->GetExtent();
+	vtkIdType increments[3];
+	image->GetIncrements(increments);
+
+	// The axis of the slice, of the values in a row and of the rows.
+	int sliceAxis, valueAxis, rowAxis;
+	switch (orientation.toInt()) {
+		case ESliceOrientation::XY:
+			sliceAxis = 2;
+			valueAxis = 0;
+			rowAxis = 1;
+			break;
+		case ESliceOrientation::YZ:
+			sliceAxis = 0;
+			valueAxis = 1;
+			rowAxis = 2;
+			break;
+		case ESliceOrientation::XZ:
+			sliceAxis = 1;
+			valueAxis = 0;
+			rowAxis = 2;
+			break;
+		default:
+			qWarning() << "Failed to apply window/level because the orientation is unknown.";
+			return false;
+	}
+	if (sliceIndex < 0 || sliceIndex >= dims[sliceAxis]) {
+		qWarning() << "Failed to apply window/level because slice" << sliceIndex << "is out of range.";
+		return false;
+	}
+
+	const int scalarType = image->GetScalarType();
+	const qint64 rowLength = dims[valueAxis];
+	for (int row = 0; row < dims[rowAxis]; row++) {
+		int ijk[3] = {extent[0], extent[2], extent[4]};
+		ijk[sliceAxis] += sliceIndex;
+		ijk[rowAxis] += row;
+		ImageAlgorithms::applyWindowLevel(image->GetScalarPointer(ijk), scalarType,
+			rowLength, increments[valueAxis], window, level, output + row * rowLength);
+	}
+	return true;
+}
+
 ImageDataVPtr ImageAlgorithms::loadGeologyData(const QString& dirPath) {
 	ImageDataVPtr data = ImageDataVPtr::New();
 	data->SetDimensions(236, 210, 13);
@@ -2,7 +2,11 @@
 
 #include <fi3d/logger/Logger.h>
 
+#include <fi3d/utilities/Voxelizer.h>
+
 #include <vtkAppendPolyData.h>
+#include <vtkCellArray.h>
+#include <vtkCellArrayIterator.h>
 #include <vtkCleanPolyData.h>
 #include <vtkClipPolyData.h>
 #include <vtkContourFilter.h>
@@ -19,6 +23,26 @@
 
 using namespace fi3d;
 
+/// @brief Appends the triangles of the cells, polygons are split as fans.
+static void appendTriangles(vtkCellArray* cells, const bool& isStrip, QVector<vtkIdType>& triangles) {
+	if (cells == Q_NULLPTR || cells->GetNumberOfCells() == 0) {
+		return;
+	}
+
+	// Each thread walks the cells with its own iterator.
+	vtkSmartPointer<vtkCellArrayIterator> it = vtk::TakeSmartPointer(cells->NewIterator());
+	for (it->GoToFirstCell(); !it->IsDoneWithTraversal(); it->GoToNextCell()) {
+		vtkIdType count;
+		const vtkIdType* ids;
+		it->GetCurrentCell(count, ids);
+		for (vtkIdType k = 0; k + 2 < count; k++) {
+			triangles.append(isStrip ? ids[k] : ids[0]);
+			triangles.append(ids[k + 1]);
+			triangles.append(ids[k + 2]);
+		}
+	}
+}
+
 void ModelAlgorithms::combineModelData(vtkSmartPointer<vtkPolyData> firstData, 
 	vtkSmartPointer<vtkPolyData> secondData,
 	vtkSmartPointer<vtkPolyData> outData)
@@ -121,62 +145,11 @@ ModelDataVPtr ModelAlgorithms::clipModel(vtkSmartPointer<vtkPolyData> modelData,
 
 ImageDataVPtr ModelAlgorithms::polyToImage(
 	vtkSmartPointer<vtkPolyData> modelData,
-	const double & vsX,	const double & vsY, const double & vsZ) 
+	const double & vsX,	const double & vsY, const double & vsZ,
+	const bool& isFilled) 
 {
-	qDebug() << "Enter - Converting ModelData to ImageData with spacings: (" << vsX << "," << vsY << "," << vsZ << ")";
 	double spacing[3] = {vsX, vsY, vsZ};
-	ImageDataVPtr outData = ImageDataVPtr::New();
-	outData->SetSpacing(spacing);
-
-	double bounds[6];
-	modelData->GetBounds(bounds);
-	qDebug() << "Setting bounds: [" << bounds[0] << ", " << bounds[1] << 
-		"], [" << bounds[2] << "," << bounds[3] << "], [" <<
-		bounds[4] << ", " << bounds[5] << "]";
-
-	int dimensions[3];
-	for (int i = 0; i < 3; i++) {
-		double value = (bounds[i * 2 + 1] - bounds[i * 2]) / spacing[i];
-		dimensions[i] = static_cast<int>(ceil(value));
-	}
-	outData->SetDimensions(dimensions);
-	qDebug() << "Setting dimensions: (" << dimensions[0] << ", " << dimensions[1] << ", " << dimensions[2] << ")";
-
-	double origin[3];
-	for (int i = 0; i < 3; i++) {
-		origin[i] = bounds[i * 2] + spacing[i] / 2;
-	}
-	outData->SetOrigin(origin);
-	qDebug() << "Setting origin: (" << origin[0] << "," << origin[1] << ", " << origin[2] << ")";
-
-	outData->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
-	qDebug() << "Setting default image data to 0 for" << dimensions[0] * dimensions[1] * dimensions[2] << "points";
-	// Set default data values to 0
-	for (int x = 0; x < dimensions[0]; x++) {
-		for (int y = 0; y < dimensions[1]; y++) {
-			for (int z = 0; z < dimensions[2]; z++) {
-				outData->SetScalarComponentFromDouble(x, y, z, 0, 0);
-			}
-		}
-	}
-	qDebug() << "Done setting default data to 0";
-
-	qDebug() << "Setting model data to image data for" << modelData->GetNumberOfPoints() << "points";
-
-	// for every point in the ModelData. Set 255 to the nearest voxel
-	for (vtkIdType i = 0; i < modelData->GetNumberOfPoints(); i++) {
-		double p[3];
-		modelData->GetPoint(i, p);
-
-		for (int i = 0; i < 3; i++) {
-			p[i] = (p[i] - origin[i]) / spacing[i];
-		}
-		outData->SetScalarComponentFromDouble(p[0], p[1], p[2], 0, 255);
-	}
-	qDebug() << "Done setting model data to image data";
-
-	qDebug() << "Exit";
-	return outData;
+	return Voxelizer::voxelize(modelData, spacing, isFilled);
 }
 
 ModelDataVPtr ModelAlgorithms::transform(
@@ -287,3 +260,14 @@ ModelDataVPtr ModelAlgorithms::reconstructSurface(vtkSmartPointer<vtkPolyData> p
 
 	return surface;
 }
+
+QVector<vtkIdType> ModelAlgorithms::getTriangles(vtkPolyData* modelData) {
+	QVector<vtkIdType> triangles;
+	if (modelData == Q_NULLPTR) {
+		return triangles;
+	}
+
+	appendTriangles(modelData->GetPolys(), false, triangles);
+	appendTriangles(modelData->GetStrips(), true, triangles);
+	return triangles;
+}
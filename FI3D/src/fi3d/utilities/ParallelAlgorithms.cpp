@@ -0,0 +1,46 @@
+#include <fi3d/utilities/ParallelAlgorithms.h>
+
+#include <QAtomicInt>
+#include <QSemaphore>
+#include <QThreadPool>
+
+using namespace fi3d;
+
+void ParallelAlgorithms::forRange(const int& count, const std::function<void(const int&)>& work) {
+	if (count <= 0) {
+		return;
+	}
+	if (count == 1) {
+		work(0);
+		return;
+	}
+
+	QAtomicInt nextIndex(0);
+	std::function<void()> runItems = [&nextIndex, &count, &work]() {
+		for (int i = nextIndex.fetchAndAddRelaxed(1); i < count; i = nextIndex.fetchAndAddRelaxed(1)) {
+			work(i);
+		}
+	};
+
+	// Helpers that cannot start right away are not waited for.
+	QSemaphore finishedHelpers;
+	int helperCount = 0;
+	int wantedHelpers = qMin(count, ParallelAlgorithms::getThreadCount()) - 1;
+	for (int i = 0; i < wantedHelpers; i++) {
+		bool isStarted = QThreadPool::globalInstance()->tryStart([&runItems, &finishedHelpers]() {
+			runItems();
+			finishedHelpers.release();
+		});
+		if (!isStarted) {
+			break;
+		}
+		helperCount++;
+	}
+
+	runItems();
+	finishedHelpers.acquire(helperCount);
+}
+
+int ParallelAlgorithms::getThreadCount() {
+	return qMax(1, QThreadPool::globalInstance()->maxThreadCount());
+}
@@ -0,0 +1,65 @@
+#include <fi3d/utilities/SegmentationTask.h>
+
+#include <fi3d/logger/Logger.h>
+
+#include <QMetaType>
+#include <QThread>
+
+using namespace fi3d;
+
+SegmentationTask::SegmentationTask(StudyPtr study, const int& seriesIndex,
+	const SegmentationSettings& settings, QObject* parent)
+	: QObject(parent),
+	mSeries(),
+	mSettings(settings),
+	mIsCancelled(0),
+	mThread(Q_NULLPTR)
+{
+	// The surface crosses to the caller's thread through a queued connection.
+	qRegisterMetaType<ModelDataVPtr>("fi3d::ModelDataVPtr");
+
+	if (study.isNull()) {
+		qWarning() << "Segmentation task was given a null study.";
+	} else {
+		mSeries = study->getContiguousSeries(seriesIndex);
+	}
+}
+
+SegmentationTask::~SegmentationTask() {
+	if (mThread != Q_NULLPTR) {
+		this->cancel();
+		mThread->wait();
+		delete mThread;
+	}
+}
+
+void SegmentationTask::start() {
+	if (mThread != Q_NULLPTR) {
+		qWarning() << "Segmentation task was already started.";
+		return;
+	}
+
+	mThread = QThread::create([this]() {
+		ModelDataVPtr model = ImageAlgorithms::segment(mSeries, mSettings,
+			[this](const double& fraction) {
+				emit this->progressed(fraction);
+				return mIsCancelled.loadRelaxed() == 0;
+			});
+
+		if (mIsCancelled.loadRelaxed() != 0) {
+			emit this->cancelled();
+		} else {
+			emit this->finished(model);
+		}
+	});
+	mThread->setObjectName("FI3D Segmentation");
+	mThread->start();
+}
+
+void SegmentationTask::cancel() {
+	mIsCancelled.storeRelaxed(1);
+}
+
+bool SegmentationTask::isRunning() const {
+	return mThread != Q_NULLPTR && mThread->isRunning();
+}
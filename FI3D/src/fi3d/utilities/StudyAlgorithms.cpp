@@ -17,128 +17,74 @@ StudyAlgorithms::StudyAlgorithms(QObject *parent)
 StudyAlgorithms::~StudyAlgorithms() {}
 
 StudyPtr StudyAlgorithms::fixStudySeriesOrder(StudyPtr inputStudy) {
-	qWarning() << "Method has not yet been implemented";
-	return StudyPtr();
-
-	//TODO: Old code used within a study. Was moved here as it makes more sense.
-	// This code needs to be modified.
-	//if (mIsInOrder) {
-	//	return;
-	//}
-
-	//QVector<int> indexOrder;
-	//QMap<int, double> matrixDistances;
-
-	//// find distance of point 1, 1, 1 from 0 after it is transformed from each matrix
-	//for (int i = 0; i < mSeriesSet.size(); i++) {
-	//	double p[4] = {0, 0, 0, 1};
-	//	//mSeriesSet.at(i)->getPatientMatrix()->MultiplyPoint(p, p);
-	//	double distance = p[0] * p[0] + p[1] * p[1] + p[2] * p[2];
-	//	matrixDistances.insert(i, distance);
-	//}
-
-	//// Order the indices by the distances obtained on previous loop
-	//for (int i = 0; i < mSeriesSet.size(); i++) {
-	//	QMap<int, double>::iterator it = matrixDistances.begin();
-	//	double minDist = it.value();
-	//	int minIndex = it.key();
-	//	it++;
-	//	for (; it != matrixDistances.end(); it++) {
-	//		if (minDist > it.value()) {
-	//			minDist = it.value();
-	//			minIndex = it.key();
-	//		}
-	//	}
-	//	matrixDistances.remove(minIndex);
-	//	indexOrder.push_back(minIndex);
-	//}
-
-	//// Assign the saved elements in the right order
-	//QVector<vtkSmartPointer<ImageData>> orderedData;
-	//QVector<QVector<QString>> orderedFileSets;
-	//QVector<vtkSmartPointer<vtkMatrix4x4>> orderedPatientMatrices;
-	//for (int i = 0; i < indexOrder.size(); i++) {
-	//	orderedData.push_back(mSeriesSet.at(indexOrder[i]));
-	//	//orderedFileSets.push_back(mDataFiles.at(indexOrder[i]));
-	//	//orderedPatientMatrices.push_back(mDataPatientMatrices.at(indexOrder[i]));
-	//}
-
-	//mSeriesSet = orderedData;
-	////mDataFiles = orderedFileSets;
-	////mDataPatientMatrices = orderedPatientMatrices;
-	//mIsInOrder = true;
+	if (inputStudy.isNull()) {
+		qWarning() << "Failed to order the series because the study is null.";
+		return StudyPtr();
+	}
+
+	QVector<SeriesDataVPtr> series;
+	QVector<vtkSmartPointer<vtkMatrix4x4>> matrices;
+	for (int i = 0; i < inputStudy->getSeriesCount(); i++) {
+		SeriesDataVPtr s = inputStudy->getContiguousSeries(i);
+		if (s.Get() == Q_NULLPTR) {
+			qWarning() << "Failed to order the series because series" << i << "is null.";
+			return StudyPtr();
+		}
+		series.append(s);
+		matrices.append(s->getPatientMatrix());
+	}
+
+	StudyPtr orderedStudy(new Study(inputStudy->getStudyID()));
+	orderedStudy->setPatientID(inputStudy->getPatientID());
+	orderedStudy->setPatientName(inputStudy->getPatientName());
+	orderedStudy->setStudyDate(inputStudy->getStudyDate());
+	orderedStudy->setStudyTime(inputStudy->getStudyTime());
+
+	// The ordered series share the scalars of the input series.
+	for (int index : StudyView::getSpatialOrder(matrices)) {
+		SeriesDataVPtr ordered = SeriesDataVPtr::New();
+		ordered->ShallowCopy(series.at(index));
+		ordered->setPatientMatrix(series.at(index)->getPatientMatrix());
+		ordered->setMetaData(series.at(index)->getMetaData());
+		orderedStudy->addSeries(ordered);
+	}
+
+	return orderedStudy;
 }
 
 StudyPtr StudyAlgorithms::convertStudyToSpatialDomain(StudyPtr inputStudy) {
-	qWarning() << "Method has not yet been implemented";
-	return StudyPtr();
-
-	//TODO: Old code used within a study. Was moved here as it makes more sense. This code needs to be modified.
-	//return;
-
-	//if (mIsSpatialDomain) return;
-	//this->fixSeriesOrder();
-
-	//QVector<vtkSmartPointer<ImageData>> newDataSets;
-	//QVector<vtkSmartPointer<vtkMatrix4x4>> newPatientMatrices;
-	//QVector<QVector<QString>> newFileSets;
-
-	//// find how many data sets we will need
-	//int newDataSetCount = mSeriesSet.at(0)->GetDimensions()[2];		// 3rd dimension is the time dimension
-
-	//																// Store pointer to the patient matrix that will be used for all new data sets
-	//																//vtkSmartPointer<vtkMatrix4x4> patientMatrix = mDataPatientMatrices.at(0);
-
-	//																// find the new dimensions of each data set
-	//int newDimension[3];
-	//mSeriesSet.at(0)->GetDimensions(newDimension);
-	//newDimension[2] = mSeriesSet.count();
-
-	//// Find the new origin of the data sets
-	//double newOrigin[3];
-	//mSeriesSet.at(0)->GetOrigin(newOrigin);
-
-	//// find the new spacings between each slice on all three orientations
-	//double newSpacings[3];
-	//mSeriesSet.at(0)->GetSpacing(newSpacings);
-	//double p1[4] = {0, 0, 0, 1};
-	//double p2[4] = {0, 0, 0, 1};
-	////mDataPatientMatrices.at(0)->MultiplyPoint(p1, p1);
-	////mDataPatientMatrices.at(1)->MultiplyPoint(p2, p2);
-	//double dist = qSqrt(qPow(p2[0] - p1[0], 2) + qPow(p2[1] - p1[1], 2) + qPow(p2[2] - p1[2], 2));
-	//newSpacings[2] = dist;
-
-	//// Keep the count of scalar components in the image data
-	//int numberOfScalarComponents = mSeriesSet.at(0)->GetNumberOfScalarComponents();
-
-	//// Create the new data sets
-	//for (int i = 0; i < newDataSetCount; i++) {
-	//	vtkSmartPointer<ImageData> im = vtkSmartPointer<ImageData>::New();
-	//	im->SetDimensions(newDimension);
-	//	im->SetSpacing(newSpacings);
-	//	im->SetOrigin(newOrigin);
-	//	im->AllocateScalars(mSeriesSet.at(0)->GetScalarType(), numberOfScalarComponents);
-
-	//	for (int j = 0; j < mSeriesSet.count(); j++) {
-	//		ImageData* data = mSeriesSet.at(j);
-	//		for (int x = 0; x < newDimension[0]; x++) {
-	//			for (int y = 0; y < newDimension[1]; y++) {
-	//				for (int k = 0; k < numberOfScalarComponents; k++) {
-	//					im->SetScalarComponentFromDouble(x, y, j, k, data->GetScalarComponentAsDouble(x, y, i, k));
-	//				}
-	//			}
-	//		}
-	//	}
-
-	//	newDataSets.push_back(im);
-	//	//newPatientMatrices.push_back(patientMatrix);
-	//	newFileSets.push_back(QVector<QString>());
-	//}
-
-	//mSeriesSet = newDataSets;
-	////mDataPatientMatrices = newPatientMatrices;
-	////mDataFiles = newFileSets;
-	//mIsSpatialDomain = true;
+	if (inputStudy.isNull()) {
+		qWarning() << "Failed to convert to spatial domain because the study is null.";
+		return StudyPtr();
+	}
+
+	QVector<SeriesDataVPtr> series;
+	for (int i = 0; i < inputStudy->getSeriesCount(); i++) {
+		series.append(inputStudy->getContiguousSeries(i));
+	}
+
+	// Each input series is one slice position over time.
+	StudyViewPtr view = StudyView::fromSeries(series, true);
+	if (view.isNull()) {
+		qWarning() << "Failed to convert study:" << inputStudy->getStudyID() << "to spatial domain.";
+		return StudyPtr();
+	}
+
+	view->reorderSlices(view->getSpatialSliceOrder());
+	if (view->getSliceCount() > 1) {
+		view->setSliceSpacing(view->getSliceDistance(0, 1));
+	}
+
+	StudyPtr spatialStudy(new Study(tr("%1_spatial").arg(inputStudy->getStudyID())));
+	spatialStudy->setPatientID(inputStudy->getPatientID());
+	spatialStudy->setPatientName(inputStudy->getPatientName());
+	spatialStudy->setStudyDate(inputStudy->getStudyDate());
+	spatialStudy->setStudyTime(inputStudy->getStudyTime());
+	spatialStudy->setView(view);
+
+	qDebug() << "Converted study:" << inputStudy->getStudyID() << "to" << view->getPhaseCount() <<
+		"phases of" << view->getSliceCount() << "slices";
+	return spatialStudy;
 }
 
 StudyPtr StudyAlgorithms::fixHeartStudy_DEBUG(StudyPtr heartStudy) {
@@ -209,7 +155,7 @@ StudyPtr StudyAlgorithms::fixHeartStudy_DEBUG(StudyPtr heartStudy) {
         series->SetSpacing(spacing[0], spacing[1], spacingZ);
 
         for (int z = 0; z < orderedStudy->getSeriesCount(); z++) {
-            vtkSmartPointer<SeriesData> timeData = orderedStudy->getSeries(z);
+            vtkSmartPointer<SeriesData> timeData = orderedStudy->getContiguousSeries(z);
             for (int y = 0; y < dims[1]; y++) {
                 for (int x = 0; x < dims[0]; x++) {
                     double value = timeData->GetScalarComponentAsDouble(x, y, i, 0);
@@ -274,7 +220,7 @@ StudyPtr StudyAlgorithms::loadBrainStudyFromText_DEBUG(const QString & filePath)
 }
 
 StudyPtr StudyAlgorithms::convertJieCardiacData_DEBUG(StudyPtr cardiacInline) {
-	SeriesDataVPtr cycle = cardiacInline->getSeries(0);
+	SeriesDataVPtr cycle = cardiacInline->getContiguousSeries(0);
 	int* dims = cycle->GetDimensions();
 	double* spac = cycle->GetSpacing();
 
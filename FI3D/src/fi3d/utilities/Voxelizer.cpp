@@ -0,0 +1,298 @@
+#include <fi3d/utilities/Voxelizer.h>
+
+#include <fi3d/logger/Logger.h>
+
+#include <fi3d/utilities/ModelAlgorithms.h>
+#include <fi3d/utilities/ParallelAlgorithms.h>
+
+#include <QVector>
+
+#include <vtkMath.h>
+#include <vtkPoints.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace fi3d;
+
+/// @brief Slabs made per thread, so threads that finish early take more.
+static const int SLABS_PER_THREAD = 4;
+
+/// @brief Gets the index of the voxel containing the coordinate along an axis.
+static int getVoxelIndex(const double& coordinate, const double& origin,
+	const double& spacing, const int& dimension)
+{
+	return qBound(0, (int)std::floor((coordinate - origin) / spacing + 0.5), dimension - 1);
+}
+
+/*!
+ * @brief Edge function of the point (y, z) to the edge from a to b, in the yz plane.
+ *
+ * It is evaluated from the lowest end of the edge, so the two triangles
+ * sharing an edge get exactly opposite values and a ray through the edge
+ * crosses only one of them.
+ */
+static double getEdgeValue(const double* a, const double* b, const double& y, const double& z) {
+	bool isSwapped = b[1] < a[1] || (b[1] == a[1] && b[2] < a[2]);
+	const double* from = isSwapped ? b : a;
+	const double* to = isSwapped ? a : b;
+	double value = (to[1] - from[1]) * (z - from[2]) - (to[2] - from[2]) * (y - from[1]);
+	return isSwapped ? -value : value;
+}
+
+/// @brief Whether a counter-clockwise triangle owns the points lying on its edge from a to b.
+static bool isOwnedEdge(const double* a, const double* b) {
+	double dy = b[1] - a[1];
+	double dz = b[2] - a[2];
+	return dz < 0 || (dz == 0 && dy > 0);
+}
+
+/// @brief Whether a value of the edge function is inside a counter-clockwise triangle.
+static bool isInsideEdge(const double& value, const double* a, const double* b) {
+	return value > 0 || (value == 0 && isOwnedEdge(a, b));
+}
+
+ImageDataVPtr Voxelizer::voxelize(vtkSmartPointer<vtkPolyData> modelData,
+	const double spacing[3], const bool& isFilled)
+{
+	qDebug() << "Enter - Voxelizing model with spacing: (" << spacing[0] << "," <<
+		spacing[1] << "," << spacing[2] << ") filled:" << isFilled;
+	ImageDataVPtr outData = ImageDataVPtr::New();
+
+	if (modelData.Get() == Q_NULLPTR || modelData->GetPoints() == Q_NULLPTR ||
+		modelData->GetNumberOfPoints() == 0)
+	{
+		qWarning() << "Failed to voxelize model because it has no points.";
+		return outData;
+	}
+	if (spacing[0] <= 0 || spacing[1] <= 0 || spacing[2] <= 0) {
+		qWarning() << "Failed to voxelize model because the spacing is not positive.";
+		return outData;
+	}
+
+	double bounds[6];
+	modelData->GetBounds(bounds);
+
+	int dimensions[3];
+	double origin[3];
+	double halfSize[3];
+	for (int i = 0; i < 3; i++) {
+		double value = (bounds[i * 2 + 1] - bounds[i * 2]) / spacing[i];
+		dimensions[i] = qMax(1, static_cast<int>(std::ceil(value)));
+		origin[i] = bounds[i * 2] + spacing[i] / 2;
+		halfSize[i] = spacing[i] / 2;
+	}
+	qDebug() << "Setting dimensions: (" << dimensions[0] << ", " << dimensions[1] << ", " << dimensions[2] << ")";
+
+	outData->SetSpacing(spacing[0], spacing[1], spacing[2]);
+	outData->SetDimensions(dimensions);
+	outData->SetOrigin(origin);
+	outData->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+
+	unsigned char* voxels = static_cast<unsigned char*>(outData->GetScalarPointer());
+	const qint64 rowSize = dimensions[0];
+	const qint64 sliceSize = rowSize * dimensions[1];
+	std::memset(voxels, 0, sliceSize * dimensions[2]);
+
+	// Copy the geometry once so the slabs read plain arrays.
+	vtkPoints* points = modelData->GetPoints();
+	vtkIdType pointCount = points->GetNumberOfPoints();
+	QVector<double> coordinates(pointCount * 3);
+	for (vtkIdType i = 0; i < pointCount; i++) {
+		points->GetPoint(i, coordinates.data() + i * 3);
+	}
+
+	QVector<vtkIdType> triangles = ModelAlgorithms::getTriangles(modelData);
+	int triangleCount = triangles.count() / 3;
+	qDebug() << "Voxelizing" << triangleCount << "triangles";
+
+	// The bounds of each triangle, in voxel indices.
+	QVector<int> voxelBounds(triangleCount * 6);
+	for (int t = 0; t < triangleCount; t++) {
+		const double* a = coordinates.constData() + triangles.at(t * 3) * 3;
+		const double* b = coordinates.constData() + triangles.at(t * 3 + 1) * 3;
+		const double* c = coordinates.constData() + triangles.at(t * 3 + 2) * 3;
+		for (int axis = 0; axis < 3; axis++) {
+			double low = qMin(a[axis], qMin(b[axis], c[axis]));
+			double high = qMax(a[axis], qMax(b[axis], c[axis]));
+			voxelBounds[t * 6 + axis * 2] = getVoxelIndex(low, origin[axis], spacing[axis], dimensions[axis]);
+			voxelBounds[t * 6 + axis * 2 + 1] = getVoxelIndex(high, origin[axis], spacing[axis], dimensions[axis]);
+		}
+	}
+
+	// Split the slices into slabs and list the triangles reaching each slab.
+	int slabCount = qMin(dimensions[2], ParallelAlgorithms::getThreadCount() * SLABS_PER_THREAD);
+	QVector<int> slabStarts(slabCount + 1);
+	QVector<int> sliceSlabs(dimensions[2]);
+	for (int slab = 0; slab <= slabCount; slab++) {
+		slabStarts[slab] = (int)((qint64)slab * dimensions[2] / slabCount);
+	}
+	for (int slab = 0; slab < slabCount; slab++) {
+		for (int k = slabStarts.at(slab); k < slabStarts.at(slab + 1); k++) {
+			sliceSlabs[k] = slab;
+		}
+	}
+
+	QVector<int> slabOffsets(slabCount + 1, 0);
+	for (int t = 0; t < triangleCount; t++) {
+		for (int slab = sliceSlabs.at(voxelBounds.at(t * 6 + 4)); slab <= sliceSlabs.at(voxelBounds.at(t * 6 + 5)); slab++) {
+			slabOffsets[slab + 1]++;
+		}
+	}
+	for (int slab = 0; slab < slabCount; slab++) {
+		slabOffsets[slab + 1] += slabOffsets.at(slab);
+	}
+	QVector<int> slabTriangles(slabOffsets.at(slabCount));
+	QVector<int> nextPlace = slabOffsets;
+	for (int t = 0; t < triangleCount; t++) {
+		for (int slab = sliceSlabs.at(voxelBounds.at(t * 6 + 4)); slab <= sliceSlabs.at(voxelBounds.at(t * 6 + 5)); slab++) {
+			slabTriangles[nextPlace[slab]++] = t;
+		}
+	}
+
+	// Each slab only writes its own slices.
+	ParallelAlgorithms::forRange(slabCount, [&](const int& slab) {
+		const int firstSlice = slabStarts.at(slab);
+		const int lastSlice = slabStarts.at(slab + 1) - 1;
+
+		// Rasterize the surface.
+		for (int s = slabOffsets.at(slab); s < slabOffsets.at(slab + 1); s++) {
+			const int t = slabTriangles.at(s);
+			const int* range = voxelBounds.constData() + t * 6;
+			const double* a = coordinates.constData() + triangles.at(t * 3) * 3;
+			const double* b = coordinates.constData() + triangles.at(t * 3 + 1) * 3;
+			const double* c = coordinates.constData() + triangles.at(t * 3 + 2) * 3;
+
+			for (int k = qMax(range[4], firstSlice); k <= qMin(range[5], lastSlice); k++) {
+				for (int j = range[2]; j <= range[3]; j++) {
+					for (int i = range[0]; i <= range[1]; i++) {
+						double center[3] = {
+							origin[0] + i * spacing[0],
+							origin[1] + j * spacing[1],
+							origin[2] + k * spacing[2]
+						};
+						if (Voxelizer::overlapsBox(center, halfSize, a, b, c)) {
+							voxels[i + j * rowSize + k * sliceSize] = INSIDE_VALUE;
+						}
+					}
+				}
+			}
+		}
+
+		if (!isFilled) {
+			return;
+		}
+
+		// Cast a ray along x through the center of each row of voxels.
+		QVector<QVector<double>> crossings(dimensions[1]);
+		for (int k = firstSlice; k <= lastSlice; k++) {
+			const double z = origin[2] + k * spacing[2];
+
+			for (int s = slabOffsets.at(slab); s < slabOffsets.at(slab + 1); s++) {
+				const int t = slabTriangles.at(s);
+				const int* range = voxelBounds.constData() + t * 6;
+				if (k < range[4] || k > range[5]) {
+					continue;
+				}
+
+				const double* a = coordinates.constData() + triangles.at(t * 3) * 3;
+				const double* b = coordinates.constData() + triangles.at(t * 3 + 1) * 3;
+				const double* c = coordinates.constData() + triangles.at(t * 3 + 2) * 3;
+				double area = getEdgeValue(a, b, c[1], c[2]);
+				if (area == 0) {
+					continue;
+				}
+				if (area < 0) {
+					std::swap(b, c);
+				}
+
+				for (int j = range[2]; j <= range[3]; j++) {
+					const double y = origin[1] + j * spacing[1];
+					double weightA = getEdgeValue(b, c, y, z);
+					double weightB = getEdgeValue(c, a, y, z);
+					double weightC = getEdgeValue(a, b, y, z);
+					if (!isInsideEdge(weightA, b, c) || !isInsideEdge(weightB, c, a) ||
+						!isInsideEdge(weightC, a, b))
+					{
+						continue;
+					}
+
+					double total = weightA + weightB + weightC;
+					crossings[j].append((weightA * a[0] + weightB * b[0] + weightC * c[0]) / total);
+				}
+			}
+
+			// Fill between each pair of crossings.
+			for (int j = 0; j < dimensions[1]; j++) {
+				QVector<double>& row = crossings[j];
+				std::sort(row.begin(), row.end());
+				for (int p = 0; p + 1 < row.count(); p += 2) {
+					int first = qMax(0, (int)std::ceil((row.at(p) - origin[0]) / spacing[0]));
+					int last = qMin(dimensions[0] - 1, (int)std::floor((row.at(p + 1) - origin[0]) / spacing[0]));
+					if (first <= last) {
+						std::memset(voxels + first + j * rowSize + k * sliceSize, INSIDE_VALUE, last - first + 1);
+					}
+				}
+				row.clear();
+			}
+		}
+	});
+
+	qDebug() << "Exit";
+	return outData;
+}
+
+bool Voxelizer::overlapsBox(const double center[3], const double halfSize[3],
+	const double a[3], const double b[3], const double c[3])
+{
+	double vertices[3][3];
+	for (int axis = 0; axis < 3; axis++) {
+		vertices[0][axis] = a[axis] - center[axis];
+		vertices[1][axis] = b[axis] - center[axis];
+		vertices[2][axis] = c[axis] - center[axis];
+	}
+
+	// The box normals.
+	for (int axis = 0; axis < 3; axis++) {
+		double low = qMin(vertices[0][axis], qMin(vertices[1][axis], vertices[2][axis]));
+		double high = qMax(vertices[0][axis], qMax(vertices[1][axis], vertices[2][axis]));
+		if (low > halfSize[axis] || high < -halfSize[axis]) {
+			return false;
+		}
+	}
+
+	double edges[3][3];
+	for (int axis = 0; axis < 3; axis++) {
+		edges[0][axis] = vertices[1][axis] - vertices[0][axis];
+		edges[1][axis] = vertices[2][axis] - vertices[1][axis];
+		edges[2][axis] = vertices[0][axis] - vertices[2][axis];
+	}
+
+	// The cross products of the box normals and the triangle edges.
+	for (int e = 0; e < 3; e++) {
+		for (int axis = 0; axis < 3; axis++) {
+			double boxAxis[3] = {0, 0, 0};
+			boxAxis[axis] = 1;
+			double direction[3];
+			vtkMath::Cross(boxAxis, edges[e], direction);
+
+			double p0 = vtkMath::Dot(vertices[0], direction);
+			double p1 = vtkMath::Dot(vertices[1], direction);
+			double p2 = vtkMath::Dot(vertices[2], direction);
+			double radius = halfSize[0] * std::fabs(direction[0]) +
+				halfSize[1] * std::fabs(direction[1]) + halfSize[2] * std::fabs(direction[2]);
+			if (qMin(p0, qMin(p1, p2)) > radius || qMax(p0, qMax(p1, p2)) < -radius) {
+				return false;
+			}
+		}
+	}
+
+	// The triangle normal.
+	double normal[3];
+	vtkMath::Cross(edges[0], edges[1], normal);
+	double distance = vtkMath::Dot(normal, vertices[0]);
+	double radius = halfSize[0] * std::fabs(normal[0]) +
+		halfSize[1] * std::fabs(normal[1]) + halfSize[2] * std::fabs(normal[2]);
+	return std::fabs(distance) <= radius;
+}
@@ -0,0 +1,174 @@
+#include <fi3d/data/data_manager/catalog/DataCatalog.h>
+
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QtTest>
+
+using namespace fi3d;
+
+/// @brief Creates the entry of a DICOM study.
+static CatalogEntry createStudyEntry(const QString& name) {
+	CatalogEntry entry;
+	entry.Type = EData::STUDY;
+	entry.ID = QUuid::createUuid();
+	entry.Name = name;
+	entry.PatientID = "P-" + name;
+	entry.PatientName = "Patient " + name;
+	entry.StudyDate = "20260101";
+	entry.StudyTime = "120000";
+	entry.SeriesCount = 2;
+	entry.IsDICOM = true;
+	return entry;
+}
+
+/// @brief Creates the DICOM files of two series.
+static QVector<QStringList> createDICOMPaths(const QString& name) {
+	return QVector<QStringList>{
+		{"/data/" + name + "/series0/0001.dcm", "/data/" + name + "/series0/0002.dcm"},
+		{"/data/" + name + "/series1/0001.dcm"}
+	};
+}
+
+/// @brief Gets the size of the file.
+static qint64 getFileSize(const QString& filePath) {
+	return QFileInfo(filePath).size();
+}
+
+class TestDataCatalog : public QObject {
+
+	Q_OBJECT
+
+private slots:
+	void reopenReadsEntries() {
+		QTemporaryDir dir;
+		QString filePath = dir.filePath("catalog.bin");
+		CatalogEntry study = createStudyEntry("A");
+
+		CatalogEntry image;
+		image.Type = EData::IMAGE;
+		image.ID = QUuid::createUuid();
+		image.Name = "Image";
+		image.Path = "/data/image.vti";
+		{
+			DataCatalog catalog(filePath);
+			QVERIFY(catalog.open());
+			QVERIFY(catalog.put(study, createDICOMPaths("A")));
+			QVERIFY(catalog.put(image));
+		}
+
+		DataCatalog catalog(filePath);
+		QVERIFY(catalog.open());
+		QCOMPARE(catalog.count(), 2);
+		QVERIFY(catalog.contains(study.ID));
+		QVERIFY(catalog.contains(image.ID));
+		QCOMPARE(catalog.readDICOMPaths(study.ID), createDICOMPaths("A"));
+		QVERIFY(catalog.readDICOMPaths(image.ID).isEmpty());
+	}
+
+	void truncatedRecordIsCutOff() {
+		QTemporaryDir dir;
+		QString filePath = dir.filePath("catalog.bin");
+		CatalogEntry first = createStudyEntry("A");
+		CatalogEntry torn = createStudyEntry("B");
+
+		qint64 firstEnd;
+		{
+			DataCatalog catalog(filePath);
+			QVERIFY(catalog.open());
+			QVERIFY(catalog.put(first, createDICOMPaths("A")));
+			firstEnd = getFileSize(filePath);
+			QVERIFY(catalog.put(torn, createDICOMPaths("B")));
+		}
+
+		// A crash while writing the second record leaves only part of it.
+		QFile file(filePath);
+		QVERIFY(file.resize(firstEnd + DataCatalog::RECORD_HEADER_SIZE + 3));
+
+		DataCatalog catalog(filePath);
+		QVERIFY(catalog.open());
+		QCOMPARE(catalog.count(), 1);
+		QVERIFY(catalog.contains(first.ID));
+		QVERIFY(!catalog.contains(torn.ID));
+		QCOMPARE(getFileSize(filePath), firstEnd);
+		QCOMPARE(catalog.readDICOMPaths(first.ID), createDICOMPaths("A"));
+
+		// Records appended after the cut are read back.
+		CatalogEntry next = createStudyEntry("C");
+		QVERIFY(catalog.put(next, createDICOMPaths("C")));
+		DataCatalog reopened(filePath);
+		QVERIFY(reopened.open());
+		QCOMPARE(reopened.count(), 2);
+		QCOMPARE(reopened.readDICOMPaths(next.ID), createDICOMPaths("C"));
+	}
+
+	void corruptRecordIsCutOff() {
+		QTemporaryDir dir;
+		QString filePath = dir.filePath("catalog.bin");
+		CatalogEntry first = createStudyEntry("A");
+		CatalogEntry corrupt = createStudyEntry("B");
+
+		qint64 firstEnd;
+		{
+			DataCatalog catalog(filePath);
+			QVERIFY(catalog.open());
+			QVERIFY(catalog.put(first));
+			firstEnd = getFileSize(filePath);
+			QVERIFY(catalog.put(corrupt));
+		}
+
+		// The size is right but a byte of the meta-data is not.
+		QFile file(filePath);
+		QVERIFY(file.open(QIODevice::ReadWrite));
+		QVERIFY(file.seek(firstEnd + DataCatalog::RECORD_HEADER_SIZE + 4));
+		char byte;
+		QVERIFY(file.getChar(&byte));
+		QVERIFY(file.seek(firstEnd + DataCatalog::RECORD_HEADER_SIZE + 4));
+		QVERIFY(file.putChar(byte ^ 0x5A));
+		file.close();
+
+		DataCatalog catalog(filePath);
+		QVERIFY(catalog.open());
+		QCOMPARE(catalog.count(), 1);
+		QVERIFY(catalog.contains(first.ID));
+		QVERIFY(!catalog.contains(corrupt.ID));
+		QCOMPARE(getFileSize(filePath), firstEnd);
+	}
+
+	void removalIsKept() {
+		QTemporaryDir dir;
+		QString filePath = dir.filePath("catalog.bin");
+		CatalogEntry removed = createStudyEntry("A");
+		CatalogEntry kept = createStudyEntry("B");
+		{
+			DataCatalog catalog(filePath);
+			QVERIFY(catalog.open());
+			QVERIFY(catalog.put(removed));
+			QVERIFY(catalog.put(kept));
+			QVERIFY(catalog.remove(removed.ID));
+		}
+
+		DataCatalog catalog(filePath);
+		QVERIFY(catalog.open());
+		QCOMPARE(catalog.count(), 1);
+		QVERIFY(catalog.contains(kept.ID));
+	}
+
+	void unknownFormatIsMovedAside() {
+		QTemporaryDir dir;
+		QString filePath = dir.filePath("catalog.bin");
+		QFile file(filePath);
+		QVERIFY(file.open(QIODevice::WriteOnly));
+		file.write("not a catalog");
+		file.close();
+
+		DataCatalog catalog(filePath);
+		QVERIFY(catalog.open());
+		QCOMPARE(catalog.count(), 0);
+		QVERIFY(QFile::exists(filePath + ".old"));
+		QCOMPARE(getFileSize(filePath), (qint64)DataCatalog::FILE_HEADER_SIZE);
+	}
+};
+
+QTEST_GUILESS_MAIN(TestDataCatalog)
+#include "TestDataCatalog.moc"
@@ -0,0 +1,120 @@
+#include <fi3d/data/data_manager/crawler/DicomScanCache.h>
+
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QtTest>
+
+using namespace fi3d;
+
+/// @brief Creates the record of a DICOM file with pixel data.
+static DicomFileRecord createDICOMRecord(const int& instanceNumber) {
+	DicomFileRecord record;
+	record.Size = 524288 + instanceNumber;
+	record.Modified = 1760000000000 + instanceNumber;
+	record.IsDICOM = true;
+	record.HasPixelData = true;
+	record.StudyUID = "1.2.840.113619.2.55.3";
+	record.SeriesUID = "1.2.840.113619.2.55.3.1";
+	record.StudyID = "4242";
+	record.PatientID = "P-0001";
+	record.PatientName = "Doe^Jane";
+	record.StudyDate = "20260101";
+	record.StudyTime = "120000";
+	record.InstanceNumber = instanceNumber;
+	return record;
+}
+
+/// @brief Compares every member of two records.
+static void compareRecords(const DicomFileRecord& actual, const DicomFileRecord& expected) {
+	QCOMPARE(actual.Size, expected.Size);
+	QCOMPARE(actual.Modified, expected.Modified);
+	QCOMPARE(actual.IsDICOM, expected.IsDICOM);
+	QCOMPARE(actual.HasPixelData, expected.HasPixelData);
+	QCOMPARE(actual.StudyUID, expected.StudyUID);
+	QCOMPARE(actual.SeriesUID, expected.SeriesUID);
+	QCOMPARE(actual.StudyID, expected.StudyID);
+	QCOMPARE(actual.PatientID, expected.PatientID);
+	QCOMPARE(actual.PatientName, expected.PatientName);
+	QCOMPARE(actual.StudyDate, expected.StudyDate);
+	QCOMPARE(actual.StudyTime, expected.StudyTime);
+	QCOMPARE(actual.InstanceNumber, expected.InstanceNumber);
+}
+
+class TestDicomScanCache : public QObject {
+
+	Q_OBJECT
+
+private slots:
+	void saveAndLoadRoundTrip() {
+		QTemporaryDir dir;
+		QString filePath = dir.filePath("scan.bin");
+
+		DicomFileRecord first = createDICOMRecord(1);
+		DicomFileRecord second = createDICOMRecord(2);
+		DicomFileRecord notDICOM;
+		notDICOM.Size = 12;
+		notDICOM.Modified = 1760000000000;
+
+		DicomScanCache saved;
+		saved.insert("/data/study/0001.dcm", first);
+		saved.insert("/data/study/0002.dcm", second);
+		saved.insert("/data/study/notes.txt", notDICOM);
+		QVERIFY(saved.save(filePath));
+
+		DicomScanCache loaded;
+		QVERIFY(loaded.load(filePath));
+		QCOMPARE(loaded.count(), 3);
+
+		DicomFileRecord record;
+		QVERIFY(loaded.find("/data/study/0001.dcm", first.Size, first.Modified, record));
+		compareRecords(record, first);
+		QVERIFY(loaded.find("/data/study/0002.dcm", second.Size, second.Modified, record));
+		compareRecords(record, second);
+		QVERIFY(loaded.find("/data/study/notes.txt", notDICOM.Size, notDICOM.Modified, record));
+		compareRecords(record, notDICOM);
+	}
+
+	void changedFileIsNotFound() {
+		DicomScanCache cache;
+		DicomFileRecord first = createDICOMRecord(1);
+		cache.insert("/data/study/0001.dcm", first);
+
+		DicomFileRecord record;
+		QVERIFY(!cache.find("/data/study/0001.dcm", first.Size + 1, first.Modified, record));
+		QVERIFY(!cache.find("/data/study/0001.dcm", first.Size, first.Modified + 1, record));
+		QVERIFY(!cache.find("/data/study/0003.dcm", first.Size, first.Modified, record));
+	}
+
+	void pruneRemovesUnseenFiles() {
+		DicomScanCache cache;
+		cache.insert("/data/study/0001.dcm", createDICOMRecord(1));
+		cache.insert("/data/study/0002.dcm", createDICOMRecord(2));
+		cache.insert("/data/other/0001.dcm", createDICOMRecord(1));
+
+		QCOMPARE(cache.prune("/data/study", QSet<QString>{"/data/study/0001.dcm"}), 1);
+		QCOMPARE(cache.count(), 2);
+	}
+
+	void truncatedFileIsIgnored() {
+		QTemporaryDir dir;
+		QString filePath = dir.filePath("scan.bin");
+
+		DicomScanCache saved;
+		saved.insert("/data/study/0001.dcm", createDICOMRecord(1));
+		saved.insert("/data/study/0002.dcm", createDICOMRecord(2));
+		QVERIFY(saved.save(filePath));
+
+		QFile file(filePath);
+		QVERIFY(file.resize(QFileInfo(filePath).size() - 5));
+
+		// The records loaded before are kept.
+		DicomScanCache loaded;
+		loaded.insert("/data/kept.dcm", createDICOMRecord(3));
+		QVERIFY(!loaded.load(filePath));
+		QCOMPARE(loaded.count(), 1);
+	}
+};
+
+QTEST_GUILESS_MAIN(TestDicomScanCache)
+#include "TestDicomScanCache.moc"
@@ -0,0 +1,133 @@
+#include <fi3d/data/ImageData.h>
+
+#include <QtTest>
+
+using namespace fi3d;
+
+/// @brief Checks an extent against [xMin, xMax, yMin, yMax, zMin, zMax].
+static bool isExtent(const int extent[6], const QVector<int>& expected) {
+	for (int i = 0; i < 6; i++) {
+		if (extent[i] != expected.at(i)) {
+			qWarning() << "Extent" << QVector<int>(extent, extent + 6) << "is not" << expected;
+			return false;
+		}
+	}
+	return true;
+}
+
+class TestImageData : public QObject {
+
+	Q_OBJECT
+
+private:
+	/// @brief Creates an 8x6x4 image.
+	ImageDataVPtr createImage() {
+		return ImageData::createImageData(8, 6, 4, 1.0, 1.0, 1.0);
+	}
+
+private slots:
+	void currentVersionHasNoChange() {
+		ImageDataVPtr image = this->createImage();
+		int extent[6];
+		QVERIFY(image->getChangedExtent(image->getDataVersion(), extent));
+		QVERIFY(extent[0] > extent[1] && extent[2] > extent[3] && extent[4] > extent[5]);
+	}
+
+	void extentsAreMerged() {
+		ImageDataVPtr image = this->createImage();
+		qint64 version = image->getDataVersion();
+
+		const int first[6] = {1, 2, 1, 1, 0, 0};
+		const int second[6] = {0, 0, 3, 4, 2, 2};
+		image->updateExtent(first);
+		image->updateExtent(second);
+		QCOMPARE(image->getDataVersion(), version + 2);
+
+		int extent[6];
+		QVERIFY(image->getChangedExtent(version, extent));
+		QVERIFY(isExtent(extent, {0, 2, 1, 4, 0, 2}));
+
+		// A copy at the version of the first change only misses the second.
+		QVERIFY(image->getChangedExtent(version + 1, extent));
+		QVERIFY(isExtent(extent, {0, 0, 3, 4, 2, 2}));
+	}
+
+	void slicesSpanTheImage() {
+		ImageDataVPtr image = this->createImage();
+		qint64 version = image->getDataVersion();
+
+		image->updateSlice(3, ESliceOrientation::XY);
+		int extent[6];
+		QVERIFY(image->getChangedExtent(version, extent));
+		QVERIFY(isExtent(extent, {0, 7, 0, 5, 3, 3}));
+
+		image->updateSlice(5, ESliceOrientation::YZ);
+		QVERIFY(image->getChangedExtent(version + 1, extent));
+		QVERIFY(isExtent(extent, {5, 5, 0, 5, 0, 3}));
+	}
+
+	void extentIsClamped() {
+		ImageDataVPtr image = this->createImage();
+		qint64 version = image->getDataVersion();
+
+		const int outside[6] = {-4, 20, 2, 3, -1, 1};
+		image->updateExtent(outside);
+		int extent[6];
+		QVERIFY(image->getChangedExtent(version, extent));
+		QVERIFY(isExtent(extent, {0, 7, 2, 3, 0, 1}));
+
+		// An extent that misses the image changes nothing.
+		const int missing[6] = {10, 12, 0, 5, 0, 3};
+		image->updateExtent(missing);
+		QCOMPARE(image->getDataVersion(), version + 1);
+	}
+
+	void wholeUpdateIsUnknown() {
+		ImageDataVPtr image = this->createImage();
+		qint64 version = image->getDataVersion();
+
+		const int slice[6] = {0, 7, 0, 5, 1, 1};
+		image->updateExtent(slice);
+		image->dataUpdated();
+		image->updateExtent(slice);
+
+		int extent[6];
+		QVERIFY(!image->getChangedExtent(version, extent));
+		QVERIFY(!image->getChangedExtent(version + 1, extent));
+		QVERIFY(image->getChangedExtent(version + 2, extent));
+		QVERIFY(isExtent(extent, {0, 7, 0, 5, 1, 1}));
+
+		// A version the image does not have yet is unknown too.
+		QVERIFY(!image->getChangedExtent(image->getDataVersion() + 1, extent));
+	}
+
+	void oldVersionsAreForgotten() {
+		ImageDataVPtr image = this->createImage();
+		qint64 version = image->getDataVersion();
+
+		const int slice[6] = {0, 7, 0, 5, 1, 1};
+		for (int i = 0; i <= ImageData::MAX_DIRTY_EXTENTS; i++) {
+			image->updateExtent(slice);
+		}
+
+		int extent[6];
+		QVERIFY(!image->getChangedExtent(version, extent));
+		QVERIFY(image->getChangedExtent(version + 1, extent));
+	}
+
+	void windowLevelKeepsTheVersion() {
+		ImageDataVPtr image = this->createImage();
+		qint64 version = image->getDataVersion();
+
+		image->setWindowLevel(100.0, 50.0);
+		QCOMPARE(image->getDataVersion(), version);
+
+		double window, level;
+		image->getWindowLevel(window, level);
+		QCOMPARE(window, 100.0);
+		QCOMPARE(level, 50.0);
+	}
+};
+
+QTEST_GUILESS_MAIN(TestImageData)
+#include "TestImageData.moc"
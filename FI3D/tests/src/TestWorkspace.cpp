@@ -0,0 +1,138 @@
+#include <fi3d/CUDA/cpu_computations.h>
+#include <fi3d/CUDA/cuda_helpers.h>
+
+#include <QVector>
+#include <QtTest>
+
+#include <vtkNew.h>
+
+#include <cmath>
+
+using namespace fi3d;
+
+/// @brief The geometry of the robot, in mm.
+static const float SEPARATION = 100.0f;
+static const float RANGE = 30.0f;
+static const float DEPTH_MIN = 20.0f;
+static const float DEPTH_MAX = 120.0f;
+
+/// @brief The largest distance allowed between the points of two kernels, in mm.
+static const double TOLERANCE = 1e-3;
+
+/*!
+ * @brief Computes the points the CUDA kernels compute, one block i and thread
+ * j at a time, with the equations of cuda_computations.cu.
+ */
+static QVector<float> computeKernelPoints(const bool& isCone, const int& blocks, const int& threads,
+	const float& blockStepSize, const float& threadStepSize)
+{
+	QVector<float> points(blocks * threads * 3);
+	for (int i = 0; i < blocks; i++) {
+		for (int j = 0; j < threads; j++) {
+			float radius = isCone ? RANGE : (i + 1) * blockStepSize;
+			float depth = isCone ? (i + 1) * blockStepSize + DEPTH_MIN : DEPTH_MIN;
+			float theta = (j + 1) * threadStepSize;
+
+			float x = radius * cosf(theta);
+			float y = radius * sinf(theta);
+			float magnitude = sqrtf(x * x + y * y + SEPARATION * SEPARATION);
+
+			int position = (i * threads + j) * 3;
+			points[position] = x + depth * x / magnitude;
+			points[position + 1] = y + depth * y / magnitude;
+			points[position + 2] = SEPARATION + depth * SEPARATION / magnitude;
+		}
+	}
+	return points;
+}
+
+/// @brief Gets the largest distance, along any axis, between the points.
+static double getMaxError(const QVector<float>& expected, const float* actual) {
+	double maxError = 0;
+	for (int i = 0; i < expected.count(); i++) {
+		maxError = qMax(maxError, (double)std::abs(expected.at(i) - actual[i]));
+	}
+	return maxError;
+}
+
+class TestWorkspace : public QObject {
+
+	Q_OBJECT
+
+private slots:
+	void cpuMatchesKernels_data() {
+		QTest::addColumn<bool>("isCone");
+		QTest::addColumn<int>("rows");
+		QTest::addColumn<int>("rotations");
+
+		QTest::newRow("sphere 1x1") << false << 1 << 1;
+		QTest::newRow("sphere 7x13") << false << 7 << 13;
+		QTest::newRow("sphere 64x1024") << false << 64 << 1024;
+		QTest::newRow("cone 1x1") << true << 1 << 1;
+		QTest::newRow("cone 7x13") << true << 7 << 13;
+		QTest::newRow("cone 1024x64") << true << 1024 << 64;
+	}
+
+	void cpuMatchesKernels() {
+		QFETCH(bool, isCone);
+		QFETCH(int, rows);
+		QFETCH(int, rotations);
+
+		const float rowStepSize = isCone ? (DEPTH_MAX - DEPTH_MIN) / rows : RANGE / rows;
+		const float pointStepSize = 6.28318f / rotations;
+		QVector<float> expected = computeKernelPoints(isCone, rows, rotations, rowStepSize, pointStepSize);
+
+		QVector<float> points(rows * rotations * 3);
+		if (isCone) {
+			CUDA::computeMK3Workspace_cone_cpu(points.data(), rows, rotations, rowStepSize, pointStepSize,
+				SEPARATION, RANGE, DEPTH_MIN);
+		} else {
+			CUDA::computeMK3Workspace_sphere_cpu(points.data(), rows, rotations, rowStepSize, pointStepSize,
+				SEPARATION, DEPTH_MIN);
+		}
+		QVERIFY(getMaxError(expected, points.constData()) < TOLERANCE);
+	}
+
+	/*!
+	 * The helpers run the CUDA kernels when built with CUDA and the CPU
+	 * kernels otherwise. Either way they must append the same points.
+	 */
+	void helpersAppendKernelPoints() {
+		const int rows = 16, rotations = 32;
+		vtkNew<ModelData> workspace;
+		CUDA::computeMK3Workspace_sphere(*workspace, SEPARATION, DEPTH_MIN, RANGE, rows, rotations);
+		CUDA::computeMK3Workspace_cone(*workspace, SEPARATION, DEPTH_MIN, DEPTH_MAX, RANGE, rows, rotations);
+
+		QVector<float> expected = computeKernelPoints(false, rows, rotations, RANGE / rows, 6.28318f / rotations);
+		expected += computeKernelPoints(true, rows, rotations, (DEPTH_MAX - DEPTH_MIN) / rows, 6.28318f / rotations);
+
+		vtkPoints* points = workspace->GetPoints();
+		QVERIFY(points != Q_NULLPTR);
+		QCOMPARE(points->GetDataType(), VTK_FLOAT);
+		QCOMPARE(points->GetNumberOfPoints() * 3, (vtkIdType)expected.count());
+		QVERIFY(getMaxError(expected, static_cast<float*>(points->GetData()->GetVoidPointer(0))) < TOLERANCE);
+	}
+
+	/// The sphere of an old workspace with double points is kept when the cone is appended.
+	void helpersKeepExistingPoints() {
+		vtkNew<ModelData> workspace;
+		vtkNew<vtkPoints> existing;
+		existing->SetDataTypeToDouble();
+		existing->InsertNextPoint(1.0, 2.0, 3.0);
+		workspace->SetPoints(existing);
+
+		CUDA::computeMK3Workspace_cone(*workspace, SEPARATION, DEPTH_MIN, DEPTH_MAX, RANGE, 2, 3);
+
+		vtkPoints* points = workspace->GetPoints();
+		QCOMPARE(points->GetDataType(), VTK_FLOAT);
+		QCOMPARE(points->GetNumberOfPoints(), (vtkIdType)7);
+		double first[3];
+		points->GetPoint(0, first);
+		QCOMPARE(first[0], 1.0);
+		QCOMPARE(first[1], 2.0);
+		QCOMPARE(first[2], 3.0);
+	}
+};
+
+QTEST_GUILESS_MAIN(TestWorkspace)
+#include "TestWorkspace.moc"
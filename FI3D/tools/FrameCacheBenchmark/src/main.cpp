@@ -0,0 +1,198 @@
+#include <fi3d/rendering/visuals/3D/models/AnimatedModel.h>
+#include <fi3d/rendering/visuals/3D/slices/AnimatedStudySlice.h>
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <QTextStream>
+#include <QtMath>
+#include <QVector>
+
+#include <vtkNew.h>
+#include <vtkRenderer.h>
+#include <vtkRenderWindow.h>
+#include <vtkSphereSource.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace fi3d;
+
+/// @brief Timings of one playback run, in ns.
+typedef struct PlaybackTimings {
+	/// @brief Time spent switching the visuals to the next frame.
+	QVector<qint64> SwitchTimes;
+	/// @brief Time spent switching and rendering the frame.
+	QVector<qint64> FrameTimes;
+} PlaybackTimings;
+
+/// @brief Creates an animation of a sphere that grows and shrinks.
+static AnimatedModelDataPtr createBeatingSphere(const int& frameCount,
+	const int& resolution, const double& offset)
+{
+	AnimatedModelDataPtr animation(new AnimatedModelData());
+	for (int i = 0; i < frameCount; i++) {
+		ModelDataVPtr frame = ModelDataVPtr::New();
+		vtkNew<vtkSphereSource> sphereSource;
+		sphereSource->SetRadius(40.0 + 10.0 * std::sin(2.0 * M_PI * i / frameCount));
+		sphereSource->SetCenter(64.0 + offset, 64.0, 20.0);
+		sphereSource->SetThetaResolution(resolution);
+		sphereSource->SetPhiResolution(resolution);
+		sphereSource->SetOutput(frame);
+		sphereSource->Update();
+		animation->addAnimationFrame(frame);
+	}
+	return animation;
+}
+
+/// @brief Creates a Study with one series per frame.
+static StudyPtr createCineStudy(const int& frameCount, const int& size, const int& slices) {
+	StudyPtr study(new Study("FrameCacheBenchmark"));
+	for (int i = 0; i < frameCount; i++) {
+		SeriesDataVPtr series = study->createAndAddSeries();
+		series->SetDimensions(size, size, slices);
+		series->SetSpacing(128.0 / size, 128.0 / size, 4.0);
+		series->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+
+		unsigned char* scalars = static_cast<unsigned char*>(series->GetScalarPointer());
+		qint64 voxelCount = (qint64)size * size * slices;
+		for (qint64 v = 0; v < voxelCount; v++) {
+			scalars[v] = (unsigned char)((v + i * 7) % 251);
+		}
+	}
+	return study;
+}
+
+/// @brief Plays every frame once without timing, then times the cycles.
+static PlaybackTimings play(vtkRenderWindow* renderWindow,
+	const QVector<AnimatedModelPtr>& models, AnimatedStudySlicePtr slice,
+	const int& frameCount, const int& cycles)
+{
+	PlaybackTimings timings;
+	QElapsedTimer clock;
+	clock.start();
+
+	for (int cycle = -1; cycle < cycles; cycle++) {
+		for (int frame = 0; frame < frameCount; frame++) {
+			qint64 start = clock.nsecsElapsed();
+			for (AnimatedModelPtr model : models) {
+				model->setFrame(frame);
+			}
+			slice->setSeriesIndex(frame);
+			qint64 switched = clock.nsecsElapsed();
+
+			renderWindow->Render();
+			renderWindow->WaitForCompletion();
+			qint64 rendered = clock.nsecsElapsed();
+
+			if (cycle >= 0) {
+				timings.SwitchTimes.append(switched - start);
+				timings.FrameTimes.append(rendered - start);
+			}
+		}
+	}
+	return timings;
+}
+
+/// @brief Gets the value at the given percentile [0, 100], in ms.
+static double getPercentile(QVector<qint64> times, const double& percentile) {
+	if (times.isEmpty()) {
+		return 0;
+	}
+
+	int rank = (int)std::ceil(percentile / 100.0 * times.count()) - 1;
+	rank = qBound(0, rank, times.count() - 1);
+	std::nth_element(times.begin(), times.begin() + rank, times.end());
+	return times.at(rank) / 1.0e6;
+}
+
+/// @brief Gets the average, in ms.
+static double getAverage(const QVector<qint64>& times) {
+	if (times.isEmpty()) {
+		return 0;
+	}
+
+	double total = 0;
+	for (qint64 time : times) {
+		total += time;
+	}
+	return total / times.count() / 1.0e6;
+}
+
+int main(int argc, char *argv[])
+{
+	QCoreApplication app(argc, argv);
+	QCoreApplication::setApplicationName("FI3DFrameCacheBenchmark");
+	QLoggingCategory::setFilterRules("*.debug=false");
+
+	QCommandLineParser parser;
+	parser.setApplicationDescription(
+		"Measures the frame switch and render time of animated visuals with "
+		"and without the frame cache, rendering offscreen.");
+	parser.addHelpOption();
+
+	QCommandLineOption framesOption("frames", "Frames in the animation.", "count", "25");
+	QCommandLineOption modelsOption("models", "Number of animated models.", "count", "2");
+	QCommandLineOption resolutionOption("resolution",
+		"Sphere resolution of the models, triangles grow with its square.", "count", "200");
+	QCommandLineOption imageOption("image", "In-plane size of the series.", "voxels", "256");
+	QCommandLineOption slicesOption("slices", "Slices in each series.", "count", "10");
+	QCommandLineOption cyclesOption("cycles", "Timed playbacks of the animation.", "count", "10");
+	QCommandLineOption sizeOption("size", "Width and height of the render window.", "pixels", "800");
+	parser.addOptions({framesOption, modelsOption, resolutionOption, imageOption,
+		slicesOption, cyclesOption, sizeOption});
+	parser.process(app);
+
+	int frameCount = qMax(2, parser.value(framesOption).toInt());
+	int modelCount = qMax(0, parser.value(modelsOption).toInt());
+	int cycles = qMax(1, parser.value(cyclesOption).toInt());
+	int size = qMax(16, parser.value(sizeOption).toInt());
+
+	vtkNew<vtkRenderer> renderer;
+	vtkNew<vtkRenderWindow> renderWindow;
+	renderWindow->SetOffScreenRendering(1);
+	renderWindow->SetSize(size, size);
+	renderWindow->AddRenderer(renderer);
+
+	QVector<AnimatedModelPtr> models;
+	for (int i = 0; i < modelCount; i++) {
+		AnimatedModelPtr model(new AnimatedModel(QString("Model%1").arg(i),
+			createBeatingSphere(frameCount, parser.value(resolutionOption).toInt(), i * 2.0)));
+		model->setOpacity(0.5);
+		renderer->AddActor(model->getActor());
+		models.append(model);
+	}
+
+	AnimatedStudySlicePtr slice(new AnimatedStudySlice("Slice", ESliceOrientation::XY,
+		createCineStudy(frameCount, qMax(2, parser.value(imageOption).toInt()),
+			qMax(1, parser.value(slicesOption).toInt()))));
+	renderer->AddViewProp(slice->getActor());
+	renderer->ResetCamera();
+
+	QTextStream stream(stdout);
+	stream << QString("%1 frames, %2 models, %3x%3 window, %4 cycles\n\n")
+		.arg(frameCount).arg(modelCount).arg(size).arg(cycles);
+	stream << QString("%1 %2 %3 %4 %5\n")
+		.arg("mode", -8).arg("switch(ms)", 11).arg("p50(ms)", 9)
+		.arg("p99(ms)", 9).arg("fps", 8);
+
+	for (bool isCached : {false, true}) {
+		for (AnimatedModelPtr model : models) {
+			model->setFrameCacheEnabled(isCached);
+		}
+		slice->setFrameCacheEnabled(isCached);
+
+		PlaybackTimings timings = play(renderWindow, models, slice, frameCount, cycles);
+		double averageFrame = getAverage(timings.FrameTimes);
+		stream << QString("%1 %2 %3 %4 %5\n")
+			.arg(isCached ? "cached" : "swap", -8)
+			.arg(getAverage(timings.SwitchTimes), 11, 'f', 3)
+			.arg(getPercentile(timings.FrameTimes, 50), 9, 'f', 2)
+			.arg(getPercentile(timings.FrameTimes, 99), 9, 'f', 2)
+			.arg(averageFrame > 0 ? 1000.0 / averageFrame : 0, 8, 'f', 1);
+		stream.flush();
+	}
+
+	return 0;
+}
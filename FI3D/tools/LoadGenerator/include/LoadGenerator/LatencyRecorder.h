@@ -0,0 +1,94 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		LatencyRecorder.h
+* @class	loadgen::LatencyRecorder
+* @brief	Collects per-operation latencies of the simulated FIs.
+*
+* Every operation a simulated FI performs is recorded as sent. Once the
+* matching response arrives, its latency (in microseconds) is recorded. If no
+* response arrives within the configured timeout, it is recorded as a timeout.
+*
+* The recorder is shared by all the simulated FIs, which all run on the same
+* thread, so no synchronization is needed.
+*/
+
+#include <QJsonObject>
+#include <QString>
+#include <QTextStream>
+#include <QVector>
+
+namespace loadgen {
+
+/// @brief The operations that a simulated FI can replay against the server.
+enum LoadOperation {
+	/// @brief Selects a slice and fetches the slice data.
+	SLICE_SCROLL = 0,
+	/// @brief Fetches the data of a Model.
+	MODEL_FETCH = 1,
+	/// @brief Translates a visual and waits for the transform update.
+	TRANSFORM = 2,
+	/// @brief Changes a module interaction and waits for the update.
+	INTERACTION = 3,
+	/// @brief Number of operations, not an operation itself.
+	OPERATION_COUNT = 4
+};
+
+/// @brief Gets the name used to identify the operation on the command line.
+QString getLoadOperationName(const int& operation);
+
+/// @brief Gets the operation from its name, -1 if the name is unknown.
+int getLoadOperationFromName(const QString& name);
+
+class LatencyRecorder {
+private:
+	/// @brief The recorded latencies in microseconds, per operation.
+	QVector<QVector<qint64>> mLatencies;
+
+	/// @brief Number of requests sent, per operation.
+	QVector<qint64> mSentCounts;
+
+	/// @brief Number of requests that timed out, per operation.
+	QVector<qint64> mTimeoutCounts;
+
+	/// @brief Number of bytes received from the server.
+	qint64 mReceivedBytes;
+
+	/// @brief Number of messages received from the server.
+	qint64 mReceivedMessages;
+
+public:
+	/// @brief Constructor.
+	LatencyRecorder();
+
+	/// @brief Destructor.
+	~LatencyRecorder();
+
+	/// @brief Clears all the recorded values.
+	void reset();
+
+	/// @brief Records that a request was sent.
+	void addSent(const int& operation);
+
+	/// @brief Records the latency of a completed request.
+	void addLatency(const int& operation, const qint64& latencyUs);
+
+	/// @brief Records that a request did not receive a response in time.
+	void addTimeout(const int& operation);
+
+	/// @brief Records a message received from the server.
+	void addReceived(const qint64& bytes);
+
+	/// @brief Gets the number of completed requests.
+	qint64 getCompletedCount(const int& operation) const;
+
+	/// @brief Gets the latency at the given percentile [0, 100] in us.
+	qint64 getPercentile(const int& operation, const double& percentile) const;
+
+	/// @brief Writes a human readable report.
+	void printReport(QTextStream& stream, const double& elapsedSeconds) const;
+
+	/// @brief Creates a JSON report, used to compare between builds.
+	QJsonObject toJson(const double& elapsedSeconds) const;
+};
+}
@@ -0,0 +1,60 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		LoadConfiguration.h
+* @brief	Parameters of a load generation run.
+*/
+
+#include <LoadGenerator/LatencyRecorder.h>
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace loadgen {
+
+/// @brief Parameters shared by the LoadGenerator and its simulated FIs.
+typedef struct LoadConfiguration {
+	/// @brief Address of the FI3D server.
+	QString Host = "localhost";
+
+	/// @brief Port of the FI3D server.
+	int Port = 9000;
+
+	/// @brief Whether the connection should be encrypted.
+	bool UseSSL = false;
+
+	/// @brief Password used to authenticate.
+	QString Password = "admin";
+
+	/// @brief Module ID or module name to subscribe to.
+	QString Module = "Demonstration";
+
+	/// @brief Whether the module should be started when it is not active.
+	bool StartModule = false;
+
+	/// @brief Number of simulated FIs.
+	int ClientCount = 1;
+
+	/// @brief Operations per second issued by each simulated FI.
+	double Rate = 10;
+
+	/// @brief Duration of the measured run in seconds.
+	double Duration = 30;
+
+	/// @brief Seconds to run before measurements start.
+	double WarmUp = 2;
+
+	/// @brief Milliseconds after which an unanswered request times out.
+	int Timeout = 5000;
+
+	/// @brief Relative weight of each LoadOperation in the mix.
+	QVector<double> Mix = QVector<double>(OPERATION_COUNT, 1.0);
+
+	/// @brief Module interactions to change, empty for all of them.
+	QStringList Interactions;
+
+	/// @brief Seed of the random generator, to replay the same sequence.
+	quint32 Seed = 0;
+} LoadConfiguration;
+}
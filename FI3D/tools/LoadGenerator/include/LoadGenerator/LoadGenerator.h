@@ -0,0 +1,101 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		LoadGenerator.h
+* @class	loadgen::LoadGenerator
+* @brief	Drives a number of simulated FIs against an FI3D server.
+*
+* Once every simulated FI has subscribed, each of them performs operations at
+* the configured rate. The operation is randomly chosen using the weights of
+* the configured mix, skipping operations the FI has no targets for. The first
+* seconds of the run are a warm-up and are not measured. At the end of the run
+* the LatencyRecorder report is printed and, optionally, written as JSON so
+* that runs from different builds can be compared.
+*/
+
+#include <LoadGenerator/LatencyRecorder.h>
+#include <LoadGenerator/LoadConfiguration.h>
+#include <LoadGenerator/SimulatedFI.h>
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QRandomGenerator>
+#include <QSharedPointer>
+#include <QTimer>
+#include <QVector>
+
+namespace loadgen {
+class LoadGenerator : public QObject {
+
+	Q_OBJECT
+
+signals:
+	/// @brief Emitted when the run is over, with the process exit code.
+	void finished(const int& exitCode) const;
+
+private:
+	/// @brief The configuration of the run.
+	LoadConfiguration mConfig;
+
+	/// @brief Where the latencies are recorded.
+	LatencyRecorder mRecorder;
+
+	/// @brief The simulated FIs.
+	QVector<QSharedPointer<SimulatedFI>> mClients;
+
+	/// @brief The timers that trigger the operations of each FI.
+	QVector<QSharedPointer<QTimer>> mOperationTimers;
+
+	/// @brief Periodically expires requests without a response.
+	QTimer mExpirationTimer;
+
+	/// @brief Fails the run if the FIs do not subscribe in time.
+	QTimer mSubscriptionTimer;
+
+	/// @brief Random generator used to select the operations.
+	QRandomGenerator mRandom;
+
+	/// @brief Measures the duration of the measured run.
+	QElapsedTimer mRunClock;
+
+	/// @brief Number of FIs subscribed so far.
+	int mSubscribedCount;
+
+	/// @brief Path of the JSON report, empty to not write it.
+	QString mJsonReportPath;
+
+public:
+	/// @brief Constructor.
+	LoadGenerator(const LoadConfiguration& config);
+
+	/// @brief Destructor.
+	~LoadGenerator();
+
+	/// @brief Sets the path where the JSON report is written.
+	void setJsonReportPath(const QString& path);
+
+public slots:
+	/// @brief Connects all the simulated FIs.
+	void start();
+
+private slots:
+	/// @brief Starts the operations once every FI is subscribed.
+	void onClientSubscribed();
+
+	/// @brief Aborts the run.
+	void onClientFailed(const QString& reason);
+
+	/// @brief Ends the warm-up and starts measuring.
+	void startMeasuring();
+
+	/// @brief Prints the report and ends the run.
+	void stop();
+
+private:
+	/// @brief Performs a randomly chosen operation on the given FI.
+	void performOperation(SimulatedFI* client);
+
+	/// @brief Stops all the timers and disconnects the FIs.
+	void shutdown();
+};
+}
@@ -0,0 +1,214 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		SimulatedFI.h
+* @class	loadgen::SimulatedFI
+* @brief	A headless framework interface (FI) that generates load.
+*
+* The simulated FI connects to the FI3D server, authenticates, and subscribes
+* to a module the same way a headset does. From the subscription response it
+* collects the targets for each LoadOperation: slices to scroll, models to
+* fetch, visuals to transform and module interactions to change.
+*
+* Each call to performOperation sends one request and remembers when it was
+* sent under a key that identifies the response it expects. When a matching
+* response arrives the latency is given to the LatencyRecorder. Scene updates
+* are batched by the server, so one update may answer several requests with
+* the same key, in which case all of them are completed.
+*
+* Slice scrolls are measured end-to-end: the SetSlice update triggers the data
+* request of the new slice, as the FI module does, and the operation completes
+* when the slice data arrives.
+*/
+
+#include <LoadGenerator/LatencyRecorder.h>
+#include <LoadGenerator/LoadConfiguration.h>
+
+#include <fi3d/server/message_keys/EMessage.h>
+#include <fi3d/server/network/ClientFI3D.h>
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonValue>
+#include <QList>
+#include <QRandomGenerator>
+
+namespace loadgen {
+
+/// @brief A slice visual that can be scrolled.
+typedef struct SliceTarget {
+	QString VisualID;
+	int DataType;
+	QString DataID;
+	int SliceIndex;
+	int SliceOrientation;
+	int SeriesIndex;
+	int SliceCount;
+	int Direction;
+} SliceTarget;
+
+/// @brief A module interaction that can be changed.
+typedef struct InteractionTarget {
+	QString InteractionID;
+	int InteractionType;
+	QJsonValue Value;
+	bool HasMin;
+	bool HasMax;
+	double Min;
+	double Max;
+	int OptionCount;
+} InteractionTarget;
+
+/// @brief A request waiting for its response.
+typedef struct PendingRequest {
+	int Operation;
+	qint64 SentAt;
+} PendingRequest;
+
+class SimulatedFI : public fi3d::ClientFI3D {
+
+	Q_OBJECT
+
+signals:
+	/// @brief Emitted once the FI has subscribed to the module.
+	void subscribed() const;
+
+	/// @brief Emitted when the FI cannot continue.
+	void failed(const QString& reason) const;
+
+private:
+	/// @brief The configuration of the run.
+	const LoadConfiguration& mConfig;
+
+	/// @brief Where the latencies are recorded.
+	LatencyRecorder* mRecorder;
+
+	/// @brief Monotonic clock used to time requests.
+	QElapsedTimer mClock;
+
+	/// @brief Random generator used to select targets.
+	QRandomGenerator mRandom;
+
+	/// @brief The client ID assigned by the server.
+	QString mClientID;
+
+	/// @brief The ID of the module subscribed to.
+	QString mModuleID;
+
+	/// @brief Whether the start module request was already sent.
+	bool mRequestedModuleStart;
+
+	/// @brief Whether the subscription response has been received.
+	bool mIsSubscribed;
+
+	/// @brief Requests waiting for a response, by expected response key.
+	QHash<QString, QList<PendingRequest>> mPendingRequests;
+
+	/// @brief Slices that can be scrolled.
+	QList<SliceTarget> mSlices;
+
+	/// @brief DataIDs of Models that can be fetched.
+	QList<QString> mModels;
+
+	/// @brief IDs of visuals that can be transformed.
+	QList<QString> mVisuals;
+
+	/// @brief Module interactions that can be changed.
+	QList<InteractionTarget> mInteractions;
+
+	/// @brief Number of transforms sent, used to alternate directions.
+	quint64 mTransformCount;
+
+public:
+	/// @brief Constructor.
+	SimulatedFI(const int& index, const LoadConfiguration& config, LatencyRecorder* recorder);
+
+	/// @brief Destructor.
+	~SimulatedFI();
+
+	/// @brief Whether the FI has targets for the given operation.
+	bool canPerform(const int& operation) const;
+
+	/// @brief Whether the FI is subscribed to the module.
+	bool isSubscribed() const;
+
+public slots:
+	/// @brief Connects to the server.
+	void start();
+
+	/// @brief Sends one request of the given operation.
+	void performOperation(const int& operation);
+
+	/// @brief Records requests that have waited too long as timed out.
+	void expireRequests();
+
+	/// @brief Forgets the requests waiting for a response without recording
+	/// them, e.g. those of the warm up when the measurement starts.
+	void clearPending();
+
+private slots:
+	/// @brief Handles every message received.
+	void onMessage(fi3d::MessagePtr message);
+
+private:
+	/*!
+	* @name Message handlers.
+	*/
+	/// @{
+	void handleAuthentication(const QJsonObject& info);
+	void handleApplication(const QJsonObject& info);
+	void handleModule(const QJsonObject& info);
+	void handleData(const QJsonObject& info);
+	/// @}
+
+	/// @brief Collects the targets announced in the subscription response.
+	void collectTargets(const QJsonArray& visualsInfo, const QJsonArray& interactionsInfo);
+
+	/// @brief Collects a single visual (and its parts) as targets.
+	void collectVisual(const QJsonObject& visualInfo, const bool& isPart);
+
+	/*!
+	* @name Operations.
+	*/
+	/// @{
+	void scrollSlice();
+	void fetchModel();
+	void transformVisual();
+	void changeInteraction();
+	/// @}
+
+	/// @brief Requests the data of the slice currently shown by the target.
+	void requestSliceData(const SliceTarget& slice);
+
+	/// @brief Remembers a request that waits for the response with the key.
+	void addPending(const QString& key, const int& operation, const qint64& sentAt);
+
+	/// @brief Completes all the requests waiting for the response with the key.
+	QList<PendingRequest> completePending(const QString& key);
+
+	/*!
+	* @name Request senders, insert the common request keys.
+	*/
+	/// @{
+	void sendRequest(const fi3d::EMessage& messageType, const QString& paramsKey, const QJsonObject& params);
+	void sendModuleRequest(const QJsonObject& params);
+	void sendDataRequest(const QJsonObject& params);
+	/// @}
+
+	/// @brief Current time of the monotonic clock in microseconds.
+	qint64 now() const;
+
+	/*!
+	* @name Response keys.
+	*/
+	/// @{
+	static QString sliceKey(const QString& visualID, const int& sliceIndex);
+	static QString sliceDataKey(const QString& dataID, const int& sliceIndex,
+		const int& orientation, const int& seriesIndex);
+	static QString modelKey(const QString& dataID);
+	static QString transformKey(const QString& visualID);
+	static QString interactionKey(const QString& interactionID);
+	/// @}
+};
+}
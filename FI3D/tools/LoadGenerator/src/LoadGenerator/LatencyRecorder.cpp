@@ -0,0 +1,132 @@
+#include <LoadGenerator/LatencyRecorder.h>
+
+#include <QJsonArray>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace loadgen;
+
+QString loadgen::getLoadOperationName(const int& operation) {
+	switch (operation) {
+		case SLICE_SCROLL:
+			return "slice";
+		case MODEL_FETCH:
+			return "model";
+		case TRANSFORM:
+			return "transform";
+		case INTERACTION:
+			return "interaction";
+		default:
+			return "unknown";
+	}
+}
+
+int loadgen::getLoadOperationFromName(const QString& name) {
+	for (int i = 0; i < OPERATION_COUNT; i++) {
+		if (getLoadOperationName(i) == name) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+LatencyRecorder::LatencyRecorder()
+	: mLatencies(OPERATION_COUNT),
+	mSentCounts(OPERATION_COUNT, 0),
+	mTimeoutCounts(OPERATION_COUNT, 0),
+	mReceivedBytes(0),
+	mReceivedMessages(0)
+{}
+
+LatencyRecorder::~LatencyRecorder() {}
+
+void LatencyRecorder::reset() {
+	for (int i = 0; i < OPERATION_COUNT; i++) {
+		mLatencies[i].clear();
+		mSentCounts[i] = 0;
+		mTimeoutCounts[i] = 0;
+	}
+	mReceivedBytes = 0;
+	mReceivedMessages = 0;
+}
+
+void LatencyRecorder::addSent(const int& operation) {
+	mSentCounts[operation]++;
+}
+
+void LatencyRecorder::addLatency(const int& operation, const qint64& latencyUs) {
+	mLatencies[operation].append(latencyUs);
+}
+
+void LatencyRecorder::addTimeout(const int& operation) {
+	mTimeoutCounts[operation]++;
+}
+
+void LatencyRecorder::addReceived(const qint64& bytes) {
+	mReceivedBytes += bytes;
+	mReceivedMessages++;
+}
+
+qint64 LatencyRecorder::getCompletedCount(const int& operation) const {
+	return mLatencies[operation].count();
+}
+
+qint64 LatencyRecorder::getPercentile(const int& operation, const double& percentile) const {
+	QVector<qint64> latencies = mLatencies[operation];
+	if (latencies.isEmpty()) {
+		return 0;
+	}
+
+	// Nearest-rank percentile.
+	int rank = (int)std::ceil(percentile / 100.0 * latencies.count()) - 1;
+	rank = qBound(0, rank, latencies.count() - 1);
+	std::nth_element(latencies.begin(), latencies.begin() + rank, latencies.end());
+	return latencies.at(rank);
+}
+
+void LatencyRecorder::printReport(QTextStream& stream, const double& elapsedSeconds) const {
+	stream << QString("%1 %2 %3 %4 %5 %6 %7 %8\n")
+		.arg("operation", -12).arg("sent", 9).arg("done", 9).arg("timeout", 9)
+		.arg("p50(ms)", 10).arg("p99(ms)", 10).arg("max(ms)", 10).arg("ops/s", 10);
+
+	for (int i = 0; i < OPERATION_COUNT; i++) {
+		double throughput = elapsedSeconds > 0 ? getCompletedCount(i) / elapsedSeconds : 0;
+		stream << QString("%1 %2 %3 %4 %5 %6 %7 %8\n")
+			.arg(getLoadOperationName(i), -12)
+			.arg(mSentCounts[i], 9)
+			.arg(getCompletedCount(i), 9)
+			.arg(mTimeoutCounts[i], 9)
+			.arg(getPercentile(i, 50) / 1000.0, 10, 'f', 2)
+			.arg(getPercentile(i, 99) / 1000.0, 10, 'f', 2)
+			.arg(getPercentile(i, 100) / 1000.0, 10, 'f', 2)
+			.arg(throughput, 10, 'f', 1);
+	}
+
+	stream << QString("Received %1 messages (%2 MB of payload) in %3 s\n")
+		.arg(mReceivedMessages)
+		.arg(mReceivedBytes / (1024.0 * 1024.0), 0, 'f', 2)
+		.arg(elapsedSeconds, 0, 'f', 1);
+	stream.flush();
+}
+
+QJsonObject LatencyRecorder::toJson(const double& elapsedSeconds) const {
+	QJsonObject report;
+	QJsonObject operations;
+	for (int i = 0; i < OPERATION_COUNT; i++) {
+		QJsonObject operation;
+		operation.insert("Sent", mSentCounts[i]);
+		operation.insert("Completed", getCompletedCount(i));
+		operation.insert("Timeouts", mTimeoutCounts[i]);
+		operation.insert("P50Us", getPercentile(i, 50));
+		operation.insert("P99Us", getPercentile(i, 99));
+		operation.insert("MaxUs", getPercentile(i, 100));
+		operation.insert("Throughput", elapsedSeconds > 0 ? getCompletedCount(i) / elapsedSeconds : 0);
+		operations.insert(getLoadOperationName(i), operation);
+	}
+	report.insert("Operations", operations);
+	report.insert("ElapsedSeconds", elapsedSeconds);
+	report.insert("ReceivedMessages", mReceivedMessages);
+	report.insert("ReceivedBytes", mReceivedBytes);
+	return report;
+}
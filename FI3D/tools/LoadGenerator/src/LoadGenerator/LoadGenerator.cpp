@@ -0,0 +1,181 @@
+#include <LoadGenerator/LoadGenerator.h>
+
+#include <QDebug>
+#include <QFile>
+#include <QJsonDocument>
+
+using namespace loadgen;
+
+LoadGenerator::LoadGenerator(const LoadConfiguration& config)
+	: QObject(),
+	mConfig(config),
+	mRecorder(),
+	mClients(),
+	mOperationTimers(),
+	mExpirationTimer(),
+	mSubscriptionTimer(),
+	mRandom(config.Seed),
+	mRunClock(),
+	mSubscribedCount(0),
+	mJsonReportPath("")
+{
+	mExpirationTimer.setInterval(100);
+	mSubscriptionTimer.setSingleShot(true);
+	mSubscriptionTimer.setInterval(qMax(mConfig.Timeout, 10000));
+	QObject::connect(
+		&mSubscriptionTimer, &QTimer::timeout,
+		[=]() {
+			this->onClientFailed(tr("Only %1 of %2 clients subscribed")
+				.arg(mSubscribedCount).arg(mConfig.ClientCount));
+		});
+}
+
+LoadGenerator::~LoadGenerator() {}
+
+void LoadGenerator::setJsonReportPath(const QString& path) {
+	mJsonReportPath = path;
+}
+
+void LoadGenerator::start() {
+	qInfo() << "Connecting" << mConfig.ClientCount << "clients to"
+		<< mConfig.Host << "on port" << mConfig.Port;
+
+	mClients.reserve(mConfig.ClientCount);
+	for (int i = 0; i < mConfig.ClientCount; i++) {
+		QSharedPointer<SimulatedFI> client(new SimulatedFI(i, mConfig, &mRecorder));
+		QObject::connect(
+			client.data(), &SimulatedFI::subscribed,
+			this, &LoadGenerator::onClientSubscribed);
+		QObject::connect(
+			client.data(), &SimulatedFI::failed,
+			this, &LoadGenerator::onClientFailed);
+		QObject::connect(
+			&mExpirationTimer, &QTimer::timeout,
+			client.data(), &SimulatedFI::expireRequests);
+		mClients.append(client);
+	}
+
+	for (QSharedPointer<SimulatedFI> client : mClients) {
+		client->start();
+	}
+	mSubscriptionTimer.start();
+}
+
+void LoadGenerator::onClientSubscribed() {
+	mSubscribedCount++;
+	if (mSubscribedCount < mClients.count()) {
+		return;
+	}
+	mSubscriptionTimer.stop();
+
+	qInfo() << "All clients subscribed, warming up for" << mConfig.WarmUp << "s";
+
+	// Spread the clients over the interval so the requests do not all arrive
+	// at once.
+	int interval = qMax(1, (int)(1000.0 / mConfig.Rate));
+	mOperationTimers.reserve(mClients.count());
+	for (int i = 0; i < mClients.count(); i++) {
+		SimulatedFI* client = mClients[i].data();
+		QSharedPointer<QTimer> timer(new QTimer());
+		timer->setTimerType(Qt::PreciseTimer);
+		timer->setInterval(interval);
+		QObject::connect(
+			timer.data(), &QTimer::timeout,
+			[=]() {
+				this->performOperation(client);
+			});
+		QTimer::singleShot(i * interval / mClients.count(), timer.data(), QOverload<>::of(&QTimer::start));
+		mOperationTimers.append(timer);
+	}
+	mExpirationTimer.start();
+
+	QTimer::singleShot((int)(mConfig.WarmUp * 1000), this, &LoadGenerator::startMeasuring);
+}
+
+void LoadGenerator::onClientFailed(const QString& reason) {
+	qCritical() << "Aborting load generation:" << reason;
+	this->shutdown();
+	emit finished(1);
+}
+
+void LoadGenerator::startMeasuring() {
+	qInfo() << "Measuring for" << mConfig.Duration << "s";
+
+	// Responses to warm up requests would otherwise be recorded as latencies,
+	// or as timeouts if they never arrive.
+	for (QSharedPointer<SimulatedFI> client : mClients) {
+		client->clearPending();
+	}
+	mRecorder.reset();
+	mRunClock.start();
+	QTimer::singleShot((int)(mConfig.Duration * 1000), this, &LoadGenerator::stop);
+}
+
+void LoadGenerator::stop() {
+	double elapsedSeconds = mRunClock.nsecsElapsed() / 1.0e9;
+
+	// Anything still waiting is counted as a timeout.
+	for (QSharedPointer<SimulatedFI> client : mClients) {
+		client->expireRequests();
+	}
+	this->shutdown();
+
+	QTextStream stream(stdout);
+	stream << QString("\n%1 clients, %2 ops/s each\n").arg(mConfig.ClientCount).arg(mConfig.Rate);
+	mRecorder.printReport(stream, elapsedSeconds);
+
+	if (!mJsonReportPath.isEmpty()) {
+		QJsonObject report = mRecorder.toJson(elapsedSeconds);
+		report.insert("Clients", mConfig.ClientCount);
+		report.insert("Rate", mConfig.Rate);
+
+		QFile file(mJsonReportPath);
+		if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+			qWarning() << "Failed to write the report to" << mJsonReportPath;
+			emit finished(1);
+			return;
+		}
+		file.write(QJsonDocument(report).toJson());
+		file.close();
+	}
+
+	emit finished(0);
+}
+
+void LoadGenerator::performOperation(SimulatedFI* client) {
+	double totalWeight = 0;
+	QVector<double> weights(OPERATION_COUNT, 0);
+	for (int i = 0; i < OPERATION_COUNT; i++) {
+		if (client->canPerform(i)) {
+			weights[i] = mConfig.Mix.at(i);
+			totalWeight += weights[i];
+		}
+	}
+	if (totalWeight <= 0) {
+		return;
+	}
+
+	double choice = mRandom.generateDouble() * totalWeight;
+	for (int i = 0; i < OPERATION_COUNT; i++) {
+		if (weights[i] <= 0) {
+			continue;
+		}
+		choice -= weights[i];
+		if (choice < 0) {
+			client->performOperation(i);
+			return;
+		}
+	}
+}
+
+void LoadGenerator::shutdown() {
+	mSubscriptionTimer.stop();
+	mExpirationTimer.stop();
+	for (QSharedPointer<QTimer> timer : mOperationTimers) {
+		timer->stop();
+	}
+	for (QSharedPointer<SimulatedFI> client : mClients) {
+		client->disconnect(this);
+		client->abort();
+	}
+}
@@ -0,0 +1,636 @@
+#include <LoadGenerator/SimulatedFI.h>
+
+#include <fi3d/data/EData.h>
+
+#include <fi3d/rendering/visuals/EVisual.h>
+#include <fi3d/rendering/visuals/3D/slices/ESliceOrientation.h>
+
+#include <fi3d/server/message_keys/MessageKeys.h>
+#include <fi3d/server/message_keys/EApplicationRequest.h>
+#include <fi3d/server/message_keys/EModuleInteraction.h>
+#include <fi3d/server/message_keys/EModuleInteractionConstraint.h>
+#include <fi3d/server/message_keys/EModuleRequest.h>
+#include <fi3d/server/message_keys/EModuleResponse.h>
+#include <fi3d/server/message_keys/EResponseStatus.h>
+
+#include <QDebug>
+#include <QJsonObject>
+
+using namespace fi3d;
+using namespace loadgen;
+
+SimulatedFI::SimulatedFI(const int& index, const LoadConfiguration& config, LatencyRecorder* recorder)
+	: ClientFI3D(),
+	mConfig(config),
+	mRecorder(recorder),
+	mClock(),
+	mRandom(config.Seed + index),
+	mClientID(""),
+	mModuleID(""),
+	mRequestedModuleStart(false),
+	mIsSubscribed(false),
+	mPendingRequests(),
+	mSlices(),
+	mModels(),
+	mVisuals(),
+	mInteractions(),
+	mTransformCount(0)
+{
+	mClock.start();
+
+	QObject::connect(
+		this, &ClientFI3D::messageReceived,
+		this, &SimulatedFI::onMessage);
+	QObject::connect(
+		this, &QAbstractSocket::errorOccurred,
+		[=](QAbstractSocket::SocketError error) {
+			emit failed(tr("Socket error: %1").arg(this->errorString()));
+		});
+}
+
+SimulatedFI::~SimulatedFI() {}
+
+bool SimulatedFI::canPerform(const int& operation) const {
+	if (!mIsSubscribed) {
+		return false;
+	}
+
+	switch (operation) {
+		case SLICE_SCROLL:
+			for (const SliceTarget& slice : mSlices) {
+				if (slice.SliceCount > 1) {
+					return true;
+				}
+			}
+			return false;
+		case MODEL_FETCH:
+			return !mModels.isEmpty();
+		case TRANSFORM:
+			return !mVisuals.isEmpty();
+		case INTERACTION:
+			return !mInteractions.isEmpty();
+		default:
+			return false;
+	}
+}
+
+bool SimulatedFI::isSubscribed() const {
+	return mIsSubscribed;
+}
+
+void SimulatedFI::start() {
+	if (mConfig.UseSSL) {
+		QObject::connect(
+			this, QOverload<const QList<QSslError>&>::of(&QSslSocket::sslErrors),
+			[=](const QList<QSslError>& errors) {
+				this->ignoreSslErrors();
+			});
+		this->connectToHostEncrypted(mConfig.Host, mConfig.Port);
+	} else {
+		this->connectToHost(mConfig.Host, mConfig.Port);
+	}
+}
+
+void SimulatedFI::performOperation(const int& operation) {
+	switch (operation) {
+		case SLICE_SCROLL:
+			this->scrollSlice();
+			break;
+		case MODEL_FETCH:
+			this->fetchModel();
+			break;
+		case TRANSFORM:
+			this->transformVisual();
+			break;
+		case INTERACTION:
+			this->changeInteraction();
+			break;
+		default:
+			break;
+	}
+}
+
+void SimulatedFI::expireRequests() {
+	qint64 expiration = this->now() - (qint64)mConfig.Timeout * 1000;
+
+	QHash<QString, QList<PendingRequest>>::iterator it = mPendingRequests.begin();
+	while (it != mPendingRequests.end()) {
+		QList<PendingRequest>& requests = it.value();
+		while (!requests.isEmpty() && requests.first().SentAt < expiration) {
+			mRecorder->addTimeout(requests.takeFirst().Operation);
+		}
+
+		if (requests.isEmpty()) {
+			it = mPendingRequests.erase(it);
+		} else {
+			it++;
+		}
+	}
+}
+
+void SimulatedFI::clearPending() {
+	mPendingRequests.clear();
+}
+
+void SimulatedFI::onMessage(MessagePtr message) {
+	mRecorder->addReceived(message->getPayload()->count());
+
+	QSharedPointer<QJsonObject> info = message->getInfo();
+	if (info->value(RESPONSE_STATUS).toInt() == EResponseStatus::ERROR_RESPONSE) {
+		qWarning() << mClientID << "received an error:" << info->value(MESSAGE).toString();
+		return;
+	}
+
+	switch (info->value(MESSAGE_TYPE).toInt()) {
+		case EMessage::AUTHENTICATION:
+			this->handleAuthentication(*info.data());
+			break;
+		case EMessage::APPLICATION:
+			this->handleApplication(*info.data());
+			break;
+		case EMessage::MODULE:
+			this->handleModule(*info.data());
+			break;
+		case EMessage::DATA:
+			this->handleData(*info.data());
+			break;
+		default:
+			break;
+	}
+}
+
+void SimulatedFI::handleAuthentication(const QJsonObject& info) {
+	if (info.value(RESPONSE_STATUS).toInt() == EResponseStatus::INFO_REQUIRED) {
+		mClientID = info.value(CLIENT_ID).toString();
+
+		QJsonObject request;
+		request.insert(CLIENT_ID, mClientID);
+		request.insert(MESSAGE_TYPE, EMessage::AUTHENTICATION);
+		request.insert(MESSAGE, "");
+		request.insert(PASSWORD, mConfig.Password);
+		this->sendMessage(MessagePtr(new Message(QSharedPointer<QJsonObject>(new QJsonObject(request)))));
+	}
+}
+
+void SimulatedFI::handleApplication(const QJsonObject& info) {
+	if (!mModuleID.isEmpty()) {
+		return;
+	}
+
+	QJsonArray activeModules = info.value(ACTIVE_MODULES).toArray();
+	for (int i = 0; i < activeModules.count(); i++) {
+		QJsonObject activeModule = activeModules[i].toObject();
+		if (activeModule.value(ID).toString() == mConfig.Module ||
+			activeModule.value(NAME).toString() == mConfig.Module)
+		{
+			mModuleID = activeModule.value(ID).toString();
+			break;
+		}
+	}
+
+	if (!mModuleID.isEmpty()) {
+		QJsonObject request{
+			{MODULE_ID, mModuleID},
+			{REQUEST_ID, EModuleRequest::SUBSCRIBE_TO_MODULE}
+		};
+		this->sendModuleRequest(request);
+		return;
+	}
+
+	if (!mConfig.StartModule) {
+		emit failed(tr("Module %1 is not active").arg(mConfig.Module));
+		return;
+	}
+
+	// The server announces the started module to every client, so only the
+	// first client to get here has to ask for it.
+	if (!mRequestedModuleStart) {
+		mRequestedModuleStart = true;
+		QJsonObject request{
+			{ACTION_TYPE, EApplicationRequest::START_MODULE},
+			{MODULE_NAME, mConfig.Module}
+		};
+		this->sendRequest(EMessage::APPLICATION, APPLICATION_PARAMS, request);
+	}
+}
+
+void SimulatedFI::handleModule(const QJsonObject& info) {
+	QJsonObject moduleInfo = info.value(MODULE_INFO).toObject();
+	if (moduleInfo.value(MODULE_ID).toString() != mModuleID) {
+		return;
+	}
+
+	QJsonArray visualsInfo = moduleInfo.value(VISUALS_INFO).toArray();
+	QJsonArray interactionsInfo = moduleInfo.value(MODULE_INTERACTIONS).toArray();
+
+	// The first module message is the response to the subscription.
+	if (!mIsSubscribed) {
+		this->collectTargets(visualsInfo, interactionsInfo);
+		mIsSubscribed = true;
+
+		// Request the current slices so their dimensions are known before
+		// any scrolling happens. These requests are not measured.
+		for (const SliceTarget& slice : mSlices) {
+			this->requestSliceData(slice);
+		}
+
+		emit subscribed();
+		return;
+	}
+
+	qint64 receivedAt = this->now();
+	for (int i = 0; i < visualsInfo.count(); i++) {
+		QJsonObject visualInfo = visualsInfo[i].toObject();
+		QString visualID = visualInfo.value(ID).toString();
+
+		switch (visualInfo.value(RESPONSE_ID).toInt()) {
+			case EModuleResponse::ADD_VISUAL:
+				this->collectVisual(visualInfo, false);
+				break;
+			case EModuleResponse::REMOVE_VISUAL:
+				mVisuals.removeAll(visualID);
+				for (int j = mSlices.count() - 1; j >= 0; j--) {
+					if (mSlices[j].VisualID == visualID) {
+						mSlices.removeAt(j);
+					}
+				}
+				break;
+			case EModuleResponse::SET_SLICE:
+			{
+				int sliceIndex = visualInfo.value(SLICE_INDEX).toInt();
+				for (SliceTarget& slice : mSlices) {
+					if (slice.VisualID != visualID) {
+						continue;
+					}
+					slice.SliceIndex = sliceIndex;
+					slice.SliceOrientation = visualInfo.value(SLICE_ORIENTATION).toInt();
+					slice.SeriesIndex = visualInfo.value(SERIES_INDEX).toInt(0);
+
+					// The scroll continues by fetching the data of the slice.
+					QList<PendingRequest> requests = this->completePending(sliceKey(visualID, sliceIndex));
+					if (requests.isEmpty()) {
+						break;
+					}
+
+					QString dataKey = sliceDataKey(slice.DataID, slice.SliceIndex,
+						slice.SliceOrientation, slice.SeriesIndex);
+					bool isRequested = mPendingRequests.contains(dataKey);
+					for (const PendingRequest& request : requests) {
+						this->addPending(dataKey, request.Operation, request.SentAt);
+					}
+					if (!isRequested) {
+						this->requestSliceData(slice);
+					}
+					break;
+				}
+				break;
+			}
+			case EModuleResponse::TRANSFORM_VISUAL:
+			{
+				QList<PendingRequest> requests = this->completePending(transformKey(visualID));
+				for (const PendingRequest& request : requests) {
+					mRecorder->addLatency(request.Operation, receivedAt - request.SentAt);
+				}
+				break;
+			}
+			default:
+				break;
+		}
+	}
+
+	for (int i = 0; i < interactionsInfo.count(); i++) {
+		QJsonObject interactionInfo = interactionsInfo[i].toObject();
+		if (interactionInfo.value(RESPONSE_ID).toInt() != EModuleResponse::UPDATE_MODULE_INTERACTION) {
+			continue;
+		}
+
+		QString interactionID = interactionInfo.value(ID).toString();
+		for (InteractionTarget& interaction : mInteractions) {
+			if (interaction.InteractionID == interactionID) {
+				interaction.Value = interactionInfo.value(VALUE);
+				break;
+			}
+		}
+
+		QList<PendingRequest> requests = this->completePending(interactionKey(interactionID));
+		for (const PendingRequest& request : requests) {
+			mRecorder->addLatency(request.Operation, receivedAt - request.SentAt);
+		}
+	}
+}
+
+void SimulatedFI::handleData(const QJsonObject& info) {
+	qint64 receivedAt = this->now();
+
+	QJsonObject data = info.value(DATA).toObject();
+	QString dataID = data.value(DATA_ID).toString();
+	int dataType = data.value(DATA_TYPE).toInt();
+
+	QString key;
+	if (dataType == EData::MODEL) {
+		key = modelKey(dataID);
+	} else {
+		int orientation = data.value(SLICE_ORIENTATION).toInt();
+
+		// Learn the number of slices in each orientation.
+		QJsonArray dims = data.value(DIMENSIONS).toArray();
+		int sliceCount = 0;
+		if (dims.count() == 3) {
+			if (orientation == ESliceOrientation::XY) {
+				sliceCount = dims[2].toInt();
+			} else if (orientation == ESliceOrientation::YZ) {
+				sliceCount = dims[0].toInt();
+			} else if (orientation == ESliceOrientation::XZ) {
+				sliceCount = dims[1].toInt();
+			}
+		}
+		for (SliceTarget& slice : mSlices) {
+			if (slice.DataID == dataID && slice.SliceOrientation == orientation) {
+				slice.SliceCount = sliceCount;
+			}
+		}
+
+		key = sliceDataKey(dataID, data.value(SLICE_INDEX).toInt(),
+			orientation, data.value(SERIES_INDEX).toInt(0));
+	}
+
+	QList<PendingRequest> requests = this->completePending(key);
+	for (const PendingRequest& request : requests) {
+		mRecorder->addLatency(request.Operation, receivedAt - request.SentAt);
+	}
+}
+
+void SimulatedFI::collectTargets(const QJsonArray& visualsInfo, const QJsonArray& interactionsInfo) {
+	for (int i = 0; i < visualsInfo.count(); i++) {
+		this->collectVisual(visualsInfo[i].toObject(), false);
+	}
+
+	for (int i = 0; i < interactionsInfo.count(); i++) {
+		QJsonObject interactionInfo = interactionsInfo[i].toObject();
+
+		InteractionTarget interaction;
+		interaction.InteractionID = interactionInfo.value(ID).toString();
+		interaction.InteractionType = interactionInfo.value(TYPE).toInt();
+		interaction.Value = interactionInfo.value(VALUE);
+
+		int constraint = interactionInfo.value(CONSTRAINT).toInt();
+		interaction.HasMin = constraint == EModuleInteractionConstraint::MIN ||
+			constraint == EModuleInteractionConstraint::RANGE;
+		interaction.HasMax = constraint == EModuleInteractionConstraint::MAX ||
+			constraint == EModuleInteractionConstraint::RANGE;
+		interaction.Min = interactionInfo.value(MIN_VALUE).toDouble();
+		interaction.Max = interactionInfo.value(MAX_VALUE).toDouble();
+		interaction.OptionCount = interactionInfo.value(VALUE_OPTIONS).toArray().count();
+
+		if (!mConfig.Interactions.isEmpty() &&
+			!mConfig.Interactions.contains(interaction.InteractionID))
+		{
+			continue;
+		}
+
+		// Valueless and string interactions do not produce an update that
+		// can be measured.
+		switch (interaction.InteractionType) {
+			case EModuleInteraction::BOOL:
+			case EModuleInteraction::INTEGER:
+			case EModuleInteraction::FLOAT:
+				mInteractions.append(interaction);
+				break;
+			case EModuleInteraction::SELECT:
+				if (interaction.OptionCount > 1) {
+					mInteractions.append(interaction);
+				}
+				break;
+			default:
+				break;
+		}
+	}
+}
+
+void SimulatedFI::collectVisual(const QJsonObject& visualInfo, const bool& isPart) {
+	QString visualID = visualInfo.value(ID).toString();
+	int visualType = visualInfo.value(TYPE).toInt();
+
+	if (!isPart && !mVisuals.contains(visualID)) {
+		mVisuals.append(visualID);
+	}
+
+	switch (visualType) {
+		case EVisual::IMAGE_SLICE:
+		case EVisual::STUDY_IMAGE_SLICE:
+		case EVisual::ANIMATED_STUDY_SLICE:
+		{
+			SliceTarget slice;
+			slice.VisualID = visualID;
+			slice.DataType = visualInfo.value(DATA_TYPE).toInt();
+			slice.DataID = visualInfo.value(DATA_ID).toString();
+			slice.SliceIndex = visualInfo.value(SLICE_INDEX).toInt();
+			slice.SliceOrientation = visualInfo.value(SLICE_ORIENTATION).toInt();
+			slice.SeriesIndex = visualInfo.value(SERIES_INDEX).toInt(0);
+			slice.SliceCount = 0;
+			slice.Direction = 1;
+			mSlices.append(slice);
+			break;
+		}
+		case EVisual::MODEL:
+		case EVisual::ANIMATED_MODEL:
+		{
+			QString dataID = visualInfo.value(DATA_ID).toString();
+			if (!dataID.isEmpty() && !mModels.contains(dataID)) {
+				mModels.append(dataID);
+			}
+			break;
+		}
+		case EVisual::ASSEMBLY:
+		{
+			QJsonArray partsInfo = visualInfo.value(ASSEMBLY_PARTS_INFO).toArray();
+			for (int i = 0; i < partsInfo.count(); i++) {
+				this->collectVisual(partsInfo[i].toObject(), true);
+			}
+			break;
+		}
+		default:
+			break;
+	}
+}
+
+void SimulatedFI::scrollSlice() {
+	QList<int> candidates;
+	for (int i = 0; i < mSlices.count(); i++) {
+		if (mSlices[i].SliceCount > 1) {
+			candidates.append(i);
+		}
+	}
+	if (candidates.isEmpty()) {
+		return;
+	}
+
+	// Scroll back and forth as a user would.
+	SliceTarget& slice = mSlices[candidates.at(mRandom.bounded(candidates.count()))];
+	int sliceIndex = slice.SliceIndex + slice.Direction;
+	if (sliceIndex < 0 || sliceIndex >= slice.SliceCount) {
+		slice.Direction = -slice.Direction;
+		sliceIndex = slice.SliceIndex + slice.Direction;
+	}
+	slice.SliceIndex = sliceIndex;
+
+	this->addPending(sliceKey(slice.VisualID, sliceIndex), SLICE_SCROLL, this->now());
+	mRecorder->addSent(SLICE_SCROLL);
+
+	QJsonObject request{
+		{MODULE_ID, mModuleID},
+		{REQUEST_ID, EModuleRequest::SELECT_SLICE},
+		{TARGET_VISUAL, slice.VisualID},
+		{SLICE_INDEX, sliceIndex}
+	};
+	this->sendModuleRequest(request);
+}
+
+void SimulatedFI::fetchModel() {
+	if (mModels.isEmpty()) {
+		return;
+	}
+
+	QString dataID = mModels.at(mRandom.bounded(mModels.count()));
+	this->addPending(modelKey(dataID), MODEL_FETCH, this->now());
+	mRecorder->addSent(MODEL_FETCH);
+
+	QJsonObject request{
+		{DATA_TYPE, EData::MODEL},
+		{DATA_ID, dataID}
+	};
+	this->sendDataRequest(request);
+}
+
+void SimulatedFI::transformVisual() {
+	if (mVisuals.isEmpty()) {
+		return;
+	}
+
+	// Alternate directions so the visuals stay around their position.
+	QString visualID = mVisuals.at(mRandom.bounded(mVisuals.count()));
+	double step = (mTransformCount++ % 2 == 0) ? 1.0 : -1.0;
+	this->addPending(transformKey(visualID), TRANSFORM, this->now());
+	mRecorder->addSent(TRANSFORM);
+
+	QJsonObject request{
+		{MODULE_ID, mModuleID},
+		{REQUEST_ID, EModuleRequest::TRANSLATE_VISUAL},
+		{TARGET_VISUAL, visualID},
+		{TRANSLATE, QJsonArray{step, 0.0, 0.0}}
+	};
+	this->sendModuleRequest(request);
+}
+
+void SimulatedFI::changeInteraction() {
+	if (mInteractions.isEmpty()) {
+		return;
+	}
+
+	// The value always changes, otherwise the server sends no update.
+	InteractionTarget& interaction = mInteractions[mRandom.bounded(mInteractions.count())];
+	QJsonValue value;
+	switch (interaction.InteractionType) {
+		case EModuleInteraction::BOOL:
+			value = !interaction.Value.toBool();
+			break;
+		case EModuleInteraction::INTEGER:
+		{
+			int next = interaction.Value.toInt() + 1;
+			if (interaction.HasMax && next > interaction.Max) {
+				next = interaction.HasMin ? (int)interaction.Min : next - 2;
+			}
+			value = next;
+			break;
+		}
+		case EModuleInteraction::FLOAT:
+		{
+			double next = interaction.Value.toDouble() + 0.1;
+			if (interaction.HasMax && next > interaction.Max) {
+				next = interaction.HasMin ? interaction.Min : next - 0.2;
+			}
+			value = next;
+			break;
+		}
+		case EModuleInteraction::SELECT:
+			value = (interaction.Value.toInt() + 1) % interaction.OptionCount;
+			break;
+		default:
+			return;
+	}
+	interaction.Value = value;
+
+	this->addPending(interactionKey(interaction.InteractionID), INTERACTION, this->now());
+	mRecorder->addSent(INTERACTION);
+
+	QJsonObject request{
+		{MODULE_ID, mModuleID},
+		{REQUEST_ID, EModuleRequest::MODULE_INTERACTION},
+		{INTERACTION_ID, interaction.InteractionID},
+		{INTERACTION_VALUE, value}
+	};
+	this->sendModuleRequest(request);
+}
+
+void SimulatedFI::requestSliceData(const SliceTarget& slice) {
+	QJsonObject request{
+		{DATA_TYPE, slice.DataType},
+		{DATA_ID, slice.DataID},
+		{SLICE_INDEX, slice.SliceIndex},
+		{SLICE_ORIENTATION, slice.SliceOrientation},
+		{SERIES_INDEX, slice.SeriesIndex}
+	};
+	this->sendDataRequest(request);
+}
+
+void SimulatedFI::addPending(const QString& key, const int& operation, const qint64& sentAt) {
+	PendingRequest request{operation, sentAt};
+	mPendingRequests[key].append(request);
+}
+
+QList<PendingRequest> SimulatedFI::completePending(const QString& key) {
+	return mPendingRequests.take(key);
+}
+
+void SimulatedFI::sendRequest(const EMessage& messageType, const QString& paramsKey, const QJsonObject& params) {
+	QSharedPointer<QJsonObject> request(new QJsonObject());
+	request->insert(CLIENT_ID, mClientID);
+	request->insert(MESSAGE_TYPE, messageType.toInt());
+	request->insert(MESSAGE, "");
+	request->insert(paramsKey, params);
+	this->sendMessage(MessagePtr(new Message(request)));
+}
+
+void SimulatedFI::sendModuleRequest(const QJsonObject& params) {
+	this->sendRequest(EMessage::MODULE, MODULE_PARAMS, params);
+}
+
+void SimulatedFI::sendDataRequest(const QJsonObject& params) {
+	this->sendRequest(EMessage::DATA, DATA_PARAMS, params);
+}
+
+qint64 SimulatedFI::now() const {
+	return mClock.nsecsElapsed() / 1000;
+}
+
+QString SimulatedFI::sliceKey(const QString& visualID, const int& sliceIndex) {
+	return QString("S|%1|%2").arg(visualID).arg(sliceIndex);
+}
+
+QString SimulatedFI::sliceDataKey(const QString& dataID, const int& sliceIndex,
+	const int& orientation, const int& seriesIndex)
+{
+	return QString("D|%1|%2|%3|%4").arg(dataID).arg(sliceIndex).arg(orientation).arg(seriesIndex);
+}
+
+QString SimulatedFI::modelKey(const QString& dataID) {
+	return QString("M|%1").arg(dataID);
+}
+
+QString SimulatedFI::transformKey(const QString& visualID) {
+	return QString("T|%1").arg(visualID);
+}
+
+QString SimulatedFI::interactionKey(const QString& interactionID) {
+	return QString("I|%1").arg(interactionID);
+}
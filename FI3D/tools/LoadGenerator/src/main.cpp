@@ -0,0 +1,82 @@
+#include <LoadGenerator/LoadGenerator.h>
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QTimer>
+
+using namespace loadgen;
+
+int main(int argc, char *argv[])
+{
+	QCoreApplication app(argc, argv);
+	QCoreApplication::setApplicationName("FI3DLoadGenerator");
+
+	QCommandLineParser parser;
+	parser.setApplicationDescription(
+		"Simulates framework interfaces to measure the latency and throughput of an FI3D server.");
+	parser.addHelpOption();
+
+	LoadConfiguration config;
+	QCommandLineOption hostOption("host", "Address of the server.", "host", config.Host);
+	QCommandLineOption portOption("port", "Port of the server.", "port", QString::number(config.Port));
+	QCommandLineOption sslOption("ssl", "Use an encrypted connection.");
+	QCommandLineOption passwordOption("password", "Password to authenticate.", "password", config.Password);
+	QCommandLineOption moduleOption("module", "ID or name of the module to subscribe to.", "module", config.Module);
+	QCommandLineOption startModuleOption("start-module", "Start the module if it is not active.");
+	QCommandLineOption clientsOption("clients", "Number of simulated FIs.", "count", QString::number(config.ClientCount));
+	QCommandLineOption rateOption("rate", "Operations per second of each FI.", "rate", QString::number(config.Rate));
+	QCommandLineOption durationOption("duration", "Seconds to measure.", "seconds", QString::number(config.Duration));
+	QCommandLineOption warmUpOption("warmup", "Seconds to run before measuring.", "seconds", QString::number(config.WarmUp));
+	QCommandLineOption timeoutOption("timeout", "Milliseconds before a request times out.", "ms", QString::number(config.Timeout));
+	QCommandLineOption mixOption("mix",
+		"Weights of the operations, e.g. slice=4,model=1,transform=2,interaction=1.", "mix");
+	QCommandLineOption interactionsOption("interactions",
+		"Comma separated module interaction IDs to change, all by default.", "ids");
+	QCommandLineOption seedOption("seed", "Seed of the random generator.", "seed", QString::number(config.Seed));
+	QCommandLineOption jsonOption("json", "Writes the report as JSON to the file.", "file");
+	parser.addOptions({hostOption, portOption, sslOption, passwordOption, moduleOption,
+		startModuleOption, clientsOption, rateOption, durationOption, warmUpOption,
+		timeoutOption, mixOption, interactionsOption, seedOption, jsonOption});
+	parser.process(app);
+
+	config.Host = parser.value(hostOption);
+	config.Port = parser.value(portOption).toInt();
+	config.UseSSL = parser.isSet(sslOption);
+	config.Password = parser.value(passwordOption);
+	config.Module = parser.value(moduleOption);
+	config.StartModule = parser.isSet(startModuleOption);
+	config.ClientCount = qMax(1, parser.value(clientsOption).toInt());
+	config.Rate = qMax(0.1, parser.value(rateOption).toDouble());
+	config.Duration = qMax(1.0, parser.value(durationOption).toDouble());
+	config.WarmUp = qMax(0.0, parser.value(warmUpOption).toDouble());
+	config.Timeout = qMax(1, parser.value(timeoutOption).toInt());
+	config.Seed = parser.value(seedOption).toUInt();
+
+	if (parser.isSet(mixOption)) {
+		config.Mix.fill(0);
+		const QStringList weights = parser.value(mixOption).split(",", Qt::SkipEmptyParts);
+		for (const QString& weight : weights) {
+			QStringList pair = weight.split("=");
+			int operation = getLoadOperationFromName(pair.first().trimmed());
+			if (pair.count() != 2 || operation < 0) {
+				qCritical() << "Invalid operation weight:" << weight;
+				return 1;
+			}
+			config.Mix[operation] = qMax(0.0, pair.last().toDouble());
+		}
+	}
+
+	if (parser.isSet(interactionsOption)) {
+		config.Interactions = parser.value(interactionsOption).split(",", Qt::SkipEmptyParts);
+	}
+
+	LoadGenerator generator(config);
+	generator.setJsonReportPath(parser.value(jsonOption));
+	QObject::connect(
+		&generator, &LoadGenerator::finished,
+		&app, &QCoreApplication::exit,
+		Qt::QueuedConnection);
+	QTimer::singleShot(0, &generator, &LoadGenerator::start);
+
+	return app.exec();
+}
@@ -0,0 +1,147 @@
+#include <fi3d/data/data_manager/stream/StreamFrame.h>
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QLocalSocket>
+#include <QTextStream>
+#include <QThread>
+#include <QtMath>
+#include <QVector>
+
+#include <cmath>
+
+using namespace fi3d;
+
+/// @brief Fills a frame of the phantom: a sphere that moves along x.
+static void fillPhantom(QVector<unsigned char>& voxels, const int& size,
+	const int& slices, const qint64& frameNumber, const int& frameRate)
+{
+	double center[3] = {
+		size / 2.0 + size / 4.0 * std::sin(frameNumber * 2.0 * M_PI / (2.0 * frameRate)),
+		size / 2.0,
+		slices / 2.0
+	};
+	double radius = size / 5.0;
+
+	int v = 0;
+	for (int z = 0; z < slices; z++) {
+		for (int y = 0; y < size; y++) {
+			for (int x = 0; x < size; x++) {
+				// Slices are thicker than the in-plane voxels.
+				double dx = x - center[0];
+				double dy = y - center[1];
+				double dz = (z - center[2]) * size / (double)slices;
+				double distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+				voxels[v++] = distance < radius ? (unsigned char)(255 - distance) : (unsigned char)(x ^ y);
+			}
+		}
+	}
+}
+
+/// @brief Writes a header and its payload, waiting until they are sent.
+static bool writeFrame(QLocalSocket& socket, StreamFrameHeader header, const char* payload) {
+	char bytes[STREAM_FRAME_HEADER_SIZE];
+	writeStreamFrameHeader(header, bytes);
+	socket.write(bytes, STREAM_FRAME_HEADER_SIZE);
+	socket.write(payload, header.PayloadLength);
+	while (socket.bytesToWrite() > 0) {
+		if (!socket.waitForBytesWritten(5000)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+int main(int argc, char *argv[])
+{
+	QCoreApplication app(argc, argv);
+	QCoreApplication::setApplicationName("FI3DStreamProducer");
+
+	QCommandLineParser parser;
+	parser.setApplicationDescription(
+		"Streams a synthetic phantom to the StreamIngest of a running FI3D.");
+	parser.addHelpOption();
+
+	QCommandLineOption streamOption("stream", "Name of the local socket of the stream.", "name", "FI3DStream");
+	QCommandLineOption sizeOption("size", "In-plane size of the frames.", "voxels", "128");
+	QCommandLineOption slicesOption("slices", "Slices in each frame.", "count", "24");
+	QCommandLineOption rateOption("rate", "Frames per second.", "fps", "10");
+	QCommandLineOption framesOption("frames", "Frames to send, 0 to send until stopped.", "count", "300");
+	QCommandLineOption bySliceOption("by-slice", "Send each frame one slice at a time.");
+	parser.addOptions({streamOption, sizeOption, slicesOption, rateOption, framesOption, bySliceOption});
+	parser.process(app);
+
+	int size = qMax(2, parser.value(sizeOption).toInt());
+	int slices = qMax(1, parser.value(slicesOption).toInt());
+	int frameRate = qMax(1, parser.value(rateOption).toInt());
+	qint64 frameCount = qMax(0, parser.value(framesOption).toInt());
+	bool isBySlice = parser.isSet(bySliceOption);
+
+	QTextStream stream(stdout);
+	QLocalSocket socket;
+	socket.connectToServer(parser.value(streamOption));
+	if (!socket.waitForConnected(5000)) {
+		stream << "Failed to connect to " << parser.value(streamOption) << ": " << socket.errorString() << "\n";
+		return 1;
+	}
+
+	StreamFrameHeader header;
+	header.Magic = STREAM_FRAME_MAGIC;
+	header.Version = STREAM_FRAME_VERSION;
+	header.ScalarType = STREAM_SCALAR_UNSIGNED_CHAR;
+	header.Dimensions[0] = size;
+	header.Dimensions[1] = size;
+	header.Dimensions[2] = slices;
+	header.Spacing[0] = 1.0;
+	header.Spacing[1] = 1.0;
+	header.Spacing[2] = (double)size / slices;
+	header.Reserved = 0;
+
+	QVector<unsigned char> voxels(size * size * slices);
+	qint64 sliceBytes = (qint64)size * size;
+
+	QElapsedTimer clock;
+	clock.start();
+	qint64 frameInterval = 1000000000LL / frameRate;
+	qint64 totalWriteTime = 0;
+
+	qint64 frameNumber = 0;
+	for (; frameCount == 0 || frameNumber < frameCount; frameNumber++) {
+		fillPhantom(voxels, size, slices, frameNumber, frameRate);
+		header.FrameNumber = frameNumber;
+
+		qint64 start = clock.nsecsElapsed();
+		bool isWritten = true;
+		if (isBySlice) {
+			header.PayloadLength = sliceBytes;
+			for (int z = 0; z < slices && isWritten; z++) {
+				header.SliceIndex = z;
+				isWritten = writeFrame(socket, header, (const char*)voxels.constData() + z * sliceBytes);
+			}
+		} else {
+			header.SliceIndex = -1;
+			header.PayloadLength = sliceBytes * slices;
+			isWritten = writeFrame(socket, header, (const char*)voxels.constData());
+		}
+		totalWriteTime += clock.nsecsElapsed() - start;
+
+		if (!isWritten) {
+			stream << "Stopped at frame " << frameNumber << ": " << socket.errorString() << "\n";
+			break;
+		}
+
+		qint64 wait = (frameNumber + 1) * frameInterval - clock.nsecsElapsed();
+		if (wait > 0) {
+			QThread::usleep((unsigned long)(wait / 1000));
+		}
+	}
+
+	stream << QString("%1 frames of %2x%2x%3 sent in %4 s, %5 ms average write\n")
+		.arg(frameNumber).arg(size).arg(slices)
+		.arg(clock.nsecsElapsed() / 1.0e9, 0, 'f', 1)
+		.arg(frameNumber > 0 ? totalWriteTime / 1.0e6 / frameNumber : 0, 0, 'f', 3);
+
+	socket.disconnectFromServer();
+	return 0;
+}
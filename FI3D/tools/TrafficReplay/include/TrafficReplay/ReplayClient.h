@@ -0,0 +1,92 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		ReplayClient.h
+* @class	replay::ReplayClient
+* @brief	Re-sends the inbound messages of one captured client.
+*
+* The server assigns a new client ID on connection, so the ID of every
+* replayed message is replaced by the assigned one. Messages that are due
+* before the ID is assigned are queued and sent once it is.
+*
+* The server does not echo request IDs, so a received message answers the
+* oldest outstanding request of its message type, and of its data for data
+* messages. Error messages carry no type and answer the oldest request of
+* any type. Messages matching no request, e.g. updates pushed to every
+* subscriber, answer none.
+*/
+
+#include <fi3d/server/capture/TrafficRecord.h>
+#include <fi3d/server/network/ClientFI3D.h>
+
+#include <QElapsedTimer>
+#include <QList>
+
+namespace replay {
+class ReplayClient : public fi3d::ClientFI3D {
+
+	Q_OBJECT
+
+signals:
+	/// @brief Emitted when a captured message is sent, info already remapped.
+	void sent(const QString& originalID, const QByteArray& info, const QByteArray& payload) const;
+
+	/// @brief Emitted when a message is received from the server.
+	void received(const QString& originalID, fi3d::MessagePtr message) const;
+
+	/// @brief Emitted for each request answered by a received message.
+	void responded(const QString& requestName, const qint64& latencyUs) const;
+
+private:
+	/// @brief A sent request waiting for a response.
+	typedef struct OutstandingRequest {
+		QString Name;
+		int MessageType;
+		QString DataID;
+		qint64 SentAt;
+	} OutstandingRequest;
+
+	/// @brief The client ID in the capture.
+	QString mOriginalID;
+
+	/// @brief The client ID assigned by the server.
+	QString mAssignedID;
+
+	/// @brief Monotonic clock shared by all the clients of the replay.
+	const QElapsedTimer* mClock;
+
+	/// @brief Messages due before the client ID was assigned.
+	QList<fi3d::TrafficRecord> mQueuedRecords;
+
+	/// @brief Requests sent and not answered yet, oldest first.
+	QList<OutstandingRequest> mOutstandingRequests;
+
+public:
+	/// @brief Constructor.
+	ReplayClient(const QString& originalID, const QElapsedTimer* clock);
+
+	/// @brief Destructor.
+	~ReplayClient();
+
+	/// @brief Gets the client ID in the capture.
+	QString getOriginalID() const;
+
+	/// @brief Sends the message of the inbound record.
+	void replay(const fi3d::TrafficRecord& record);
+
+	/// @brief Gets a readable name for the request, e.g. Module/SelectSlice.
+	static QString getRequestName(const QJsonObject& info);
+
+private slots:
+	/// @brief Handles every message received.
+	void onMessage(fi3d::MessagePtr message);
+
+private:
+	/// @brief Sends the record with the assigned client ID.
+	void send(const fi3d::TrafficRecord& record);
+
+	/// @brief Takes the outstanding request answered by the message, returns
+	/// whether there was one.
+	bool takeAnsweredRequest(const QJsonObject& info, OutstandingRequest& request);
+};
+}
@@ -0,0 +1,116 @@
+#pragma once
+/*!
+* @author	VelazcoJD
+* @file		TrafficReplayer.h
+* @class	replay::TrafficReplayer
+* @brief	Replays the inbound side of a traffic capture against a server.
+*
+* Every captured client is replayed by a ReplayClient that connects when the
+* capture shows it connecting and sends the captured messages at their
+* captured times, scaled by the speed. A speed of 0 sends everything as soon
+* as possible.
+*
+* The replay can itself be recorded, using the original client IDs, so that
+* the server side of two builds can be compared record by record. At the end,
+* the response time of each kind of request is reported.
+*/
+
+#include <TrafficReplay/ReplayClient.h>
+
+#include <fi3d/server/capture/TrafficRecorder.h>
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QSharedPointer>
+#include <QTimer>
+#include <QVector>
+
+namespace replay {
+class TrafficReplayer : public QObject {
+
+	Q_OBJECT
+
+signals:
+	/// @brief Emitted when the replay is over, with the process exit code.
+	void finished(const int& exitCode) const;
+
+private:
+	/// @brief Address of the server.
+	QString mHost;
+
+	/// @brief Port of the server.
+	int mPort;
+
+	/// @brief Whether the connections are encrypted.
+	bool mUseSSL;
+
+	/// @brief Time scale of the replay, 0 for as fast as possible.
+	double mSpeed;
+
+	/// @brief Milliseconds to wait for responses after the last message.
+	int mLinger;
+
+	/// @brief The connection, disconnection and inbound records.
+	QVector<fi3d::TrafficRecord> mRecords;
+
+	/// @brief The number of outbound messages in the capture.
+	qint64 mCapturedResponses;
+
+	/// @brief The index of the next record to replay.
+	int mNextRecord;
+
+	/// @brief Monotonic clock started when the replay starts.
+	QElapsedTimer mClock;
+
+	/// @brief Triggers the next due records.
+	QTimer mReplayTimer;
+
+	/// @brief The replaying clients by their captured ID.
+	QHash<QString, QSharedPointer<ReplayClient>> mClients;
+
+	/// @brief Records the replay, if requested.
+	fi3d::TrafficRecorder mRecorder;
+
+	/// @brief The response times in microseconds, by request name.
+	QHash<QString, QVector<qint64>> mLatencies;
+
+	/// @brief The number of messages received from the server.
+	qint64 mReceivedMessages;
+
+public:
+	/// @brief Constructor.
+	TrafficReplayer(const QString& host, const int& port, const bool& useSSL,
+		const double& speed, const int& linger);
+
+	/// @brief Destructor.
+	~TrafficReplayer();
+
+	/// @brief Loads the capture to replay.
+	bool load(const QString& capturePath);
+
+	/// @brief Records the replay to the given capture file.
+	bool record(const QString& capturePath, const bool& includePayloads);
+
+public slots:
+	/// @brief Starts the replay.
+	void start();
+
+private slots:
+	/// @brief Replays all the records that are due.
+	void replayDueRecords();
+
+	/// @brief Prints the report and ends the replay.
+	void stop();
+
+private:
+	/// @brief Creates and connects the client for the captured ID.
+	void connectClient(const QString& originalID);
+
+	/// @brief Gets when the record is due, in microseconds since the start.
+	qint64 getDueTime(const fi3d::TrafficRecord& record) const;
+
+	/// @brief Gets the latency at the given percentile [0, 100].
+	static qint64 getPercentile(QVector<qint64> latencies, const double& percentile);
+};
+}
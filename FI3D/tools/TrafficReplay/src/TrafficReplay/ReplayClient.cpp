@@ -0,0 +1,125 @@
+#include <TrafficReplay/ReplayClient.h>
+
+#include <fi3d/server/message_keys/EMessage.h>
+#include <fi3d/server/message_keys/EModuleRequest.h>
+#include <fi3d/server/message_keys/EResponseStatus.h>
+#include <fi3d/server/message_keys/MessageKeys.h>
+
+#include <QDebug>
+#include <QJsonDocument>
+
+using namespace fi3d;
+using namespace replay;
+
+ReplayClient::ReplayClient(const QString& originalID, const QElapsedTimer* clock)
+	: ClientFI3D(),
+	mOriginalID(originalID),
+	mAssignedID(""),
+	mClock(clock),
+	mQueuedRecords(),
+	mOutstandingRequests()
+{
+	QObject::connect(
+		this, &ClientFI3D::messageReceived,
+		this, &ReplayClient::onMessage);
+}
+
+ReplayClient::~ReplayClient() {}
+
+QString ReplayClient::getOriginalID() const {
+	return mOriginalID;
+}
+
+void ReplayClient::replay(const TrafficRecord& record) {
+	if (mAssignedID.isEmpty()) {
+		mQueuedRecords.append(record);
+		return;
+	}
+	this->send(record);
+}
+
+QString ReplayClient::getRequestName(const QJsonObject& info) {
+	EMessage messageType(info.value(MESSAGE_TYPE).toInt());
+	if (messageType == EMessage::MODULE) {
+		EModuleRequest request(info.value(MODULE_PARAMS).toObject().value(REQUEST_ID).toInt());
+		return QString("%1/%2").arg(messageType.getName()).arg(request.getName());
+	}
+	return messageType.getName();
+}
+
+void ReplayClient::onMessage(MessagePtr message) {
+	qint64 receivedAt = mClock->nsecsElapsed() / 1000;
+	QSharedPointer<QJsonObject> info = message->getInfo();
+
+	OutstandingRequest request;
+	if (this->takeAnsweredRequest(*info.data(), request)) {
+		emit responded(request.Name, receivedAt - request.SentAt);
+	}
+
+	emit received(mOriginalID, message);
+
+	if (mAssignedID.isEmpty() &&
+		info->value(MESSAGE_TYPE).toInt() == EMessage::AUTHENTICATION &&
+		info->value(RESPONSE_STATUS).toInt() == EResponseStatus::INFO_REQUIRED)
+	{
+		mAssignedID = info->value(CLIENT_ID).toString();
+		qDebug() << mOriginalID << "is replayed as" << mAssignedID;
+
+		QList<TrafficRecord> queuedRecords = mQueuedRecords;
+		mQueuedRecords.clear();
+		for (const TrafficRecord& record : queuedRecords) {
+			this->send(record);
+		}
+	}
+}
+
+void ReplayClient::send(const TrafficRecord& record) {
+	QJsonParseError error;
+	QJsonDocument document = QJsonDocument::fromJson(record.Info, &error);
+	if (error.error != QJsonParseError::NoError) {
+		qWarning() << "Skipping captured message of" << mOriginalID << "because:" << error.errorString();
+		return;
+	}
+
+	QSharedPointer<QJsonObject> info(new QJsonObject(document.object()));
+	info->insert(CLIENT_ID, mAssignedID);
+
+	// Captures without payload contents are replayed with blank payloads of
+	// the same length.
+	MessagePtr message;
+	QByteArray payload;
+	if (record.PayloadLength > 0) {
+		payload = record.Payload.count() == record.PayloadLength ?
+			record.Payload : QByteArray(record.PayloadLength, '\0');
+		message.reset(new Message(info, QSharedPointer<QByteArray>(new QByteArray(payload))));
+	} else {
+		message.reset(new Message(info));
+	}
+
+	OutstandingRequest request{getRequestName(*info.data()), info->value(MESSAGE_TYPE).toInt(),
+		info->value(DATA_PARAMS).toObject().value(DATA_ID).toString(), mClock->nsecsElapsed() / 1000};
+	mOutstandingRequests.append(request);
+
+	this->sendMessage(message);
+	emit sent(mOriginalID, QJsonDocument(*info.data()).toJson(QJsonDocument::JsonFormat::Compact), payload);
+}
+
+bool ReplayClient::takeAnsweredRequest(const QJsonObject& info, OutstandingRequest& request) {
+	bool hasType = info.contains(MESSAGE_TYPE);
+	int messageType = info.value(MESSAGE_TYPE).toInt();
+	QString dataID = info.value(DATA).toObject().value(DATA_ID).toString();
+
+	for (int i = 0; i < mOutstandingRequests.count(); i++) {
+		const OutstandingRequest& outstanding = mOutstandingRequests.at(i);
+		if (hasType && outstanding.MessageType != messageType) {
+			continue;
+		}
+		if (!dataID.isEmpty() && !outstanding.DataID.isEmpty() && outstanding.DataID != dataID) {
+			continue;
+		}
+
+		request = mOutstandingRequests.takeAt(i);
+		return true;
+	}
+	return false;
+}
@@ -0,0 +1,220 @@
+#include <TrafficReplay/TrafficReplayer.h>
+
+#include <fi3d/server/capture/TrafficReader.h>
+
+#include <QDebug>
+#include <QJsonDocument>
+#include <QTextStream>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace fi3d;
+using namespace replay;
+
+TrafficReplayer::TrafficReplayer(const QString& host, const int& port,
+	const bool& useSSL, const double& speed, const int& linger)
+	: QObject(),
+	mHost(host),
+	mPort(port),
+	mUseSSL(useSSL),
+	mSpeed(speed),
+	mLinger(linger),
+	mRecords(),
+	mCapturedResponses(0),
+	mNextRecord(0),
+	mClock(),
+	mReplayTimer(),
+	mClients(),
+	mRecorder(),
+	mLatencies(),
+	mReceivedMessages(0)
+{
+	mReplayTimer.setSingleShot(true);
+	mReplayTimer.setTimerType(Qt::PreciseTimer);
+	QObject::connect(
+		&mReplayTimer, &QTimer::timeout,
+		this, &TrafficReplayer::replayDueRecords);
+}
+
+TrafficReplayer::~TrafficReplayer() {}
+
+bool TrafficReplayer::load(const QString& capturePath) {
+	TrafficReader reader;
+	if (!reader.open(capturePath)) {
+		return false;
+	}
+
+	// Outbound records are only counted, the replay produces its own.
+	TrafficRecord record;
+	while (reader.readNext(record)) {
+		if (record.Event == TRAFFIC_OUTBOUND) {
+			mCapturedResponses++;
+		} else {
+			mRecords.append(record);
+		}
+	}
+
+	if (mRecords.isEmpty()) {
+		qWarning() << capturePath << "has nothing to replay.";
+		return false;
+	}
+
+	qInfo() << "Loaded" << mRecords.count() << "records spanning"
+		<< mRecords.last().Timestamp / 1.0e6 << "s from" << capturePath;
+	return true;
+}
+
+bool TrafficReplayer::record(const QString& capturePath, const bool& includePayloads) {
+	return mRecorder.open(capturePath, includePayloads);
+}
+
+void TrafficReplayer::start() {
+	mNextRecord = 0;
+	mClock.start();
+	this->replayDueRecords();
+}
+
+void TrafficReplayer::replayDueRecords() {
+	qint64 now = mClock.nsecsElapsed() / 1000;
+
+	for (; mNextRecord < mRecords.count(); mNextRecord++) {
+		const TrafficRecord& record = mRecords.at(mNextRecord);
+		if (this->getDueTime(record) > now) {
+			break;
+		}
+
+		switch (record.Event) {
+			case TRAFFIC_CONNECTED:
+				this->connectClient(record.ClientID);
+				break;
+			case TRAFFIC_DISCONNECTED:
+			{
+				QSharedPointer<ReplayClient> client = mClients.value(record.ClientID);
+				if (!client.isNull()) {
+					client->disconnectFromHost();
+				}
+				mRecorder.recordDisconnected(record.ClientID);
+				break;
+			}
+			case TRAFFIC_INBOUND:
+			{
+				// Clients connected before the capture started may not have
+				// a connection record.
+				if (!mClients.contains(record.ClientID)) {
+					this->connectClient(record.ClientID);
+				}
+				mClients.value(record.ClientID)->replay(record);
+				break;
+			}
+			default:
+				break;
+		}
+	}
+
+	if (mNextRecord < mRecords.count()) {
+		qint64 wait = this->getDueTime(mRecords.at(mNextRecord)) - now;
+		mReplayTimer.start((int)qMax((qint64)0, wait / 1000));
+		return;
+	}
+
+	qInfo() << "All records replayed, waiting" << mLinger << "ms for responses";
+	QTimer::singleShot(mLinger, this, &TrafficReplayer::stop);
+}
+
+void TrafficReplayer::stop() {
+	double elapsedSeconds = mClock.nsecsElapsed() / 1.0e9;
+	double capturedSeconds = mRecords.last().Timestamp / 1.0e6;
+
+	QHash<QString, QSharedPointer<ReplayClient>>::iterator it = mClients.begin();
+	for (; it != mClients.end(); it++) {
+		it.value()->disconnect(this);
+		it.value()->abort();
+	}
+	mRecorder.close();
+
+	QTextStream stream(stdout);
+	stream << QString("\nReplayed %1 s of traffic in %2 s (speed %3)\n")
+		.arg(capturedSeconds, 0, 'f', 1).arg(elapsedSeconds, 0, 'f', 1).arg(mSpeed);
+	stream << QString("Responses: %1 captured, %2 replayed\n\n")
+		.arg(mCapturedResponses).arg(mReceivedMessages);
+
+	stream << QString("%1 %2 %3 %4 %5\n")
+		.arg("request", -32).arg("count", 9)
+		.arg("p50(ms)", 10).arg("p99(ms)", 10).arg("max(ms)", 10);
+
+	QStringList names = mLatencies.keys();
+	names.sort();
+	for (const QString& name : names) {
+		const QVector<qint64>& latencies = mLatencies[name];
+		stream << QString("%1 %2 %3 %4 %5\n")
+			.arg(name, -32)
+			.arg(latencies.count(), 9)
+			.arg(getPercentile(latencies, 50) / 1000.0, 10, 'f', 2)
+			.arg(getPercentile(latencies, 99) / 1000.0, 10, 'f', 2)
+			.arg(getPercentile(latencies, 100) / 1000.0, 10, 'f', 2);
+	}
+	stream.flush();
+
+	emit finished(0);
+}
+
+void TrafficReplayer::connectClient(const QString& originalID) {
+	if (mClients.contains(originalID)) {
+		return;
+	}
+
+	QSharedPointer<ReplayClient> client(new ReplayClient(originalID, &mClock));
+	QObject::connect(
+		client.data(), &ReplayClient::sent,
+		[=](const QString& originalID, const QByteArray& info, const QByteArray& payload) {
+			mRecorder.recordInbound(originalID, info, &payload);
+		});
+	QObject::connect(
+		client.data(), &ReplayClient::received,
+		[=](const QString& originalID, MessagePtr message) {
+			mReceivedMessages++;
+			if (mRecorder.isOpen()) {
+				QByteArray info = QJsonDocument(*message->getInfo().data()).toJson(QJsonDocument::JsonFormat::Compact);
+				mRecorder.recordOutbound(originalID, info,
+					message->hasPayload() ? message->getPayload().data() : Q_NULLPTR);
+			}
+		});
+	QObject::connect(
+		client.data(), &ReplayClient::responded,
+		[=](const QString& requestName, const qint64& latencyUs) {
+			mLatencies[requestName].append(latencyUs);
+		});
+	mClients.insert(originalID, client);
+	mRecorder.recordConnected(originalID);
+
+	if (mUseSSL) {
+		QObject::connect(
+			client.data(), QOverload<const QList<QSslError>&>::of(&QSslSocket::sslErrors),
+			[=](const QList<QSslError>& errors) {
+				client->ignoreSslErrors();
+			});
+		client->connectToHostEncrypted(mHost, mPort);
+	} else {
+		client->connectToHost(mHost, mPort);
+	}
+}
+
+qint64 TrafficReplayer::getDueTime(const TrafficRecord& record) const {
+	if (mSpeed <= 0) {
+		return 0;
+	}
+	return (qint64)(record.Timestamp / mSpeed);
+}
+
+qint64 TrafficReplayer::getPercentile(QVector<qint64> latencies, const double& percentile) {
+	if (latencies.isEmpty()) {
+		return 0;
+	}
+
+	// Nearest-rank percentile.
+	int rank = (int)std::ceil(percentile / 100.0 * latencies.count()) - 1;
+	rank = qBound(0, rank, latencies.count() - 1);
+	std::nth_element(latencies.begin(), latencies.begin() + rank, latencies.end());
+	return latencies.at(rank);
+}
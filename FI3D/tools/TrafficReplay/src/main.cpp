@@ -0,0 +1,57 @@
+#include <TrafficReplay/TrafficReplayer.h>
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QTimer>
+
+using namespace replay;
+
+int main(int argc, char *argv[])
+{
+	QCoreApplication app(argc, argv);
+	QCoreApplication::setApplicationName("FI3DTrafficReplay");
+
+	QCommandLineParser parser;
+	parser.setApplicationDescription(
+		"Replays the messages of an FI3D traffic capture against a server.");
+	parser.addHelpOption();
+	parser.addPositionalArgument("capture", "The traffic capture to replay.");
+
+	QCommandLineOption hostOption("host", "Address of the server.", "host", "localhost");
+	QCommandLineOption portOption("port", "Port of the server.", "port", "9000");
+	QCommandLineOption sslOption("ssl", "Use encrypted connections.");
+	QCommandLineOption speedOption("speed",
+		"Time scale of the replay, e.g. 2 for twice as fast, 0 for as fast as possible.", "speed", "1");
+	QCommandLineOption lingerOption("linger",
+		"Milliseconds to wait for responses after the last message.", "ms", "2000");
+	QCommandLineOption recordOption("record", "Records the replay to the capture file.", "file");
+	QCommandLineOption payloadsOption("payloads", "Include payload contents in the recorded replay.");
+	parser.addOptions({hostOption, portOption, sslOption, speedOption,
+		lingerOption, recordOption, payloadsOption});
+	parser.process(app);
+
+	if (parser.positionalArguments().count() != 1) {
+		parser.showHelp(1);
+	}
+
+	TrafficReplayer replayer(parser.value(hostOption), parser.value(portOption).toInt(),
+		parser.isSet(sslOption), qMax(0.0, parser.value(speedOption).toDouble()),
+		qMax(0, parser.value(lingerOption).toInt()));
+
+	if (!replayer.load(parser.positionalArguments().first())) {
+		return 1;
+	}
+	if (parser.isSet(recordOption) &&
+		!replayer.record(parser.value(recordOption), parser.isSet(payloadsOption)))
+	{
+		return 1;
+	}
+
+	QObject::connect(
+		&replayer, &TrafficReplayer::finished,
+		&app, &QCoreApplication::exit,
+		Qt::QueuedConnection);
+	QTimer::singleShot(0, &replayer, &TrafficReplayer::start);
+
+	return app.exec();
+}
@@ -0,0 +1,152 @@
+#include <fi3d/utilities/ParallelAlgorithms.h>
+#include <fi3d/utilities/Voxelizer.h>
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <QTextStream>
+#include <QVector>
+
+#include <vtkNew.h>
+#include <vtkSTLReader.h>
+
+#include <cmath>
+
+using namespace fi3d;
+
+/// @brief Splats the vertices into the nearest voxel, as polyToImage used to.
+static ImageDataVPtr splatPoints(vtkPolyData* modelData, const double spacing[3]) {
+	ImageDataVPtr outData = ImageDataVPtr::New();
+	outData->SetSpacing(spacing[0], spacing[1], spacing[2]);
+
+	double bounds[6];
+	modelData->GetBounds(bounds);
+	int dimensions[3];
+	double origin[3];
+	for (int i = 0; i < 3; i++) {
+		dimensions[i] = qMax(1, static_cast<int>(std::ceil((bounds[i * 2 + 1] - bounds[i * 2]) / spacing[i])));
+		origin[i] = bounds[i * 2] + spacing[i] / 2;
+	}
+	outData->SetDimensions(dimensions);
+	outData->SetOrigin(origin);
+	outData->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+
+	for (int x = 0; x < dimensions[0]; x++) {
+		for (int y = 0; y < dimensions[1]; y++) {
+			for (int z = 0; z < dimensions[2]; z++) {
+				outData->SetScalarComponentFromDouble(x, y, z, 0, 0);
+			}
+		}
+	}
+
+	for (vtkIdType i = 0; i < modelData->GetNumberOfPoints(); i++) {
+		double p[3];
+		modelData->GetPoint(i, p);
+		int voxel[3];
+		for (int axis = 0; axis < 3; axis++) {
+			voxel[axis] = qBound(0, (int)((p[axis] - origin[axis]) / spacing[axis] + 0.5), dimensions[axis] - 1);
+		}
+		outData->SetScalarComponentFromDouble(voxel[0], voxel[1], voxel[2], 0, 255);
+	}
+	return outData;
+}
+
+/// @brief Counts the voxels that are not 0.
+static qint64 countSetVoxels(ImageDataVPtr image) {
+	int* dimensions = image->GetDimensions();
+	qint64 voxelCount = (qint64)dimensions[0] * dimensions[1] * dimensions[2];
+	const unsigned char* voxels = static_cast<const unsigned char*>(image->GetScalarPointer());
+	qint64 count = 0;
+	for (qint64 v = 0; v < voxelCount; v++) {
+		if (voxels[v] != 0) {
+			count++;
+		}
+	}
+	return count;
+}
+
+int main(int argc, char *argv[])
+{
+	QCoreApplication app(argc, argv);
+	QCoreApplication::setApplicationName("FI3DVoxelizerBenchmark");
+	QLoggingCategory::setFilterRules("*.debug=false");
+
+	QCommandLineParser parser;
+	parser.setApplicationDescription(
+		"Measures the voxelization of the DEMO meshes by the old vertex splat "
+		"and by the Voxelizer, as a surface and filled.");
+	parser.addHelpOption();
+
+	QCommandLineOption assetsOption("assets", "Directory of the STL meshes.", "path", TOOL_VOXELBENCH_ASSETS);
+	QCommandLineOption meshesOption("meshes", "Number of meshes to voxelize, 0 for all.", "count", "4");
+	QCommandLineOption spacingOption("spacing", "Comma separated isotropic spacings, in mm.", "list", "1,0.5,0.25");
+	QCommandLineOption repeatOption("repeat", "Timed runs of each case, the best is reported.", "count", "3");
+	QCommandLineOption splatOption("no-splat", "Skips the old vertex splat, which is slow at fine spacings.");
+	parser.addOptions({assetsOption, meshesOption, spacingOption, repeatOption, splatOption});
+	parser.process(app);
+
+	QDir assets(parser.value(assetsOption));
+	QStringList files = assets.entryList({"*.stl"}, QDir::Files, QDir::Name);
+	int meshCount = parser.value(meshesOption).toInt();
+	if (meshCount > 0 && meshCount < files.count()) {
+		files = files.mid(0, meshCount);
+	}
+	if (files.isEmpty()) {
+		qWarning() << "No STL meshes found in" << assets.absolutePath();
+		return 1;
+	}
+
+	QVector<vtkSmartPointer<vtkPolyData>> meshes;
+	for (const QString& file : files) {
+		vtkNew<vtkSTLReader> reader;
+		reader->SetFileName(assets.absoluteFilePath(file).toStdString().c_str());
+		reader->Update();
+		meshes.append(reader->GetOutput());
+	}
+
+	QVector<double> spacings;
+	for (const QString& value : parser.value(spacingOption).split(',', Qt::SkipEmptyParts)) {
+		if (value.toDouble() > 0) {
+			spacings.append(value.toDouble());
+		}
+	}
+	int repeat = qMax(1, parser.value(repeatOption).toInt());
+	bool isSplatting = !parser.isSet(splatOption);
+
+	QTextStream stream(stdout);
+	stream << QString("%1 meshes, %2 threads, best of %3\n\n")
+		.arg(meshes.count()).arg(ParallelAlgorithms::getThreadCount()).arg(repeat);
+	stream << QString("%1 %2 %3 %4\n")
+		.arg("spacing", -8).arg("mode", -8).arg("time(ms)", 10).arg("voxels", 12);
+
+	for (double spacing : spacings) {
+		double spacings3[3] = {spacing, spacing, spacing};
+		for (int mode = isSplatting ? 0 : 1; mode < 3; mode++) {
+			QElapsedTimer clock;
+			qint64 best = -1;
+			qint64 voxels = 0;
+			for (int run = 0; run < repeat; run++) {
+				voxels = 0;
+				qint64 elapsed = 0;
+				for (vtkSmartPointer<vtkPolyData> mesh : meshes) {
+					clock.start();
+					ImageDataVPtr image = mode == 0 ? splatPoints(mesh, spacings3) :
+						Voxelizer::voxelize(mesh, spacings3, mode == 2);
+					elapsed += clock.nsecsElapsed();
+					voxels += countSetVoxels(image);
+				}
+				best = best < 0 ? elapsed : qMin(best, elapsed);
+			}
+
+			const char* modeNames[3] = {"splat", "surface", "filled"};
+			stream << QString("%1 %2 %3 %4\n")
+				.arg(spacing, -8, 'g', 4).arg(modeNames[mode], -8)
+				.arg(best / 1.0e6, 10, 'f', 2).arg(voxels, 12);
+			stream.flush();
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,168 @@
+#include <fi3d/CUDA/cpu_computations.h>
+#include <fi3d/utilities/ParallelAlgorithms.h>
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <QTextStream>
+#include <QVector>
+
+#include <vtkNew.h>
+#include <vtkPoints.h>
+
+#include <cmath>
+
+using namespace fi3d;
+
+/// @brief The geometry of the robot, in mm.
+static const float SEPARATION = 100.0f;
+static const float RANGE = 30.0f;
+static const float DEPTH_MIN = 20.0f;
+static const float DEPTH_MAX = 120.0f;
+
+/// @brief Computes one point per the CUDA kernels, block i and thread j.
+static void computeKernelPoint(const bool& isCone, const int& i, const int& j,
+	const float& rowStepSize, const float& pointStepSize, float p[3])
+{
+	float radius = isCone ? RANGE : (i + 1) * rowStepSize;
+	float depth = isCone ? (i + 1) * rowStepSize + DEPTH_MIN : DEPTH_MIN;
+	float theta = (j + 1) * pointStepSize;
+
+	float x = radius * std::cos(theta);
+	float y = radius * std::sin(theta);
+	float magnitude = std::sqrt(x * x + y * y + SEPARATION * SEPARATION);
+
+	p[0] = x + depth * x / magnitude;
+	p[1] = y + depth * y / magnitude;
+	p[2] = SEPARATION + depth * SEPARATION / magnitude;
+}
+
+/// @brief Computes the points one at a time and inserts each, as the old copy loop did.
+static void insertPoints(vtkPoints* points, const bool& isCone, const int& rows, const int& rotations,
+	const float& rowStepSize, const float& pointStepSize)
+{
+	for (int i = 0; i < rows; i++) {
+		for (int j = 0; j < rotations; j++) {
+			float p[3];
+			computeKernelPoint(isCone, i, j, rowStepSize, pointStepSize, p);
+			points->InsertNextPoint(p);
+		}
+	}
+}
+
+/// @brief Computes the points with the CPU kernels into a preallocated array.
+static void writePoints(vtkPoints* points, const bool& isCone, const int& rows, const int& rotations,
+	const float& rowStepSize, const float& pointStepSize)
+{
+	points->SetDataTypeToFloat();
+	points->SetNumberOfPoints((vtkIdType)rows * rotations);
+	float* values = static_cast<float*>(points->GetData()->GetVoidPointer(0));
+	if (isCone) {
+		CUDA::computeMK3Workspace_cone_cpu(values, rows, rotations, rowStepSize, pointStepSize,
+			SEPARATION, RANGE, DEPTH_MIN);
+	} else {
+		CUDA::computeMK3Workspace_sphere_cpu(values, rows, rotations, rowStepSize, pointStepSize,
+			SEPARATION, DEPTH_MIN);
+	}
+}
+
+/// @brief Gets the largest distance, along any axis, between the points of both.
+static double getMaxError(vtkPoints* expected, vtkPoints* actual) {
+	if (expected->GetNumberOfPoints() != actual->GetNumberOfPoints()) {
+		return INFINITY;
+	}
+
+	double maxError = 0;
+	for (vtkIdType i = 0; i < expected->GetNumberOfPoints(); i++) {
+		double e[3], a[3];
+		expected->GetPoint(i, e);
+		actual->GetPoint(i, a);
+		for (int axis = 0; axis < 3; axis++) {
+			maxError = qMax(maxError, std::abs(e[axis] - a[axis]));
+		}
+	}
+	return maxError;
+}
+
+/// @brief Parses a comma separated list of counts in [1, 1024].
+static QVector<int> parseCounts(const QString& list) {
+	QVector<int> counts;
+	for (const QString& value : list.split(',', Qt::SkipEmptyParts)) {
+		int count = value.toInt();
+		if (count >= 1 && count <= 1024) {
+			counts.append(count);
+		}
+	}
+	return counts;
+}
+
+int main(int argc, char *argv[])
+{
+	QCoreApplication app(argc, argv);
+	QCoreApplication::setApplicationName("FI3DWorkspaceBenchmark");
+	QLoggingCategory::setFilterRules("*.debug=false");
+
+	QCommandLineParser parser;
+	parser.setApplicationDescription(
+		"Measures the MK3 robot workspace computed one inserted point at a "
+		"time and by the multithreaded CPU kernels.");
+	parser.addHelpOption();
+
+	QCommandLineOption translationsOption("translations", "Comma separated translation/insertion counts.", "list", "64,256,1024");
+	QCommandLineOption rotationsOption("rotations", "Comma separated rotation counts.", "list", "64,256,1024");
+	QCommandLineOption repeatOption("repeat", "Timed runs of each case, the best is reported.", "count", "5");
+	parser.addOptions({translationsOption, rotationsOption, repeatOption});
+	parser.process(app);
+
+	QVector<int> translationCounts = parseCounts(parser.value(translationsOption));
+	QVector<int> rotationCounts = parseCounts(parser.value(rotationsOption));
+	int repeat = qMax(1, parser.value(repeatOption).toInt());
+	if (translationCounts.isEmpty() || rotationCounts.isEmpty()) {
+		qWarning() << "The counts must be in [1, 1024].";
+		return 1;
+	}
+
+	QTextStream stream(stdout);
+	stream << QString("%1 threads, best of %2\n\n").arg(ParallelAlgorithms::getThreadCount()).arg(repeat);
+	stream << QString("%1 %2 %3 %4 %5 %6 %7\n")
+		.arg("shape", -7).arg("rows", 6).arg("rots", 6)
+		.arg("insert(ms)", 11).arg("cpu(ms)", 9).arg("speedup", 8).arg("max error", 11);
+
+	for (int shape = 0; shape < 2; shape++) {
+		const bool isCone = shape == 1;
+		for (int rows : translationCounts) {
+			for (int rotations : rotationCounts) {
+				const float rowStepSize = isCone ? (DEPTH_MAX - DEPTH_MIN) / rows : RANGE / rows;
+				const float pointStepSize = 6.28318f / rotations;
+
+				QElapsedTimer clock;
+				qint64 bestInsert = -1, bestWrite = -1;
+				vtkNew<vtkPoints> inserted, written;
+				for (int run = 0; run < repeat; run++) {
+					inserted->Initialize();
+					inserted->SetDataTypeToFloat();
+					clock.start();
+					insertPoints(inserted, isCone, rows, rotations, rowStepSize, pointStepSize);
+					qint64 elapsed = clock.nsecsElapsed();
+					bestInsert = bestInsert < 0 ? elapsed : qMin(bestInsert, elapsed);
+
+					written->Initialize();
+					clock.start();
+					writePoints(written, isCone, rows, rotations, rowStepSize, pointStepSize);
+					elapsed = clock.nsecsElapsed();
+					bestWrite = bestWrite < 0 ? elapsed : qMin(bestWrite, elapsed);
+				}
+
+				stream << QString("%1 %2 %3 %4 %5 %6 %7\n")
+					.arg(isCone ? "cone" : "sphere", -7).arg(rows, 6).arg(rotations, 6)
+					.arg(bestInsert / 1.0e6, 11, 'f', 3).arg(bestWrite / 1.0e6, 9, 'f', 3)
+					.arg((double)bestInsert / qMax<qint64>(1, bestWrite), 8, 'f', 1)
+					.arg(getMaxError(inserted, written), 11, 'g', 3);
+				stream.flush();
+			}
+		}
+	}
+
+	return 0;
+}